@@ -0,0 +1,133 @@
+#ifndef __ARENA_H
+#define __ARENA_H
+
+#include <stddef.h>
+#include "util.h"
+
+/*
+ * Declaration of a memory arena for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University.
+ *
+ * An arena hands out memory from large blocks, one allocation after
+ * the other, and never returns single allocations. Instead, all memory
+ * is returned at once by arena_reset or arena_kill. The arena is used
+ * through its allocator, see util.h, which can be given to the
+ * *_with_allocator constructors of e.g. table, dlist, list, queue and
+ * stack. The allocator has no deallocate function, so a container
+ * created in an arena without kill functions for its elements is
+ * killed in O(1) time, without visiting its elements. All containers
+ * of e.g. a request can thus be created in one arena and destroyed
+ * with one call to arena_reset.
+ *
+ * Any container with memory in the arena must not be used after the
+ * arena is reset or killed. A frozen table must still be killed before
+ * that, since the index built by table_freeze is not in the arena.
+ *
+ * After use, the function arena_kill must be called to de-allocate
+ * the dynamic memory used by the arena.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Arena type.
+typedef struct arena arena;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * arena_create() - Create an empty arena.
+ * @block_size: The number of bytes of each block, or 0 for a default
+ *              size of 64 KiB. Larger allocations get a block of
+ *              their own.
+ *
+ * No block is allocated until the first allocation.
+ *
+ * Returns: A pointer to the new arena, or NULL if not enough memory
+ * was available.
+ */
+arena *arena_create(size_t block_size);
+
+/**
+ * arena_allocator() - Return the allocator of an arena.
+ * @a: Arena to allocate from.
+ *
+ * The allocator returns zero-initialized memory from the arena. It
+ * has no deallocate function. The allocator is valid until the arena
+ * is killed.
+ *
+ * Returns: A pointer to the allocator.
+ */
+const allocator *arena_allocator(arena *a);
+
+/**
+ * arena_allocate() - Allocate memory from an arena.
+ * @a: Arena to allocate from.
+ * @size: The number of bytes to allocate.
+ *
+ * The memory is suitably aligned for any built-in type, and is valid
+ * until the arena is reset or killed.
+ *
+ * Returns: A pointer to size bytes of zero-initialized memory, or NULL
+ * if not enough memory was available.
+ */
+void *arena_allocate(arena *a, size_t size);
+
+/**
+ * arena_reset() - Return all memory allocated from an arena.
+ * @a: Arena to reset.
+ *
+ * The blocks are kept and reused by later allocations, so an arena
+ * that is reset after each request stops allocating new blocks once
+ * it has grown to the size of the largest request.
+ *
+ * Returns: Nothing.
+ */
+void arena_reset(arena *a);
+
+/**
+ * arena_used() - Return the memory allocated from an arena.
+ * @a: Arena to inspect.
+ *
+ * Returns: The number of bytes allocated since the arena was created
+ * or last reset, including padding for alignment.
+ */
+size_t arena_used(const arena *a);
+
+/**
+ * arena_bytes() - Return the memory used by an arena.
+ * @a: Arena to inspect.
+ *
+ * Returns: The number of bytes of the head and all blocks of the
+ * arena.
+ */
+size_t arena_bytes(const arena *a);
+
+/**
+ * arena_kill() - Destroy an arena.
+ * @a: Arena to destroy.
+ *
+ * Return all dynamic memory used by the arena, including all memory
+ * allocated from it.
+ *
+ * Returns: Nothing.
+ */
+void arena_kill(arena *a);
+
+/**
+ * arena_print_internal() - Print the internal structure of the arena in dot format.
+ * @a: Arena to print.
+ * @desc: String with a description/state of the arena, or NULL for no description.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the arena and prints code that shows its internal
+ * structure, i.e. the head and the chain of blocks.
+ *
+ * Returns: Nothing.
+ */
+void arena_print_internal(const arena *a, const char *desc, int indent_level);
+
+#endif
@@ -24,6 +24,7 @@
  *   v1.0  2018-01-28: First public version.
  *   v1.5  2024-03-13: Renamed free_* stuff to kill_*. Converted to 4-tabs.
  *   v2.0  2024-05-10: Added print_internal.
+ *   v2.1  2026-10-18: Added array_1d_create_with_allocator.
  */
 
 // ==========PUBLIC DATA TYPES============
@@ -48,6 +49,23 @@ typedef struct array_1d array_1d;
  */
 array_1d *array_1d_create(int lo, int hi, kill_function kill_func);
 
+/**
+ * array_1d_create_with_allocator() - Create an array with a given allocator.
+ * @lo: low index limit.
+ * @hi: high index limit.
+ * @kill_func: A pointer to a function (or NULL) to be called to
+ *             de-allocate memory on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the
+ *         array. Must remain valid until the array is killed.
+ *
+ * See util.h for the definition of allocator.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_1d *array_1d_create_with_allocator(int lo, int hi, kill_function kill_func,
+                                         const allocator *alloc);
+
 /**
  * array_1d_low() - Return the low index limit for the array.
  * @a: array to inspect.
@@ -0,0 +1,273 @@
+#ifndef __CACHE_H
+#define __CACHE_H
+
+#include <stdbool.h>
+#include "util.h"
+
+/*
+ * Declaration of a generic, bounded cache for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University.
+ *
+ * The cache is a table with a fixed capacity. When a pair is inserted
+ * into a full cache, a pair is evicted according to the eviction
+ * policy of the cache, by default the least recently used pair (LRU).
+ * The CLOCK policy approximates LRU without reordering pairs on a
+ * hit. The 2Q and S3-FIFO policies resist scans, i.e. a sequence of
+ * keys used once does not evict the frequently used pairs. Lookups,
+ * inserts and evictions take O(1) expected time, amortized for CLOCK
+ * and S3-FIFO. The cache counts the number of lookups that found their
+ * key (hits) and the number that did not (misses).
+ *
+ * The cache stores void pointers, so it can be used to store all
+ * types of values. After use, the function cache_kill must be called
+ * to de-allocate the dynamic memory used by the cache itself. The
+ * de-allocation of any dynamic memory allocated for the key and/or
+ * value values is the responsibility of the user of the cache, unless
+ * a corresponding kill_function is registered in cache_empty.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: Added cache_empty_with_policy with the CLOCK, 2Q
+ *                     and S3-FIFO eviction policies.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Cache type.
+typedef struct cache cache;
+
+// Eviction policies, see cache_empty_with_policy.
+typedef enum cache_policy {
+    CACHE_LRU,
+    CACHE_CLOCK,
+    CACHE_2Q,
+    CACHE_S3_FIFO
+} cache_policy;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * cache_empty() - Create an empty LRU cache.
+ * @capacity: The maximum number of key/value pairs in the cache.
+ * @key_cmp_func: A pointer to a function to be used to compare keys. See
+ *                util.h for the definition of compare_function.
+ * @key_hash_func: A pointer to a function to be used to hash keys. See
+ *                 util.h for the definition of hash_function.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/evict/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/evict/kill.
+ *
+ * The least recently used pair is evicted. Equivalent to
+ * cache_empty_with_policy() with the policy CACHE_LRU.
+ *
+ * Returns: Pointer to a new cache, or NULL if capacity is not positive.
+ */
+cache *cache_empty(int capacity, compare_function *key_cmp_func,
+                   hash_function *key_hash_func, kill_function key_kill_func,
+                   kill_function value_kill_func);
+
+/**
+ * cache_empty_with_policy() - Create an empty cache with a given eviction policy.
+ * @capacity: The maximum number of key/value pairs in the cache.
+ * @policy: The eviction policy:
+ *          CACHE_LRU - evict the least recently used pair.
+ *          CACHE_CLOCK - evict the first pair not used since the clock
+ *                        hand last passed it.
+ *          CACHE_2Q - keep new pairs in a FIFO queue, and only move the
+ *                     pairs that return after being evicted to an LRU list.
+ *          CACHE_S3_FIFO - keep new pairs in a small FIFO queue, and only
+ *                          move the pairs that are used again to a main
+ *                          FIFO queue.
+ * @key_cmp_func: A pointer to a function to be used to compare keys. See
+ *                util.h for the definition of compare_function.
+ * @key_hash_func: A pointer to a function to be used to hash keys. See
+ *                 util.h for the definition of hash_function.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/evict/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/evict/kill.
+ *
+ * The 2Q and S3-FIFO policies remember the hashes of recently evicted
+ * keys in addition to the pairs in the cache.
+ *
+ * Returns: Pointer to a new cache, or NULL if capacity is not positive.
+ */
+cache *cache_empty_with_policy(int capacity, cache_policy policy,
+                               compare_function *key_cmp_func,
+                               hash_function *key_hash_func,
+                               kill_function key_kill_func,
+                               kill_function value_kill_func);
+
+/**
+ * cache_set_evict_callback() - Register a function to call on eviction.
+ * @c: Cache to manipulate.
+ * @evict_func: Function (or NULL) called with the key and value of
+ *              each evicted pair.
+ *
+ * The function is called before any kill functions, e.g. to write the
+ * pair back to slower storage. It is not called for pairs removed by
+ * cache_remove() or cache_kill().
+ *
+ * Returns: Nothing.
+ */
+void cache_set_evict_callback(cache *c, inspect_callback_pair evict_func);
+
+/**
+ * cache_is_empty() - Check if a cache is empty.
+ * @c: Cache to check.
+ *
+ * Returns: True if the cache contains no key/value pairs, false otherwise.
+ */
+bool cache_is_empty(const cache *c);
+
+/**
+ * cache_size() - Return the number of key/value pairs in a cache.
+ * @c: Cache to inspect.
+ *
+ * Returns: The number of key/value pairs.
+ */
+int cache_size(const cache *c);
+
+/**
+ * cache_capacity() - Return the capacity of a cache.
+ * @c: Cache to inspect.
+ *
+ * Returns: The maximum number of key/value pairs.
+ */
+int cache_capacity(const cache *c);
+
+/**
+ * cache_get() - Look up a given key in a cache.
+ * @c: Cache to manipulate.
+ * @key: Key to look up.
+ *
+ * A found pair is marked as used according to the eviction policy,
+ * e.g. it becomes the most recently used pair of an LRU cache. The
+ * lookup is counted as a hit or a miss.
+ *
+ * Returns: The value corresponding to the key, or NULL if the key is
+ * not found in the cache.
+ */
+void *cache_get(cache *c, const void *key);
+
+/**
+ * cache_peek() - Look up a given key without updating the cache.
+ * @c: Cache to inspect.
+ * @key: Key to look up.
+ *
+ * Unlike cache_get(), the pair is not marked as used and the hit/miss
+ * counters are not updated.
+ *
+ * Returns: The value corresponding to the key, or NULL if the key is
+ * not found in the cache.
+ */
+void *cache_peek(const cache *c, const void *key);
+
+/**
+ * cache_put() - Add a key/value pair to a cache.
+ * @c: Cache to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ *
+ * If the key is already in the cache, the stored key/value pair is
+ * killed and replaced, and the pair is marked as used. Otherwise, if
+ * the cache is full, a pair is evicted first.
+ *
+ * Returns: 1 if a pair was evicted, otherwise 0.
+ */
+int cache_put(cache *c, void *key, void *value);
+
+/**
+ * cache_remove() - Remove a key/value pair from a cache.
+ * @c: Cache to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Will call any kill functions set for keys/values. Does nothing if
+ * key is not found in the cache.
+ *
+ * Returns: Nothing.
+ */
+void cache_remove(cache *c, const void *key);
+
+/**
+ * cache_evict() - Evict a pair from a cache according to its policy.
+ * @c: Cache to manipulate.
+ *
+ * Calls the evict callback, if any, followed by any kill functions
+ * set for keys/values.
+ *
+ * Returns: 0 on success, -1 if the cache is empty.
+ */
+int cache_evict(cache *c);
+
+/**
+ * cache_hits() - Return the number of lookups that found their key.
+ * @c: Cache to inspect.
+ *
+ * Returns: The number of hits since the cache was created or the
+ * counters were reset.
+ */
+long cache_hits(const cache *c);
+
+/**
+ * cache_misses() - Return the number of lookups that did not find their key.
+ * @c: Cache to inspect.
+ *
+ * Returns: The number of misses since the cache was created or the
+ * counters were reset.
+ */
+long cache_misses(const cache *c);
+
+/**
+ * cache_reset_stats() - Reset the hit and miss counters.
+ * @c: Cache to manipulate.
+ *
+ * Returns: Nothing.
+ */
+void cache_reset_stats(cache *c);
+
+/**
+ * cache_kill() - Destroy a cache.
+ * @c: Cache to destroy.
+ *
+ * Return all dynamic memory used by the cache and its elements. If a
+ * kill_func was registered for keys and/or values at cache creation,
+ * it is called for each element to free any user-allocated memory
+ * occupied by the element values. The evict callback is not called.
+ *
+ * Returns: Nothing.
+ */
+void cache_kill(cache *c);
+
+/**
+ * cache_print() - Print the given cache.
+ * @c: Cache to print.
+ * @print_func: Function called for each key/value pair in the cache.
+ *
+ * Iterates over the key/value pairs and prints them. For an LRU cache,
+ * the pairs are printed from the most recently used to the least
+ * recently used pair. For the other policies, the order is unspecified.
+ *
+ * Returns: Nothing.
+ */
+void cache_print(const cache *c, inspect_callback_pair print_func);
+
+/**
+ * cache_print_internal() - Output the internal structure of the cache.
+ * @c: Cache to print.
+ * @key_print_func: Function called for each key in the cache.
+ * @value_print_func: Function called for each value in the cache.
+ * @desc: String with a description/state of the cache.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the cache and prints code that shows its' internal structure.
+ *
+ * Returns: Nothing.
+ */
+void cache_print_internal(const cache *c, inspect_callback key_print_func,
+                          inspect_callback value_print_func, const char *desc,
+                          int indent_level);
+
+#endif
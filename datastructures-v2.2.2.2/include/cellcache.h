@@ -0,0 +1,59 @@
+#ifndef __CELLCACHE_H
+#define __CELLCACHE_H
+
+#include "util.h"
+
+/*
+ * Declaration of an allocator with per-thread caches of small blocks
+ * for the "Datastructures and algorithms" courses at the Department
+ * of Computing Science, Umea University.
+ *
+ * The allocator is meant for the cells of lists, dlists and stacks,
+ * and is given to their *_with_allocator constructors. Each thread
+ * that allocates gets a cache with one free list per block size, and
+ * takes its blocks from large slabs that belong to the cache. A block
+ * that is returned by the thread that allocated it goes directly back
+ * to the free list of the thread, so allocations and deallocations
+ * take no lock. A block returned by another thread is collected in a
+ * batch, which is handed back to the owning cache under a lock once
+ * it holds 64 blocks. Once the caches have grown to the size needed,
+ * insertions and removals thus never call malloc or free.
+ *
+ * Blocks larger than 128 bytes are allocated with calloc and returned
+ * with free. The slabs are kept for the lifetime of the program. When
+ * a thread exits, its pending batch is handed back and its cache,
+ * with all its free blocks, is taken over by the next thread that
+ * starts to allocate.
+ *
+ * Programs that use the allocator must be linked with -pthread.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * cellcache_allocator() - Return the allocator with per-thread caches.
+ *
+ * The allocator may be used by any number of threads, and a block
+ * may be returned by another thread than the one that allocated it.
+ *
+ * Returns: A pointer to the allocator.
+ */
+const allocator *cellcache_allocator(void);
+
+/**
+ * cellcache_flush() - Hand back the blocks returned by this thread to
+ *                     the caches of other threads.
+ *
+ * Blocks returned by one thread to the cache of another are collected
+ * in batches. The last, incomplete batch is handed back when the
+ * thread exits, or when this function is called, e.g. by a consumer
+ * thread before it waits for more work.
+ *
+ * Returns: Nothing.
+ */
+void cellcache_flush(void);
+
+#endif
@@ -28,6 +28,8 @@
  *   v2.0  2024-03-14: Added dlist_print_internal to output dot code for visualization.
  *                     Renamed free_* stuff to kill_*. Converted to 4-tabs.
  *   v2.1  2024-05-10: updated print_internal to enhance encapsulation.
+ *   v2.2  2026-10-18: Added dlist_empty_with_allocator.
+ *   v2.3  2026-10-18: dlist_kill takes O(1) time for lists in an arena.
  */
 
 // ==========PUBLIC DATA TYPES============
@@ -50,6 +52,19 @@ typedef struct cell *dlist_pos;
  */
 dlist *dlist_empty(kill_function kill_func);
 
+/**
+ * dlist_empty_with_allocator() - Create an empty dlist with a given allocator.
+ * @kill_func: A pointer to a function (or NULL) to be called to
+ *             de-allocate memory on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the list
+ *         and its elements. Must remain valid until the list is killed.
+ *
+ * See util.h for the definition of allocator.
+ *
+ * Returns: A pointer to the new list.
+ */
+dlist *dlist_empty_with_allocator(kill_function kill_func, const allocator *alloc);
+
 /**
  * dlist_is_empty() - Check if a dlist is empty.
  * @l: List to check.
@@ -131,6 +146,10 @@ dlist_pos dlist_remove(dlist *l, const dlist_pos p);
  * kill_func was registered at list creation, also calls it for each
  * element to return any user-allocated memory occupied by the element values.
  *
+ * A list without kill_func whose allocator has no deallocate function,
+ * e.g. a list in an arena, is not traversed, and the call takes O(1)
+ * time. Its memory is returned with the rest of the arena.
+ *
  * Returns: Nothing.
  */
 void dlist_kill(dlist *l);
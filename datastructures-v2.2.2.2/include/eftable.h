@@ -0,0 +1,144 @@
+#ifndef __EFTABLE_H
+#define __EFTABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "util.h"
+
+/*
+ * Declaration of a compressed, read-only table with integer keys and
+ * integer values for the "Datastructures and algorithms" courses at
+ * the Department of Computing Science, Umea University.
+ *
+ * The table is built once from a sorted array of keys and cannot be
+ * modified afterwards. The keys are stored with Elias-Fano encoding:
+ * the low bits of each key are packed into a bit array, and the high
+ * bits are stored in unary in a second bit array. The position of
+ * every 256th bit set and bit unset in the second array is sampled,
+ * so a lookup jumps close to the keys in question and takes O(1)
+ * expected time for keys that are spread evenly. The values are
+ * packed with the number of bits needed for the difference between
+ * the largest and the smallest value. A table with n keys from a
+ * range of u integers thus uses about 2 + log2(u/n) bits per key.
+ *
+ * After use, the function eftable_kill must be called to de-allocate
+ * the dynamic memory used by the table.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Elias-Fano table type.
+typedef struct eftable eftable;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * eftable_create() - Create a table from arrays of keys and values.
+ * @keys: The keys, in strictly increasing order.
+ * @values: The values, where values[i] belongs to keys[i].
+ * @n: The number of key/value pairs.
+ *
+ * The table keeps no reference to the arrays, which may be reused or
+ * deallocated directly after the call.
+ *
+ * Returns: A pointer to the new table, or NULL if n is negative, if
+ * the keys are not strictly increasing, or if not enough memory was
+ * available.
+ */
+eftable *eftable_create(const int *keys, const int *values, int n);
+
+/**
+ * eftable_is_empty() - Check if a table is empty.
+ * @t: Table to check.
+ *
+ * Returns: True if the table contains no key/value pairs, false otherwise.
+ */
+bool eftable_is_empty(const eftable *t);
+
+/**
+ * eftable_size() - Return the number of key/value pairs in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The number of key/value pairs.
+ */
+int eftable_size(const eftable *t);
+
+/**
+ * eftable_lookup() - Look up a given key in a table.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ * @value: Pointer to where the value of the key is stored, or NULL.
+ *
+ * Returns: True if the key is found in the table, false otherwise.
+ * The value is only stored if the key is found and value is non-NULL.
+ */
+bool eftable_lookup(const eftable *t, int key, int *value);
+
+/**
+ * eftable_inspect_key() - Return the key of a given pair.
+ * @t: Table to inspect.
+ * @i: Index of the pair, 0 <= i < eftable_size(t).
+ *
+ * The pairs are indexed in increasing key order, i.e. in the order
+ * they were given to eftable_create.
+ *
+ * Returns: The key of pair i.
+ */
+int eftable_inspect_key(const eftable *t, int i);
+
+/**
+ * eftable_inspect_value() - Return the value of a given pair.
+ * @t: Table to inspect.
+ * @i: Index of the pair, 0 <= i < eftable_size(t).
+ *
+ * Returns: The value of pair i.
+ */
+int eftable_inspect_value(const eftable *t, int i);
+
+/**
+ * eftable_bytes() - Return the memory used by a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The number of bytes allocated for the table, including
+ * the head.
+ */
+size_t eftable_bytes(const eftable *t);
+
+/**
+ * eftable_kill() - Destroy a table.
+ * @t: Table to destroy.
+ *
+ * Return all dynamic memory used by the table.
+ *
+ * Returns: Nothing.
+ */
+void eftable_kill(eftable *t);
+
+/**
+ * eftable_print() - Iterate over the table and print its pairs.
+ * @t: Table to print.
+ *
+ * Prints the key/value pairs in increasing key order.
+ *
+ * Returns: Nothing.
+ */
+void eftable_print(const eftable *t);
+
+/**
+ * eftable_print_internal() - Print the internal structure of the table in dot format.
+ * @t: Table to print.
+ * @desc: String with a description/state of the table, or NULL for no description.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the table and prints code that shows its internal
+ * structure, i.e. the head and the bit arrays with the keys and
+ * values.
+ *
+ * Returns: Nothing.
+ */
+void eftable_print_internal(const eftable *t, const char *desc, int indent_level);
+
+#endif
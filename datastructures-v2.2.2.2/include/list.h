@@ -27,6 +27,8 @@
  *   v1.3  2023-03-23: Renamed list_pos_are_equal to list_pos_is_equal.
  *   v2.0  2024-03-14: Added list_print_internal to output dot code for visualization.
  *   v2.1  2024-05-10: Updated print_internal to enhance encapsulation.
+ *   v2.2  2026-10-18: Added list_empty_with_allocator.
+ *   v2.3  2026-10-18: list_kill takes O(1) time for lists in an arena.
  */
 
 // ==========PUBLIC DATA TYPES============
@@ -48,6 +50,19 @@ typedef struct cell *list_pos;
  */
 list *list_empty(kill_function kill_func);
 
+/**
+ * list_empty_with_allocator() - Create an empty list with a given allocator.
+ * @kill_func: A pointer to a function (or NULL) to be called to
+ *             de-allocate memory on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the list
+ *         and its elements. Must remain valid until the list is killed.
+ *
+ * See util.h for the definition of allocator.
+ *
+ * Returns: A pointer to the new list.
+ */
+list *list_empty_with_allocator(kill_function kill_func, const allocator *alloc);
+
 /**
  * list_is_empty() - Check if a list is empty.
  * @l: List to check.
@@ -139,6 +154,10 @@ list_pos list_remove(list *l, const list_pos p);
  * kill_func was registered at list creation, also calls it for each
  * element to return any user-allocated memory occupied by the element values.
  *
+ * A list without kill_func whose allocator has no deallocate function,
+ * e.g. a list in an arena, is not traversed, and the call takes O(1)
+ * time. Its memory is returned with the rest of the arena.
+ *
  * Returns: Nothing.
  */
 void list_kill(list *l);
@@ -0,0 +1,195 @@
+#ifndef __MULTIMAP_H
+#define __MULTIMAP_H
+
+#include <stdbool.h>
+#include "util.h"
+
+/*
+ * Declaration of a generic multimap for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University.
+ *
+ * A multimap is a table where a key may have any number of values.
+ * Unlike table_insert, multimap_insert never overwrites a value.
+ * Instead, the values of each key are kept together in insertion
+ * order, so all values of a key are visited without searching for
+ * each of them. Inserts, counts and removals of keys take O(1)
+ * expected time (amortized for inserts), and multimap_lookup_all
+ * takes O(1) expected time plus O(1) per value.
+ *
+ * The multimap stores void pointers, so it can be used to store all
+ * types of values. After use, the function multimap_kill must be
+ * called to de-allocate the dynamic memory used by the multimap
+ * itself. The de-allocation of any dynamic memory allocated for the
+ * key and/or value values is the responsibility of the user of the
+ * multimap, unless a corresponding kill_function is registered in
+ * multimap_empty.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: The multimap_lookup_all callback gets a context
+ *                     argument from the caller.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Multimap type.
+typedef struct multimap multimap;
+
+// Callback of multimap_lookup_all. Gets a value and the argument
+// given to multimap_lookup_all.
+typedef void (*multimap_value_callback)(const void *value, void *arg);
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * multimap_empty() - Create an empty multimap.
+ * @key_cmp_func: A pointer to a function to be used to compare keys. See
+ *                util.h for the definition of compare_function.
+ * @key_hash_func: A pointer to a function to be used to hash keys. See
+ *                 util.h for the definition of hash_function.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on insert/remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new multimap.
+ */
+multimap *multimap_empty(compare_function *key_cmp_func,
+                         hash_function *key_hash_func,
+                         kill_function key_kill_func,
+                         kill_function value_kill_func);
+
+/**
+ * multimap_is_empty() - Check if a multimap is empty.
+ * @m: Multimap to check.
+ *
+ * Returns: True if the multimap contains no key/value pairs, false otherwise.
+ */
+bool multimap_is_empty(const multimap *m);
+
+/**
+ * multimap_size() - Return the number of key/value pairs in a multimap.
+ * @m: Multimap to inspect.
+ *
+ * Returns: The number of key/value pairs, counting every value of
+ * each key.
+ */
+int multimap_size(const multimap *m);
+
+/**
+ * multimap_key_count() - Return the number of distinct keys in a multimap.
+ * @m: Multimap to inspect.
+ *
+ * Returns: The number of distinct keys.
+ */
+int multimap_key_count(const multimap *m);
+
+/**
+ * multimap_insert() - Add a key/value pair to a multimap.
+ * @m: Multimap to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ *
+ * The value is added after any values the key already has. The
+ * multimap keeps the key of the first insert of a key. If a later
+ * insert of an equal key uses another key pointer and a key
+ * kill_function is registered, the new key is killed directly.
+ *
+ * Returns: Nothing.
+ */
+void multimap_insert(multimap *m, void *key, void *value);
+
+/**
+ * multimap_lookup() - Look up the latest value of a given key.
+ * @m: Multimap to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value that was inserted last for the key, or NULL if
+ * the key is not found in the multimap.
+ */
+void *multimap_lookup(const multimap *m, const void *key);
+
+/**
+ * multimap_lookup_all() - Visit all values of a given key.
+ * @m: Multimap to inspect.
+ * @key: Key to look up.
+ * @callback: Function called for each value of the key, in the order
+ *            the values were inserted.
+ * @arg: Argument passed on to each call of callback, e.g. a pointer
+ *       to state that the callback updates. May be NULL.
+ *
+ * The callback must not modify the multimap.
+ *
+ * Returns: The number of values of the key, i.e. the number of calls
+ * to callback.
+ */
+int multimap_lookup_all(const multimap *m, const void *key,
+                        multimap_value_callback callback, void *arg);
+
+/**
+ * multimap_count() - Return the number of values of a given key.
+ * @m: Multimap to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The number of values of the key, or 0 if the key is not
+ * found in the multimap.
+ */
+int multimap_count(const multimap *m, const void *key);
+
+/**
+ * multimap_remove() - Remove all key/value pairs of a given key.
+ * @m: Multimap to manipulate.
+ * @key: Key for which to remove pairs.
+ *
+ * Will call any kill functions set for keys/values. Does nothing if
+ * key is not found in the multimap.
+ *
+ * Returns: Nothing.
+ */
+void multimap_remove(multimap *m, const void *key);
+
+/**
+ * multimap_kill() - Destroy a multimap.
+ * @m: Multimap to destroy.
+ *
+ * Return all dynamic memory used by the multimap and its elements. If
+ * a kill_func was registered for keys and/or values at multimap
+ * creation, it is called for each element to free any user-allocated
+ * memory occupied by the element values.
+ *
+ * Returns: Nothing.
+ */
+void multimap_kill(multimap *m);
+
+/**
+ * multimap_print() - Print the given multimap.
+ * @m: Multimap to print.
+ * @print_func: Function called for each key/value pair in the multimap.
+ *
+ * Iterates over the keys in an unspecified order and prints each
+ * key/value pair. The pairs of a key are printed together, in the
+ * order the values were inserted.
+ *
+ * Returns: Nothing.
+ */
+void multimap_print(const multimap *m, inspect_callback_pair print_func);
+
+/**
+ * multimap_print_internal() - Output the internal structure of the multimap.
+ * @m: Multimap to print.
+ * @key_print_func: Function called for each key in the multimap.
+ * @value_print_func: Function called for each value in the multimap.
+ * @desc: String with a description/state of the multimap.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the multimap and prints code that shows its' internal
+ * structure.
+ *
+ * Returns: Nothing.
+ */
+void multimap_print_internal(const multimap *m, inspect_callback key_print_func,
+                             inspect_callback value_print_func, const char *desc,
+                             int indent_level);
+
+#endif
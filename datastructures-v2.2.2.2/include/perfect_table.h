@@ -0,0 +1,204 @@
+#ifndef __PERFECT_TABLE_H
+#define __PERFECT_TABLE_H
+
+#include <stdbool.h>
+#include "util.h"
+
+/*
+ * Declaration of a generic, immutable table indexed by a minimal
+ * perfect hash function for the "Datastructures and algorithms"
+ * courses at the Department of Computing Science, Umea University.
+ *
+ * The table is built once from a set of key/value pairs and cannot be
+ * modified afterwards. The key/value pairs are stored in a packed
+ * array without empty slots. The hash function is built with the
+ * compress, hash and displace (CHD) algorithm, i.e. the keys are
+ * distributed over a small number of buckets, and a displacement is
+ * stored for each bucket that maps the keys of the bucket to distinct
+ * slots. A lookup thus needs exactly one probe into the array.
+ *
+ * The table stores void pointers, so it can be used to store all
+ * types of values. After use, the function perfect_table_kill must be
+ * called to de-allocate the dynamic memory used by the table
+ * itself. The de-allocation of any dynamic memory allocated for the
+ * key and/or value values is the responsibility of the user of the
+ * table, unless a corresponding kill_function is registered in
+ * perfect_table_create.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: Added ordered queries min, max, floor, ceiling and range.
+ *   v1.2  2026-10-18: Retry the construction with a new seed and more buckets.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Perfect table type.
+typedef struct perfect_table perfect_table;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * perfect_table_create() - Create a table from a set of key/value pairs.
+ * @key_cmp_func: A pointer to a function to be used to compare keys. See
+ *                util.h for the definition of compare_function.
+ * @key_hash_func: A pointer to a function to be used to hash keys. See
+ *                 util.h for the definition of hash_function.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on kill.
+ * @n: The number of key/value pairs.
+ * @keys: Array with the n keys.
+ * @values: Array with the n values.
+ *
+ * The key/value pointers are copied into the table, the arrays
+ * themselves are not referenced after the call. If a key occurs more
+ * than once, the pair with the lowest index is kept. If a kill_func
+ * was registered, it is called for the keys and/or values of the
+ * discarded duplicates.
+ *
+ * The construction fails if two different keys have the same hash
+ * value. In that case, no kill function is called and the ownership
+ * of all keys and values stays with the caller.
+ *
+ * Returns: Pointer to a new table, or NULL if the construction failed.
+ */
+perfect_table *perfect_table_create(compare_function key_cmp_func,
+                                    hash_function key_hash_func,
+                                    kill_function key_kill_func,
+                                    kill_function value_kill_func,
+                                    int n, void *keys[], void *values[]);
+
+/**
+ * perfect_table_size() - Return the number of key/value pairs in a table.
+ * @pt: Table to inspect.
+ *
+ * Returns: The number of key/value pairs, excluding any discarded
+ *          duplicates.
+ */
+int perfect_table_size(const perfect_table *pt);
+
+/**
+ * perfect_table_lookup() - Look up a given key in a table.
+ * @pt: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to a given key, or NULL if the key
+ * is not found in the table.
+ */
+void *perfect_table_lookup(const perfect_table *pt, const void *key);
+
+/**
+ * perfect_table_inspect_key() - Return the key stored in a given slot.
+ * @pt: Table to inspect.
+ * @i: Slot index, 0 <= i < perfect_table_size(pt).
+ *
+ * Can be used together with perfect_table_inspect_value() to iterate
+ * over all key/value pairs in the table.
+ *
+ * Returns: The key stored in slot i.
+ */
+void *perfect_table_inspect_key(const perfect_table *pt, int i);
+
+/**
+ * perfect_table_inspect_value() - Return the value stored in a given slot.
+ * @pt: Table to inspect.
+ * @i: Slot index, 0 <= i < perfect_table_size(pt).
+ *
+ * Returns: The value stored in slot i.
+ */
+void *perfect_table_inspect_value(const perfect_table *pt, int i);
+
+/**
+ * perfect_table_min() - Return the smallest key in a table.
+ * @pt: Table to inspect.
+ *
+ * The slots are not ordered by key, so this and the other ordered
+ * queries below compare all keys, i.e. are O(n).
+ *
+ * Returns: The smallest key, or NULL if the table is empty.
+ */
+void *perfect_table_min(const perfect_table *pt);
+
+/**
+ * perfect_table_max() - Return the largest key in a table.
+ * @pt: Table to inspect.
+ *
+ * Returns: The largest key, or NULL if the table is empty.
+ */
+void *perfect_table_max(const perfect_table *pt);
+
+/**
+ * perfect_table_floor() - Return the largest key less than or equal to a key.
+ * @pt: Table to inspect.
+ * @key: Key to compare with.
+ *
+ * Returns: The largest key <= key, or NULL if there is none.
+ */
+void *perfect_table_floor(const perfect_table *pt, const void *key);
+
+/**
+ * perfect_table_ceiling() - Return the smallest key greater than or equal to a key.
+ * @pt: Table to inspect.
+ * @key: Key to compare with.
+ *
+ * Returns: The smallest key >= key, or NULL if there is none.
+ */
+void *perfect_table_ceiling(const perfect_table *pt, const void *key);
+
+/**
+ * perfect_table_range() - Iterate over the key/value pairs within an interval.
+ * @pt: Table to inspect.
+ * @lo: Lower bound of the interval, inclusive.
+ * @hi: Upper bound of the interval, inclusive.
+ * @callback: Function called for each key/value pair in the interval.
+ *
+ * The pairs are visited in ascending key order.
+ *
+ * Returns: Nothing.
+ */
+void perfect_table_range(const perfect_table *pt, const void *lo, const void *hi,
+                         inspect_callback_pair callback);
+
+/**
+ * perfect_table_kill() - Destroy a table.
+ * @pt: Table to destroy.
+ *
+ * Return all dynamic memory used by the table. If a kill_func was
+ * registered for keys and/or values at table creation, it is called
+ * for each element to free any user-allocated memory occupied by the
+ * element values.
+ *
+ * Returns: Nothing.
+ */
+void perfect_table_kill(perfect_table *pt);
+
+/**
+ * perfect_table_print() - Print the given table.
+ * @pt: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Iterates over the key/value pairs in slot order and prints them.
+ *
+ * Returns: Nothing.
+ */
+void perfect_table_print(const perfect_table *pt, inspect_callback_pair print_func);
+
+/**
+ * perfect_table_print_internal() - Output the internal structure of the table.
+ * @pt: Table to print.
+ * @key_print_func: Function called for each key in the table.
+ * @value_print_func: Function called for each value in the table.
+ * @desc: String with a description/state of the table.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the table and prints code that shows its' internal structure.
+ *
+ * Returns: Nothing.
+ */
+void perfect_table_print_internal(const perfect_table *pt, inspect_callback key_print_func,
+                                  inspect_callback value_print_func, const char *desc,
+                                  int indent_level);
+
+#endif
@@ -22,6 +22,8 @@
  * Version information:
  *   v1.0  2018-01-28: First public version.
  *   v1.1  2024-05-10: Added/updated print_internal to enhance encapsulation.
+ *   v1.2  2026-10-18: Added queue_empty_with_allocator.
+ *   v1.3  2026-10-18: queue_kill takes O(1) time for queues in an arena.
  */
 
 // ==========PUBLIC DATA TYPES============
@@ -40,6 +42,19 @@ typedef struct queue queue;
  */
 queue *queue_empty(kill_function kill_func);
 
+/**
+ * queue_empty_with_allocator() - Create an empty queue with a given allocator.
+ * @kill_func: A pointer to a function (or NULL) to be called to
+ *             de-allocate memory on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the queue
+ *         and its elements. Must remain valid until the queue is killed.
+ *
+ * See util.h for the definition of allocator.
+ *
+ * Returns: A pointer to the new queue.
+ */
+queue *queue_empty_with_allocator(kill_function kill_func, const allocator *alloc);
+
 /**
  * queue_is_empty() - Check if a queue is empty.
  * @q: Queue to check.
@@ -84,6 +99,10 @@ void *queue_front(const queue *q);
  * kill_func was registered at queue creation, also calls it for each
  * element to kill any user-allocated memory occupied by the element values.
  *
+ * A queue without kill_func whose allocator has no deallocate
+ * function, e.g. a queue in an arena, is not traversed, and the call
+ * takes O(1) time.
+ *
  * Returns: Nothing.
  */
 void queue_kill(queue *q);
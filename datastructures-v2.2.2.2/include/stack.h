@@ -22,6 +22,8 @@
  * Version information:
  *   v1.0  2018-01-28: First public version.
  *   v1.1  2024-05-10: Added/updated print_internal to enhance encapsulation.
+ *   v1.2  2026-10-18: Added stack_empty_with_allocator.
+ *   v1.3  2026-10-18: stack_kill takes O(1) time for stacks in an arena.
  */
 
 // ==========PUBLIC DATA TYPES============
@@ -40,6 +42,19 @@ typedef struct stack stack;
  */
 stack *stack_empty(kill_function kill_func);
 
+/**
+ * stack_empty_with_allocator() - Create an empty stack with a given allocator.
+ * @kill_func: A pointer to a function (or NULL) to be called to
+ *             de-allocate memory on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the stack
+ *         and its elements. Must remain valid until the stack is killed.
+ *
+ * See util.h for the definition of allocator.
+ *
+ * Returns: A pointer to the new stack.
+ */
+stack *stack_empty_with_allocator(kill_function kill_func, const allocator *alloc);
+
 /**
  * stack_is_empty() - Check if a stack is empty.
  * @s: Stack to check.
@@ -86,6 +101,10 @@ void *stack_top(const stack *s);
  * kill_func was registered at stack creation, also calls it for each
  * element to kill any user-allocated memory occupied by the element values.
  *
+ * A stack without kill_func whose allocator has no deallocate
+ * function, e.g. a stack in an arena, is not traversed, and the call
+ * takes O(1) time.
+ *
  * Returns: Nothing.
  */
 void stack_kill(stack *s);
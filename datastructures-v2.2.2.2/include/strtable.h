@@ -0,0 +1,138 @@
+#ifndef __STRTABLE_H
+#define __STRTABLE_H
+
+#include <stdbool.h>
+#include "util.h"
+
+/*
+ * Declaration of a table with string keys for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University.
+ *
+ * Unlike the generic table, the string table stores its own copies of
+ * the keys. The user does not need to allocate a copy of each key,
+ * and the key given to strtable_insert may be reused or deallocated
+ * directly after the call. Short keys are stored inside the table
+ * itself, so the table does not allocate any memory per key.
+ * Lookups, inserts and removals take O(1) expected time plus the time
+ * to hash and compare the key, amortized for inserts and removals.
+ *
+ * The values are void pointers, so the table can be used to store all
+ * types of values. After use, the function strtable_kill must be
+ * called to de-allocate the dynamic memory used by the table itself.
+ * The de-allocation of any dynamic memory allocated for the values is
+ * the responsibility of the user of the table, unless a
+ * kill_function is registered in strtable_empty.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// String table type.
+typedef struct strtable strtable;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * strtable_empty() - Create an empty string table.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+strtable *strtable_empty(kill_function value_kill_func);
+
+/**
+ * strtable_is_empty() - Check if a table is empty.
+ * @t: Table to check.
+ *
+ * Returns: True if the table contains no key/value pairs, false otherwise.
+ */
+bool strtable_is_empty(const strtable *t);
+
+/**
+ * strtable_size() - Return the number of key/value pairs in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The number of key/value pairs.
+ */
+int strtable_size(const strtable *t);
+
+/**
+ * strtable_insert() - Add a key/value pair to a table.
+ * @t: Table to manipulate.
+ * @key: The key, a '\0'-terminated string. The table stores a copy.
+ * @value: A pointer to the value value.
+ *
+ * If the key already exists, the value replaces the existing value,
+ * which is killed if a value kill_function is registered.
+ *
+ * Returns: Nothing.
+ */
+void strtable_insert(strtable *t, const char *key, void *value);
+
+/**
+ * strtable_lookup() - Look up a given key in a table.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to the key, or NULL if the key is
+ * not found in the table.
+ */
+void *strtable_lookup(const strtable *t, const char *key);
+
+/**
+ * strtable_remove() - Remove a key/value pair from a table.
+ * @t: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Will call any kill function set for values. Does nothing if key is
+ * not found in the table.
+ *
+ * Returns: Nothing.
+ */
+void strtable_remove(strtable *t, const char *key);
+
+/**
+ * strtable_kill() - Destroy a table.
+ * @t: Table to destroy.
+ *
+ * Return all dynamic memory used by the table, including the copies
+ * of the keys. If a kill_func was registered for values at table
+ * creation, it is called for each value.
+ *
+ * Returns: Nothing.
+ */
+void strtable_kill(strtable *t);
+
+/**
+ * strtable_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *              The key is passed as a const char *.
+ *
+ * Iterates over the key/value pairs in an unspecified order and
+ * prints them.
+ *
+ * Returns: Nothing.
+ */
+void strtable_print(const strtable *t, inspect_callback_pair print_func);
+
+/**
+ * strtable_print_internal() - Output the internal structure of the table.
+ * @t: Table to print.
+ * @value_print_func: Function called for each value in the table.
+ * @desc: String with a description/state of the table.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the table and prints code that shows its' internal
+ * structure. The keys are printed by the table itself.
+ *
+ * Returns: Nothing.
+ */
+void strtable_print_internal(const strtable *t, inspect_callback value_print_func,
+                             const char *desc, int indent_level);
+
+#endif
@@ -30,12 +30,38 @@
  *   v1.1  2024-04-15: Changed the comments to leave room for different
  *                     internal handling of duplicates.
  *   v1.2  2024-05-10: Added/updated print_internal to enhance encapsulation.
+ *   v1.3  2026-10-18: Added table_empty_with_hash.
+ *   v1.4  2026-10-18: Added table_freeze. table_insert and table_remove
+ *                     now return an error code.
+ *   v1.5  2026-10-18: Added the ordered queries table_min, table_max,
+ *                     table_floor, table_ceiling and table_range.
+ *   v1.6  2026-10-18: Added table_merge, table_intersect and
+ *                     table_difference.
+ *   v1.7  2026-10-18: Added table_clone.
+ *   v1.8  2026-10-18: Added table_empty_with_key_type and table_prefix_scan.
+ *   v1.9  2026-10-18: Added table_empty_with_allocator.
+ *   v1.10 2026-10-18: table_kill takes O(1) time for tables in an arena.
+ *   v1.11 2026-10-18: Added TABLE_KEY_OPAQUE, the key type of table_empty
+ *                     and table_empty_with_hash.
  */
 
 // ==========PUBLIC DATA TYPES============
 // Table type.
 typedef struct table table;
 
+// Policy for keys found in both tables in table_merge.
+typedef enum table_merge_policy {
+    TABLE_MERGE_KEEP_DST, // Keep the pair in the destination table
+    TABLE_MERGE_KEEP_SRC, // Replace it with the pair from the source table
+} table_merge_policy;
+
+// Representation of the keys, for tables that index the bytes of the keys.
+typedef enum table_key_type {
+    TABLE_KEY_STRING, // The keys are '\0'-terminated strings
+    TABLE_KEY_INT,    // The keys are pointers to int
+    TABLE_KEY_OPAQUE, // The keys are only known through key_cmp_func and key_hash_func
+} table_key_type;
+
 // ==========DATA STRUCTURE INTERFACE==========
 
 /**
@@ -53,6 +79,88 @@ table *table_empty(compare_function key_cmp_func,
                    kill_function key_kill_func,
                    kill_function value_kill_func);
 
+/**
+ * table_empty_with_hash() - Create an empty table with cached key hashes.
+ * @key_cmp_func: A pointer to a function to be used to compare keys. See
+ *                util.h for the definition of compare_function.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash
+ *                 keys. See util.h for the definition of hash_function.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * The hash of each key is computed once on insert and stored with
+ * the key. Lookups and removals compare the stored hashes first and
+ * only call key_cmp_func for entries with a matching hash. With
+ * key_hash_func == NULL, the table behaves as one created by
+ * table_empty().
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_with_hash(compare_function key_cmp_func,
+                             hash_function key_hash_func,
+                             kill_function key_kill_func,
+                             kill_function value_kill_func);
+
+/**
+ * table_empty_with_key_type() - Create an empty table for a given type of keys.
+ * @key_cmp_func: A pointer to a function to be used to compare keys. See
+ *                util.h for the definition of compare_function.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash
+ *                 keys. See util.h for the definition of hash_function.
+ * @key_type: The type of the keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * Tables that index the bytes of the keys, e.g. a radix tree, need to
+ * know how the keys are represented. Such tables treat the keys of a
+ * table created by table_empty() or table_empty_with_hash() as
+ * opaque, and index them by the bytes of their hashes, which is
+ * slower for the ordered queries. key_cmp_func must order the keys as
+ * strcmp() for strings and numerically for ints. Other tables only
+ * compare the keys with key_cmp_func, and ignore the key type.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_with_key_type(compare_function key_cmp_func,
+                                 hash_function key_hash_func,
+                                 table_key_type key_type,
+                                 kill_function key_kill_func,
+                                 kill_function value_kill_func);
+
+/**
+ * table_empty_with_allocator() - Create an empty table with a given allocator.
+ * @key_cmp_func: A pointer to a function to be used to compare keys. See
+ *                util.h for the definition of compare_function.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash
+ *                 keys. See util.h for the definition of hash_function.
+ * @key_type: The type of the keys, see table_empty_with_key_type().
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the table
+ *         and its elements. Must remain valid until the table and all
+ *         its clones are killed. See util.h for the definition of
+ *         allocator.
+ *
+ * The allocator is used for all memory that the table keeps between
+ * calls, e.g. its head, entries, list cells or tree nodes. Clones
+ * use the same allocator. Temporary memory used within a call and
+ * the index built by table_freeze() are allocated with malloc.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_with_allocator(compare_function key_cmp_func,
+                                  hash_function key_hash_func,
+                                  table_key_type key_type,
+                                  kill_function key_kill_func,
+                                  kill_function value_kill_func,
+                                  const allocator *alloc);
+
 /**
  * table_is_empty() - Check if a table is empty.
  * @t: Table to check.
@@ -73,9 +181,9 @@ bool table_is_empty(const table *t);
  * will return the latest added value for a duplicate
  * key and table_remove() will remove all duplicates for a given key.
  *
- * Returns: Nothing.
+ * Returns: 0 on success, -1 if the table is frozen.
  */
-void table_insert(table *t, void *key, void *value);
+int table_insert(table *t, void *key, void *value);
 
 /**
  * table_lookup() - Look up a given key in a table.
@@ -109,9 +217,184 @@ void *table_choose_key(const table *t);
  * functions set for keys/values. Does nothing if key is not found in
  * the table.
  *
+ * Returns: 0 on success, -1 if the table is frozen.
+ */
+int table_remove(table *t, const void *key);
+
+/**
+ * table_freeze() - Make a table immutable.
+ * @t: Table to freeze.
+ *
+ * Builds an index over the pairs with a minimal perfect hash
+ * function, i.e. every lookup needs exactly one probe. The index
+ * holds the latest value of each key. The table keeps its own
+ * representation for the other queries, including any stored
+ * duplicates, and no keys/values are killed by the freeze. They are
+ * killed by table_kill() as for any other table. After a successful
+ * freeze, table_insert() and table_remove() fail with an error code.
+ * The table must have been created with a hash function. Freezing an
+ * already frozen table does nothing.
+ *
+ * Returns: 0 on success, -1 if the table has no hash function, -2
+ * if two different keys have the same hash value. The table is
+ * unchanged if the freeze fails.
+ */
+int table_freeze(table *t);
+
+/**
+ * table_is_frozen() - Check if a table is frozen.
+ * @t: Table to check.
+ *
+ * Returns: True if table_freeze() has been successfully called for
+ * the table, otherwise false.
+ */
+bool table_is_frozen(const table *t);
+
+/**
+ * table_min() - Return the smallest key in a table.
+ * @t: Table to inspect.
+ *
+ * The keys are ordered by the key_cmp_func given at creation. A table
+ * that stores its keys ordered answers this and the other ordered
+ * queries below in O(log n + k) time, where k is the number of
+ * visited pairs. Other tables fall back to scanning all pairs.
+ *
+ * Returns: The smallest key, or NULL if the table is empty.
+ */
+void *table_min(const table *t);
+
+/**
+ * table_max() - Return the largest key in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The largest key, or NULL if the table is empty.
+ */
+void *table_max(const table *t);
+
+/**
+ * table_floor() - Return the largest key less than or equal to a key.
+ * @t: Table to inspect.
+ * @key: Key to compare with. Need not be stored in the table.
+ *
+ * Returns: The largest key <= key, or NULL if there is none.
+ */
+void *table_floor(const table *t, const void *key);
+
+/**
+ * table_ceiling() - Return the smallest key greater than or equal to a key.
+ * @t: Table to inspect.
+ * @key: Key to compare with. Need not be stored in the table.
+ *
+ * Returns: The smallest key >= key, or NULL if there is none.
+ */
+void *table_ceiling(const table *t, const void *key);
+
+/**
+ * table_range() - Iterate over the key/value pairs within an interval.
+ * @t: Table to inspect.
+ * @lo: Lower bound of the interval, inclusive.
+ * @hi: Upper bound of the interval, inclusive.
+ * @callback: Function called for each key/value pair in the interval.
+ *
+ * The pairs are visited in ascending key order. Each key is visited
+ * once, with its latest value. The callback must not modify the table.
+ *
+ * Returns: Nothing.
+ */
+void table_range(const table *t, const void *lo, const void *hi,
+                 inspect_callback_pair callback);
+
+/**
+ * table_prefix_scan() - Iterate over the key/value pairs with keys starting with a prefix.
+ * @t: Table to inspect. The keys must be '\0'-terminated strings.
+ * @prefix: The prefix. The empty string matches all keys.
+ * @callback: Function called for each key/value pair with a matching key.
+ *
+ * The pairs are visited in ascending key order. Each key is visited
+ * once, with its latest value. The callback must not modify the table.
+ *
  * Returns: Nothing.
  */
-void table_remove(table *t, const void *key);
+void table_prefix_scan(const table *t, const char *prefix,
+                       inspect_callback_pair callback);
+
+/**
+ * table_merge() - Move all key/value pairs from one table to another.
+ * @dst: Table to merge into.
+ * @src: Table to merge from. Empty after the call.
+ * @policy: Which pair to keep for keys found in both tables.
+ *
+ * The key/value pairs are moved, not copied, i.e. dst takes over the
+ * responsibility for the keys and values of src. For a key found in
+ * both tables, the pair that is not kept is treated as a duplicate,
+ * i.e. depending on the table design it is either killed directly or
+ * stored internally until the key is removed or the table is
+ * killed. Both tables must have been created with the same compare,
+ * hash and kill functions, and with the same allocator.
+ *
+ * Tables that keep their keys ordered are merged in linear time. Other
+ * tables use a hash join if they have a hash function.
+ *
+ * Returns: 0 on success, -1 if either table is frozen.
+ */
+int table_merge(table *dst, table *src, table_merge_policy policy);
+
+/**
+ * table_intersect() - Keep only the keys that are found in another table.
+ * @t: Table to manipulate.
+ * @other: Table with the keys to keep. Not modified.
+ *
+ * Removes each key/value pair of t whose key is not found in
+ * other. Will call any kill functions set for keys/values. The tables
+ * must have been created with the same compare and hash functions.
+ *
+ * Tables that keep their keys ordered are intersected in linear
+ * time. Other tables use a hash join if other has a hash function
+ * and fall back to O(n*m) comparisons otherwise.
+ *
+ * Returns: 0 on success, -1 if t is frozen.
+ */
+int table_intersect(table *t, const table *other);
+
+/**
+ * table_difference() - Remove the keys that are found in another table.
+ * @t: Table to manipulate.
+ * @other: Table with the keys to remove. Not modified.
+ *
+ * Removes each key/value pair of t whose key is found in other. Will
+ * call any kill functions set for keys/values. The tables must have
+ * been created with the same compare and hash functions. The time
+ * complexity is the same as for table_intersect().
+ *
+ * Returns: 0 on success, -1 if t is frozen.
+ */
+int table_difference(table *t, const table *other);
+
+/**
+ * table_clone() - Create a copy of a table.
+ * @t: Table to copy. Not modified.
+ *
+ * The copy is created in constant time. The two tables share their
+ * internal structure and key/value pairs until one of them is
+ * modified. What is copied then depends on the implementation. A
+ * table stored in a list or an array copies the whole list, i.e. the
+ * first insert or remove after a clone takes O(n) time for n pairs,
+ * in either table. A table stored in a tree only copies the nodes on
+ * the path to the modified key. The pairs themselves are never
+ * copied. A key/value pair is only killed when it is removed from the
+ * last table that shares it. The copy has the same compare, hash and
+ * kill functions as t, and is frozen if t is frozen. After use, the
+ * copy must be destroyed with table_kill(). The tables may be killed
+ * in any order.
+ *
+ * The shared parts have plain, non-atomic reference counts, which
+ * some tables update even on lookups. A table and all its clones
+ * must therefore only be used from one thread at a time, also when
+ * each thread uses a different clone.
+ *
+ * Returns: Pointer to the new table.
+ */
+table *table_clone(const table *t);
 
 /**
  * table_kill() - Destroy a table.
@@ -122,6 +405,10 @@ void table_remove(table *t, const void *key);
  * it is called each element to free any user-allocated memory
  * occupied by the element values.
  *
+ * A table without kill functions whose allocator has no deallocate
+ * function, e.g. a table in an arena, is not traversed, and the call
+ * takes O(1) time apart from killing the index of a frozen table.
+ *
  * Returns: Nothing.
  */
 void table_kill(table *t);
@@ -0,0 +1,207 @@
+#ifndef __TTLTABLE_H
+#define __TTLTABLE_H
+
+#include <stdbool.h>
+#include "util.h"
+
+/*
+ * Declaration of a generic table with expiring pairs for the
+ * "Datastructures and algorithms" courses at the Department of
+ * Computing Science, Umea University.
+ *
+ * Each key/value pair is inserted with a time to live (TTL), measured
+ * in ticks of a logical clock. The clock only moves when the user
+ * calls ttltable_advance_time, e.g. once per second from the main loop
+ * of a server. A pair expires when the clock reaches its insert time
+ * plus its TTL, and is then removed from the table as if by
+ * ttltable_remove. Lookups, inserts and removals take O(1) expected
+ * time. The expired pairs are found without scanning the table, in
+ * O(1) amortized time per pair for TTLs up to 2^24 ticks. A pair with
+ * a longer TTL is also moved once per 2^24 ticks that it waits beyond
+ * that, so its cost grows with TTL / 2^24.
+ *
+ * The table stores void pointers, so it can be used to store all
+ * types of values. After use, the function ttltable_kill must be
+ * called to de-allocate the dynamic memory used by the table itself.
+ * The de-allocation of any dynamic memory allocated for the key
+ * and/or value values is the responsibility of the user of the table,
+ * unless a corresponding kill_function is registered in
+ * ttltable_empty.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: ttltable_advance_time does not step one tick at a time.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// Table type.
+typedef struct ttltable ttltable;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * ttltable_empty() - Create an empty table with expiring pairs.
+ * @key_cmp_func: A pointer to a function to be used to compare keys. See
+ *                util.h for the definition of compare_function.
+ * @key_hash_func: A pointer to a function to be used to hash keys. See
+ *                 util.h for the definition of hash_function.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/expire/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/expire/kill.
+ *
+ * The clock of the new table is at time 0.
+ *
+ * Returns: Pointer to a new table.
+ */
+ttltable *ttltable_empty(compare_function *key_cmp_func,
+                         hash_function *key_hash_func,
+                         kill_function key_kill_func,
+                         kill_function value_kill_func);
+
+/**
+ * ttltable_set_expire_callback() - Register a function to call on expiry.
+ * @t: Table to manipulate.
+ * @expire_func: Function (or NULL) called with the key and value of
+ *               each expired pair.
+ *
+ * The function is called before any kill functions. It is not called
+ * for pairs removed by ttltable_remove() or ttltable_kill().
+ *
+ * Returns: Nothing.
+ */
+void ttltable_set_expire_callback(ttltable *t, inspect_callback_pair expire_func);
+
+/**
+ * ttltable_is_empty() - Check if a table is empty.
+ * @t: Table to check.
+ *
+ * Returns: True if the table contains no key/value pairs, false otherwise.
+ */
+bool ttltable_is_empty(const ttltable *t);
+
+/**
+ * ttltable_size() - Return the number of key/value pairs in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The number of pairs that have not expired.
+ */
+int ttltable_size(const ttltable *t);
+
+/**
+ * ttltable_insert() - Add a key/value pair with a time to live to a table.
+ * @t: Table to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ * @ttl: The number of ticks until the pair expires.
+ *
+ * If the key already exists, the key/value overwrites the existing
+ * pair and the pair gets the new TTL, e.g. to keep a session alive.
+ *
+ * Returns: 0 on success, -1 if ttl is 0. On failure, the pair is not
+ * inserted and the caller keeps the responsibility for its memory.
+ */
+int ttltable_insert(ttltable *t, void *key, void *value, unsigned long ttl);
+
+/**
+ * ttltable_lookup() - Look up a given key in a table.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to the key, or NULL if the key is
+ * not found in the table or has expired.
+ */
+void *ttltable_lookup(const ttltable *t, const void *key);
+
+/**
+ * ttltable_time_left() - Return the time left before a pair expires.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The number of ticks until the pair with the given key
+ * expires, or 0 if the key is not found in the table.
+ */
+unsigned long ttltable_time_left(const ttltable *t, const void *key);
+
+/**
+ * ttltable_remove() - Remove a key/value pair from a table.
+ * @t: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Will call any kill functions set for keys/values. Does nothing if
+ * key is not found in the table.
+ *
+ * Returns: Nothing.
+ */
+void ttltable_remove(ttltable *t, const void *key);
+
+/**
+ * ttltable_now() - Return the time of the clock of a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The number of ticks the clock has been advanced since the
+ * table was created.
+ */
+unsigned long ttltable_now(const ttltable *t);
+
+/**
+ * ttltable_advance_time() - Advance the clock of a table.
+ * @t: Table to manipulate.
+ * @ticks: The number of ticks to advance the clock.
+ *
+ * The pairs that expire are removed in the order of their expiry
+ * times. For each pair, the expire callback, if any, is called
+ * followed by any kill functions set for keys/values. The clock
+ * jumps over the ticks where no pair expires or moves within the
+ * timing wheel, so the time taken does not grow with ticks, but is
+ * O(1) amortized per expired pair and per emptied wheel slot. Pairs
+ * with TTLs beyond 2^24 ticks are moved again every 2^24 ticks until
+ * they are within range, at O(1) per move.
+ *
+ * Returns: The number of expired pairs.
+ */
+int ttltable_advance_time(ttltable *t, unsigned long ticks);
+
+/**
+ * ttltable_kill() - Destroy a table.
+ * @t: Table to destroy.
+ *
+ * Return all dynamic memory used by the table and its elements. If a
+ * kill_func was registered for keys and/or values at table creation,
+ * it is called for each element to free any user-allocated memory
+ * occupied by the element values. The expire callback is not called.
+ *
+ * Returns: Nothing.
+ */
+void ttltable_kill(ttltable *t);
+
+/**
+ * ttltable_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Iterates over the key/value pairs in an unspecified order and
+ * prints them.
+ *
+ * Returns: Nothing.
+ */
+void ttltable_print(const ttltable *t, inspect_callback_pair print_func);
+
+/**
+ * ttltable_print_internal() - Output the internal structure of the table.
+ * @t: Table to print.
+ * @key_print_func: Function called for each key in the table.
+ * @value_print_func: Function called for each value in the table.
+ * @desc: String with a description/state of the table.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the table and prints code that shows its' internal structure.
+ *
+ * Returns: Nothing.
+ */
+void ttltable_print_internal(const ttltable *t, inspect_callback key_print_func,
+                             inspect_callback value_print_func, const char *desc,
+                             int indent_level);
+
+#endif
@@ -15,8 +15,14 @@
  *   v1.1 2018-02-06: Updated explanation for the compare_function.
  *   v1.2 2023-01-14: Added version define constants and strings.
  *   v1.3 2024-03-13: Added PTR2ADDR macro.
+ *   v1.4 2026-10-18: Added hash_function.
+ *   v1.5 2026-10-18: Added allocator.
+ *   v1.6 2026-10-18: Added default_allocator and allocator_deallocate,
+ *                    implemented in util.c.
  */
 
+#include <stddef.h>
+
 // Macros to create a version string out of version constants
 #define STR_HELPER(x) #x
 #define STR(x) STR_HELPER(x)
@@ -72,6 +78,42 @@ typedef void (*inspect_callback_pair)(const void *, const void *);
 // value should be returned.
 typedef int compare_function(const void *,const void *);
 
+// Type definition for hash function, used by e.g. table.
+//
+// Hash functions should return the same value for any two arguments
+// that the corresponding compare_function considers equal. Arguments
+// that are not equal may share the same hash value, but should do so
+// as seldom as possible.
+typedef unsigned long hash_function(const void *);
+
+// Type definitions for the functions of an allocator.
+//
+// An allocation function should return a pointer to size bytes of
+// zero-initialized memory, or NULL if no memory is available. A
+// de-allocation function returns memory given by the allocation
+// function of the same allocator. It gets the same size as the
+// allocation, so that e.g. pools of equal-sized blocks can be used.
+typedef void *allocate_function(void *context, size_t size);
+typedef void deallocate_function(void *context, void *p, size_t size);
+
+// Allocator, used by e.g. table, dlist and list for their own memory
+// instead of calloc and free. The context pointer is passed to both
+// functions. The deallocate function may be NULL if the memory is
+// returned all at once by the owner of the allocator, e.g. an arena.
+typedef struct allocator {
+    allocate_function *allocate;
+    deallocate_function *deallocate;
+    void *context;
+} allocator;
+
+// The allocator that uses calloc and free, used by the constructors
+// that are given no allocator. Implemented in util.c.
+const allocator *default_allocator(void);
+
+// Return memory to an allocator, unless the allocator returns all its
+// memory at once. Implemented in util.c.
+void allocator_deallocate(const allocator *a, void *p, size_t size);
+
 // Constant used by ptr2addr, used by various print_internal functions.
 #define PTR2ADDR_MASK 0xffff
 
@@ -1,8 +1,10 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <table.h>
 #include <array_1d.h>
+#include <perfect_table.h>
 
 /**
  * @file    arraytable.c
@@ -12,8 +14,8 @@
  * 
  * @authors Alvar Sjögren, id24asn  
  *          Josefin Berg, id24jbg
- * @version 1.0
- * @date    2025-02-20
+ * @version 1.7
+ * @date    2026-10-18
  */
 
 
@@ -26,13 +28,19 @@ struct table {
     array_1d *entries; // The table entries are stored in a directed list
     int item_count;
     compare_function *key_cmp_func;
+    hash_function *key_hash_func; // NULL if no hashes are cached
     kill_function key_kill_func;
     kill_function value_kill_func;
+    perfect_table *frozen; // Non-NULL once the table has been frozen
+    int *shared; // Number of tables sharing entries and frozen, see table_clone
+    const allocator *alloc; // Allocator for the head, entries and array
 };
 
 typedef struct table_entry {
     void *key;
     void *value;
+    unsigned long hash; // Cached hash of the key, 0 without hash function
+    int refs; // Number of entry arrays referring to the entry
 } table_entry;
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
@@ -43,29 +51,98 @@ typedef struct table_entry {
  * @param key A pointer to a function to be used to compare keys.
  * @param value A pointer to a function (or NULL) to be called to
  *              de-allocate memory for keys on remove/kill.
+ * @param hash The hash of the key.
+ * @param alloc The allocator of the table.
  * @return Returns a pointer to the newly created table entry.
  */
-table_entry *table_entry_create(void *key, void *value)
+table_entry *table_entry_create(void *key, void *value, unsigned long hash,
+                                const allocator *alloc)
 {
-    table_entry *e = calloc(1, sizeof(*e));
+    table_entry *e = alloc->allocate(alloc->context, sizeof(*e));
 
     e->key = key;
     e->value = value;
+    e->hash = hash;
+    e->refs = 1;
 
     return e;
 }
 
 /**
- * @brief table_entry_kill() - Return the memory allocated to a table entry.
+ * @brief table_entry_kill() - Drop a reference to a table entry. The
+ *        entry struct is deallocated when the last reference is dropped.
  * 
- * @param v The table entry to deallocate.
+ * @param alloc The allocator of the table.
+ * @param v The table entry.
  */
-void table_entry_kill(void *v)
+void table_entry_kill(const allocator *alloc, void *v)
 {
     table_entry *e = v; // Convert the pointer (useful if debugging the code)
 
-    // All we need to do is to deallocate the struct.
-    free(e);
+    e->refs--;
+    if (e->refs == 0) {
+        allocator_deallocate(alloc, e, sizeof(*e));
+    }
+}
+
+/**
+ * @brief table_key_hash() - Compute the hash of a key.
+ * 
+ * @param t The table whose hash function to use.
+ * @param key The key to hash.
+ * @return Returns the hash of the key, or 0 if the table has no hash function.
+ */
+static unsigned long table_key_hash(const table *t, const void *key)
+{
+    if (t->key_hash_func == NULL) {
+        return 0;
+    }
+    return t->key_hash_func(key);
+}
+
+/**
+ * @brief table_entry_matches() - Check if a table entry matches a key.
+ *        The cached hashes are compared first, the key compare function
+ *        is only called if the hashes are equal.
+ * 
+ * @param t The table to which the entry belongs.
+ * @param e The table entry to check.
+ * @param key The key to compare with.
+ * @param hash The hash of the key, as returned by table_key_hash().
+ * @return true if the entry key is equal to key.
+ * @return false otherwise.
+ */
+static bool table_entry_matches(const table *t, const table_entry *e,
+                                const void *key, unsigned long hash)
+{
+    return e->hash == hash && t->key_cmp_func(e->key, key) == 0;
+}
+
+/**
+ * @brief table_unshare() - Give a table its own entry array before it
+ *        is modified. A clone shares the entry array with the table it
+ *        was cloned from. The whole array is copied on the first
+ *        modification of either table, in O(n) time for n entries,
+ *        while the entries themselves stay shared.
+ * 
+ * @param t The table to manipulate. Must not be frozen.
+ */
+static void table_unshare(table *t)
+{
+    if (*t->shared == 1) {
+        return;
+    }
+    (*t->shared)--;
+    t->shared = t->alloc->allocate(t->alloc->context, sizeof(*t->shared));
+    *t->shared = 1;
+
+    array_1d *entries = array_1d_create_with_allocator(0, MAXSIZE, NULL, t->alloc);
+    for (int i = 0; i < t->item_count; i++) {
+        table_entry *e = array_1d_inspect_value(t->entries, i);
+        e->refs++;
+        array_1d_set_value(entries, e, i);
+    }
+    t->entries = entries;
 }
 
 /**
@@ -80,15 +157,84 @@ table *table_empty(compare_function *key_cmp_func,
                    kill_function key_kill_func,
                    kill_function value_kill_func)
 {
-    table *t = calloc(1, sizeof(table));
+    return table_empty_with_hash(key_cmp_func, NULL, key_kill_func, value_kill_func);
+}
 
-    t->entries = array_1d_create(0, MAXSIZE, NULL);
+/**
+ * @brief table_empty_with_hash() - Create an empty table with cached key hashes.
+ * 
+ * @param key_cmp_func The key compare function.
+ * @param key_hash_func The key hash function, or NULL.
+ * @param key_kill_func The key kill function.
+ * @param value_kill_func The value kill function.
+ * @return Returns a pointer to the new empty table.
+ */
+table *table_empty_with_hash(compare_function *key_cmp_func,
+                             hash_function *key_hash_func,
+                             kill_function key_kill_func,
+                             kill_function value_kill_func)
+{
+    return table_empty_with_allocator(key_cmp_func, key_hash_func, TABLE_KEY_OPAQUE,
+                                      key_kill_func, value_kill_func, NULL);
+}
+
+/**
+ * @brief table_empty_with_key_type() - Create an empty table for a
+ *        given type of keys. The keys are only compared with
+ *        key_cmp_func, so the key type is not used.
+ * 
+ * @param key_cmp_func The key compare function.
+ * @param key_hash_func The key hash function, or NULL.
+ * @param key_type The type of the keys.
+ * @param key_kill_func The key kill function.
+ * @param value_kill_func The value kill function.
+ * @return Returns a pointer to the new empty table.
+ */
+table *table_empty_with_key_type(compare_function *key_cmp_func,
+                                 hash_function *key_hash_func,
+                                 table_key_type key_type,
+                                 kill_function key_kill_func,
+                                 kill_function value_kill_func)
+{
+    return table_empty_with_hash(key_cmp_func, key_hash_func, key_kill_func, value_kill_func);
+}
+
+/**
+ * @brief table_empty_with_allocator() - Create an empty table with a
+ *        given allocator. The keys are only compared with
+ *        key_cmp_func, so the key type is not used.
+ * 
+ * @param key_cmp_func The key compare function.
+ * @param key_hash_func The key hash function, or NULL.
+ * @param key_type The type of the keys.
+ * @param key_kill_func The key kill function.
+ * @param value_kill_func The value kill function.
+ * @param alloc The allocator, or NULL for calloc/free.
+ * @return Returns a pointer to the new empty table.
+ */
+table *table_empty_with_allocator(compare_function *key_cmp_func,
+                                  hash_function *key_hash_func,
+                                  table_key_type key_type,
+                                  kill_function key_kill_func,
+                                  kill_function value_kill_func,
+                                  const allocator *alloc)
+{
+    if (alloc == NULL) {
+        alloc = default_allocator();
+    }
+    table *t = alloc->allocate(alloc->context, sizeof(table));
+
+    t->entries = array_1d_create_with_allocator(0, MAXSIZE, NULL, alloc);
 
     t->key_cmp_func = key_cmp_func;
+    t->key_hash_func = key_hash_func;
     t->key_kill_func = key_kill_func;
     t->value_kill_func = value_kill_func;
+    t->alloc = alloc;
 
     t->item_count = 0;
+    t->shared = alloc->allocate(alloc->context, sizeof(*t->shared));
+    *t->shared = 1;
 
     return t;
 }
@@ -102,6 +248,9 @@ table *table_empty(compare_function *key_cmp_func,
  */
 bool table_is_empty(const table *t)
 {
+    if (t->frozen != NULL) {
+        return perfect_table_size(t->frozen) == 0;
+    }
     return t->item_count == 0;
 }
 
@@ -112,16 +261,23 @@ bool table_is_empty(const table *t)
  * @param t The table to insert into.
  * @param key The key to insert.
  * @param value The value to insert.
+ * @return Returns 0 on success, -1 if the table is frozen.
  */
-void table_insert(table *t, void *key, void *value)
+int table_insert(table *t, void *key, void *value)
 {
-    table_entry *e = table_entry_create(key, value);
+    if (t->frozen != NULL) {
+        return -1;
+    }
+    table_unshare(t);
+
+    unsigned long hash = table_key_hash(t, key);
+    table_entry *e = table_entry_create(key, value, hash, t->alloc);
     
     int index = array_1d_low(t->entries);
     while (index <= t->item_count-1)
     {
         table_entry *n = array_1d_inspect_value(t->entries, index);
-        if (t->key_cmp_func(n->key, key) == 0)
+        if (table_entry_matches(t, n, key, hash))
         {
             table_remove(t, n->key);
         } else {
@@ -131,6 +287,8 @@ void table_insert(table *t, void *key, void *value)
     
     array_1d_set_value(t->entries, e, t->item_count);
     t->item_count++;
+
+    return 0;
 }
 
 /**
@@ -142,12 +300,18 @@ void table_insert(table *t, void *key, void *value)
  */
 void *table_lookup(const table *t, const void *key)
 {
+    if (t->frozen != NULL) {
+        return perfect_table_lookup(t->frozen, key);
+    }
+
+    unsigned long hash = table_key_hash(t, key);
+
     int index = array_1d_low(t->entries);
     while (index <= t->item_count-1)
     {
         table_entry *e = array_1d_inspect_value(t->entries, index);
 
-        if (t->key_cmp_func(e->key, key) == 0) {
+        if (table_entry_matches(t, e, key, hash)) {
             return e->value;
         }
         index++;
@@ -163,6 +327,9 @@ void *table_lookup(const table *t, const void *key)
  */
 void *table_choose_key(const table *t)
 {
+    if (t->frozen != NULL) {
+        return perfect_table_inspect_key(t->frozen, 0);
+    }
     table_entry *e = array_1d_inspect_value(t->entries, 0);
     return e->key;
 }
@@ -175,28 +342,36 @@ void *table_choose_key(const table *t)
  * 
  * @param t The table to remove from.
  * @param key The key to remove.
+ * @return Returns 0 on success, -1 if the table is frozen.
  */
-void table_remove(table *t, const void *key)
+int table_remove(table *t, const void *key)
 {
+    if (t->frozen != NULL) {
+        return -1;
+    }
+    table_unshare(t);
+
     void *deferred_ptr = NULL;
     int items_to_remove = 0;
+    unsigned long hash = table_key_hash(t, key);
     
     int index = array_1d_low(t->entries);
     while (index <= t->item_count-1) {
         table_entry *e = array_1d_inspect_value(t->entries, index);
-        if (t->key_cmp_func(e->key, key) == 0) {
-            if (t->key_kill_func != NULL) {
+        if (table_entry_matches(t, e, key, hash)) {
+            // Entries shared with a clone keep their key and value.
+            if (t->key_kill_func != NULL && e->refs == 1) {
                 if (e->key == key) {
                     deferred_ptr = e->key;
                 } else {
                     t->key_kill_func(e->key);
                 }
             }
-            if (t->value_kill_func != NULL) {
+            if (t->value_kill_func != NULL && e->refs == 1) {
                 t->value_kill_func(e->value);
             }
             array_1d_set_value(t->entries, NULL, index);
-            table_entry_kill(e);
+            table_entry_kill(t->alloc, e);
             items_to_remove++;
         }
         index++;
@@ -218,6 +393,488 @@ void table_remove(table *t, const void *key)
     }
 
     t->item_count -= items_to_remove;
+
+    return 0;
+}
+
+/**
+ * @brief table_freeze() - Make the table immutable. A perfect_table is
+ *        built over the entries. The entries stay in the array, which
+ *        keeps the responsibility to kill the keys and values.
+ * 
+ * @param t The table to freeze.
+ * @return Returns 0 on success, -1 if the table has no hash function,
+ *         -2 if two different keys have the same hash value.
+ */
+int table_freeze(table *t)
+{
+    if (t->frozen != NULL) {
+        return 0;
+    }
+    if (t->key_hash_func == NULL) {
+        return -1;
+    }
+    // The frozen table must not be shared with any unfrozen clone.
+    table_unshare(t);
+
+    void **keys = calloc(t->item_count + 1, sizeof(*keys));
+    void **values = calloc(t->item_count + 1, sizeof(*values));
+    for (int i = 0; i < t->item_count; i++) {
+        table_entry *e = array_1d_inspect_value(t->entries, i);
+        keys[i] = e->key;
+        values[i] = e->value;
+    }
+
+    t->frozen = perfect_table_create(t->key_cmp_func, t->key_hash_func,
+                                     NULL, NULL, t->item_count, keys, values);
+    free(keys);
+    free(values);
+    if (t->frozen == NULL) {
+        return -2;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief table_is_frozen() - Check if the table is frozen.
+ * 
+ * @param t The table to check.
+ * @return true if the table is frozen.
+ * @return false otherwise.
+ */
+bool table_is_frozen(const table *t)
+{
+    return t->frozen != NULL;
+}
+
+/**
+ * @brief table_clone() - Create a copy of a table in constant time.
+ *        The copy shares the entry array, and the frozen table if
+ *        any, with t. The whole array is copied, in O(n) time, by
+ *        the first of the tables to be modified.
+ * 
+ * @param t The table to copy.
+ * @return Returns a pointer to the new table.
+ */
+table *table_clone(const table *t)
+{
+    table *c = t->alloc->allocate(t->alloc->context, sizeof(*c));
+    *c = *t;
+    (*c->shared)++;
+
+    return c;
+}
+
+/**
+ * @brief closest_key() - Find the key closest to a bound on one side
+ *        of it. The array is not ordered, so all entries are compared.
+ * 
+ * @param t The table to inspect.
+ * @param bound The bound key, or NULL for no bound.
+ * @param dir -1 to search for the largest key <= bound, +1 to search
+ *            for the smallest key >= bound.
+ * @return The closest key, or NULL if there is none.
+ */
+static void *closest_key(const table *t, const void *bound, int dir)
+{
+    void *best = NULL;
+    for (int i = 0; i < t->item_count; i++) {
+        table_entry *e = array_1d_inspect_value(t->entries, i);
+        if ((bound == NULL || dir * t->key_cmp_func(e->key, bound) >= 0)
+            && (best == NULL || dir * t->key_cmp_func(e->key, best) < 0)) {
+            best = e->key;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief sort_entries() - Sort table entries by key with a merge sort.
+ * 
+ * @param t The table whose keys to compare.
+ * @param a The array with the entries to sort.
+ * @param tmp A scratch array with room for n entries.
+ * @param n The number of entries.
+ */
+static void sort_entries(const table *t, table_entry **a, table_entry **tmp, int n)
+{
+    if (n < 2) {
+        return;
+    }
+    int mid = n / 2;
+    sort_entries(t, a, tmp, mid);
+    sort_entries(t, a + mid, tmp, n - mid);
+
+    int i = 0, j = mid, k = 0;
+    while (i < mid && j < n) {
+        if (t->key_cmp_func(a[j]->key, a[i]->key) < 0) {
+            tmp[k++] = a[j++];
+        } else {
+            tmp[k++] = a[i++];
+        }
+    }
+    while (i < mid) {
+        tmp[k++] = a[i++];
+    }
+    while (j < n) {
+        tmp[k++] = a[j++];
+    }
+    for (k = 0; k < n; k++) {
+        a[k] = tmp[k];
+    }
+}
+
+/**
+ * @brief table_min() - Return the smallest key in the table.
+ * 
+ * @param t The table to inspect.
+ * @return The smallest key, or NULL if the table is empty.
+ */
+void *table_min(const table *t)
+{
+    if (t->frozen != NULL) {
+        return perfect_table_min(t->frozen);
+    }
+    return closest_key(t, NULL, 1);
+}
+
+/**
+ * @brief table_max() - Return the largest key in the table.
+ * 
+ * @param t The table to inspect.
+ * @return The largest key, or NULL if the table is empty.
+ */
+void *table_max(const table *t)
+{
+    if (t->frozen != NULL) {
+        return perfect_table_max(t->frozen);
+    }
+    return closest_key(t, NULL, -1);
+}
+
+/**
+ * @brief table_floor() - Return the largest key less than or equal to
+ *        a given key.
+ * 
+ * @param t The table to inspect.
+ * @param key The key to compare with.
+ * @return The largest key <= key, or NULL if there is none.
+ */
+void *table_floor(const table *t, const void *key)
+{
+    if (t->frozen != NULL) {
+        return perfect_table_floor(t->frozen, key);
+    }
+    return closest_key(t, key, -1);
+}
+
+/**
+ * @brief table_ceiling() - Return the smallest key greater than or
+ *        equal to a given key.
+ * 
+ * @param t The table to inspect.
+ * @param key The key to compare with.
+ * @return The smallest key >= key, or NULL if there is none.
+ */
+void *table_ceiling(const table *t, const void *key)
+{
+    if (t->frozen != NULL) {
+        return perfect_table_ceiling(t->frozen, key);
+    }
+    return closest_key(t, key, 1);
+}
+
+/**
+ * @brief table_range() - Call a function for each key/value pair with
+ *        lo <= key <= hi, in ascending key order. The array never
+ *        holds duplicates, so the matching entries are just sorted.
+ * 
+ * @param t The table to inspect.
+ * @param lo The lower bound of the interval, inclusive.
+ * @param hi The upper bound of the interval, inclusive.
+ * @param callback The function called for each key/value pair.
+ */
+void table_range(const table *t, const void *lo, const void *hi,
+                 inspect_callback_pair callback)
+{
+    if (t->frozen != NULL) {
+        perfect_table_range(t->frozen, lo, hi, callback);
+        return;
+    }
+
+    table_entry **matches = calloc(t->item_count + 1, sizeof(*matches));
+    table_entry **tmp = calloc(t->item_count + 1, sizeof(*tmp));
+    int k = 0;
+    for (int i = 0; i < t->item_count; i++) {
+        table_entry *e = array_1d_inspect_value(t->entries, i);
+        if (t->key_cmp_func(e->key, lo) >= 0 && t->key_cmp_func(e->key, hi) <= 0) {
+            matches[k++] = e;
+        }
+    }
+
+    sort_entries(t, matches, tmp, k);
+    for (int i = 0; i < k; i++) {
+        callback(matches[i]->key, matches[i]->value);
+    }
+    free(matches);
+    free(tmp);
+}
+
+/**
+ * @brief table_prefix_scan() - Call a function for each key/value pair
+ *        with a key starting with a prefix, in ascending key order.
+ *        The keys must be strings. The array is kept when the table
+ *        is frozen, so it is always scanned.
+ * 
+ * @param t The table to inspect.
+ * @param prefix The prefix. The empty string matches all keys.
+ * @param callback The function called for each key/value pair.
+ */
+void table_prefix_scan(const table *t, const char *prefix,
+                       inspect_callback_pair callback)
+{
+    int len = strlen(prefix);
+    table_entry **matches = calloc(t->item_count + 1, sizeof(*matches));
+    table_entry **tmp = calloc(t->item_count + 1, sizeof(*tmp));
+    int k = 0;
+    for (int i = 0; i < t->item_count; i++) {
+        table_entry *e = array_1d_inspect_value(t->entries, i);
+        if (strncmp(e->key, prefix, len) == 0) {
+            matches[k++] = e;
+        }
+    }
+
+    sort_entries(t, matches, tmp, k);
+    for (int i = 0; i < k; i++) {
+        callback(matches[i]->key, matches[i]->value);
+    }
+    free(matches);
+    free(tmp);
+}
+
+/**
+ * @brief entry_index_create() - Build a hash index over the entries of
+ *        a table. The index is a perfect_table that maps each key to a
+ *        pointer to its position in the array. A lookup thus returns
+ *        non-NULL if and only if the key is in the table. The entries
+ *        stay in the array also when the table is frozen.
+ * 
+ * @param t The table whose entries to index.
+ * @param positions Output parameter for the array with the positions,
+ *                  to be deallocated by the caller after the index.
+ * @return The index, or NULL if the table has no hash function or two
+ *         different keys have the same hash value.
+ */
+static perfect_table *entry_index_create(const table *t, int **positions)
+{
+    *positions = NULL;
+    if (t->key_hash_func == NULL) {
+        return NULL;
+    }
+
+    int n = t->item_count;
+    void **keys = calloc(n + 1, sizeof(*keys));
+    void **values = calloc(n + 1, sizeof(*values));
+    *positions = calloc(n + 1, sizeof(**positions));
+    for (int i = 0; i < n; i++) {
+        keys[i] = ((table_entry *)array_1d_inspect_value(t->entries, i))->key;
+        (*positions)[i] = i;
+        values[i] = &(*positions)[i];
+    }
+
+    // The index does not own the keys, so no kill functions are given.
+    perfect_table *index = perfect_table_create(t->key_cmp_func, t->key_hash_func,
+                                                NULL, NULL, n, keys, values);
+    free(keys);
+    free(values);
+    return index;
+}
+
+/**
+ * @brief find_position() - Find the position of a key, using an index
+ *        if there is one and scanning the array otherwise.
+ * 
+ * @param t The table to inspect.
+ * @param index The index created by entry_index_create() for t, or NULL.
+ * @param key The key to look for.
+ * @return The position of the key in the array, or -1 if the key is
+ *         not found.
+ */
+static int find_position(const table *t, const perfect_table *index, const void *key)
+{
+    if (index != NULL) {
+        const int *p = perfect_table_lookup(index, key);
+        return p == NULL ? -1 : *p;
+    }
+    unsigned long hash = table_key_hash(t, key);
+    for (int i = 0; i < t->item_count; i++) {
+        if (table_entry_matches(t, array_1d_inspect_value(t->entries, i), key, hash)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief filter_keys() - Remove the pairs of a table depending on
+ *        whether their keys are found in another table. The kept
+ *        entries are compacted to the start of the array.
+ * 
+ * @param t The table to manipulate.
+ * @param other The table to look up the keys in.
+ * @param keep_found If true, keep the pairs whose keys are in other.
+ *                   If false, keep the pairs whose keys are not.
+ * @return Returns 0 on success, -1 if t is frozen.
+ */
+static int filter_keys(table *t, const table *other, bool keep_found)
+{
+    if (t->frozen != NULL) {
+        return -1;
+    }
+    if (t == other && keep_found) {
+        return 0;
+    }
+    table_unshare(t);
+
+    // Index the keys of the other table before any key is killed.
+    int *positions;
+    perfect_table *index = entry_index_create(other, &positions);
+
+    int kept = 0;
+    for (int i = 0; i < t->item_count; i++) {
+        table_entry *e = array_1d_inspect_value(t->entries, i);
+        array_1d_set_value(t->entries, NULL, i);
+        bool found = t == other || find_position(other, index, e->key) >= 0;
+        if (found == keep_found) {
+            array_1d_set_value(t->entries, e, kept);
+            kept++;
+        } else {
+            if (t->key_kill_func != NULL && e->refs == 1) {
+                t->key_kill_func(e->key);
+            }
+            if (t->value_kill_func != NULL && e->refs == 1) {
+                t->value_kill_func(e->value);
+            }
+            table_entry_kill(t->alloc, e);
+        }
+    }
+    t->item_count = kept;
+    if (index != NULL) {
+        perfect_table_kill(index);
+    }
+    free(positions);
+
+    return 0;
+}
+
+/**
+ * @brief table_merge() - Move all key/value pairs from one table to
+ *        another. The source entries are looked up in an index over
+ *        the destination entries. On a conflict where the source pair
+ *        is kept, the source entry takes the place of the destination
+ *        entry. The replaced entries are released after the index,
+ *        which refers to their keys, has been killed.
+ * 
+ * @param dst The table to merge into.
+ * @param src The table to merge from. Empty after the call.
+ * @param policy Which pair to keep for keys found in both tables.
+ * @return Returns 0 on success, -1 if either table is frozen.
+ */
+int table_merge(table *dst, table *src, table_merge_policy policy)
+{
+    if (dst->frozen != NULL || src->frozen != NULL) {
+        return -1;
+    }
+    if (dst == src) {
+        return 0;
+    }
+    table_unshare(dst);
+    table_unshare(src);
+
+    int *positions;
+    perfect_table *index = entry_index_create(dst, &positions);
+    // The replaced destination entries and their positions.
+    table_entry **replaced = calloc(src->item_count + 1, sizeof(*replaced));
+    int *replaced_pos = calloc(src->item_count + 1, sizeof(*replaced_pos));
+    int replaced_count = 0;
+
+    for (int i = 0; i < src->item_count; i++) {
+        table_entry *e = array_1d_inspect_value(src->entries, i);
+        array_1d_set_value(src->entries, NULL, i);
+        int pos = find_position(dst, index, e->key);
+
+        if (pos < 0) {
+            // New key, move the entry.
+            array_1d_set_value(dst->entries, e, dst->item_count);
+            dst->item_count++;
+            continue;
+        }
+        table_entry *d = array_1d_inspect_value(dst->entries, pos);
+        if (policy == TABLE_MERGE_KEEP_SRC) {
+            // Move the entry, and its reference, to the destination.
+            array_1d_set_value(dst->entries, e, pos);
+            replaced[replaced_count] = d;
+            replaced_pos[replaced_count] = pos;
+            replaced_count++;
+            continue;
+        }
+        // Entries shared with a clone keep their key and value.
+        if (src->key_kill_func != NULL && e->refs == 1 && e->key != d->key) {
+            src->key_kill_func(e->key);
+        }
+        if (src->value_kill_func != NULL && e->refs == 1 && e->value != d->value) {
+            src->value_kill_func(e->value);
+        }
+        table_entry_kill(src->alloc, e);
+    }
+    src->item_count = 0;
+    if (index != NULL) {
+        perfect_table_kill(index);
+    }
+    free(positions);
+
+    for (int i = 0; i < replaced_count; i++) {
+        table_entry *d = replaced[i];
+        table_entry *e = array_1d_inspect_value(dst->entries, replaced_pos[i]);
+        if (dst->key_kill_func != NULL && d->refs == 1 && d->key != e->key) {
+            dst->key_kill_func(d->key);
+        }
+        if (dst->value_kill_func != NULL && d->refs == 1 && d->value != e->value) {
+            dst->value_kill_func(d->value);
+        }
+        table_entry_kill(dst->alloc, d);
+    }
+    free(replaced);
+    free(replaced_pos);
+
+    return 0;
+}
+
+/**
+ * @brief table_intersect() - Keep only the keys that are found in
+ *        another table.
+ * 
+ * @param t The table to manipulate.
+ * @param other The table with the keys to keep.
+ * @return Returns 0 on success, -1 if t is frozen.
+ */
+int table_intersect(table *t, const table *other)
+{
+    return filter_keys(t, other, true);
+}
+
+/**
+ * @brief table_difference() - Remove the keys that are found in
+ *        another table.
+ * 
+ * @param t The table to manipulate.
+ * @param other The table with the keys to remove.
+ * @return Returns 0 on success, -1 if t is frozen.
+ */
+int table_difference(table *t, const table *other)
+{
+    return filter_keys(t, other, false);
 }
 
 /**
@@ -229,24 +886,42 @@ void table_remove(table *t, const void *key)
  */
 void table_kill(table *t) {
 
+    (*t->shared)--;
+    if (*t->shared > 0) {
+        // The entries and frozen table are still used by a clone.
+        allocator_deallocate(t->alloc, t, sizeof(*t));
+        return;
+    }
+    allocator_deallocate(t->alloc, t->shared, sizeof(*t->shared));
+
+    if (t->frozen != NULL) {
+        perfect_table_kill(t->frozen);
+    }
+    if (t->alloc->deallocate == NULL && t->key_kill_func == NULL
+        && t->value_kill_func == NULL) {
+        // No entry, key or value is returned on its own. The memory
+        // is returned at once by the owner of the allocator.
+        return;
+    }
+
     // Iterate over the list. Destroy all elements.
     int index = array_1d_low(t->entries);
 
     while (index <= t->item_count-1){
         table_entry *e = array_1d_inspect_value(t->entries, index);
 
-        if (t->key_kill_func != NULL) {
+        if (t->key_kill_func != NULL && e->refs == 1) {
             t->key_kill_func(e->key);
         }
-        if (t->value_kill_func != NULL) {
+        if (t->value_kill_func != NULL && e->refs == 1) {
             t->value_kill_func(e->value);
         }
-        table_entry_kill(e);
+        table_entry_kill(t->alloc, e);
         index++;
     }
 
     array_1d_kill(t->entries);
-    free(t);
+    allocator_deallocate(t->alloc, t, sizeof(*t));
 }
 
 /**
@@ -258,6 +933,11 @@ void table_kill(table *t) {
  */
 void table_print(const table *t, inspect_callback_pair print_func)
 {
+    if (t->frozen != NULL) {
+        perfect_table_print(t->frozen, print_func);
+        return;
+    }
+
     int i = array_1d_low(t->entries);
 
     while (i <= t->item_count-1) {
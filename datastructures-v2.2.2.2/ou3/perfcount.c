@@ -0,0 +1,231 @@
+// syscall is not part of C99.
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "perfcount.h"
+
+/*
+ * Implementation of hardware performance counters for the table
+ * benchmarks of the "Datastructures and algorithms" courses at the
+ * Department of Computing Science, Umea University.
+ *
+ * Each counter is a perf event of its own, not a group, so that the
+ * counters that the CPU has room for can be counted even when the
+ * others cannot. On other systems than Linux, no counter is available.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// ===========INTERNAL DATA TYPES ============
+
+static const char *names[PERF_COUNTER_COUNT] = {
+        "cycles", "instructions", "L1d_misses", "LLC_misses",
+        "branch_misses", "dTLB_misses",
+};
+
+#ifdef __linux__
+
+// The type and config of each counter.
+#define CACHE_READ_MISS(cache) ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) \
+                                | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static const struct {
+        uint32_t type;
+        uint64_t config;
+} events[PERF_COUNTER_COUNT] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D) },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        { PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_DTLB) },
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * read_raw() - Read the value and the times of a counter.
+ * @fd: The file descriptor of the counter.
+ * @raw: The value, time enabled and time running to fill in.
+ *
+ * Returns: 0 on success, otherwise -1.
+ */
+static int read_raw(int fd, uint64_t raw[3])
+{
+        return read(fd, raw, 3 * sizeof(raw[0])) == 3 * sizeof(raw[0]) ? 0 : -1;
+}
+
+#endif
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * perf_counter_name() - Get the name of a counter.
+ * @i: The index of the counter, from 0 to PERF_COUNTER_COUNT-1.
+ *
+ * Returns: The name, e.g. "cycles".
+ */
+const char *perf_counter_name(int i)
+{
+        return names[i];
+}
+
+/**
+ * perf_counters_open() - Open the counters, disabled and reset.
+ * @pc: The counters.
+ *
+ * Returns: The number of available counters. If it is less than
+ * PERF_COUNTER_COUNT, pc->error tells why a counter is unavailable.
+ */
+int perf_counters_open(perf_counters *pc)
+{
+        int available = 0;
+        memset(pc, 0, sizeof(*pc));
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+                pc->fd[i] = -1;
+#ifdef __linux__
+                struct perf_event_attr attr;
+                memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = events[i].type;
+                attr.config = events[i].config;
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+                        | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                // This thread, on any CPU.
+                pc->fd[i] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+                if (pc->fd[i] < 0) {
+                        pc->fd[i] = -1;
+                        pc->error = errno;
+                } else {
+                        available++;
+                }
+#else
+                pc->error = ENOSYS;
+#endif
+        }
+        perf_counters_reset(pc);
+        return available;
+}
+
+/**
+ * perf_counters_enable() - Start counting.
+ * @pc: The counters.
+ *
+ * Returns: Nothing.
+ */
+void perf_counters_enable(perf_counters *pc)
+{
+#ifdef __linux__
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+                if (pc->fd[i] >= 0) {
+                        ioctl(pc->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+                }
+        }
+#else
+        (void)pc;
+#endif
+}
+
+/**
+ * perf_counters_disable() - Stop counting.
+ * @pc: The counters.
+ *
+ * Returns: Nothing.
+ */
+void perf_counters_disable(perf_counters *pc)
+{
+#ifdef __linux__
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+                if (pc->fd[i] >= 0) {
+                        ioctl(pc->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+                }
+        }
+#else
+        (void)pc;
+#endif
+}
+
+/**
+ * perf_counters_reset() - Restart the values of the counters from 0.
+ * @pc: The counters.
+ *
+ * Returns: Nothing.
+ */
+void perf_counters_reset(perf_counters *pc)
+{
+        // PERF_EVENT_IOC_RESET does not reset the times, so the values
+        // and times are instead kept, and subtracted when read.
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+                memset(pc->base[i], 0, sizeof(pc->base[i]));
+#ifdef __linux__
+                if (pc->fd[i] >= 0) {
+                        read_raw(pc->fd[i], pc->base[i]);
+                }
+#endif
+        }
+}
+
+/**
+ * perf_counters_read() - Read the counters.
+ * @pc: The counters.
+ * @values: Array of PERF_COUNTER_COUNT values to fill in.
+ *
+ * Each value is the number of events while the counter was enabled
+ * since the last reset, or NAN if the counter is unavailable.
+ *
+ * Returns: Nothing.
+ */
+void perf_counters_read(const perf_counters *pc, double values[])
+{
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+                values[i] = NAN;
+#ifdef __linux__
+                uint64_t raw[3];
+                if (pc->fd[i] < 0 || read_raw(pc->fd[i], raw) != 0) {
+                        continue;
+                }
+                double value = raw[0] - pc->base[i][0];
+                double enabled = raw[1] - pc->base[i][1];
+                double running = raw[2] - pc->base[i][2];
+                if (running > 0) {
+                        // Scale up for the time the counter had to
+                        // wait for the other counters.
+                        values[i] = value * enabled / running;
+                } else if (enabled == 0) {
+                        values[i] = 0;
+                }
+#endif
+        }
+}
+
+/**
+ * perf_counters_close() - Close the counters.
+ * @pc: The counters.
+ *
+ * Returns: Nothing.
+ */
+void perf_counters_close(perf_counters *pc)
+{
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+#ifdef __linux__
+                if (pc->fd[i] >= 0) {
+                        close(pc->fd[i]);
+                }
+#endif
+                pc->fd[i] = -1;
+        }
+}
@@ -0,0 +1,108 @@
+#ifndef __PERFCOUNT_H
+#define __PERFCOUNT_H
+
+#include <stdint.h>
+
+/*
+ * Declaration of hardware performance counters for the table benchmarks
+ * of the "Datastructures and algorithms" courses at the Department of
+ * Computing Science, Umea University.
+ *
+ * The counters are read with the perf_event_open system call of Linux,
+ * and count the events of the calling thread in user space only:
+ *
+ *   cycles             - CPU cycles.
+ *   instructions       - Retired instructions.
+ *   L1d_misses         - Read misses in the level 1 data cache.
+ *   LLC_misses         - Misses in the last level cache.
+ *   branch_misses      - Mispredicted branches.
+ *   dTLB_misses        - Read misses in the data TLB.
+ *
+ * Any of the counters may be unavailable, e.g. on other systems than
+ * Linux, in virtual machines without a virtual PMU, on CPUs without the
+ * event, or when /proc/sys/kernel/perf_event_paranoid is above 2. The
+ * value of an unavailable counter is NAN. When more counters are asked
+ * for than the CPU has, the kernel takes turns counting them, and the
+ * values are scaled up to the time the counters were enabled.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// The number of counters.
+#define PERF_COUNTER_COUNT 6
+
+// A set of counters. The members are internal.
+typedef struct perf_counters {
+        int fd[PERF_COUNTER_COUNT]; // File descriptors, -1 if unavailable
+        int error;                  // errno of the last failed counter
+        // Value, time enabled and time running at the last reset.
+        uint64_t base[PERF_COUNTER_COUNT][3];
+} perf_counters;
+
+// ==========COUNTER INTERFACE==========
+
+/**
+ * perf_counter_name() - Get the name of a counter.
+ * @i: The index of the counter, from 0 to PERF_COUNTER_COUNT-1.
+ *
+ * Returns: The name, e.g. "cycles".
+ */
+const char *perf_counter_name(int i);
+
+/**
+ * perf_counters_open() - Open the counters, disabled and reset.
+ * @pc: The counters.
+ *
+ * Returns: The number of available counters. If it is less than
+ * PERF_COUNTER_COUNT, pc->error tells why a counter is unavailable.
+ */
+int perf_counters_open(perf_counters *pc);
+
+/**
+ * perf_counters_enable() - Start counting.
+ * @pc: The counters.
+ *
+ * Returns: Nothing.
+ */
+void perf_counters_enable(perf_counters *pc);
+
+/**
+ * perf_counters_disable() - Stop counting.
+ * @pc: The counters.
+ *
+ * Returns: Nothing.
+ */
+void perf_counters_disable(perf_counters *pc);
+
+/**
+ * perf_counters_reset() - Restart the values of the counters from 0.
+ * @pc: The counters.
+ *
+ * Returns: Nothing.
+ */
+void perf_counters_reset(perf_counters *pc);
+
+/**
+ * perf_counters_read() - Read the counters.
+ * @pc: The counters.
+ * @values: Array of PERF_COUNTER_COUNT values to fill in.
+ *
+ * Each value is the number of events while the counter was enabled
+ * since the last reset, or NAN if the counter is unavailable.
+ *
+ * Returns: Nothing.
+ */
+void perf_counters_read(const perf_counters *pc, double values[]);
+
+/**
+ * perf_counters_close() - Close the counters.
+ * @pc: The counters.
+ *
+ * Returns: Nothing.
+ */
+void perf_counters_close(perf_counters *pc);
+
+#endif
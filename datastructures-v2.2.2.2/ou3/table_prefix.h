@@ -0,0 +1,57 @@
+#ifndef __TABLE_PREFIX_H
+#define __TABLE_PREFIX_H
+
+/*
+ * Renaming of the functions of a table implementation, so that several
+ * implementations can be linked into one program. A table
+ * implementation compiled with
+ *
+ *   gcc -c -DTABLE_PREFIX=table2 -include table_prefix.h table2.c
+ *
+ * defines table2_table_insert instead of table_insert etc. The
+ * functions of table.h are renamed, together with table_entry_create
+ * and table_entry_kill, that some implementations do not declare
+ * static. Used by the tablebench program.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#ifndef TABLE_PREFIX
+#error "TABLE_PREFIX must be defined, e.g. with -DTABLE_PREFIX=table2."
+#endif
+
+// Paste the prefix and the name. The extra level makes TABLE_PREFIX
+// expand before it is pasted.
+#define TABLE_PREFIXED(name) TABLE_PREFIXED_WITH(TABLE_PREFIX, name)
+#define TABLE_PREFIXED_WITH(prefix, name) TABLE_PASTE(prefix, name)
+#define TABLE_PASTE(prefix, name) prefix ## _ ## name
+
+#define table_empty TABLE_PREFIXED(table_empty)
+#define table_empty_with_hash TABLE_PREFIXED(table_empty_with_hash)
+#define table_empty_with_key_type TABLE_PREFIXED(table_empty_with_key_type)
+#define table_empty_with_allocator TABLE_PREFIXED(table_empty_with_allocator)
+#define table_is_empty TABLE_PREFIXED(table_is_empty)
+#define table_insert TABLE_PREFIXED(table_insert)
+#define table_lookup TABLE_PREFIXED(table_lookup)
+#define table_choose_key TABLE_PREFIXED(table_choose_key)
+#define table_remove TABLE_PREFIXED(table_remove)
+#define table_freeze TABLE_PREFIXED(table_freeze)
+#define table_is_frozen TABLE_PREFIXED(table_is_frozen)
+#define table_min TABLE_PREFIXED(table_min)
+#define table_max TABLE_PREFIXED(table_max)
+#define table_floor TABLE_PREFIXED(table_floor)
+#define table_ceiling TABLE_PREFIXED(table_ceiling)
+#define table_range TABLE_PREFIXED(table_range)
+#define table_prefix_scan TABLE_PREFIXED(table_prefix_scan)
+#define table_merge TABLE_PREFIXED(table_merge)
+#define table_intersect TABLE_PREFIXED(table_intersect)
+#define table_difference TABLE_PREFIXED(table_difference)
+#define table_clone TABLE_PREFIXED(table_clone)
+#define table_kill TABLE_PREFIXED(table_kill)
+#define table_print TABLE_PREFIXED(table_print)
+#define table_print_internal TABLE_PREFIXED(table_print_internal)
+#define table_entry_create TABLE_PREFIXED(table_entry_create)
+#define table_entry_kill TABLE_PREFIXED(table_entry_kill)
+
+#endif
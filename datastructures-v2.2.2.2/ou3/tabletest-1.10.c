@@ -4,7 +4,10 @@
  * Should be compiled together with a table implementation that
  * follows the interface in table.h of the code base for the
  * Datastructures and Algorithms courses at the Department of
- * Computing Science, Umea University.
+ * Computing Science, Umea University. Compiled with -DTABLE_BACKENDS
+ * together with all implementations, renamed by table_prefix.h, the
+ * program is tablebench, which compares the speed of the
+ * implementations.
  *
  * 20xx-xx-xx v1.0  Lena Kallin Westin <kallin@cs.umu.se>.
  * 2017-03-xx v1.1  Adam Dahlstrom <dali@cs.umu.se>
@@ -30,10 +33,49 @@
  * 2019-02-12 v1.8  Reverted back to single-parameter version v1.6.
  * 2019-04-17 v1.9  Added -m for machine-readable results.
  * 2023-02-17 v1.10 Added printout of the codebase version.
+ * 2026-10-18 v1.11 Added test of tables with cached key hashes.
+ * 2026-10-18 v1.12 Added test of frozen tables.
+ * 2026-10-18 v1.13 Added test of ordered queries.
+ * 2026-10-18 v1.14 Added test of set operations.
+ * 2026-10-18 v1.15 Added test of cloned tables.
+ * 2026-10-18 v1.16 Added tests of prefix scans and of tables with int
+ *                  keys. The speed test creates the tables with int keys.
+ * 2026-10-18 v1.17 The speed test uses the monotonic clock in ns, runs
+ *                  each phase after warm-up runs a number of times (-r,
+ *                  -w) and prints the min, median, mean and standard
+ *                  deviation. The -t table keeps n and the (median) time
+ *                  in ms in the second and third columns.
+ * 2026-10-18 v1.18 Added latency histograms of single operations (-l)
+ *                  with percentiles, and their export to csv (-c).
+ * 2026-10-18 v1.19 The keys of the speed test are computed from a
+ *                  permutation instead of stored, and n is no longer
+ *                  limited to 40000. Added sweeps over a geometric
+ *                  series of sizes (-s).
+ * 2026-10-18 v1.20 The speed test calls the table through a struct of
+ *                  function pointers. Compiled with -DTABLE_BACKENDS
+ *                  and the implementations renamed by table_prefix.h,
+ *                  the program becomes tablebench, which runs the speed
+ *                  test for all implementations with the same keys and
+ *                  prints them side by side. tablebench has no
+ *                  correctness tests.
+ * 2026-10-18 v1.21 The random numbers come from the seedable generator
+ *                  of workload.c (-k) instead of rand(). The skewed
+ *                  lookups draw from a distribution of workload.c (-d),
+ *                  by default zipf with theta 0.99, instead of uniformly
+ *                  from the middle third of the keys.
+ * 2026-10-18 v1.22 Added phases with YCSB-style mixes of lookups,
+ *                  updates, insertions and removals (-m), with their
+ *                  throughput and latency percentiles.
+ * 2026-10-18 v1.23 Added hardware counters of the timed operations (-p),
+ *                  printed per operation, from perfcount.c.
+ * 2026-10-18 v1.24 Added counting of the memory of the tables (-a), with
+ *                  a counting allocator given to table_empty_with_allocator.
+ * 2026-10-18 v1.25 Added string keys to the speed test (-K): random,
+ *                  with a shared prefix, or like URLs, of 8-64 characters.
 */
 
-#define VERSION "v1.10"
-#define VERSION_DATE "2023-02-17"
+#define VERSION "v1.25"
+#define VERSION_DATE "2026-10-18"
 
 /*
  * Correctness testing algorithm:
@@ -62,19 +104,71 @@
  *    that it is gone and that the other key returns the cocorrect
  *    value. The second key is removed and it is checked that the
  *    table is empty.
+ * 9. Tests a table created with a hash function by inserting, looking
+ *    up and removing keys, both with a proper hash function and with
+ *    a hash function where all keys collide.
+ * 10. Tests freezing a table with duplicate keys. After that, it is
+ *    checked that lookups return the latest value for each key and
+ *    that insert and remove fail. Tables of every size up to 64 keys
+ *    are frozen as well. It is also checked that a table without a
+ *    hash function cannot be frozen.
+ * 11. Tests the ordered queries min, max, floor, ceiling and range on
+ *    a table with keys inserted out of order, including a duplicate,
+ *    both before and after the table is frozen, for a table created
+ *    with a hash function and for a table created with the key type
+ *    for strings.
+ * 12. Tests merging tables with both conflict policies, and the
+ *    intersection and difference of tables, also with a frozen table.
+ * 13. Tests cloning a table. Both the table and the clone are modified
+ *    and it is checked that the changes are not visible in the other
+ *    table, both for a few keys and for enough keys to need a
+ *    rebalanced tree. A frozen table is cloned as well, and the tables
+ *    are killed in both orders. Tables are merged while clones of
+ *    both tables are alive, also when a pair of one table has the
+ *    same key and value pointers as a pair of the other.
+ * 14. Tests prefix scans of a table with hierarchical keys, where some
+ *    keys are prefixes of other keys, including a duplicate, both
+ *    before and after the table is frozen, for a table created with a
+ *    hash function and for a table created with the key type for
+ *    strings.
+ * 15. Tests a table created with the key type for int keys. Negative
+ *    and positive keys are inserted, and it is checked that lookups,
+ *    removals and ordered queries work.
+ * 16. Tests int keys in tables created without the key type, where
+ *    the keys are only known through the compare and hash functions,
+ *    both without a hash function and with a hash function where
+ *    many keys collide. Keys with the same low byte are included. It
+ *    is checked that no keys are merged, and that lookups, removals,
+ *    clones and ordered queries work, and that merging tables with
+ *    colliding keys leaves the pairs of clones intact.
  *
  * There is also a module measuring time for insertions, lookups etc.
  * */
+// clock_gettime is a POSIX function.
+#define _POSIX_C_SOURCE 199309L
+
 #include <stdbool.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/time.h>
+#include <math.h>
+#include <time.h>
 #include "table.h"
+#include "workload.h"
+#include "perfcount.h"
+
+// Maximum size of the table to generate. The keys of the speed test
+// are the numbers 0..2n-1.
+#define TABLESIZE (INT_MAX/2)
 
-// Maximum size of the table to generate
-#define TABLESIZE 40000
-#define SAMPLESIZE TABLESIZE*2
+// The smallest size of a sweep.
+#define SWEEP_START 100
+
+// The name of the implementation in the rows of a sweep.
+#ifndef TABLE_IMPL
+#define TABLE_IMPL "table"
+#endif
 
 /**
  * copy_string() - Create a dynamic copy of a string.
@@ -124,15 +218,16 @@ int *int_ptr_from_int(int i)
 }
 
 /**
- * get_milliseconds() - Return the current time-of-day in milliseconds.
+ * get_nanoseconds() - Return the time of the monotonic clock in
+ *                     nanoseconds.
  *
- * Returns: The current time-of-day in milliseconds.
+ * Returns: The time of the monotonic clock in nanoseconds.
  */
-unsigned long get_milliseconds()
+unsigned long long get_nanoseconds()
 {
-        struct timeval tv;
-        gettimeofday(&tv, 0);
-        return (unsigned long)(tv.tv_sec*1000 + tv.tv_usec/1000);
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (unsigned long long)ts.tv_sec*1000000000ULL + ts.tv_nsec;
 }
 
 /**
@@ -167,195 +262,1129 @@ int string_compare(const void *ip1,const void *ip2)
         return strcmp(s1,s2);
 }
 
-/* Shuffles the numbers stored in seq
- *    seq - an array of randomnumbers to be shuffled
- *    n - the number of elements in seq to shuffle, i.e the indexes [0, n]
- *        will be shuffled. However, seq might be larger than n...
+/**
+ * string_hash() - Hash a string.
+ * @ip: Pointer to the string to be hashed.
+ *
+ * Computes the 64-bit FNV-1a hash of the string that ip points to.
+ *
+ * Returns: The hash value.
  */
-void random_shuffle(int seq[], int n)
+unsigned long string_hash(const void *ip)
 {
-        for(int i=0;i<n;i++) {
-                int switchPos=rand()%n;
-                if(i!=switchPos) {
-                        int temp=seq[i];
-                        seq[i]=seq[switchPos];
-                        seq[switchPos]=temp;
+        const unsigned char *s=ip;
+        unsigned long long h=14695981039346656037ULL;
+        while (*s != '\0') {
+                h ^= *s++;
+                h *= 1099511628211ULL;
+        }
+        return (unsigned long)h;
+}
+
+/**
+ * constant_hash() - Hash function where all keys collide.
+ * @ip: Pointer to the key, ignored.
+ *
+ * Returns: Always 0.
+ */
+unsigned long constant_hash(const void *ip)
+{
+        return 0;
+}
+
+// A random permutation of the numbers 0..size-1, computed one number
+// at a time instead of stored, so that the speed test needs no memory
+// for its keys. The numbers are mixed by bijections of the numbers
+// 0..mask, i.e. by xor with the seed, multiplication by odd constants
+// and xor with a right shift, until the result is below size.
+typedef struct permutation {
+        unsigned long long size;
+        unsigned long long mask; // 2^bits-1, the smallest at least size-1
+        int shift;               // bits/2
+        unsigned long long seed;
+} permutation;
+
+/* Returns a random permutation of the numbers 0..size-1.
+ *    size - the number of numbers, at least 1
+ *    r - the random number generator that gives the permutation
+ */
+permutation permutation_create(unsigned long long size, rng *r)
+{
+        permutation p;
+        int bits=2;
+        while ((1ULL << bits) < size) {
+                bits++;
+        }
+        p.size=size;
+        p.mask=(1ULL << bits)-1;
+        p.shift=bits/2;
+        p.seed=rng_next(r);
+        return p;
+}
+
+/* Returns the number at position i of a permutation.
+ *    p - the permutation
+ *    i - the position, from 0 to size-1
+ */
+unsigned long long permutation_at(const permutation *p, unsigned long long i)
+{
+        unsigned long long x=i;
+        do {
+                x=(x ^ p->seed) & p->mask;
+                x=(x * 0x9e3779b97f4a7c15ULL) & p->mask;
+                x^=x >> p->shift;
+                x=(x * 0xbf58476d1ce4e5b9ULL) & p->mask;
+                x^=x >> p->shift;
+        } while (x >= p->size);
+        return x;
+}
+
+// The kinds of keys of the speed test.
+typedef enum key_kind {
+        KEYS_INT,    // The numbers of the permutation
+        KEYS_RANDOM, // Strings of random characters
+        KEYS_PREFIX, // Strings with a long shared prefix
+        KEYS_URL,    // Strings that look like URLs
+} key_kind;
+
+static const char *key_kind_names[] = { "int", "random", "prefix", "url" };
+
+#define KEY_KIND_COUNT ((int)(sizeof(key_kind_names)/sizeof(key_kind_names[0])))
+
+// The shortest and the longest string key.
+#define MIN_KEY_LENGTH 8
+#define MAX_KEY_LENGTH 64
+
+// The keys of the speed test, in the order of a permutation. Int keys
+// are the numbers of the permutation. String keys are made from the
+// numbers and stored one after another, so that making them is not
+// part of the timed operations.
+typedef struct speed_keys {
+        key_kind kind;
+        permutation perm;
+        char *chars;     // The string keys, or NULL for int keys
+        size_t *offsets; // The offset of the string key at each position
+} speed_keys;
+
+/* Writes the string key made from a number. The number is written in
+ * six base 62 digits, so that different numbers give different keys,
+ * and the rest of the key is drawn with the number as seed.
+ *    buf - room for MAX_KEY_LENGTH+1 characters
+ *    kind - the kind of key, not KEYS_INT
+ *    v - the number, below 62^6
+ */
+void make_string_key(char *buf, key_kind kind, unsigned long long v)
+{
+        static const char digits[] =
+                "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+        static const char *hosts[] = {
+                "www.example.com", "cdn.example.net", "api.example.org",
+                "shop.example.se",
+        };
+        static const char *words[] = {
+                "articles", "images", "users", "products", "search", "static",
+                "v2", "2026", "index", "download",
+        };
+        char id[7];
+        unsigned long long x=v;
+        for(int i=5;i>=0;i--) {
+                id[i]=digits[x%62];
+                x/=62;
+        }
+        id[6]='\0';
+
+        rng r;
+        rng_seed(&r,v);
+        int len;
+        if (kind == KEYS_RANDOM) {
+                // Random characters, then the id.
+                len=MIN_KEY_LENGTH+rng_below(&r,MAX_KEY_LENGTH-MIN_KEY_LENGTH+1);
+                for(int i=0;i<len-6;i++) {
+                        buf[i]=digits[rng_below(&r,62)];
+                }
+                strcpy(buf+len-6,id);
+        } else if (kind == KEYS_PREFIX) {
+                // The shared prefix and the id, then random characters.
+                const char *prefix="org.example.service.accounts.user.";
+                int pre=strlen(prefix);
+                len=pre+6+rng_below(&r,MAX_KEY_LENGTH-pre-6+1);
+                sprintf(buf,"%s%s",prefix,id);
+                for(int i=pre+6;i<len;i++) {
+                        buf[i]=digits[rng_below(&r,62)];
+                }
+        } else {
+                // A host, a path and the id, then more of the path,
+                // cut at a random length after the id.
+                int n=sizeof(words)/sizeof(words[0]);
+                int at=sprintf(buf,"https://%s/%s/%s",hosts[rng_below(&r,4)],
+                               words[rng_below(&r,n)],id);
+                int id_end=at;
+                while (at < MAX_KEY_LENGTH) {
+                        const char *w=words[rng_below(&r,n)];
+                        for(int i=-1;w[i] != '\0' || i<0;i++) {
+                                buf[at++] = i<0 ? '/' : w[i];
+                                if (at == MAX_KEY_LENGTH) {
+                                        break;
+                                }
+                        }
                 }
+                len=id_end+rng_below(&r,MAX_KEY_LENGTH-id_end+1);
         }
+        buf[len]='\0';
 }
 
-/* Generate n unique random numbers. The numbers will be stored i seq
- *    seq - an array of randomnumbers created in the function
- *    n - the number of elements in seq
+/* Returns the keys of a random permutation of the numbers 0..size-1.
+ * The string keys are made here, in O(size) time and memory.
+ *    kind - the kind of keys
+ *    size - the number of keys, at least 1
+ *    r - the random number generator that gives the permutation
  */
-void create_random_sample(int seq[], int n)
+speed_keys speed_keys_create(key_kind kind, unsigned long long size, rng *r)
 {
-        for(int i=0;i<n;i++) {
-                seq[i]=i;
+        speed_keys k={ kind, permutation_create(size,r), NULL, NULL };
+        if (kind != KEYS_INT) {
+                k.offsets=malloc((size+1)*sizeof(k.offsets[0]));
+                k.chars=malloc(size*(MAX_KEY_LENGTH+1));
+                size_t at=0;
+                for(unsigned long long i=0;i<size;i++) {
+                        k.offsets[i]=at;
+                        make_string_key(k.chars+at,kind,permutation_at(&k.perm,i));
+                        at+=strlen(k.chars+at)+1;
+                }
+                // Give back the room that the keys did not need.
+                k.chars=realloc(k.chars,at);
+        }
+        return k;
+}
+
+/* Frees the string keys of the speed test.
+ *    k - the keys
+ */
+void speed_keys_kill(speed_keys *k)
+{
+        free(k->chars);
+        free(k->offsets);
+}
+
+/* Returns the key at a position, for a lookup or a removal.
+ *    k - the keys
+ *    i - the position
+ *    tmp - room for an int key
+ */
+const void *key_at(const speed_keys *k, unsigned long long i, int *tmp)
+{
+        if (k->kind == KEYS_INT) {
+                *tmp=permutation_at(&k->perm,i);
+                return tmp;
+        }
+        return k->chars+k->offsets[i];
+}
+
+/* Returns a dynamic copy of the key at a position, for an insertion.
+ *    k - the keys
+ *    i - the position
+ */
+void *key_copy(const speed_keys *k, unsigned long long i)
+{
+        if (k->kind == KEYS_INT) {
+                return int_ptr_from_int(permutation_at(&k->perm,i));
         }
-        random_shuffle(seq,n);
+        return copy_string(k->chars+k->offsets[i]);
 }
 
+// The operations of a table implementation used by the speed test.
+typedef struct table_backend {
+        const char *name;
+        table *(*empty)(compare_function key_cmp_func,
+                        hash_function key_hash_func, table_key_type key_type,
+                        kill_function key_kill_func,
+                        kill_function value_kill_func,
+                        const allocator *alloc);
+        int (*insert)(table *t, void *key, void *value);
+        void *(*lookup)(const table *t, const void *key);
+        int (*remove)(table *t, const void *key);
+        void (*kill)(table *t);
+} table_backend;
+
+#ifdef TABLE_BACKENDS
+
+// The implementations of tablebench, compiled with table_prefix.h so
+// that the functions of implementation x are named x_table_insert etc.
+#define BACKEND_PROTOTYPES(x)                                           \
+        table *x##_table_empty_with_allocator(compare_function,         \
+                hash_function, table_key_type, kill_function,           \
+                kill_function, const allocator *);                      \
+        int x##_table_insert(table *, void *, void *);                  \
+        void *x##_table_lookup(const table *, const void *);            \
+        int x##_table_remove(table *, const void *);                    \
+        void x##_table_kill(table *);
+
+#define BACKEND(x)                                                      \
+        { #x, x##_table_empty_with_allocator, x##_table_insert,         \
+          x##_table_lookup, x##_table_remove, x##_table_kill }
+
+BACKEND_PROTOTYPES(table)
+BACKEND_PROTOTYPES(table2)
+BACKEND_PROTOTYPES(mtftable)
+BACKEND_PROTOTYPES(arraytable)
+BACKEND_PROTOTYPES(avltable)
+BACKEND_PROTOTYPES(arttable)
+
+static const table_backend backends[] = {
+        BACKEND(table),
+        BACKEND(table2),
+        BACKEND(mtftable),
+        BACKEND(arraytable),
+        BACKEND(avltable),
+        BACKEND(arttable),
+};
+
+#else
+
+// The implementation that the program is compiled with.
+static const table_backend backends[] = {
+        { TABLE_IMPL, table_empty_with_allocator, table_insert, table_lookup,
+          table_remove, table_kill },
+};
+
+#endif
+
+#define BACKEND_COUNT ((int)(sizeof(backends)/sizeof(backends[0])))
 
 /* Fill a table with values.
+ *    b - the implementation of the table
  *    table - the table to fill
- *    keys - a list of keys to use
- *    values - a list of values to use
+ *    keys - the keys to use, the first n are inserted
+ *    n - the number of items to insert
  */
-void insert_values(table *t, int *keys, int *values, int n)
+void insert_values(const table_backend *b, table *t, const speed_keys *keys,
+                   int n)
 {
         // Insert all items
         for(int i=0;i<n;i++) {
-                table_insert(t, int_ptr_from_int(keys[i]),
-                             int_ptr_from_int(values[i]));
+                b->insert(t, key_copy(keys,i), int_ptr_from_int(i));
         }
 }
 
+/* Creates an empty table for the speed test with keys of the given
+ * kind. String keys are compared with string_compare and hashed with
+ * string_hash. The table gets its memory from alloc, or from the heap
+ * if alloc is NULL. The keys and values are always allocated with
+ * malloc.
+ */
+table *speed_test_table(const table_backend *b, const allocator *alloc,
+                        key_kind kind)
+{
+        if (kind == KEYS_INT) {
+                return b->empty(int_compare, NULL, TABLE_KEY_INT, free, free, alloc);
+        }
+        return b->empty(string_compare, string_hash, TABLE_KEY_STRING, free, free,
+                        alloc);
+}
 
-/* Measures time taken to fill a table with values
- *    table - the table to fill
- *    keys - a list of keys to use
- *    values - a list of values to use
- *    n - the number of items to insert
- *    machine_table - true if we should output a machine-readable table
+/* Creates a table for the keys and fills it with n values.
  */
-void get_insert_speed(table *t, int *keys, int *values, int n,
-		bool machine_table)
+table *filled_table(const table_backend *b, const allocator *alloc,
+                    const speed_keys *keys, int n)
 {
-        unsigned long start;
-        unsigned long end;
+        table *t = speed_test_table(b,alloc,keys->kind);
+        insert_values(b,t,keys,n);
+        return t;
+}
 
-        // Insert all items
-        start = get_milliseconds();
-        insert_values(t,keys,values,n);
-        end =  get_milliseconds();
-	if (machine_table) {
-		printf("%d, %d, %lu\n",1,n,end-start);
-	} else {
-		printf("Insert %5d items                   : ", n);
-		printf("%lu ms.\n",end-start);
-	}
+// The histogram of the latencies of single operations. The latencies
+// are in nanoseconds. Latencies below HISTOGRAM_SUB_BUCKETS have a
+// bucket each. Larger latencies are bucketed by their power of two,
+// and each power of two is divided into HISTOGRAM_SUB_BUCKETS buckets
+// of the same width, so a bucket is at most 1/16 of its latencies
+// wide.
+#define HISTOGRAM_SUB_BITS 4
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_BUCKETS (64 * HISTOGRAM_SUB_BUCKETS)
+
+typedef struct histogram {
+        unsigned long long counts[HISTOGRAM_BUCKETS];
+        unsigned long long count; // The number of latencies
+        unsigned long long max;   // The largest latency
+} histogram;
+
+/* Returns the bucket of a latency.
+ */
+int histogram_bucket(unsigned long long v)
+{
+        if (v < HISTOGRAM_SUB_BUCKETS) {
+                return v;
+        }
+        // The position of the highest bit, at least HISTOGRAM_SUB_BITS.
+        int e=HISTOGRAM_SUB_BITS;
+        while ((v >> (e+1)) != 0) {
+                e++;
+        }
+        int sub=(v >> (e-HISTOGRAM_SUB_BITS)) & (HISTOGRAM_SUB_BUCKETS-1);
+        return (e-HISTOGRAM_SUB_BITS+1)*HISTOGRAM_SUB_BUCKETS + sub;
 }
 
-/* Measures time taken to do n lookups of existing keys in a table
- *    t - the table to fill
- *    keys - a list of keys to use
- *    values - a list of values to use
- *    n - the number of lookups to perform
- *    machine_table - true if we should output a machine-readable table
+/* Returns the largest latency of a bucket.
  */
-void get_random_existing_lookup_speed(table *t, int *keys, int n,
-				bool machine_table)
+unsigned long long histogram_bucket_max(int b)
 {
-        unsigned long start;
-        unsigned long end;
+        if (b < HISTOGRAM_SUB_BUCKETS) {
+                return b;
+        }
+        int e=b/HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BITS - 1;
+        unsigned long long sub=b%HISTOGRAM_SUB_BUCKETS;
+        return ((HISTOGRAM_SUB_BUCKETS+sub+1) << (e-HISTOGRAM_SUB_BITS)) - 1;
+}
 
-        start = get_milliseconds();
-        for(int i=0;i<n;i++) {
-                // The existing keys in the table are stored in index
-                // [0, TABLESIZE-1] in the key-array
-                int pos = rand()%n;
-                table_lookup(t,&keys[pos]);
-        }
-        end = get_milliseconds();
-	if (machine_table) {
-		printf("%d, %d, %lu\n",4,n,end-start);
-	} else {
-		printf("%5d random lookups                 : ",n );
-		printf("%lu ms.\n", end-start);
-	}
+/* Adds a latency to a histogram.
+ */
+void histogram_record(histogram *h, unsigned long long v)
+{
+        h->counts[histogram_bucket(v)]++;
+        h->count++;
+        if (v > h->max) {
+                h->max=v;
+        }
 }
 
-/* Measures time taken to do n lookups of non-existing keys in a table
- *    t - the table to fill
- *    keys - a list of keys to use
- *    values - a list of values to use
- *    n - the number of lookups to perform
- *    machine_table - true if we should output a machine-readable table
+/* Returns the latency at a percentile of a histogram, i.e. the largest
+ * latency of the bucket that holds it, but at most the largest latency
+ * recorded.
+ *    h - the histogram
+ *    p - the percentile, from 0 to 100
  */
-void get_random_non_existing_lookup_speed(table *t, int *keys, int n,
-				bool machine_table)
+unsigned long long histogram_percentile(const histogram *h, double p)
 {
-        unsigned long start;
-        unsigned long end;
+        // The rank of the latency, from 1 to count.
+        unsigned long long rank=(unsigned long long)(p/100*h->count + 0.5);
+        if (rank < 1) {
+                rank=1;
+        }
+        unsigned long long seen=0;
+        for(int b=0;b<HISTOGRAM_BUCKETS;b++) {
+                seen+=h->counts[b];
+                if (seen >= rank) {
+                        unsigned long long v=histogram_bucket_max(b);
+                        return v < h->max ? v : h->max;
+                }
+        }
+        return h->max;
+}
 
-        // We know the exisiting keys have indexes in [0, TABLESIZE-1]
-        // so if we try to lookup keys in the area [TABLESIZE,
-        // 2*TABLESIZE-1] they will not exist
-        start =  get_milliseconds();
-        int startindex = n;
-        for(int i=0;i<n;i++){
-                table_lookup(t,&keys[startindex + (i%n)]);
+// The percentiles reported for each phase.
+static const double percentiles[]={ 50, 90, 99, 99.9 };
+#define PERCENTILE_COUNT 4
+
+// The memory of the tables of a phase, counted by an allocator that
+// passes the allocations on to calloc and free. Only the memory of
+// the tables is counted, not the keys and values.
+typedef struct memory_counter {
+        allocator alloc;             // The counting allocator
+        unsigned long long bytes;    // Bytes held now
+        unsigned long long peak;     // Most bytes held at once
+        unsigned long long allocs;   // Allocations so far
+        unsigned long long frees;    // De-allocations so far
+        unsigned long long steady;   // Bytes held after the timed operations
+        unsigned long long timed_allocs; // Allocations of the timed operations
+        unsigned long long timed_frees;  // De-allocations of the timed operations
+} memory_counter;
+
+/* Allocates zeroed memory for a table and counts it.
+ *    context - the memory counter
+ *    size - the number of bytes
+ */
+void *count_allocate(void *context, size_t size)
+{
+        memory_counter *m = context;
+        void *p = calloc(1,size);
+        if (p != NULL) {
+                m->allocs++;
+                m->bytes += size;
+                if (m->bytes > m->peak) {
+                        m->peak = m->bytes;
+                }
         }
-        end = get_milliseconds();
-	if (machine_table) {
-		printf("%d, %d, %lu\n",3,n,end-start);
-	} else {
-		printf("%5d lookups with non-existent keys : ", n);
-		printf("%lu ms.\n" ,end-start);
-	}
+        return p;
 }
 
-/* Measures time taken to do n lookups of existing keys in a table when the
- * keys chosen are from only a part of all available keys
- *    t - the table to fill
- *    keys - a list of keys to use
- *    values - a list of values to use
- *    n - the number of lookups to perform
- *    machine_table - true if we should output a machine-readable table
+/* Frees the memory of a table and counts it.
+ *    context - the memory counter
+ *    p - the memory
+ *    size - the number of bytes, as when allocated
  */
-void get_skewed_lookup_speed(table *t, int *keys, int n, bool machine_table)
+void count_deallocate(void *context, void *p, size_t size)
 {
-        unsigned long start;
-        unsigned long end;
+        memory_counter *m = context;
+        m->frees++;
+        m->bytes -= size;
+        free(p);
+}
 
-        // Lookup skewed to a certain range (in this case the middle third
-        // of the keys used)
-        int startindex = n/3;
-        int stopindex = n*2/3;
-        int partition = stopindex - startindex + 1;
+/* Resets a memory counter.
+ *    m - the memory counter
+ */
+void memory_counter_reset(memory_counter *m)
+{
+        *m = (memory_counter){ { count_allocate, count_deallocate, m } };
+}
 
-        start =  get_milliseconds();
-        for(int i=0;i<n;i++) {
-                int pos = rand()%partition + startindex;
-                table_lookup(t,&keys[pos]);
+// The operations of a mixed phase.
+enum { MIX_LOOKUP, MIX_UPDATE, MIX_INSERT, MIX_REMOVE, MIX_OPS };
+
+// The largest number of mixed phases.
+#define MAX_MIXES 8
+
+// A mix of operations for a mixed phase, see parse_mix.
+typedef struct mix_spec {
+        int weights[MIX_OPS]; // Weights of lookup, update, insert, remove
+        workload_spec dist;   // Distribution of the keys of lookups/updates
+        int ops;              // Number of operations, 0 for n
+        char name[32];        // The name in sweeps and csv files
+        char label[128];      // printf format of the description, with n
+} mix_spec;
+
+/* Parses the description of a mix of operations, in the form
+ * ratios[/distribution[/ops]]. The ratios are either four weights of
+ * lookups, updates, insertions and removals, e.g. 90,0,5,5, or one of
+ * the YCSB workloads a (50% updates), b (5% updates), c (only lookups)
+ * or d (5% insertions, lookups of the latest keys). The distribution of
+ * the keys of lookups and updates is described as for workload_parse,
+ * by default zipf:0.99 (latest:0.99 for d). The number of operations
+ * is by default n.
+ *    m - the mix to fill in
+ *    s - the description
+ * Returns 0 if the description is valid, otherwise -1.
+ */
+int parse_mix(mix_spec *m, const char *s)
+{
+        static const struct {
+                const char *name;
+                int weights[MIX_OPS];
+                const char *dist;
+        } presets[] = {
+                { "a", { 50, 50, 0, 0 }, "zipf:0.99" },
+                { "b", { 95, 5, 0, 0 }, "zipf:0.99" },
+                { "c", { 100, 0, 0, 0 }, "zipf:0.99" },
+                { "d", { 95, 0, 5, 0 }, "latest:0.99" },
+        };
+        char buf[128];
+        if (strlen(s) >= sizeof(buf)) {
+                return -1;
         }
-        end = get_milliseconds();
-	if (machine_table) {
-		printf("%d, %d, %lu\n",5,n,end-start);
-	} else {
-		printf("%5d skewed lookups                 : " ,n);
-		printf("%lu ms.\n" ,end-start);
-	}
+        strcpy(buf,s);
+        char *ratios=buf;
+        char *dist=strchr(ratios,'/');
+        char *ops=NULL;
+        if (dist != NULL) {
+                *dist++='\0';
+                ops=strchr(dist,'/');
+                if (ops != NULL) {
+                        *ops++='\0';
+                }
+        }
+
+        const char *default_dist="zipf:0.99";
+        int k=0;
+        while (k<4 && strcmp(presets[k].name,ratios)!=0) {
+                k++;
+        }
+        if (k<4) {
+                memcpy(m->weights,presets[k].weights,sizeof(m->weights));
+                default_dist=presets[k].dist;
+                snprintf(m->name,sizeof(m->name),"ycsb_%s",presets[k].name);
+        } else {
+                char *end;
+                int total=0;
+                for(int i=0;i<MIX_OPS;i++) {
+                        m->weights[i]=strtol(ratios,&end,10);
+                        if (end==ratios || m->weights[i]<0
+                            || *end!=(i<MIX_OPS-1 ? ',' : '\0')) {
+                                return -1;
+                        }
+                        total+=m->weights[i];
+                        ratios=end+1;
+                }
+                if (total==0) {
+                        return -1;
+                }
+                snprintf(m->name,sizeof(m->name),"mix_%d_%d_%d_%d",m->weights[0],
+                         m->weights[1],m->weights[2],m->weights[3]);
+        }
+        if (workload_parse(&m->dist,dist != NULL ? dist : default_dist)!=0) {
+                return -1;
+        }
+        m->ops=0;
+        if (ops != NULL) {
+                char *end;
+                long v=strtol(ops,&end,10);
+                if (end==ops || *end!='\0' || v<1 || v>TABLESIZE) {
+                        return -1;
+                }
+                m->ops=v;
+        }
+
+        char d[64];
+        workload_describe(&m->dist,d,sizeof(d));
+        if (m->ops>0) {
+                snprintf(m->label,sizeof(m->label),"%d ops, %s, %s",m->ops,m->name,d);
+        } else {
+                snprintf(m->label,sizeof(m->label),"%%5d ops, %s, %s",m->name,d);
+        }
+        return 0;
 }
 
-/* Measures time taken remove all keys from a table
- *    t - the table to fill
- *    keys - a list of keys to use
- *    values - a list of values to use
- *    n - number of items in the table
- *    machine_table - true if we should output a machine-readable table
+// The options of the speed test.
+typedef struct speed_options {
+        int warmups;        // Number of untimed runs of each phase
+        int reps;           // Number of timed runs of each phase
+        bool machine_table; // Output a machine-readable table
+        bool latencies;     // Time single operations into histograms
+        FILE *csv;          // File for the latency percentiles, or NULL
+        double sweep;       // Factor of the sizes of a sweep, or 0
+        uint64_t seed;      // Seed of the keys and of the operations
+        workload_spec skew; // Distribution of the skewed lookups
+        mix_spec mixes[MAX_MIXES]; // The mixed phases
+        int mix_count;      // The number of mixed phases
+        perf_counters *counters; // Hardware counters, or NULL
+        bool memory;        // Count the memory of the tables
+        key_kind keys;      // The kind of keys
+} speed_options;
+
+// The input of a timed phase of the speed test.
+typedef struct phase_input {
+        const speed_keys *keys;    // Keys 0..2n-1, the first n in the table
+        int n;                     // The number of items
+        uint64_t seed;             // Seed of the random numbers of the run
+        const workload_spec *skew; // Distribution of the skewed lookups
+        const mix_spec *mix;       // The mix of a mixed phase, or NULL
+        perf_counters *counters;   // Counters of the operations, or NULL
+        memory_counter *memory;    // Counter of the memory, or NULL
+} phase_input;
+
+// A timed phase of the speed test. It builds the table it needs with
+// the implementation b, performs the timed operations and kills the
+// table, and returns the time of the timed operations in nanoseconds.
+// If h is not NULL, the latency of each operation is also added to h.
+typedef unsigned long long phase_function(const table_backend *b,
+                                          const phase_input *in,
+                                          histogram *h);
+
+/* Returns the allocator of the tables of a phase, or NULL for the heap.
+ *    in - the input of the phase
  */
-void get_remove_speed(table *t, int *keys, int n, bool machine_table)
+const allocator *phase_allocator(const phase_input *in)
 {
-        unsigned long start;
-        unsigned long end;
+        return in->memory != NULL ? &in->memory->alloc : NULL;
+}
 
-        // Remove all items, not in the same order as they were inserted
-        start = get_milliseconds();
-        random_shuffle(keys, n);  // to get a new order of the keys
-        for(int i=0;i<n;i++) {
-                table_remove(t,&keys[i]);
+/* Starts the timing of the operations of a phase, and the hardware
+ * counters if they are used, and returns the start time in ns. If the
+ * memory is counted, the allocations from here on are counted as the
+ * allocations of the timed operations.
+ *    in - the input of the phase
+ */
+unsigned long long phase_start(const phase_input *in)
+{
+        if (in->memory != NULL) {
+                in->memory->timed_allocs = in->memory->allocs;
+                in->memory->timed_frees = in->memory->frees;
+        }
+        if (in->counters != NULL) {
+                perf_counters_enable(in->counters);
         }
-        end = get_milliseconds();
-	if (machine_table) {
-		printf("%d, %d, %lu\n",2,n,end-start);
+        return get_nanoseconds();
+}
+
+/* Ends the timing of the operations of a phase, and stops the hardware
+ * counters if they are used, and returns the end time in ns. If the
+ * memory is counted, the memory held now is the steady-state memory of
+ * the phase.
+ *    in - the input of the phase
+ */
+unsigned long long phase_end(const phase_input *in)
+{
+        unsigned long long end = get_nanoseconds();
+        if (in->counters != NULL) {
+                perf_counters_disable(in->counters);
+        }
+        if (in->memory != NULL) {
+                in->memory->steady = in->memory->bytes;
+                in->memory->timed_allocs = in->memory->allocs - in->memory->timed_allocs;
+                in->memory->timed_frees = in->memory->frees - in->memory->timed_frees;
+        }
+        return end;
+}
+
+/* Times the insertion of n items into an empty table.
+ *    b - the implementation of the table
+ *    in - the keys and the number of items to insert
+ *    h - histogram of the latencies, or NULL
+ */
+unsigned long long time_insert(const table_backend *b, const phase_input *in,
+                               histogram *h)
+{
+        table *t = speed_test_table(b,phase_allocator(in),in->keys->kind);
+        unsigned long long start = phase_start(in);
+        for(int i=0;i<in->n;i++) {
+                void *key=key_copy(in->keys,i);
+                int *value=int_ptr_from_int(i);
+                unsigned long long op = h != NULL ? get_nanoseconds() : 0;
+                b->insert(t, key, value);
+                if (h != NULL) {
+                        histogram_record(h, get_nanoseconds()-op);
+                }
+        }
+        unsigned long long end = phase_end(in);
+        b->kill(t);
+        return end-start;
+}
+
+/* Times the removal of all n items of a table, in another order than
+ * they were inserted.
+ *    b - the implementation of the table
+ *    in - the keys, the number of items and the seed of the order
+ *    h - histogram of the latencies, or NULL
+ */
+unsigned long long time_remove(const table_backend *b, const phase_input *in,
+                               histogram *h)
+{
+        table *t = filled_table(b,phase_allocator(in),in->keys,in->n);
+        // A new order of the existing keys, at positions [0, n-1].
+        rng r;
+        rng_seed(&r,in->seed);
+        permutation order = permutation_create(in->n,&r);
+        unsigned long long start = phase_start(in);
+        for(int i=0;i<in->n;i++) {
+                int tmp;
+                const void *key = key_at(in->keys,permutation_at(&order,i),&tmp);
+                unsigned long long op = h != NULL ? get_nanoseconds() : 0;
+                b->remove(t,key);
+                if (h != NULL) {
+                        histogram_record(h, get_nanoseconds()-op);
+                }
+        }
+        unsigned long long end = phase_end(in);
+        b->kill(t);
+        return end-start;
+}
+
+/* Times n lookups of non-existing keys in a table with n items.
+ *    b - the implementation of the table
+ *    in - the keys and the number of lookups to perform
+ *    h - histogram of the latencies, or NULL
+ */
+unsigned long long time_non_existing_lookup(const table_backend *b,
+                                            const phase_input *in,
+                                            histogram *h)
+{
+        table *t = filled_table(b,phase_allocator(in),in->keys,in->n);
+        // We know the exisiting keys have positions in [0, n-1] so if
+        // we try to lookup keys at positions [n, 2*n-1] they will not
+        // exist
+        int startindex = in->n;
+        unsigned long long start = phase_start(in);
+        for(int i=0;i<in->n;i++){
+                int tmp;
+                const void *key = key_at(in->keys,startindex + i,&tmp);
+                unsigned long long op = h != NULL ? get_nanoseconds() : 0;
+                b->lookup(t,key);
+                if (h != NULL) {
+                        histogram_record(h, get_nanoseconds()-op);
+                }
+        }
+        unsigned long long end = phase_end(in);
+        b->kill(t);
+        return end-start;
+}
+
+/* Times n random lookups of existing keys in a table with n items.
+ *    b - the implementation of the table
+ *    in - the keys, the number of lookups and the seed of the lookups
+ *    h - histogram of the latencies, or NULL
+ */
+unsigned long long time_existing_lookup(const table_backend *b,
+                                        const phase_input *in, histogram *h)
+{
+        table *t = filled_table(b,phase_allocator(in),in->keys,in->n);
+        rng r;
+        rng_seed(&r,in->seed);
+        unsigned long long start = phase_start(in);
+        for(int i=0;i<in->n;i++) {
+                // The existing keys in the table are at positions
+                // [0, n-1] of the permutation
+                int tmp;
+                const void *key = key_at(in->keys,rng_below(&r,in->n),&tmp);
+                unsigned long long op = h != NULL ? get_nanoseconds() : 0;
+                b->lookup(t,key);
+                if (h != NULL) {
+                        histogram_record(h, get_nanoseconds()-op);
+                }
+        }
+        unsigned long long end = phase_end(in);
+        b->kill(t);
+        return end-start;
+}
+
+/* Times n lookups of existing keys in a table with n items when the
+ * keys are drawn from a skewed distribution, e.g. zipf, so that some
+ * keys are looked up much more often than others.
+ *    b - the implementation of the table
+ *    in - the keys, the number of lookups, the seed and the
+ *         distribution of the lookups
+ *    h - histogram of the latencies, or NULL
+ */
+unsigned long long time_skewed_lookup(const table_backend *b,
+                                      const phase_input *in, histogram *h)
+{
+        table *t = filled_table(b,phase_allocator(in),in->keys,in->n);
+        // The positions of the keys, drawn from the distribution. The
+        // workload is set up before the timing, since zipf needs O(n)
+        // time for that.
+        workload *w = workload_create(in->skew,in->n,in->seed);
+
+        unsigned long long start = phase_start(in);
+        for(int i=0;i<in->n;i++) {
+                int tmp;
+                const void *key = key_at(in->keys,workload_next(w),&tmp);
+                unsigned long long op = h != NULL ? get_nanoseconds() : 0;
+                b->lookup(t,key);
+                if (h != NULL) {
+                        histogram_record(h, get_nanoseconds()-op);
+                }
+        }
+        unsigned long long end = phase_end(in);
+        workload_kill(w);
+        b->kill(t);
+        return end-start;
+}
+
+/* Times a mix of operations on a table with n items. The operations
+ * are drawn with the weights of the mix. The keys in the table are
+ * always those at the positions first..next-1 of a permutation, where
+ * first and next start at 0 and n. Insertions add the key at position
+ * next, removals remove the oldest key, at position first, and lookups
+ * and updates (insertions of an existing key) use the key at rank d of
+ * the keys in the table, where d is drawn from the distribution of the
+ * mix and scaled from [0, n-1] to the number of keys. Position 0 of a
+ * zipf distribution is thus the oldest key, and of latest the newest.
+ * An operation that needs a key when the table is empty becomes an
+ * insertion.
+ *    b - the implementation of the table
+ *    in - the number of items, the seed and the mix
+ *    h - histogram of the latencies, or NULL
+ */
+unsigned long long time_mix(const table_backend *b, const phase_input *in,
+                            histogram *h)
+{
+        const mix_spec *m = in->mix;
+        int n = in->n;
+        int ops = m->ops > 0 ? m->ops : n;
+        int total = 0;
+        for(int k=0;k<MIX_OPS;k++) {
+                total += m->weights[k];
+        }
+
+        rng r;
+        rng_seed(&r,in->seed);
+        // Room for all keys that can be inserted.
+        speed_keys keys = speed_keys_create(in->keys->kind,(uint64_t)n+ops,&r);
+        table *t = filled_table(b,phase_allocator(in),&keys,n);
+        workload *w = workload_create(&m->dist,n,in->seed);
+        uint64_t first = 0, next = n;
+
+        unsigned long long start = phase_start(in);
+        for(int i=0;i<ops;i++) {
+                // Draw the operation.
+                int x = rng_below(&r,total);
+                int op = 0;
+                while (x >= m->weights[op]) {
+                        x -= m->weights[op];
+                        op++;
+                }
+                uint64_t size = next - first;
+                if (size == 0) {
+                        op = MIX_INSERT;
+                }
+                uint64_t pos;
+                if (op == MIX_LOOKUP || op == MIX_UPDATE) {
+                        pos = first + workload_next(w)*size/n;
+                } else if (op == MIX_INSERT) {
+                        pos = next++;
+                } else {
+                        pos = first++;
+                }
+                int tmp;
+                const void *key = key_at(&keys,pos,&tmp);
+                void *new_key = NULL;
+                int *new_value = NULL;
+                if (op == MIX_UPDATE || op == MIX_INSERT) {
+                        new_key = key_copy(&keys,pos);
+                        new_value = int_ptr_from_int(i);
+                }
+
+                unsigned long long op_start = h != NULL ? get_nanoseconds() : 0;
+                if (op == MIX_LOOKUP) {
+                        b->lookup(t,key);
+                } else if (op == MIX_REMOVE) {
+                        b->remove(t,key);
+                } else {
+                        b->insert(t,new_key,new_value);
+                }
+                if (h != NULL) {
+                        histogram_record(h, get_nanoseconds()-op_start);
+                }
+        }
+        unsigned long long end = phase_end(in);
+        workload_kill(w);
+        b->kill(t);
+        speed_keys_kill(&keys);
+        return end-start;
+}
+
+// Statistics of the repetitions of a phase, in nanoseconds.
+typedef struct phase_stats {
+        double min;
+        double median;
+        double mean;
+        double stddev;
+        // Hardware events per operation, NAN if not counted.
+        double events[PERF_COUNTER_COUNT];
+        memory_counter memory; // The memory of a run, if counted
+} phase_stats;
+
+/* Compares two times, for qsort.
+ */
+int time_compare(const void *p1, const void *p2)
+{
+        unsigned long long t1=*(const unsigned long long *)p1;
+        unsigned long long t2=*(const unsigned long long *)p2;
+        return (t1 > t2) - (t1 < t2);
+}
+
+/* Computes the statistics of the times of the repetitions of a phase.
+ * The times are sorted.
+ *    times - the times in nanoseconds
+ *    reps - the number of times, at least 1
+ */
+phase_stats compute_stats(unsigned long long *times, int reps)
+{
+        phase_stats s;
+        qsort(times,reps,sizeof(times[0]),time_compare);
+        s.min=times[0];
+        if (reps%2==1) {
+                s.median=times[reps/2];
+        } else {
+                s.median=(times[reps/2-1]+(double)times[reps/2])/2;
+        }
+        double sum=0;
+        for(int i=0;i<reps;i++) {
+                sum+=times[i];
+        }
+        s.mean=sum/reps;
+        double squares=0;
+        for(int i=0;i<reps;i++) {
+                squares+=(times[i]-s.mean)*(times[i]-s.mean);
+        }
+        // The sample standard deviation, 0 for a single repetition.
+        s.stddev=reps>1 ? sqrt(squares/(reps-1)) : 0;
+        return s;
+}
+
+// The phases of the speed test, in the order they are run.
+typedef struct speed_phase {
+        int id;               // The id in the machine-readable table
+        const char *name;     // The name in sweeps and csv files
+        const char *label;    // printf format of the description, with n
+        phase_function *run;
+        const mix_spec *mix;  // The mix of a mixed phase, or NULL
+} speed_phase;
+
+static const speed_phase phases[] = {
+        { 1, "insert", "Insert %5d items                   ", time_insert },
+        { 2, "remove", "Remove all items                     ", time_remove },
+        { 3, "lookup_miss", "%5d lookups with non-existent keys ",
+          time_non_existing_lookup },
+        { 4, "lookup_hit", "%5d random lookups                 ",
+          time_existing_lookup },
+        { 5, "lookup_skewed", "%5d skewed lookups                 ",
+          time_skewed_lookup },
+};
+
+// The id of the first mixed phase.
+#define FIRST_MIX_ID 6
+
+#define PHASE_COUNT ((int)(sizeof(phases)/sizeof(phases[0])))
+
+/* Returns the number of timed operations of a phase.
+ *    p - the phase
+ *    n - number of items
+ */
+int phase_ops(const speed_phase *p, int n)
+{
+        return p->mix != NULL && p->mix->ops > 0 ? p->mix->ops : n;
+}
+
+/* Runs a phase warmups times without timing it and then reps times,
+ * and returns the statistics of the timed repetitions. If h is not
+ * NULL, the phase is then run reps more times with each operation
+ * timed into h, so that the timing of single operations does not add
+ * to the times of the phase. If hardware counters are used, they count
+ * the operations of the timed repetitions. If the memory is counted,
+ * the phase is run once more with the tables on a counting allocator. The random numbers are seeded the same
+ * way for each implementation, so that all implementations get the
+ * same operations.
+ *    b - the implementation of the table
+ *    p - the phase to run
+ *    keys - the keys to use
+ *    n - number of items
+ *    opt - the options of the speed test
+ *    h - histogram of the latencies, or NULL
+ */
+phase_stats measure_phase(const table_backend *b, const speed_phase *p,
+                          const speed_keys *keys, int n,
+                          const speed_options *opt, histogram *h)
+{
+        // Run i of the warm-ups, the timed runs and the latency runs
+        // gets the seed opt->seed+i.
+        phase_input in={ keys, n, 0, &opt->skew, p->mix };
+        unsigned long long *times=malloc(opt->reps*sizeof(times[0]));
+        for(int i=0;i<opt->warmups;i++) {
+                in.seed=opt->seed+i;
+                p->run(b,&in,NULL);
+        }
+        in.counters=opt->counters;
+        if (in.counters != NULL) {
+                perf_counters_reset(in.counters);
+        }
+        for(int i=0;i<opt->reps;i++) {
+                in.seed=opt->seed+i;
+                times[i]=p->run(b,&in,NULL);
+        }
+        in.counters=NULL;
+        phase_stats s=compute_stats(times,opt->reps);
+        free(times);
+        for(int i=0;i<PERF_COUNTER_COUNT;i++) {
+                s.events[i]=NAN;
+        }
+        if (opt->counters != NULL) {
+                perf_counters_read(opt->counters,s.events);
+                for(int i=0;i<PERF_COUNTER_COUNT;i++) {
+                        s.events[i]/=(double)opt->reps*phase_ops(p,n);
+                }
+        }
+        if (h != NULL) {
+                for(int i=0;i<opt->reps;i++) {
+                        in.seed=opt->seed+i;
+                        p->run(b,&in,h);
+                }
+        }
+        if (opt->memory) {
+                memory_counter_reset(&s.memory);
+                in.seed=opt->seed;
+                in.memory=&s.memory;
+                p->run(b,&in,NULL);
+                in.memory=NULL;
+        }
+        return s;
+}
+
+/* Writes the latency percentiles of a phase to the csv file.
+ *    impl - the name of the implementation
+ *    name - the name of the phase
+ *    h - the histogram of the latencies of the phase
+ *    n - number of items
+ *    csv - the csv file
+ */
+void write_latencies(const char *impl, const char *name, const histogram *h,
+                     int n, FILE *csv)
+{
+        fprintf(csv,"%s,%s,%d,%llu",impl,name,n,h->count);
+        for(int i=0;i<PERCENTILE_COUNT;i++) {
+                fprintf(csv,",%llu",histogram_percentile(h,percentiles[i]));
+        }
+        fprintf(csv,",%llu\n",h->max);
+}
+
+/* Prints the result of a phase of one implementation.
+ *    b - the implementation of the table
+ *    p - the phase
+ *    n - number of items
+ *    s - the statistics of the times of the phase
+ *    h - the histogram of the latencies of the phase, or NULL
+ *    opt - the options of the speed test
+ */
+void print_phase(const table_backend *b, const speed_phase *p, int n,
+                 const phase_stats *s, const histogram *h,
+                 const speed_options *opt)
+{
+        unsigned long long q[PERCENTILE_COUNT];
+        for(int i=0;h != NULL && i<PERCENTILE_COUNT;i++) {
+                q[i]=histogram_percentile(h,percentiles[i]);
+        }
+	if (opt->sweep > 0) {
+		// One row per implementation, phase and n.
+		printf("%s, %s, %d, %.6f, %.6f, %.6f, %.6f, %.2f",b->name,p->name,n,
+		       s->median/1e6,s->min/1e6,s->mean/1e6,s->stddev/1e6,
+		       s->median/phase_ops(p,n));
+	} else if (opt->machine_table) {
+		// The third column is the median in ms, as the single
+		// time of earlier versions.
+		printf("%d, %d, %.6f, %.6f, %.6f, %.6f",p->id,n,s->median/1e6,
+		       s->min/1e6,s->mean/1e6,s->stddev/1e6);
 	} else {
-		printf("Remove all items                     : ");
-		printf("%lu ms.\n" ,end-start);
+		char label[128];
+		snprintf(label,sizeof(label),p->label,n);
+		printf("%s: median %10.3f ms (min %10.3f, mean %10.3f, "
+		       "stddev %8.3f)\n",label,s->median/1e6,s->min/1e6,s->mean/1e6,
+		       s->stddev/1e6);
+		if (p->mix != NULL) {
+			printf("%37s  throughput %.0f ops/s\n","",
+			       phase_ops(p,n)/(s->median/1e9));
+		}
+		if (h != NULL) {
+			printf("%37s  latency ns: p50 %llu, p90 %llu, p99 %llu, "
+			       "p99.9 %llu, max %llu\n","",q[0],q[1],q[2],q[3],h->max);
+		}
+		if (opt->counters != NULL) {
+			const char *sep=" ";
+			printf("%37s  per op:","");
+			for(int i=0;i<PERF_COUNTER_COUNT;i++) {
+				if (!isnan(s->events[i])) {
+					printf("%s%s %.2f",sep,perf_counter_name(i),s->events[i]);
+					sep=", ";
+				}
+			}
+			printf("\n");
+		}
+		if (opt->memory) {
+			const memory_counter *m=&s->memory;
+			printf("%37s  memory: steady %llu bytes (%.1f per item), peak %llu "
+			       "bytes, %llu allocs, %llu frees\n","",m->steady,
+			       (double)m->steady/n,m->peak,m->timed_allocs,m->timed_frees);
+		}
+		return;
+	}
+	if (h != NULL) {
+		printf(", %llu, %llu, %llu, %llu, %llu",q[0],q[1],q[2],q[3],h->max);
+	}
+	if (p->mix != NULL && opt->sweep == 0) {
+		printf(", %.0f",phase_ops(p,n)/(s->median/1e9));
 	}
+	for(int i=0;opt->counters != NULL && i<PERF_COUNTER_COUNT;i++) {
+		printf(", %.3f",s->events[i]);
+	}
+	if (opt->memory) {
+		printf(", %llu, %llu, %llu, %llu",s->memory.steady,s->memory.peak,
+		       s->memory.timed_allocs,s->memory.timed_frees);
+	}
+	printf("\n");
 }
 
+#ifndef TABLE_BACKENDS
+
+// The correctness tests use the table functions directly, and are
+// left out of tablebench, where each implementation has its own names.
+
 /* Tests if isempty returns true directly after a table is created.
  */
 void test_isempty(){
@@ -682,6 +1711,763 @@ void test_remove_elements_same_keys()
         table_kill(t);
 }
 
+/* Tests a table created with the given hash function by inserting
+ *  three keys, of which two are duplicates, looking them up and
+ *  removing them one at a time.
+ *     hash_func - the hash function to create the table with
+ */
+void test_hashed_keys_with(hash_function *hash_func)
+{
+        table *t = table_empty_with_hash(string_compare, hash_func,
+                                         free, free);
+
+        table_insert(t, copy_string("key1"), copy_string("value1"));
+        table_insert(t, copy_string("key2"), copy_string("value21"));
+        table_insert(t, copy_string("key2"), copy_string("value22"));
+
+        test_lookup_existing_key(t, "key1", "value1");
+        test_lookup_existing_key(t, "key2", "value22");
+        test_lookup_missing_key(t, "key3");
+
+        table_remove(t, "key2");
+        test_lookup_missing_key(t, "key2");
+        test_lookup_existing_key(t, "key1", "value1");
+
+        table_remove(t, "key1");
+        if (!table_is_empty(t)) {
+                printf("Removing the last element from a table with "
+                       "hashed keys does not result in an empty table.\n");
+                exit(EXIT_FAILURE);
+        }
+        table_kill(t);
+}
+
+/* Tests tables with cached key hashes, both with a proper hash
+ * function and with a hash function where all keys collide.
+ */
+void test_hashed_keys()
+{
+        test_hashed_keys_with(string_hash);
+        test_hashed_keys_with(constant_hash);
+
+        printf("Inserting, looking up and removing keys in a table with "
+               "cached key hashes - OK\n");
+}
+
+/* Tests freezing a table. A table with a single key followed by
+ *  three duplicates of another key is frozen, and it is checked that
+ *  the latest value of each key is found, that a missing key is not
+ *  found and that the frozen table rejects inserts and removes.
+ *  Finally, it is checked that a table without a hash function
+ *  cannot be frozen.
+ */
+void test_freeze()
+{
+        table *t = table_empty_with_hash(string_compare, string_hash,
+                                         free, free);
+
+        table_insert(t, copy_string("key1"), copy_string("value11"));
+        table_insert(t, copy_string("key2"), copy_string("value21"));
+        table_insert(t, copy_string("key2"), copy_string("value22"));
+        table_insert(t, copy_string("key2"), copy_string("value23"));
+
+        if (table_freeze(t) != 0 || !table_is_frozen(t)) {
+                printf("Freezing a table with a hash function failed.\n");
+                exit(EXIT_FAILURE);
+        }
+        test_lookup_existing_key(t, "key1", "value11");
+        test_lookup_existing_key(t, "key2", "value23");
+        test_lookup_missing_key(t, "key3");
+
+        char *key3 = copy_string("key3");
+        char *value3 = copy_string("value3");
+        if (table_insert(t, key3, value3) == 0) {
+                printf("Inserting into a frozen table succeeded.\n");
+                exit(EXIT_FAILURE);
+        }
+        // The table did not take over the responsibility for the pair.
+        free(key3);
+        free(value3);
+        if (table_remove(t, "key1") == 0 || table_is_empty(t)) {
+                printf("Removing from a frozen table succeeded.\n");
+                exit(EXIT_FAILURE);
+        }
+        test_lookup_existing_key(t, "key1", "value11");
+        table_kill(t);
+
+        // Small tables of every size, where the construction of the
+        // perfect hash function is most likely to need a retry.
+        char key[16];
+        for (int n = 1; n <= 64; n++) {
+                t = table_empty_with_hash(string_compare, string_hash,
+                                          free, free);
+                for (int i = 0; i < n; i++) {
+                        sprintf(key, "key%d", i);
+                        table_insert(t, copy_string(key), copy_string(key));
+                }
+                if (table_freeze(t) != 0) {
+                        printf("Freezing a table with %d keys failed.\n", n);
+                        exit(EXIT_FAILURE);
+                }
+                for (int i = 0; i < n; i++) {
+                        sprintf(key, "key%d", i);
+                        test_lookup_existing_key(t, key, key);
+                }
+                table_kill(t);
+        }
+
+        t = table_empty(string_compare, free, free);
+        table_insert(t, copy_string("key1"), copy_string("value1"));
+        if (table_freeze(t) == 0 || table_is_frozen(t)) {
+                printf("Freezing a table without a hash function "
+                       "succeeded.\n");
+                exit(EXIT_FAILURE);
+        }
+        test_lookup_existing_key(t, "key1", "value1");
+        table_kill(t);
+
+        printf("Freezing a table, checking that lookups still work and "
+               "that inserts and removes fail - OK\n");
+}
+
+/* Checks that a key returned by an ordered query is the expected one.
+ *     query - the name of the query, used in the error message
+ *     key - the returned key
+ *     expected - the expected key, or NULL if no key is expected
+ */
+void check_ordered_key(const char *query, const char *key,
+                       const char *expected)
+{
+        if ((key == NULL) != (expected == NULL)
+            || (key != NULL && strcmp(key, expected) != 0)) {
+                printf("%s returned %s, expected %s.\n", query,
+                       key ? key : "NULL",
+                       expected ? expected : "NULL");
+                exit(EXIT_FAILURE);
+        }
+}
+
+// The key/value pairs visited by table_range, as "key=value;" strings.
+char range_visited[200];
+
+/* Appends a key/value pair visited by table_range to range_visited.
+ */
+void record_range_pair(const void *key, const void *value)
+{
+        const char *k = key;
+        const char *v = value;
+        if (strlen(range_visited) + strlen(k) + strlen(v) + 3
+            > sizeof(range_visited)) {
+                printf("table_range visited too many pairs.\n");
+                exit(EXIT_FAILURE);
+        }
+        strcat(range_visited, k);
+        strcat(range_visited, "=");
+        strcat(range_visited, v);
+        strcat(range_visited, ";");
+}
+
+/* Checks that table_range visits the expected pairs in order.
+ *     t - the table to query
+ *     lo, hi - the interval bounds
+ *     expected - the expected contents of range_visited
+ */
+void check_range(const table *t, const char *lo, const char *hi,
+                 const char *expected)
+{
+        range_visited[0] = '\0';
+        table_range(t, lo, hi, record_range_pair);
+        if (strcmp(range_visited, expected) != 0) {
+                printf("table_range(%s, %s) visited \"%s\", expected "
+                       "\"%s\".\n", lo, hi, range_visited, expected);
+                exit(EXIT_FAILURE);
+        }
+}
+
+/* Runs the ordered queries on a table with the keys key1, ..., key5,
+ *  where key3 has the value value32 and the other keys the values
+ *  value1, ..., value5.
+ */
+void check_ordered_queries(const table *t)
+{
+        check_ordered_key("table_min", table_min(t), "key1");
+        check_ordered_key("table_max", table_max(t), "key5");
+        check_ordered_key("table_floor", table_floor(t, "key3"), "key3");
+        check_ordered_key("table_floor", table_floor(t, "key3a"), "key3");
+        check_ordered_key("table_floor", table_floor(t, "a"), NULL);
+        check_ordered_key("table_ceiling", table_ceiling(t, "key3"), "key3");
+        check_ordered_key("table_ceiling", table_ceiling(t, "key3a"), "key4");
+        check_ordered_key("table_ceiling", table_ceiling(t, "z"), NULL);
+        check_range(t, "key2", "key4",
+                    "key2=value2;key3=value32;key4=value4;");
+        check_range(t, "key0", "key1a", "key1=value1;");
+        check_range(t, "key3a", "key3b", "");
+        check_range(t, "a", "z", "key1=value1;key2=value2;key3=value32;"
+                    "key4=value4;key5=value5;");
+}
+
+/* Tests the ordered queries. The keys are inserted out of order and
+ *  with a duplicate. The queries are checked on an empty table, on
+ *  the filled table, and on the table after it has been frozen.
+ *     t - an empty table with string keys and a hash function. Killed.
+ */
+void test_ordered_queries_in(table *t)
+{
+        check_ordered_key("table_min", table_min(t), NULL);
+        check_ordered_key("table_max", table_max(t), NULL);
+        check_ordered_key("table_floor", table_floor(t, "key1"), NULL);
+        check_range(t, "a", "z", "");
+
+        table_insert(t, copy_string("key3"), copy_string("value31"));
+        table_insert(t, copy_string("key5"), copy_string("value5"));
+        table_insert(t, copy_string("key1"), copy_string("value1"));
+        table_insert(t, copy_string("key4"), copy_string("value4"));
+        table_insert(t, copy_string("key3"), copy_string("value32"));
+        table_insert(t, copy_string("key2"), copy_string("value2"));
+
+        check_ordered_queries(t);
+        if (table_freeze(t) != 0) {
+                printf("Freezing a table with a hash function failed.\n");
+                exit(EXIT_FAILURE);
+        }
+        check_ordered_queries(t);
+        table_kill(t);
+}
+
+/* Tests the ordered queries on a table created with a hash function,
+ *  and on a table created with the key type for strings.
+ */
+void test_ordered_queries()
+{
+        test_ordered_queries_in(table_empty_with_hash(string_compare,
+                                                      string_hash,
+                                                      free, free));
+        test_ordered_queries_in(table_empty_with_key_type(string_compare,
+                                                          string_hash,
+                                                          TABLE_KEY_STRING,
+                                                          free, free));
+
+        printf("Min, max, floor, ceiling and range queries, before and "
+               "after freezing the table - OK\n");
+}
+
+/* Inserts copies of the pairs in the NULL-terminated array pairs,
+ *  given as key, value, key, ..., into a table.
+ */
+void insert_pairs(table *t, const char *pairs[])
+{
+        for (int i = 0; pairs[i] != NULL; i += 2) {
+                table_insert(t, copy_string(pairs[i]),
+                             copy_string(pairs[i + 1]));
+        }
+}
+
+/* Creates a table with the given hash function and inserts the pairs
+ *  in the NULL-terminated array pairs, given as key, value, key, ...
+ */
+table *table_from_pairs(hash_function *hash_func, const char *pairs[])
+{
+        table *t = table_empty_with_hash(string_compare, hash_func,
+                                         free, free);
+        insert_pairs(t, pairs);
+        return t;
+}
+
+/* Tests the set operations on tables created with the given hash
+ *  function.
+ *     hash_func - the hash function, or NULL
+ */
+void test_set_operations_with(hash_function *hash_func)
+{
+        const char *dst_pairs[] = { "key1", "a1", "key2", "a2",
+                                    "key3", "a3", NULL };
+        const char *src_pairs[] = { "key4", "b41", "key2", "b2",
+                                    "key4", "b42", NULL };
+
+        // Merging, keeping the pairs of the source table.
+        table *dst = table_from_pairs(hash_func, dst_pairs);
+        table *src = table_from_pairs(hash_func, src_pairs);
+        if (table_merge(dst, src, TABLE_MERGE_KEEP_SRC) != 0
+            || !table_is_empty(src)) {
+                printf("table_merge failed or did not empty the source "
+                       "table.\n");
+                exit(EXIT_FAILURE);
+        }
+        check_range(dst, "a", "z",
+                    "key1=a1;key2=b2;key3=a3;key4=b42;");
+        table_kill(src);
+
+        // Merging, keeping the pairs of the destination table.
+        src = table_from_pairs(hash_func, dst_pairs);
+        table_insert(src, copy_string("key0"), copy_string("c0"));
+        table_merge(dst, src, TABLE_MERGE_KEEP_DST);
+        check_range(dst, "a", "z", "key0=c0;key1=a1;key2=b2;key3=a3;"
+                    "key4=b42;");
+        table_kill(src);
+
+        // Intersection and difference.
+        const char *other_pairs[] = { "key2", "x", "key4", "x",
+                                      "key9", "x", NULL };
+        table *other = table_from_pairs(hash_func, other_pairs);
+        table_intersect(dst, other);
+        check_range(dst, "a", "z", "key2=b2;key4=b42;");
+        table_remove(other, "key4");
+        table_difference(dst, other);
+        check_range(dst, "a", "z", "key4=b42;");
+        table_difference(dst, dst);
+        if (!table_is_empty(dst)) {
+                printf("The difference of a table and itself is not "
+                       "empty.\n");
+                exit(EXIT_FAILURE);
+        }
+        table_kill(dst);
+
+        // Intersection with a frozen table.
+        if (hash_func != NULL) {
+                dst = table_from_pairs(hash_func, dst_pairs);
+                table_freeze(other);
+                table_intersect(dst, other);
+                check_range(dst, "a", "z", "key2=a2;");
+                if (table_merge(other, dst, TABLE_MERGE_KEEP_SRC) == 0) {
+                        printf("Merging into a frozen table "
+                               "succeeded.\n");
+                        exit(EXIT_FAILURE);
+                }
+                table_kill(dst);
+        }
+        table_kill(other);
+}
+
+/* Tests merge, intersection and difference of tables, both with and
+ *  without a hash function.
+ */
+void test_set_operations()
+{
+        test_set_operations_with(NULL);
+        test_set_operations_with(string_hash);
+
+        printf("Merging, intersecting and taking the difference of "
+               "tables - OK\n");
+}
+
+/* Checks that the keys k000, k001, ... in a table have the values
+ *  v000, v001, ..., except that the keys with a number for which
+ *  removed returns true are missing.
+ *     t - the table to check
+ *     n - the number of keys
+ *     removed - the function telling which keys are removed
+ */
+void check_numbered_keys(const table *t, int n, bool (*removed)(int))
+{
+        char key[16];
+        char value[16];
+        for (int i = 0; i < n; i++) {
+                sprintf(key, "k%03d", i);
+                sprintf(value, "v%03d", i);
+                const char *v = table_lookup(t, key);
+                if (removed(i) ? v != NULL
+                    : v == NULL || strcmp(v, value) != 0) {
+                        printf("Lookup of %s in a cloned table returned "
+                               "%s.\n", key, v ? v : "NULL");
+                        exit(EXIT_FAILURE);
+                }
+        }
+}
+
+// Used by check_numbered_keys for a table where no key is removed.
+bool none_removed(int i)
+{
+        (void)i;
+        return false;
+}
+
+// Used by check_numbered_keys for a table where the even keys are removed.
+bool even_removed(int i)
+{
+        return i % 2 == 0;
+}
+
+/* Tests cloning tables. The table and the clone are modified
+ *  independently, and must not see the changes of each other.
+ */
+void test_clone()
+{
+        const char *pairs[] = { "key1", "a1", "key2", "a2",
+                                "key3", "a3", NULL };
+
+        // Modify both the table and its clone.
+        table *t = table_from_pairs(string_hash, pairs);
+        table *c = table_clone(t);
+        check_range(c, "a", "z", "key1=a1;key2=a2;key3=a3;");
+        table_insert(c, copy_string("key2"), copy_string("c2"));
+        table_remove(c, "key1");
+        table_insert(t, copy_string("key4"), copy_string("a4"));
+        check_range(t, "a", "z", "key1=a1;key2=a2;key3=a3;key4=a4;");
+        check_range(c, "a", "z", "key2=c2;key3=a3;");
+        table_kill(t);
+        check_range(c, "a", "z", "key2=c2;key3=a3;");
+
+        // Clone a frozen table and kill the original last.
+        table_freeze(c);
+        table *f = table_clone(c);
+        char *key5 = copy_string("key5");
+        if (!table_is_frozen(f) || table_insert(f, key5, NULL) == 0) {
+                printf("A clone of a frozen table is not frozen.\n");
+                exit(EXIT_FAILURE);
+        }
+        free(key5);
+        check_range(f, "a", "z", "key2=c2;key3=a3;");
+        table_kill(f);
+        check_range(c, "a", "z", "key2=c2;key3=a3;");
+        table_kill(c);
+
+        // Enough keys to rebuild or rebalance the internal structure.
+        const int n = 200;
+        char key[16];
+        char value[16];
+        t = table_empty_with_hash(string_compare, string_hash, free, free);
+        for (int i = 0; i < n; i++) {
+                sprintf(key, "k%03d", i);
+                sprintf(value, "v%03d", i);
+                table_insert(t, copy_string(key), copy_string(value));
+        }
+        c = table_clone(t);
+        for (int i = 0; i < n; i += 2) {
+                sprintf(key, "k%03d", i);
+                table_remove(c, key);
+        }
+        table *d = table_clone(c);
+        table_difference(t, d);
+        check_numbered_keys(c, n, even_removed);
+        check_numbered_keys(d, n, even_removed);
+        table_kill(c);
+        table_merge(t, d, TABLE_MERGE_KEEP_SRC);
+        check_numbered_keys(t, n, none_removed);
+        table_kill(d);
+        table_kill(t);
+
+        // Merge tables that share their pairs with clones, keeping the
+        // source pairs, and kill the clones before the merged table.
+        const char *src_pairs[] = { "key2", "b2", "key4", "b4", NULL };
+        t = table_from_pairs(string_hash, pairs);
+        table *s = table_from_pairs(string_hash, src_pairs);
+        c = table_clone(t);
+        d = table_clone(s);
+        table_merge(t, s, TABLE_MERGE_KEEP_SRC);
+        check_range(c, "a", "z", "key1=a1;key2=a2;key3=a3;");
+        table_kill(c);
+        table_kill(d);
+        check_range(t, "a", "z", "key1=a1;key2=b2;key3=a3;key4=b4;");
+        table_kill(s);
+        table_kill(t);
+
+        // Merge a pair that has the same key and value pointers as a
+        // pair of the other table, while clones of both tables are
+        // alive. The clones must keep their pairs intact.
+        char shared_key[] = "key2";
+        char shared_value[] = "v2";
+        t = table_empty_with_hash(string_compare, string_hash, NULL, NULL);
+        s = table_empty_with_hash(string_compare, string_hash, NULL, NULL);
+        table_insert(t, "key1", "a1");
+        table_insert(t, shared_key, shared_value);
+        table_insert(t, "key3", "a3");
+        table_insert(s, shared_key, shared_value);
+        c = table_clone(t);
+        d = table_clone(s);
+        table_merge(t, s, TABLE_MERGE_KEEP_SRC);
+        check_range(c, "a", "z", "key1=a1;key2=v2;key3=a3;");
+        check_range(d, "a", "z", "key2=v2;");
+        check_range(t, "a", "z", "key1=a1;key2=v2;key3=a3;");
+        table_kill(d);
+        d = table_clone(t);
+        table_insert(s, shared_key, shared_value);
+        table_merge(s, t, TABLE_MERGE_KEEP_DST);
+        check_range(c, "a", "z", "key1=a1;key2=v2;key3=a3;");
+        check_range(d, "a", "z", "key1=a1;key2=v2;key3=a3;");
+        check_range(s, "a", "z", "key1=a1;key2=v2;key3=a3;");
+        table_kill(c);
+        table_kill(d);
+        table_kill(s);
+        table_kill(t);
+
+        printf("Cloning tables and modifying the clones - OK\n");
+}
+
+/* Checks that table_prefix_scan visits the expected pairs in order.
+ *     t - the table to query
+ *     prefix - the prefix
+ *     expected - the expected contents of range_visited
+ */
+void check_prefix_scan(const table *t, const char *prefix,
+                       const char *expected)
+{
+        range_visited[0] = '\0';
+        table_prefix_scan(t, prefix, record_range_pair);
+        if (strcmp(range_visited, expected) != 0) {
+                printf("table_prefix_scan(%s) visited \"%s\", expected "
+                       "\"%s\".\n", prefix, range_visited, expected);
+                exit(EXIT_FAILURE);
+        }
+}
+
+/* Runs the prefix scans on the table created by test_prefix_scan.
+ */
+void check_prefix_scans(const table *t)
+{
+        check_prefix_scan(t, "se/umu/cs", "se/umu/cs=cs;se/umu/cs/doa=doa2;"
+                          "se/umu/cs/ou3=ou3;se/umu/csc=csc;");
+        check_prefix_scan(t, "se/umu/cs/", "se/umu/cs/doa=doa2;"
+                          "se/umu/cs/ou3=ou3;");
+        check_prefix_scan(t, "se/umu/cs/doa", "se/umu/cs/doa=doa2;");
+        check_prefix_scan(t, "se/umu/cs/doax", "");
+        check_prefix_scan(t, "se/umu/d", "");
+        check_prefix_scan(t, "se/kth", "se/kth=kth;");
+        check_prefix_scan(t, "", "se/kth=kth;se/umu/cs=cs;"
+                          "se/umu/cs/doa=doa2;se/umu/cs/ou3=ou3;"
+                          "se/umu/csc=csc;");
+}
+
+/* Tests prefix scans. Some keys are prefixes of other keys, and one
+ *  key is inserted twice. The scans are checked before and after the
+ *  table is frozen.
+ */
+void test_prefix_scan()
+{
+        const char *pairs[] = { "se/umu/cs/ou3", "ou3", "se/kth", "kth",
+                                "se/umu/cs/doa", "doa1", "se/umu/csc", "csc",
+                                "se/umu/cs", "cs", "se/umu/cs/doa", "doa2",
+                                NULL };
+        table *t = table_from_pairs(string_hash, pairs);
+
+        check_prefix_scans(t);
+        table_freeze(t);
+        check_prefix_scans(t);
+        table_kill(t);
+
+        // The same scans on a table that knows that the keys are strings.
+        t = table_empty_with_key_type(string_compare, string_hash,
+                                      TABLE_KEY_STRING, free, free);
+        insert_pairs(t, pairs);
+        check_prefix_scans(t);
+        table_freeze(t);
+        check_prefix_scans(t);
+        table_kill(t);
+
+        printf("Prefix scans, before and after freezing the table - OK\n");
+}
+
+// The keys visited by table_range on a table with int keys.
+int int_range_visited[10];
+int int_range_count;
+
+/* Appends a key visited by table_range to int_range_visited.
+ */
+void record_int_key(const void *key, const void *value)
+{
+        if (int_range_count == 10) {
+                printf("table_range visited too many pairs.\n");
+                exit(EXIT_FAILURE);
+        }
+        int_range_visited[int_range_count++] = *(const int *)key;
+}
+
+/* Checks that a key returned by an ordered query on a table with int
+ *  keys is the expected one.
+ *     query - the name of the query, for the error message
+ *     key - the key returned by the query, or NULL
+ *     expected - the expected key
+ */
+void check_int_key(const char *query, const int *key, int expected)
+{
+        if (key == NULL || *key != expected) {
+                printf("%s returned the wrong key on a table with int "
+                       "keys.\n", query);
+                exit(EXIT_FAILURE);
+        }
+}
+
+/* Tests a table with int keys, created with the key type. Negative
+ *  keys must be ordered before positive keys.
+ */
+void test_int_keys()
+{
+        const int keys[] = { 300, -5, 7, 0, -70000, 65536, -1 };
+        const int n = sizeof(keys) / sizeof(keys[0]);
+        table *t = table_empty_with_key_type(int_compare, NULL, TABLE_KEY_INT,
+                                             free, free);
+        for (int i = 0; i < n; i++) {
+                table_insert(t, int_ptr_from_int(keys[i]),
+                             int_ptr_from_int(i));
+        }
+        for (int i = 0; i < n; i++) {
+                int *v = table_lookup(t, &keys[i]);
+                if (v == NULL || *v != i) {
+                        printf("Lookup of %d in a table with int keys "
+                               "failed.\n", keys[i]);
+                        exit(EXIT_FAILURE);
+                }
+        }
+        int missing = 8;
+        if (table_lookup(t, &missing) != NULL) {
+                printf("Lookup of a missing int key returned a value.\n");
+                exit(EXIT_FAILURE);
+        }
+
+        int bound = 2;
+        check_int_key("table_min", table_min(t), -70000);
+        check_int_key("table_max", table_max(t), 65536);
+        check_int_key("table_floor", table_floor(t, &bound), 0);
+        check_int_key("table_ceiling", table_ceiling(t, &bound), 7);
+
+        // The keys -5, -1, 0, 7 and 300 are in [-10, 1000].
+        int lo = -10, hi = 1000;
+        const int expected[] = { -5, -1, 0, 7, 300 };
+        int_range_count = 0;
+        table_range(t, &lo, &hi, record_int_key);
+        if (int_range_count != 5
+            || memcmp(int_range_visited, expected, sizeof(expected)) != 0) {
+                printf("table_range on a table with int keys visited the "
+                       "wrong keys.\n");
+                exit(EXIT_FAILURE);
+        }
+
+        table_remove(t, &keys[1]);
+        check_int_key("table_min", table_min(t), -70000);
+        table_remove(t, &keys[4]);
+        check_int_key("table_min", table_min(t), -1);
+        table_kill(t);
+
+        printf("Lookups, removals and ordered queries of int keys - OK\n");
+}
+
+// A hash function for int keys where all even keys collide, and all
+// odd keys collide.
+unsigned long int_parity_hash(const void *key)
+{
+        return *(const int *)key & 1;
+}
+
+/* Tests the int keys 0, 256, 512, 65536, ..., which share their low
+ *  byte, in a table created with the given constructor. No two keys
+ *  may be merged into one entry.
+ *     t - an empty table with int keys and int_compare. Killed.
+ */
+void test_opaque_keys_in(table *t)
+{
+        const int keys[] = { 256, 0, 65536, -3, 512, 7, 1 };
+        const int n = sizeof(keys) / sizeof(keys[0]);
+        for (int i = 0; i < n; i++) {
+                table_insert(t, int_ptr_from_int(keys[i]),
+                             int_ptr_from_int(i));
+        }
+        // A duplicate replaces the value of key 0 only.
+        table_insert(t, int_ptr_from_int(0), int_ptr_from_int(10));
+        table *c = table_clone(t);
+        table_remove(c, &keys[4]);
+        table_insert(c, int_ptr_from_int(1024), int_ptr_from_int(11));
+
+        for (int i = 0; i < n; i++) {
+                int *v = table_lookup(t, &keys[i]);
+                int expected = keys[i] == 0 ? 10 : i;
+                if (v == NULL || *v != expected) {
+                        printf("Lookup of %d in a table with opaque int "
+                               "keys returned %d, expected %d.\n", keys[i],
+                               v ? *v : -1, expected);
+                        exit(EXIT_FAILURE);
+                }
+        }
+        int missing = 1024;
+        if (table_lookup(t, &missing) != NULL
+            || table_lookup(c, &keys[4]) != NULL
+            || table_lookup(c, &missing) == NULL) {
+                printf("A clone of a table with opaque int keys shares "
+                       "the changes of the table.\n");
+                exit(EXIT_FAILURE);
+        }
+        table_kill(c);
+
+        int bound = 2;
+        check_int_key("table_min", table_min(t), -3);
+        check_int_key("table_max", table_max(t), 65536);
+        check_int_key("table_floor", table_floor(t, &bound), 1);
+        check_int_key("table_ceiling", table_ceiling(t, &bound), 7);
+        int lo = 0, hi = 600;
+        const int expected[] = { 0, 1, 7, 256, 512 };
+        int_range_count = 0;
+        table_range(t, &lo, &hi, record_int_key);
+        if (int_range_count != 5
+            || memcmp(int_range_visited, expected, sizeof(expected)) != 0) {
+                printf("table_range on a table with opaque int keys "
+                       "visited the wrong keys.\n");
+                exit(EXIT_FAILURE);
+        }
+
+        // Remove all keys but 512.
+        for (int i = 0; i < n; i++) {
+                if (keys[i] != 512) {
+                        table_remove(t, &keys[i]);
+                }
+        }
+        int *v = table_lookup(t, &keys[4]);
+        if (v == NULL || *v != 4 || table_lookup(t, &keys[0]) != NULL) {
+                printf("Removal from a table with opaque int keys "
+                       "failed.\n");
+                exit(EXIT_FAILURE);
+        }
+        check_int_key("table_min", table_min(t), 512);
+        table_remove(t, &keys[4]);
+        if (!table_is_empty(t)) {
+                printf("A table with opaque int keys is not empty after "
+                       "removing all keys.\n");
+                exit(EXIT_FAILURE);
+        }
+        table_kill(t);
+}
+
+/* Tests int keys in tables created without the key type, i.e. for
+ *  keys that are only known through the compare and hash functions.
+ */
+void test_opaque_keys()
+{
+        test_opaque_keys_in(table_empty(int_compare, free, free));
+        test_opaque_keys_in(table_empty_with_hash(int_compare, int_parity_hash,
+                                                  free, free));
+
+        // Merge tables that share key and value pointers while clones
+        // of both are alive. All even keys, and all odd keys, collide.
+        int keys[10];
+        table *t = table_empty_with_hash(int_compare, int_parity_hash,
+                                         NULL, NULL);
+        table *s = table_empty_with_hash(int_compare, int_parity_hash,
+                                         NULL, NULL);
+        for (int i = 0; i < 10; i++) {
+                keys[i] = i;
+                table_insert(t, &keys[i], &keys[i]);
+                if (i % 3 == 0) {
+                        table_insert(s, &keys[i], &keys[i]);
+                }
+        }
+        table *c = table_clone(t);
+        table *d = table_clone(s);
+        table_merge(t, s, TABLE_MERGE_KEEP_SRC);
+        for (int i = 0; i < 10; i++) {
+                if (table_lookup(c, &keys[i]) != &keys[i]
+                    || table_lookup(t, &keys[i]) != &keys[i]
+                    || (i % 3 == 0 && table_lookup(d, &keys[i]) != &keys[i])) {
+                        printf("Merging a table with opaque int keys "
+                               "changed the pair of %d in a clone.\n", i);
+                        exit(EXIT_FAILURE);
+                }
+        }
+        table_kill(c);
+        table_kill(d);
+        table_kill(s);
+        table_kill(t);
+
+        printf("Lookups, removals and ordered queries of int keys without "
+               "the key type - OK\n");
+}
+
 /*  Tests a table by performing a set of tests. Program exits if any
  *  error is found.
  */
@@ -695,56 +2481,227 @@ void correctness_test()
         test_remove_single_element();
         test_remove_elements_different_keys();
         test_remove_elements_same_keys();
+        test_hashed_keys();
+        test_freeze();
+        test_ordered_queries();
+        test_set_operations();
+        test_clone();
+        test_prefix_scan();
+        test_int_keys();
+        test_opaque_keys();
 }
 
-/* Tests the speed of a table using random numbers. First a number of
- * elements are inserted. Second a random lookup among the elements are
- * done followed by a skewed lookup (where a subset of the keys are
- * looked up more frequently). Finally all elements are removed.
+#endif
+
+/* Prints the medians of a phase of all implementations side by side.
+ * For a mixed phase, the throughputs follow on a second line, with
+ * latencies, the p99 latencies follow, with hardware counters, one
+ * line per counter with the events per operation, and with memory
+ * counting, the steady-state bytes per item, the peak memory and the
+ * allocations per operation.
+ *    p - the phase
+ *    n - number of items
+ *    s - the statistics of the phase for each implementation
+ *    h - the histograms of the phase for each implementation, or NULL
+ *    opt - the options of the speed test
  */
-void speed_test(int n,bool machine_table)
+void print_side_by_side(const speed_phase *p, int n, const phase_stats *s,
+                        histogram **h, const speed_options *opt)
 {
-        int randomsize = 2*n; // To make it easier testing
-                              // non-existing keys later
-        int *keys = malloc(randomsize*sizeof(int));
-        int *values = malloc(randomsize*sizeof(int));
-        create_random_sample(keys, randomsize);
-        create_random_sample(values, n);
-
-        table *t = table_empty(int_compare, free, free);
-        get_insert_speed(t, keys, values, n, machine_table);
-        table_kill(t);
-
-        t = table_empty(int_compare, free, free);
-        insert_values(t,keys,values,n);
-        get_remove_speed(t, keys, n, machine_table);
-        table_kill(t);
-
-        t = table_empty(int_compare, free, free);
-        insert_values(t,keys,values,n);
-        get_random_non_existing_lookup_speed(t, keys, n, machine_table);
-        table_kill(t);
-
-        t = table_empty(int_compare, free, free);
-        insert_values(t,keys,values,n);
-        get_random_existing_lookup_speed(t, keys, n, machine_table);
-        table_kill(t);
+	if (opt->machine_table) {
+		printf("%d, %d",p->id,n);
+		for(int k=0;k<BACKEND_COUNT;k++) {
+			printf(", %.6f",s[k].median/1e6);
+		}
+		for(int k=0;h != NULL && k<BACKEND_COUNT;k++) {
+			printf(", %llu",histogram_percentile(h[k],99));
+		}
+		for(int k=0;p->mix != NULL && k<BACKEND_COUNT;k++) {
+			printf(", %.0f",phase_ops(p,n)/(s[k].median/1e9));
+		}
+		for(int i=0;opt->counters != NULL && i<PERF_COUNTER_COUNT;i++) {
+			for(int k=0;k<BACKEND_COUNT;k++) {
+				printf(", %.3f",s[k].events[i]);
+			}
+		}
+		for(int k=0;opt->memory && k<BACKEND_COUNT;k++) {
+			printf(", %llu",s[k].memory.steady);
+		}
+		for(int k=0;opt->memory && k<BACKEND_COUNT;k++) {
+			printf(", %llu",s[k].memory.peak);
+		}
+		for(int k=0;opt->memory && k<BACKEND_COUNT;k++) {
+			printf(", %llu",s[k].memory.timed_allocs);
+		}
+		printf("\n");
+		return;
+	}
+	printf("%-16s",p->name);
+	for(int k=0;k<BACKEND_COUNT;k++) {
+		printf(" %11.3f",s[k].median/1e6);
+	}
+	printf("\n");
+	if (p->mix != NULL) {
+		printf("%-16s","  kops/s");
+		for(int k=0;k<BACKEND_COUNT;k++) {
+			printf(" %11.1f",phase_ops(p,n)/(s[k].median/1e6));
+		}
+		printf("\n");
+	}
+	if (h != NULL) {
+		printf("%-16s","  p99 ns");
+		for(int k=0;k<BACKEND_COUNT;k++) {
+			printf(" %11llu",histogram_percentile(h[k],99));
+		}
+		printf("\n");
+	}
+	for(int i=0;opt->counters != NULL && i<PERF_COUNTER_COUNT;i++) {
+		if (isnan(s[0].events[i])) {
+			continue;
+		}
+		char name[32];
+		snprintf(name,sizeof(name),"  %s",perf_counter_name(i));
+		printf("%-16s",name);
+		for(int k=0;k<BACKEND_COUNT;k++) {
+			printf(" %11.2f",s[k].events[i]);
+		}
+		printf("\n");
+	}
+	if (opt->memory) {
+		printf("%-16s","  bytes/item");
+		for(int k=0;k<BACKEND_COUNT;k++) {
+			printf(" %11.1f",(double)s[k].memory.steady/n);
+		}
+		printf("\n%-16s","  peak KiB");
+		for(int k=0;k<BACKEND_COUNT;k++) {
+			printf(" %11.1f",s[k].memory.peak/1024.0);
+		}
+		printf("\n%-16s","  allocs/op");
+		for(int k=0;k<BACKEND_COUNT;k++) {
+			printf(" %11.2f",(double)s[k].memory.timed_allocs/phase_ops(p,n));
+		}
+		printf("\n");
+	}
+}
 
-        t = table_empty(int_compare, free, free);
-        insert_values(t,keys,values,n);
-        get_skewed_lookup_speed(t, keys, n, machine_table);
-        table_kill(t);
+/* Tests the speed of a table using random keys of the kind in opt,
+ * int keys or strings made from random numbers. First a number of
+ * elements are inserted. Second a random lookup among the elements are
+ * done followed by a skewed lookup (where the keys are drawn from a
+ * skewed distribution, so that some keys are looked up more often).
+ * Finally all elements are removed. The mixed phases, if any, follow
+ * with ids from FIRST_MIX_ID, see time_mix. Each phase is run warmups times without timing and then reps times, for
+ * each implementation with the same keys. The machine-readable table
+ * has one line per phase with the columns id, n, median time in ms,
+ * min time in ms, mean time in ms and standard deviation in ms,
+ * followed by the latency percentiles p50, p90, p99, p99.9 and the max
+ * latency in ns if latencies are asked for, and for a mixed phase by
+ * the throughput in operations per second, and then by the hardware
+ * events per operation, if hardware counters are used, in the order of
+ * perfcount.h, nan for an unavailable counter, and then by the
+ * steady-state and peak bytes of the table and the number of
+ * allocations and de-allocations of the timed operations, if the
+ * memory is counted. In a sweep, the lines
+ * instead start with the implementation and the name of the phase, and
+ * the id is replaced by the median time per operation in ns after the
+ * times in ms, without the throughput. With several implementations, and not in a sweep, the
+ * median times of the implementations are printed side by side, and
+ * the lines of the machine-readable table have the columns id, n and
+ * the median time in ms of each implementation, followed by the p99
+ * latency in ns of each implementation if latencies are asked for,
+ * for a mixed phase by the throughput of each implementation, by
+ * each hardware counter of each implementation, per operation, and by
+ * the steady-state bytes, the peak bytes and the allocations of each
+ * implementation.
+ */
+void speed_test(int n,const speed_options *opt)
+{
+        // The keys are made from a permutation of [0, 2n-1], to make
+        // it easier testing non-existing keys later.
+        rng r;
+        rng_seed(&r,opt->seed);
+        speed_keys keys = speed_keys_create(opt->keys,2*(unsigned long long)n,&r);
+        bool side_by_side = BACKEND_COUNT > 1 && opt->sweep == 0;
+
+	if (side_by_side && !opt->machine_table) {
+		char title[32];
+		snprintf(title,sizeof(title),"Median ms, n=%d",n);
+		printf("%-16s",title);
+		for(int k=0;k<BACKEND_COUNT;k++) {
+			printf(" %11s",backends[k].name);
+		}
+		printf("\n");
+	}
+        for(int i=0;i<PHASE_COUNT+opt->mix_count;i++) {
+                speed_phase p;
+                if (i<PHASE_COUNT) {
+                        p=phases[i];
+                } else {
+                        const mix_spec *m=&opt->mixes[i-PHASE_COUNT];
+                        p=(speed_phase){ FIRST_MIX_ID+i-PHASE_COUNT, m->name,
+                                         m->label, time_mix, m };
+                }
+                phase_stats s[BACKEND_COUNT];
+                histogram *h[BACKEND_COUNT];
+                for(int k=0;k<BACKEND_COUNT;k++) {
+                        h[k]=opt->latencies ? calloc(1,sizeof(histogram)) : NULL;
+                        s[k]=measure_phase(&backends[k],&p,&keys,n,opt,h[k]);
+                        if (!side_by_side) {
+                                print_phase(&backends[k],&p,n,&s[k],h[k],opt);
+                        }
+                        if (opt->csv != NULL) {
+                                write_latencies(backends[k].name,p.name,
+                                                h[k],n,opt->csv);
+                        }
+                }
+                if (side_by_side) {
+                        print_side_by_side(&p,n,s,opt->latencies ? h : NULL,
+                                           opt);
+                }
+                for(int k=0;k<BACKEND_COUNT;k++) {
+                        free(h[k]);
+                }
+        }
+        speed_keys_kill(&keys);
+}
 
-        free(keys);
-        free(values);
+/* Runs the speed test for the sizes of a geometric series, from
+ * SWEEP_START to n, where each size is opt->sweep times the previous
+ * one. The last size is n.
+ */
+void sweep_test(int n,const speed_options *opt)
+{
+	printf("# impl, phase, n, median_ms, min_ms, mean_ms, stddev_ms, "
+	       "median_ns_per_op%s",
+	       opt->latencies ? ", p50_ns, p90_ns, p99_ns, p99.9_ns, max_ns" : "");
+	for(int i=0;opt->counters != NULL && i<PERF_COUNTER_COUNT;i++) {
+		printf(", %s_per_op",perf_counter_name(i));
+	}
+	printf("%s\n",opt->memory ? ", steady_bytes, peak_bytes, allocs, frees" : "");
+        double size=SWEEP_START;
+        while (size < n) {
+                speed_test((int)size,opt);
+                // Grow by at least one element.
+                size=size*opt->sweep > size+1 ? size*opt->sweep : size+1;
+        }
+        speed_test(n,opt);
 }
 
+#ifdef TABLE_BACKENDS
+#define NAME "tablebench"
+#else
 #define NAME "tabletest"
+#endif
 
 int main(int argc,char **argv)
 {
 	bool do_test=true; // Should we run the testing code?
-	bool machine_table=false; // Should we output a machine-readable table?
+        // The options of the speed test, with their defaults.
+        speed_options opt={ 1, 5, false, false, NULL, 0, 1 };
+        workload_parse(&opt.skew,"zipf:0.99");
+        const char *csv_name=NULL; // File for the latency percentiles
+        bool use_counters=false;   // Count hardware events
+        perf_counters counters;
         int n=-1;
 
         fprintf(stderr,NAME " " VERSION " (" VERSION_DATE ")\n");
@@ -759,7 +2716,84 @@ int main(int argc,char **argv)
 				do_test=false;
 				break;
 			case 't':
-				machine_table=true;
+				opt.machine_table=true;
+				break;
+			case 'l':
+				opt.latencies=true;
+				break;
+			case 'p':
+				use_counters=true;
+				break;
+			case 'a':
+				opt.memory=true;
+				break;
+			case 'r':
+			case 'w':
+			case 'c':
+			case 's':
+			case 'k':
+			case 'd':
+			case 'm':
+			case 'K':
+				// The count, file name, factor, seed,
+				// distribution, mix or kind of keys is the
+				// next argument.
+				if (i+1>=argc) {
+					fprintf(stderr,"%s: Missing argument after %s.\n",
+						argv[0],s);
+					exit(EXIT_FAILURE);
+				}
+				if (s[1]=='r') {
+					opt.reps=atoi(argv[++i]);
+				} else if (s[1]=='w') {
+					opt.warmups=atoi(argv[++i]);
+				} else if (s[1]=='k') {
+					opt.seed=strtoull(argv[++i],NULL,10);
+				} else if (s[1]=='d') {
+					if (workload_parse(&opt.skew,argv[++i])!=0) {
+						fprintf(stderr,"%s: Bad distribution: %s.\n",
+							argv[0],argv[i]);
+						exit(EXIT_FAILURE);
+					}
+				} else if (s[1]=='K') {
+					int k=0;
+					while (k<KEY_KIND_COUNT
+					       && strcmp(key_kind_names[k],argv[i+1])!=0) {
+						k++;
+					}
+					if (k==KEY_KIND_COUNT) {
+						fprintf(stderr,"%s: Bad kind of keys: %s.\n",
+							argv[0],argv[i+1]);
+						exit(EXIT_FAILURE);
+					}
+					opt.keys=k;
+					i++;
+				} else if (s[1]=='m') {
+					if (opt.mix_count==MAX_MIXES) {
+						fprintf(stderr,"%s: At most %d mixes.\n",
+							argv[0],MAX_MIXES);
+						exit(EXIT_FAILURE);
+					}
+					if (parse_mix(&opt.mixes[opt.mix_count++],
+						      argv[++i])!=0) {
+						fprintf(stderr,"%s: Bad mix: %s.\n",
+							argv[0],argv[i]);
+						exit(EXIT_FAILURE);
+					}
+					// The percentiles are part of the
+					// results of a mix.
+					opt.latencies=true;
+				} else if (s[1]=='s') {
+					opt.sweep=atof(argv[++i]);
+					if (opt.sweep<=1) {
+						fprintf(stderr,"%s: The factor of a sweep "
+							"must be larger than 1.\n",argv[0]);
+						exit(EXIT_FAILURE);
+					}
+				} else {
+					csv_name=argv[++i];
+					opt.latencies=true;
+				}
 				break;
 			default:
 				fprintf(stderr,"%s: Bad switch: %s.\n",
@@ -774,11 +2808,37 @@ int main(int argc,char **argv)
 	}
 
         if (n<0) {
-                fprintf(stderr,"Usage:\n\t%s [-n] [-t] n\n"
+                fprintf(stderr,"Usage:\n\t%s [-n] [-t] [-r reps] [-w warmups] [-l] [-c file] [-p] [-a]\n"
+			"\t\t[-s factor] [-k seed] [-d distribution] [-m mix]... [-K keys] n\n"
 			"\twhere n is an integer from 1 to %d.\n\n"
 			"\tUse -n (no-test) to skip the testing.\n"
-			"\tUse -t (table) to output a machine-readable table with the timings.\n",
-			argv[0],TABLESIZE);
+			"\tUse -t (table) to output a machine-readable table with the timings.\n"
+			"\tUse -r to set the number of timed runs of each phase (default 5).\n"
+			"\tUse -w to set the number of untimed warm-up runs (default 1).\n"
+			"\tUse -l (latency) to time single operations and print percentiles.\n"
+			"\tUse -c to also write the percentiles to a csv file (implies -l).\n"
+			"\tUse -p (perf) to count hardware events per operation, where the\n"
+			"\tsystem allows it.\n"
+			"\tUse -a (allocations) to count the memory of the tables in an\n"
+			"\textra run of each phase.\n"
+			"\tUse -s to run the speed test for the sizes %d, %d*factor, ... up\n"
+			"\tto n, with one line per implementation, phase and size.\n"
+			"\tUse -k to set the seed of the keys and lookups (default 1).\n"
+			"\tUse -d to set the distribution of the skewed lookups (default\n"
+			"\tzipf:0.99): uniform, zipf:theta, hotspot:fraction:probability,\n"
+			"\tlatest:theta or shifting:fraction:probability:period.\n"
+			"\tUse -m to add a phase with a mix of operations on a table with n\n"
+			"\titems (implies -l), up to %d times. The mix is given as\n"
+			"\tratios[/distribution[/ops]], where ratios is either the weights\n"
+			"\tof lookups, updates, insertions and removals, e.g. 90,0,5,5, or\n"
+			"\tone of the YCSB workloads a, b, c and d. The keys of lookups and\n"
+			"\tupdates are drawn from the distribution (default zipf:0.99, for\n"
+			"\td latest:0.99), and ops operations are timed (default n).\n"
+			"\tUse -K to set the kind of keys: int (default), or strings of\n"
+			"\t%d-%d characters: random, prefix (with a long shared prefix)\n"
+			"\tor url. String keys are made before the timing and need memory.\n",
+			argv[0],TABLESIZE,SWEEP_START,SWEEP_START,MAX_MIXES,
+			MIN_KEY_LENGTH,MAX_KEY_LENGTH);
 		exit(EXIT_FAILURE);
 	}
 	if (n<1 || n>TABLESIZE) {
@@ -786,14 +2846,64 @@ int main(int argc,char **argv)
                         "allowed range 1-%d.\n",n,TABLESIZE);
                 exit(EXIT_FAILURE);
         }
+	if (opt.reps<1 || opt.warmups<0) {
+		fprintf(stderr,"Error: need at least one timed run (%d) and no "
+			"negative number of warm-up runs (%d).\n",opt.reps,opt.warmups);
+		exit(EXIT_FAILURE);
+	}
+	if (csv_name!=NULL) {
+		opt.csv=fopen(csv_name,"w");
+		if (opt.csv==NULL) {
+			fprintf(stderr,"Error: cannot open %s for writing.\n",csv_name);
+			exit(EXIT_FAILURE);
+		}
+		fprintf(opt.csv,"impl,phase,n,count,p50_ns,p90_ns,p99_ns,p99.9_ns,max_ns\n");
+	}
 	if (do_test) {
+#ifdef TABLE_BACKENDS
+		fprintf(stderr,"The correctness tests are run by the tabletest "
+			"program of each implementation.\n\n");
+#else
 		printf("Testing...\n");
 		correctness_test();
 		printf("All correctness tests succeeded!\n\n");
+#endif
+	}
+	if (use_counters) {
+		int available=perf_counters_open(&counters);
+		if (available==0) {
+			fprintf(stderr,"Hardware counters are not available (%s), "
+				"running without them.\n\n",strerror(counters.error));
+		} else {
+			if (available<PERF_COUNTER_COUNT) {
+				fprintf(stderr,"Some hardware counters are not "
+					"available (%s).\n\n",strerror(counters.error));
+			}
+			opt.counters=&counters;
+		}
 	}
         /*getchar();*/
-        speed_test(n,machine_table);
-        if (!machine_table) {
+	if (!opt.machine_table && opt.sweep == 0) {
+		char dist[64];
+		printf("Skewed lookups draw from %s.\n",
+		       workload_describe(&opt.skew,dist,sizeof(dist)));
+		if (opt.keys != KEYS_INT) {
+			printf("The keys are %s strings of %d-%d characters.\n",
+			       key_kind_names[opt.keys],MIN_KEY_LENGTH,MAX_KEY_LENGTH);
+		}
+	}
+	if (opt.sweep > 0) {
+		sweep_test(n,&opt);
+	} else {
+		speed_test(n,&opt);
+	}
+	if (opt.csv!=NULL) {
+		fclose(opt.csv);
+	}
+	if (opt.counters!=NULL) {
+		perf_counters_close(opt.counters);
+	}
+        if (!opt.machine_table && opt.sweep == 0) {
 		printf("Test completed.\n");
 	}
         return 0;
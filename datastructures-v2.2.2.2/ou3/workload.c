@@ -0,0 +1,383 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "workload.h"
+
+/*
+ * Implementation of a random number generator and of generators of key
+ * positions with different distributions, for the table benchmarks of
+ * the "Datastructures and algorithms" courses at the Department of
+ * Computing Science, Umea University.
+ *
+ * The zipf distribution uses the method of Gray et al., "Quickly
+ * generating billion-record synthetic databases", SIGMOD 1994, as in
+ * the YCSB benchmark. It needs the sum zeta(n, theta) of 1/i^theta for
+ * i from 1 to n, which is computed once when the workload is created,
+ * and then draws each position in O(1) time.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// ===========INTERNAL DATA TYPES ============
+
+struct workload {
+        workload_spec spec;
+        uint64_t n;
+        rng r;
+        // For zipf and latest.
+        double zetan;
+        double alpha;
+        double eta;
+        double half_pow_theta; // 0.5^theta
+        // For hotspot and shifting.
+        uint64_t hot_size;     // At least 1 and at most n
+        uint64_t draws;        // Number of positions drawn so far
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
+
+// Rotate a 64-bit number left.
+static uint64_t rotl(uint64_t x, int k)
+{
+        return (x << k) | (x >> (64 - k));
+}
+
+// The splitmix64 generator, used to seed xoshiro256**.
+static uint64_t splitmix64(uint64_t *x)
+{
+        uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+}
+
+/**
+ * zeta() - Sum 1/i^theta for i from 1 to n.
+ * @n: The number of terms.
+ * @theta: The exponent.
+ *
+ * Returns: The sum.
+ */
+static double zeta(uint64_t n, double theta)
+{
+        double sum = 0;
+        for (uint64_t i = 1; i <= n; i++) {
+                sum += 1 / pow((double)i, theta);
+        }
+        return sum;
+}
+
+/**
+ * next_zipf() - Draw a zipf distributed rank.
+ * @w: A zipf or latest workload.
+ *
+ * Returns: A rank in [0, n-1], where 0 is the most popular.
+ */
+static uint64_t next_zipf(workload *w)
+{
+        double u = rng_double(&w->r);
+        double uz = u * w->zetan;
+        if (uz < 1) {
+                return 0;
+        }
+        if (uz < 1 + w->half_pow_theta) {
+                return w->n > 1 ? 1 : 0;
+        }
+        uint64_t rank = (uint64_t)(w->n * pow(w->eta * u - w->eta + 1, w->alpha));
+        return rank < w->n ? rank : w->n - 1;
+}
+
+/**
+ * next_hotspot() - Draw a position with a hot set.
+ * @w: A hotspot or shifting workload.
+ * @start: The first position of the hot set.
+ *
+ * Returns: A position in [0, n-1].
+ */
+static uint64_t next_hotspot(workload *w, uint64_t start)
+{
+        uint64_t cold_size = w->n - w->hot_size;
+        uint64_t offset;
+        if (cold_size == 0 || rng_double(&w->r) < w->spec.hot_probability) {
+                offset = rng_below(&w->r, w->hot_size);
+        } else {
+                offset = w->hot_size + rng_below(&w->r, cold_size);
+        }
+        return (start + offset) % w->n;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * rng_seed() - Seed a random number generator.
+ * @r: The generator.
+ * @seed: The seed. Any value, including 0, is allowed.
+ *
+ * Returns: Nothing.
+ */
+void rng_seed(rng *r, uint64_t seed)
+{
+        for (int i = 0; i < 4; i++) {
+                r->s[i] = splitmix64(&seed);
+        }
+}
+
+/**
+ * rng_next() - Draw a random 64-bit number.
+ * @r: The generator.
+ *
+ * Returns: A number in [0, 2^64-1].
+ */
+uint64_t rng_next(rng *r)
+{
+        uint64_t *s = r->s;
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+
+        return result;
+}
+
+/**
+ * rng_below() - Draw a random number below a bound, without bias.
+ * @r: The generator.
+ * @n: The bound, at least 1.
+ *
+ * Returns: A number in [0, n-1].
+ */
+uint64_t rng_below(rng *r, uint64_t n)
+{
+        // Numbers below 2^64 mod n would make the low results more
+        // likely, and are drawn again.
+        uint64_t threshold = -n % n;
+        uint64_t x;
+        do {
+                x = rng_next(r);
+        } while (x < threshold);
+        return x % n;
+}
+
+/**
+ * rng_double() - Draw a random floating point number.
+ * @r: The generator.
+ *
+ * Returns: A number in [0, 1).
+ */
+double rng_double(rng *r)
+{
+        // The 53 high bits fill the mantissa.
+        return (rng_next(r) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * workload_parse() - Parse the description of a distribution.
+ * @spec: The distribution to fill in.
+ * @s: The description, e.g. "zipf:0.99", see the top of workload.h.
+ *
+ * Parameters that are left out get default values: theta 0.99, hot
+ * fraction 0.2, hot probability 0.8 and period 1000000.
+ *
+ * Returns: 0 if the description is valid, otherwise -1.
+ */
+int workload_parse(workload_spec *spec, const char *s)
+{
+        static const struct {
+                const char *name;
+                workload_distribution distribution;
+        } names[] = {
+                { "uniform", WORKLOAD_UNIFORM },
+                { "zipf", WORKLOAD_ZIPF },
+                { "hotspot", WORKLOAD_HOTSPOT },
+                { "latest", WORKLOAD_LATEST },
+                { "shifting", WORKLOAD_SHIFTING_HOTSPOT },
+        };
+        int count = sizeof(names) / sizeof(names[0]);
+        size_t len = strcspn(s, ":");
+
+        int k = 0;
+        while (k < count && (strlen(names[k].name) != len
+                             || strncmp(names[k].name, s, len) != 0)) {
+                k++;
+        }
+        if (k == count) {
+                return -1;
+        }
+
+        spec->distribution = names[k].distribution;
+        spec->theta = 0.99;
+        spec->hot_fraction = 0.2;
+        spec->hot_probability = 0.8;
+        spec->period = 1000000;
+
+        // The parameters that follow the name, separated by colons.
+        double p[3];
+        int params = 0;
+        const char *rest = s + len;
+        while (*rest == ':' && params < 3) {
+                char *end;
+                p[params] = strtod(rest + 1, &end);
+                if (end == rest + 1) {
+                        return -1;
+                }
+                params++;
+                rest = end;
+        }
+        if (*rest != '\0') {
+                return -1;
+        }
+
+        switch (spec->distribution) {
+        case WORKLOAD_UNIFORM:
+                return params == 0 ? 0 : -1;
+        case WORKLOAD_ZIPF:
+        case WORKLOAD_LATEST:
+                if (params > 1) {
+                        return -1;
+                }
+                if (params == 1) {
+                        spec->theta = p[0];
+                }
+                return spec->theta > 0 && spec->theta < 1 ? 0 : -1;
+        case WORKLOAD_HOTSPOT:
+        case WORKLOAD_SHIFTING_HOTSPOT:
+                if (params > 2 && spec->distribution == WORKLOAD_HOTSPOT) {
+                        return -1;
+                }
+                if (params > 0) {
+                        spec->hot_fraction = p[0];
+                }
+                if (params > 1) {
+                        spec->hot_probability = p[1];
+                }
+                if (params > 2) {
+                        spec->period = p[2];
+                }
+                return spec->hot_fraction > 0 && spec->hot_fraction <= 1
+                        && spec->hot_probability >= 0 && spec->hot_probability <= 1
+                        && spec->period >= 1 ? 0 : -1;
+        }
+        return -1;
+}
+
+/**
+ * workload_describe() - Describe a distribution.
+ * @spec: The distribution.
+ * @buf: The buffer to write the description to.
+ * @size: The size of buf.
+ *
+ * The description is accepted by workload_parse.
+ *
+ * Returns: buf.
+ */
+char *workload_describe(const workload_spec *spec, char *buf, int size)
+{
+        switch (spec->distribution) {
+        case WORKLOAD_UNIFORM:
+                snprintf(buf, size, "uniform");
+                break;
+        case WORKLOAD_ZIPF:
+                snprintf(buf, size, "zipf:%g", spec->theta);
+                break;
+        case WORKLOAD_LATEST:
+                snprintf(buf, size, "latest:%g", spec->theta);
+                break;
+        case WORKLOAD_HOTSPOT:
+                snprintf(buf, size, "hotspot:%g:%g", spec->hot_fraction,
+                         spec->hot_probability);
+                break;
+        case WORKLOAD_SHIFTING_HOTSPOT:
+                snprintf(buf, size, "shifting:%g:%g:%g", spec->hot_fraction,
+                         spec->hot_probability, spec->period);
+                break;
+        }
+        return buf;
+}
+
+/**
+ * workload_create() - Create a workload.
+ * @spec: The distribution of the workload.
+ * @n: The number of positions, at least 1.
+ * @seed: The seed of the random numbers of the workload.
+ *
+ * Returns: A pointer to the new workload, or NULL if not enough memory
+ * was available.
+ */
+workload *workload_create(const workload_spec *spec, uint64_t n,
+                          uint64_t seed)
+{
+        workload *w = calloc(1, sizeof(*w));
+        if (w == NULL) {
+                return NULL;
+        }
+        w->spec = *spec;
+        w->n = n;
+        rng_seed(&w->r, seed);
+
+        if (spec->distribution == WORKLOAD_ZIPF
+            || spec->distribution == WORKLOAD_LATEST) {
+                double theta = spec->theta;
+                w->zetan = zeta(n, theta);
+                w->alpha = 1 / (1 - theta);
+                w->half_pow_theta = pow(0.5, theta);
+                if (n > 2) {
+                        w->eta = (1 - pow(2.0 / n, 1 - theta))
+                                / (1 - zeta(2, theta) / w->zetan);
+                }
+        }
+        w->hot_size = (uint64_t)(spec->hot_fraction * n);
+        if (w->hot_size < 1) {
+                w->hot_size = 1;
+        }
+        if (w->hot_size > n) {
+                w->hot_size = n;
+        }
+        return w;
+}
+
+/**
+ * workload_next() - Draw the next position of a workload.
+ * @w: The workload.
+ *
+ * Returns: A position in [0, n-1].
+ */
+uint64_t workload_next(workload *w)
+{
+        uint64_t start;
+        w->draws++;
+        switch (w->spec.distribution) {
+        case WORKLOAD_ZIPF:
+                return next_zipf(w);
+        case WORKLOAD_LATEST:
+                return w->n - 1 - next_zipf(w);
+        case WORKLOAD_HOTSPOT:
+                return next_hotspot(w, 0);
+        case WORKLOAD_SHIFTING_HOTSPOT:
+                // The hot set has moved hot_size positions after each
+                // period of draws.
+                start = (uint64_t)(w->draws / w->spec.period * w->hot_size) % w->n;
+                return next_hotspot(w, start);
+        case WORKLOAD_UNIFORM:
+        default:
+                return rng_below(&w->r, w->n);
+        }
+}
+
+/**
+ * workload_kill() - Destroy a workload.
+ * @w: The workload.
+ *
+ * Returns: Nothing.
+ */
+void workload_kill(workload *w)
+{
+        free(w);
+}
@@ -0,0 +1,157 @@
+#ifndef __WORKLOAD_H
+#define __WORKLOAD_H
+
+#include <stdint.h>
+
+/*
+ * Declaration of a random number generator and of generators of key
+ * positions with different distributions, for the table benchmarks of
+ * the "Datastructures and algorithms" courses at the Department of
+ * Computing Science, Umea University.
+ *
+ * The random number generator is xoshiro256**, seeded with splitmix64.
+ * It is fast, has a period of 2^256-1 and, unlike rand(), gives the
+ * same numbers on all platforms for the same seed.
+ *
+ * A workload draws positions in [0, n-1], e.g. positions in an array
+ * or a permutation of keys, with one of the distributions:
+ *
+ *   uniform            - All positions are equally likely.
+ *   zipf:theta         - Position i is drawn with a probability
+ *                        proportional to 1/(i+1)^theta, 0 < theta < 1.
+ *                        Position 0 is the most popular.
+ *   hotspot:f:p        - The first f*n positions, the hot set, get a
+ *                        fraction p of the draws, uniformly. The other
+ *                        positions share the rest uniformly.
+ *   latest:theta       - As zipf, but position n-1, the most recently
+ *                        inserted, is the most popular.
+ *   shifting:f:p:t     - As hotspot, but the hot set moves one
+ *                        position at a time, so that it has moved by
+ *                        its own size after t draws, and wraps around.
+ *
+ * The strings above are accepted by workload_parse. Creating a zipf
+ * or latest workload takes O(n) time, to sum the probabilities.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// The state of a random number generator.
+typedef struct rng {
+        uint64_t s[4];
+} rng;
+
+// The distributions of a workload.
+typedef enum workload_distribution {
+        WORKLOAD_UNIFORM,
+        WORKLOAD_ZIPF,
+        WORKLOAD_HOTSPOT,
+        WORKLOAD_LATEST,
+        WORKLOAD_SHIFTING_HOTSPOT
+} workload_distribution;
+
+// The distribution of a workload and its parameters.
+typedef struct workload_spec {
+        workload_distribution distribution;
+        double theta;            // Skew of zipf and latest
+        double hot_fraction;     // Size of the hot set, as part of n
+        double hot_probability;  // Probability of drawing from the hot set
+        double period;           // Draws until the hot set has shifted
+} workload_spec;
+
+// Workload type.
+typedef struct workload workload;
+
+// ==========RANDOM NUMBER INTERFACE==========
+
+/**
+ * rng_seed() - Seed a random number generator.
+ * @r: The generator.
+ * @seed: The seed. Any value, including 0, is allowed.
+ *
+ * Returns: Nothing.
+ */
+void rng_seed(rng *r, uint64_t seed);
+
+/**
+ * rng_next() - Draw a random 64-bit number.
+ * @r: The generator.
+ *
+ * Returns: A number in [0, 2^64-1].
+ */
+uint64_t rng_next(rng *r);
+
+/**
+ * rng_below() - Draw a random number below a bound, without bias.
+ * @r: The generator.
+ * @n: The bound, at least 1.
+ *
+ * Returns: A number in [0, n-1].
+ */
+uint64_t rng_below(rng *r, uint64_t n);
+
+/**
+ * rng_double() - Draw a random floating point number.
+ * @r: The generator.
+ *
+ * Returns: A number in [0, 1).
+ */
+double rng_double(rng *r);
+
+// ==========WORKLOAD INTERFACE==========
+
+/**
+ * workload_parse() - Parse the description of a distribution.
+ * @spec: The distribution to fill in.
+ * @s: The description, e.g. "zipf:0.99", see the top of this file.
+ *
+ * Parameters that are left out get default values: theta 0.99, hot
+ * fraction 0.2, hot probability 0.8 and period 1000000.
+ *
+ * Returns: 0 if the description is valid, otherwise -1.
+ */
+int workload_parse(workload_spec *spec, const char *s);
+
+/**
+ * workload_describe() - Describe a distribution.
+ * @spec: The distribution.
+ * @buf: The buffer to write the description to.
+ * @size: The size of buf.
+ *
+ * The description is accepted by workload_parse.
+ *
+ * Returns: buf.
+ */
+char *workload_describe(const workload_spec *spec, char *buf, int size);
+
+/**
+ * workload_create() - Create a workload.
+ * @spec: The distribution of the workload.
+ * @n: The number of positions, at least 1.
+ * @seed: The seed of the random numbers of the workload.
+ *
+ * Returns: A pointer to the new workload, or NULL if not enough memory
+ * was available.
+ */
+workload *workload_create(const workload_spec *spec, uint64_t n,
+                          uint64_t seed);
+
+/**
+ * workload_next() - Draw the next position of a workload.
+ * @w: The workload.
+ *
+ * Returns: A position in [0, n-1].
+ */
+uint64_t workload_next(workload *w);
+
+/**
+ * workload_kill() - Destroy a workload.
+ * @w: The workload.
+ *
+ * Returns: Nothing.
+ */
+void workload_kill(workload *w);
+
+#endif
@@ -0,0 +1,518 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include <arena.h>
+
+/*
+ * Implementation of a memory arena for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University.
+ *
+ * The arena is a chain of blocks. Each block starts with a header,
+ * followed by the memory handed out, and is filled from the start
+ * with allocations rounded up to ALIGNMENT bytes. The arena allocates
+ * from its current block, and moves on to the next block of the chain
+ * when an allocation does not fit. A new block is added after the
+ * current block when no block of the chain has room. Allocations of
+ * more than a quarter of the block size get a block of their own, so
+ * that the rest of the current block is not wasted. After a reset,
+ * they reuse the smallest unused block that is large enough, so that
+ * an arena reset after each request stops growing.
+ *
+ * New blocks are allocated with calloc. Each block remembers how much
+ * of it has ever been handed out. When the arena is reset, the blocks
+ * are only marked as unused, so a reset takes time proportional to
+ * the number of blocks. Memory that is handed out again is cleared by
+ * the allocation instead, so the arena always hands out
+ * zero-initialized memory.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// The size of the blocks if none is given to arena_create.
+#define DEFAULT_BLOCK_SIZE 65536
+
+// All allocations start at a multiple of ALIGNMENT bytes, which is
+// enough for any built-in type.
+#define ALIGNMENT 16
+
+// Round a size up to a multiple of ALIGNMENT.
+#define ALIGN(size) (((size) + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1))
+
+// ===========INTERNAL DATA TYPES ============
+
+typedef struct block {
+    struct block *next; // The next block of the chain, or NULL
+    size_t size;        // Number of bytes that can be handed out
+    size_t used;        // Number of bytes handed out
+    size_t dirty;       // Number of bytes handed out since the calloc
+} block;
+
+// The memory of a block starts after the header, at an aligned offset.
+#define HEADER_SIZE ALIGN(sizeof(block))
+
+struct arena {
+    block *first;      // The first block of the chain, or NULL
+    block *current;    // The block allocated from, or NULL
+    size_t block_size; // Size of the blocks added to the chain
+    size_t bytes;      // Number of bytes of the head and all blocks
+    size_t used;       // Number of bytes handed out since the last reset
+    allocator alloc;   // The allocator returned by arena_allocator
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
+
+// Return the first byte of the memory of a block.
+static unsigned char *block_data(block *b)
+{
+    return (unsigned char *)b + HEADER_SIZE;
+}
+
+/**
+ * block_create() - Allocate an empty block and link it into the chain.
+ * @a: Arena to add the block to.
+ * @size: The number of bytes of the block.
+ *
+ * The block is linked in directly after the current block, or first
+ * in the chain if there is no current block.
+ *
+ * Returns: A pointer to the new block, or NULL if not enough memory
+ * was available.
+ */
+static block *block_create(arena *a, size_t size)
+{
+    // Use calloc so that the memory handed out is zero-initialized.
+    block *b = calloc(1, HEADER_SIZE + size);
+    if (b == NULL) {
+        return NULL;
+    }
+    b->size = size;
+    if (a->current == NULL) {
+        b->next = a->first;
+        a->first = b;
+    } else {
+        b->next = a->current->next;
+        a->current->next = b;
+    }
+    a->bytes += HEADER_SIZE + size;
+
+    return b;
+}
+
+/**
+ * unused_block() - Find the smallest unused block with room for an
+ * allocation.
+ * @a: Arena to search.
+ * @size: The number of bytes of the allocation.
+ *
+ * Returns: A pointer to the block, or NULL if there is none.
+ */
+static block *unused_block(const arena *a, size_t size)
+{
+    block *best = NULL;
+    for (block *b = a->first; b != NULL; b = b->next) {
+        if (b->used == 0 && b->size >= size
+            && (best == NULL || b->size < best->size)) {
+            best = b;
+        }
+    }
+    return best;
+}
+
+/**
+ * take_memory() - Hand out memory from the unused part of a block.
+ * @a: Arena that the block belongs to.
+ * @b: The block, with room for the allocation.
+ * @size: The number of bytes of the allocation, a multiple of ALIGNMENT.
+ *
+ * Returns: A pointer to size bytes of zero-initialized memory.
+ */
+static void *take_memory(arena *a, block *b, size_t size)
+{
+    unsigned char *p = block_data(b) + b->used;
+    if (b->used < b->dirty) {
+        // Clear memory handed out before the last reset.
+        size_t n = b->dirty - b->used < size ? b->dirty - b->used : size;
+        memset(p, 0, n);
+    }
+    b->used += size;
+    if (b->used > b->dirty) {
+        b->dirty = b->used;
+    }
+    a->used += size;
+
+    return p;
+}
+
+// Allocation function of the allocator of an arena.
+static void *allocate_from_arena(void *context, size_t size)
+{
+    return arena_allocate(context, size);
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * arena_create() - Create an empty arena.
+ * @block_size: The number of bytes of each block, or 0 for a default
+ *              size of 64 KiB. Larger allocations get a block of
+ *              their own.
+ *
+ * No block is allocated until the first allocation.
+ *
+ * Returns: A pointer to the new arena, or NULL if not enough memory
+ * was available.
+ */
+arena *arena_create(size_t block_size)
+{
+    arena *a = calloc(1, sizeof(*a));
+    if (a == NULL) {
+        return NULL;
+    }
+    a->block_size = block_size == 0 ? DEFAULT_BLOCK_SIZE : ALIGN(block_size);
+    a->bytes = sizeof(*a);
+    a->alloc.allocate = allocate_from_arena;
+    // The memory is returned at once by arena_reset and arena_kill.
+    a->alloc.deallocate = NULL;
+    a->alloc.context = a;
+
+    return a;
+}
+
+/**
+ * arena_allocator() - Return the allocator of an arena.
+ * @a: Arena to allocate from.
+ *
+ * Returns: A pointer to the allocator.
+ */
+const allocator *arena_allocator(arena *a)
+{
+    return &a->alloc;
+}
+
+/**
+ * arena_allocate() - Allocate memory from an arena.
+ * @a: Arena to allocate from.
+ * @size: The number of bytes to allocate.
+ *
+ * Returns: A pointer to size bytes of zero-initialized memory, or NULL
+ * if not enough memory was available.
+ */
+void *arena_allocate(arena *a, size_t size)
+{
+    // Give each allocation, even an empty one, its own address.
+    size = size == 0 ? ALIGNMENT : ALIGN(size);
+
+    if (size > a->block_size / 4) {
+        // A large allocation gets a block of its own, which does not
+        // become the current block. A block left unused by a reset is
+        // reused if one is large enough.
+        block *b = unused_block(a, size);
+        if (b == NULL) {
+            b = block_create(a, size);
+            if (b == NULL) {
+                return NULL;
+            }
+        }
+        void *p = take_memory(a, b, size);
+        // Nothing else is allocated from the block until the next reset.
+        b->used = b->size;
+        return p;
+    }
+
+    // Find a block with room, starting with the current block. The
+    // blocks after the current block are empty, or hold a single
+    // large allocation.
+    block *b = a->current != NULL ? a->current : a->first;
+    while (b != NULL && b->used + size > b->size) {
+        b = b->next;
+    }
+    if (b == NULL) {
+        b = block_create(a, a->block_size);
+        if (b == NULL) {
+            return NULL;
+        }
+    }
+    a->current = b;
+
+    return take_memory(a, b, size);
+}
+
+/**
+ * arena_reset() - Return all memory allocated from an arena.
+ * @a: Arena to reset.
+ *
+ * Returns: Nothing.
+ */
+void arena_reset(arena *a)
+{
+    for (block *b = a->first; b != NULL; b = b->next) {
+        // The memory is cleared when it is handed out again.
+        b->used = 0;
+    }
+    a->current = NULL;
+    a->used = 0;
+}
+
+/**
+ * arena_used() - Return the memory allocated from an arena.
+ * @a: Arena to inspect.
+ *
+ * Returns: The number of bytes allocated since the arena was created
+ * or last reset, including padding for alignment.
+ */
+size_t arena_used(const arena *a)
+{
+    return a->used;
+}
+
+/**
+ * arena_bytes() - Return the memory used by an arena.
+ * @a: Arena to inspect.
+ *
+ * Returns: The number of bytes of the head and all blocks of the
+ * arena.
+ */
+size_t arena_bytes(const arena *a)
+{
+    return a->bytes;
+}
+
+/**
+ * arena_kill() - Destroy an arena.
+ * @a: Arena to destroy.
+ *
+ * Returns: Nothing.
+ */
+void arena_kill(arena *a)
+{
+    block *b = a->first;
+    while (b != NULL) {
+        block *next = b->next;
+        free(b);
+        b = next;
+    }
+    free(a);
+}
+
+// ===========INTERNAL FUNCTIONS USED BY arena_print_internal ============
+
+// The functions below output code in the dot language, used by
+// GraphViz. For documention of the dot language, see graphviz.org.
+
+/**
+ * indent() - Output indentation string.
+ * @n: Indentation level.
+ *
+ * Print n tab characters.
+ *
+ * Returns: Nothing.
+ */
+static void indent(int n)
+{
+    for (int i=0; i<n; i++) {
+        printf("\t");
+    }
+}
+
+/**
+ * iprintf(...) - Indent and print.
+ * @n: Indentation level
+ * @...: printf arguments
+ *
+ * Print n tab characters and calls printf.
+ *
+ * Returns: Nothing.
+ */
+static void iprintf(int n, const char *fmt, ...)
+{
+    // Indent...
+    indent(n);
+    // ...and call printf
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * print_edge() - Print a edge between two addresses.
+ * @from: The address of the start of the edge. Should be non-NULL.
+ * @to: The address of the destination for the edge, including NULL.
+ * @port: The name of the port on the source node, or NULL.
+ * @label: The label for the edge, or NULL.
+ * @options: A string with other edge options, or NULL.
+ *
+ * Print an edge from port PORT on node FROM to TO with label
+ * LABEL. If to is NULL, the destination is the NULL node, otherwise a
+ * memory node. If the port is NULL, the edge starts at the node, not
+ * a specific port on it. If label is NULL, no label is used. The
+ * options string, if non-NULL, is printed before the label.
+ *
+ * Returns: Nothing.
+ */
+static void print_edge(int indent_level, const void *from, const void *to, const char *port,
+                       const char *label, const char *options)
+{
+    indent(indent_level);
+    if (port) {
+        printf("m%04lx:%s -> ", PTR2ADDR(from), port);
+    } else {
+        printf("m%04lx -> ", PTR2ADDR(from));
+    }
+    if (to == NULL) {
+        printf("NULL");
+    } else {
+        printf("m%04lx", PTR2ADDR(to));
+    }
+    printf(" [");
+    if (options != NULL) {
+        printf("%s", options);
+    }
+    if (label != NULL) {
+        printf(" label=\"%s\"",label);
+    }
+    printf("]\n");
+}
+
+// Internal function to print the head node in dot format.
+static void print_head_node(int indent_level, const arena *a)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"<f>first\\n%04lx"
+            "|<c>current\\n%04lx|block_size\\n%zu|bytes\\n%zu|used\\n%zu\"]\n",
+            PTR2ADDR(a), PTR2ADDR(a->first), PTR2ADDR(a->current),
+            a->block_size, a->bytes, a->used);
+}
+
+// Internal function to print the first max_blocks blocks in dot
+// format, with the edges between them.
+static void print_blocks(int indent_level, const arena *a, int max_blocks)
+{
+    int i = 0;
+    const block *b;
+    for (b = a->first; b != NULL && i < max_blocks; b = b->next, i++) {
+        iprintf(indent_level, "m%04lx [shape=record label=\"size\\n%zu|used\\n%zu"
+                "|dirty\\n%zu|<n>next\\n%04lx\" xlabel=\"%04lx\"]\n", PTR2ADDR(b),
+                b->size, b->used, b->dirty, PTR2ADDR(b->next), PTR2ADDR(b));
+    }
+    i = 0;
+    for (b = a->first; b != NULL && i < max_blocks; b = b->next, i++) {
+        if (b->next != NULL && i + 1 < max_blocks) {
+            print_edge(indent_level, b, b->next, "n", NULL, NULL);
+        }
+    }
+}
+
+// Create an escaped version of the input string. The most common
+// control characters - newline, horizontal tab, backslash, and double
+// quote - are replaced by their escape sequence. The returned pointer
+// must be deallocated by the caller.
+static char *escape_chars(const char *s)
+{
+    int i, j;
+    int escaped = 0; // The number of chars that must be escaped.
+
+    // Count how many chars need to be escaped, i.e. how much longer
+    // the output string will be.
+    for (i = escaped = 0; s[i] != '\0'; i++) {
+        if (s[i] == '\n' || s[i] == '\t' || s[i] == '\\' || s[i] == '\"') {
+            escaped++;
+        }
+    }
+    // Allocate space for the escaped string. The variable i holds the input
+    // length, escaped how much the string will grow.
+    char *t = malloc(i + escaped + 1);
+
+    // Copy-and-escape loop
+    for (i = j = 0; s[i] != '\0'; i++) {
+        // Convert each control character by its escape sequence.
+        // Non-control characters are copied as-is.
+        switch (s[i]) {
+        case '\n': t[i+j] = '\\'; t[i+j+1] = 'n';  j++; break;
+        case '\t': t[i+j] = '\\'; t[i+j+1] = 't';  j++; break;
+        case '\\': t[i+j] = '\\'; t[i+j+1] = '\\'; j++; break;
+        case '\"': t[i+j] = '\\'; t[i+j+1] = '\"'; j++; break;
+        default:   t[i+j] = s[i]; break;
+        }
+    }
+    // Terminal the output string
+    t[i+j] = '\0';
+    return t;
+}
+
+/**
+ * arena_print_internal() - Print the internal structure of the arena in dot format.
+ * @a: Arena to print.
+ * @desc: String with a description/state of the arena, or NULL for no description.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the arena and prints code that shows its internal
+ * structure, i.e. the head and the chain of blocks.
+ *
+ * Returns: Nothing.
+ */
+void arena_print_internal(const arena *a, const char *desc, int indent_level)
+{
+    static int graph_number = 0;
+    graph_number++;
+    int il = indent_level;
+
+    if (indent_level == 0) {
+        // If this is the outermost datatype, start a graph...
+        printf("digraph ARENA_%d {\n", graph_number);
+
+        // Specify default shape and fontname
+        il++;
+        iprintf(il, "node [shape=rectangle fontname=\"Courier New\"]\n");
+        iprintf(il, "ranksep=0.01\n");
+    }
+
+    if (desc != NULL) {
+        // Escape the string before printout
+        char *escaped = escape_chars(desc);
+        // Use different names on inner description nodes
+        if (indent_level == 0) {
+            iprintf(il, "description [label=\"%s\"]\n", escaped);
+        } else {
+            iprintf(il, "cluster_arena_%d_description [label=\"%s\"]\n", graph_number,
+                    escaped);
+        }
+        // Return the memory used by the escaped string
+        free(escaped);
+    }
+
+    if (indent_level == 0) {
+        // Use a single "pointer" edge as a starting point for the
+        // outermost datatype
+        iprintf(il, "a [label=\"%04lx\" xlabel=\"a\"]\n", PTR2ADDR(a));
+        iprintf(il, "a -> m%04lx\n", PTR2ADDR(a));
+    }
+
+    // Print the subgraph to surround the arena content
+    iprintf(il, "subgraph cluster_arena_%d { label=\"Arena\"\n", graph_number);
+    il++;
+
+    // Output the head node and the blocks. Limit output to 20 blocks.
+    print_head_node(il, a);
+    print_blocks(il, a, 20);
+
+    // Close the subgraph
+    il--;
+    iprintf(il, "}\n");
+
+    // Output the edges from the head
+    if (a->first != NULL) {
+        print_edge(il, a, a->first, "f", "first", NULL);
+    }
+    if (a->current != NULL) {
+        print_edge(il, a, a->current, "c", "current", NULL);
+    }
+
+    if (indent_level == 0) {
+        // Termination of graph
+        printf("}\n");
+    }
+}
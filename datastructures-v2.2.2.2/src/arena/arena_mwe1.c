@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <arena.h>
+#include <table.h>
+#include <list.h>
+#include <queue.h>
+
+/*
+ * Minimum working example for arena.c. Handles three "requests", each
+ * with a table of words and their lengths, a list of the words in
+ * reverse order and a queue of the words in order. All containers of
+ * a request, and the word lengths, are allocated in one arena. The
+ * containers have no kill functions, so killing them does not visit
+ * their elements, and all their memory is returned by one call to
+ * arena_reset after each request.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+// Compare two keys (char *).
+int compare_strings(const void *k1, const void *k2)
+{
+    return strcmp(k1, k2);
+}
+
+// Print a string value.
+void print_string(const void *value)
+{
+    printf("\"%s\"", (const char *)value);
+}
+
+// Handle a request, i.e. a NULL-terminated array of words, with all
+// memory allocated from an arena.
+void handle_request(arena *a, const char **words)
+{
+    const allocator *alloc = arena_allocator(a);
+
+    table *t = table_empty_with_allocator(compare_strings, NULL, TABLE_KEY_STRING,
+                                          NULL, NULL, alloc);
+    list *l = list_empty_with_allocator(NULL, alloc);
+    queue *q = queue_empty_with_allocator(NULL, alloc);
+
+    for (int i = 0; words[i] != NULL; i++) {
+        // The words are constants, but their lengths are stored in
+        // the arena.
+        int *len = arena_allocate(a, sizeof(*len));
+        *len = strlen(words[i]);
+        table_insert(t, (void *)words[i], len);
+        list_insert(l, (void *)words[i], list_first(l));
+        q = queue_enqueue(q, (void *)words[i]);
+    }
+
+    printf("Words in reverse order: ");
+    list_print(l, print_string);
+    printf("The first word has %d letters.\n",
+           *(int *)table_lookup(t, queue_front(q)));
+
+    // The kills return at once, since the containers have no kill
+    // functions and the arena has no deallocate function.
+    table_kill(t);
+    list_kill(l);
+    queue_kill(q);
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Request-scoped containers in an arena.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    const char *requests[3][6] = {
+        { "the", "quick", "brown", "fox", NULL },
+        { "jumps", "over", NULL },
+        { "the", "lazy", "dog", "and", "runs", NULL },
+    };
+
+    arena *a = arena_create(0);
+
+    for (int r = 0; r < 3; r++) {
+        printf("Request %d:\n", r + 1);
+        handle_request(a, requests[r]);
+        printf("The request used %zu bytes of the arena.\n\n", arena_used(a));
+        // Return the memory of all containers of the request at once.
+        arena_reset(a);
+    }
+    printf("The arena holds %zu bytes for the next request.\n", arena_bytes(a));
+
+    arena_kill(a);
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <arena.h>
+
+/*
+ * Minimum working example for arena.c. Allocates a number of small
+ * and large blocks of memory from an arena with a small block size,
+ * and outputs dot/graphviz code to show the internal structure of the
+ * arena, i.e. its chain of blocks, before and after a reset.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+// Print cut lines before and after a call arena_print_internal.
+void print_internal_with_cut_lines(const arena *a, const char *desc)
+{
+    // Internal counter that will be remembered between calls.
+
+    // Used to generate sequentially numbered -- CUT HERE -- marker lines
+    // to enable automatic parsing of the output.
+    static int cut = 1;
+
+    // Print starting marker line.
+    printf("\n--- START CUT HERE %d ---\n", cut);
+
+    // Call the internal print function to get the actual dot code.
+    arena_print_internal(a, desc, 0);
+
+    // Print ending marker line
+    printf("--- END CUT HERE %d ---\n\n", cut);
+
+    // Increment the cut number. Will be remembered next time the
+    // function is called since cut is a static variable.
+    cut++;
+}
+
+// Print a message with intructions how to use the dot output. prog is
+// the name of the executable.
+void print_dot_usage(char *prog)
+{
+    printf("\nGenerate dot code to visualize internal structure with GraphViz. ");
+    printf("Use\n\n%s ", prog);
+    printf("| sed -n '/START CUT HERE X/,/END CUT HERE X/{//!p}' | dot -Tsvg > /tmp/dot.svg\n\n");
+    printf("to generate an svg file of cut X (replace X by the requested cut number).\n");
+    printf("The generated file can then be visualized with\n\n");
+    printf("firefox /tmp/dot.svg\n\n");
+    printf("Use -Tpng to generate a .png file instead. "
+           "See graphviz.org and %s for documentation.\n", __FILE__);
+
+    printf("\n--- Start of normal output ---\n\n");
+}
+
+int main(int argc, char *argv[])
+{
+    printf("%s, %s %s: Create an arena with 256-byte blocks.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    print_dot_usage(argv[0]);
+
+    arena *a = arena_create(256);
+
+    print_internal_with_cut_lines(a, __FILE__ ": Empty arena showing the inside structure.");
+
+    // Ten allocations of 40 bytes fill one block and part of another.
+    for (int i = 0; i < 10; i++) {
+        arena_allocate(a, 40);
+    }
+    // An allocation of more than a quarter of a block gets its own block.
+    arena_allocate(a, 100);
+
+    printf("%zu bytes used, %zu bytes in the arena.\n", arena_used(a), arena_bytes(a));
+    print_internal_with_cut_lines(a, __FILE__ ": Arena after 10 small and one large "
+                                  "allocation showing the inside structure.");
+
+    arena_reset(a);
+
+    printf("%zu bytes used, %zu bytes in the arena.\n", arena_used(a), arena_bytes(a));
+    print_internal_with_cut_lines(a, __FILE__ ": Arena after reset showing the "
+                                  "inside structure.");
+
+    arena_kill(a);
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
@@ -0,0 +1,437 @@
+/*
+ * arena_test - test the arena and containers created in an arena.
+ *
+ * Should be compiled together with the arena implementation that
+ * follows the interface in arena.h, and with the table, dlist, list,
+ * queue and stack implementations, of the code base for the
+ * Datastructures and Algorithms courses at the Department of
+ * Computing Science, Umea University.
+ *
+ * The program is modelled on cache_test. It first runs a number of
+ * correctness tests and then measures the cost of a request that
+ * builds a table, three lists and a queue and then destroys them,
+ * once with the containers on the heap and once with the containers
+ * in an arena that is reset after each request.
+ *
+ * 2026-10-18 v1.0  First public version.
+ * 2026-10-18 v1.1  The helpers shared with the other tests, and the
+ *                  monotonic clock of the timing, come from testutil.c.
+ * 2026-10-18 v1.2  Moved from ou3/arenatest.c to
+ *                  src/arena/arena_test.c.
+*/
+
+#define VERSION "v1.2"
+#define VERSION_DATE "2026-10-18"
+
+/*
+ * Correctness testing algorithm:
+ *
+ * 1. Tests that the memory of an arena is aligned, zero-initialized
+ *    and not shared between allocations, also for allocations larger
+ *    than a block, and that it is zero-initialized again after a
+ *    reset.
+ * 2. Tests that an arena reset after each request stops growing once
+ *    it has room for the largest request, also when the requests
+ *    have allocations larger than a quarter of a block.
+ * 3. Tests that a table, a dlist, a list, a queue and a stack created
+ *    in an arena hold their elements, and that their kill functions
+ *    are still called for each element when given.
+ *
+ * There is also a module measuring the time to build and to destroy
+ * the containers of a request.
+ * */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+#include "table.h"
+#include "dlist.h"
+#include "list.h"
+#include "queue.h"
+#include "stack.h"
+#include "testutil.h"
+
+// Maximum number of elements per request
+#define KEYSIZE 100000
+
+// The number of elements handled by all requests of a speed test
+// measurement together.
+#define TOTAL_ELEMENTS 2000000
+
+// The number of calls to count_kill.
+static int kill_count;
+
+// Kill function that counts the number of killed elements.
+void count_kill(void *p)
+{
+    kill_count++;
+}
+
+/* Tests the alignment, zero-initialization and separation of the
+ * memory of an arena, before and after a reset.
+ */
+void test_allocations()
+{
+    const size_t sizes[]={ 1, 7, 16, 33, 100, 1000, 5000 };
+    const int count=sizeof(sizes)/sizeof(sizes[0]);
+    unsigned char *p[3*7];
+    arena *a=arena_create(1024);
+
+    for(int round=0;round<2;round++) {
+        check_allocations(arena_allocator(a),sizes,count,p,round);
+        if (arena_used(a)<3*(1+7+16+33+100+1000+5000)) {
+            printf("The arena reports %zu bytes used, too few.\n",arena_used(a));
+            exit(EXIT_FAILURE);
+        }
+        arena_reset(a);
+        if (arena_used(a)!=0) {
+            printf("The arena reports %zu bytes used after reset.\n",
+                   arena_used(a));
+            exit(EXIT_FAILURE);
+        }
+    }
+    arena_kill(a);
+    printf("Allocations are aligned, zero-initialized and separate. - OK\n");
+}
+
+/* Builds the containers of a request with n elements in an arena,
+ * checks their content and kills them.
+ */
+void request_in_arena(arena *a, int *elements, int n)
+{
+    const allocator *alloc=arena_allocator(a);
+    table *t=table_empty_with_allocator(int_compare,NULL,TABLE_KEY_INT,NULL,NULL,alloc);
+    dlist *d=dlist_empty_with_allocator(NULL,alloc);
+    list *l=list_empty_with_allocator(NULL,alloc);
+    queue *q=queue_empty_with_allocator(NULL,alloc);
+    stack *s=stack_empty_with_allocator(NULL,alloc);
+
+    for(int i=0;i<n;i++) {
+        table_insert(t,&elements[i],&elements[n-1-i]);
+        dlist_insert(d,&elements[i],dlist_first(d));
+        list_insert(l,&elements[i],list_end(l));
+        q=queue_enqueue(q,&elements[i]);
+        s=stack_push(s,&elements[i]);
+    }
+    dlist_pos dp=dlist_first(d);
+    list_pos lp=list_first(l);
+    for(int i=0;i<n;i++) {
+        int *v=table_lookup(t,&elements[i]);
+        int *dv=dlist_inspect(d,dp);
+        int *lv=list_inspect(l,lp);
+        if (v==NULL || *v!=elements[n-1-i] || *dv!=elements[n-1-i]
+            || *lv!=elements[i] || *(int *)queue_front(q)!=elements[i]
+            || *(int *)stack_top(s)!=elements[n-1-i]) {
+            printf("Element %d of a request in an arena is wrong.\n",i);
+            exit(EXIT_FAILURE);
+        }
+        dp=dlist_next(d,dp);
+        lp=list_next(l,lp);
+        q=queue_dequeue(q);
+        s=stack_pop(s);
+    }
+    if (!queue_is_empty(q) || !stack_is_empty(s)) {
+        printf("A queue or stack in an arena is not empty.\n");
+        exit(EXIT_FAILURE);
+    }
+    table_kill(t);
+    dlist_kill(d);
+    list_kill(l);
+    queue_kill(q);
+    stack_kill(s);
+}
+
+/* Tests containers in an arena that is reset after each request, and
+ * that the arena stops growing.
+ */
+void test_requests()
+{
+    int elements[1000];
+    for(int i=0;i<1000;i++) {
+        elements[i]=i*7919%1000;
+    }
+    arena *a=arena_create(4096);
+    const int sizes[]={ 1000, 10, 500, 1000, 0, 999, 1000 };
+    size_t bytes=0;
+    for(int r=0;r<sizeof(sizes)/sizeof(sizes[0]);r++) {
+        request_in_arena(a,elements,sizes[r]);
+        if (r==0) {
+            bytes=arena_bytes(a);
+        } else if (arena_bytes(a)!=bytes) {
+            printf("The arena grew from %zu to %zu bytes for a request "
+                   "that is not larger than the first.\n",bytes,arena_bytes(a));
+            exit(EXIT_FAILURE);
+        }
+        arena_reset(a);
+    }
+    arena_kill(a);
+    printf("Containers in an arena reset after each request. - OK\n");
+}
+
+/* Tests that an arena reset after each request with an allocation
+ * larger than a quarter of a block reuses the large block, and that
+ * the reused memory is zero-initialized.
+ */
+void test_large_requests()
+{
+    arena *a=arena_create(0);
+    size_t bytes=0;
+    for(int r=0;r<1000;r++) {
+        unsigned char *large=arena_allocate(a,20000);
+        unsigned char *small=arena_allocate(a,100);
+        if (!is_zero(large,20000) || !is_zero(small,100)) {
+            printf("Memory reused after a reset is not "
+                   "zero-initialized.\n");
+            exit(EXIT_FAILURE);
+        }
+        memset(large,1,20000);
+        memset(small,1,100);
+        if (r==0) {
+            bytes=arena_bytes(a);
+        } else if (arena_bytes(a)!=bytes) {
+            printf("The arena grew from %zu to %zu bytes after %d "
+                   "resets.\n",bytes,arena_bytes(a),r);
+            exit(EXIT_FAILURE);
+        }
+        arena_reset(a);
+    }
+    arena_kill(a);
+    printf("Large allocations in an arena reset after each request. - OK\n");
+}
+
+/* Tests that the kill functions of containers in an arena are called.
+ */
+void test_kill_functions()
+{
+    int elements[100];
+    arena *a=arena_create(0);
+    const allocator *alloc=arena_allocator(a);
+
+    kill_count=0;
+    table *t=table_empty_with_allocator(int_compare,NULL,TABLE_KEY_INT,
+                                        count_kill,count_kill,alloc);
+    dlist *d=dlist_empty_with_allocator(count_kill,alloc);
+    list *l=list_empty_with_allocator(count_kill,alloc);
+    queue *q=queue_empty_with_allocator(count_kill,alloc);
+    stack *s=stack_empty_with_allocator(count_kill,alloc);
+    for(int i=0;i<100;i++) {
+        elements[i]=i;
+        table_insert(t,&elements[i],&elements[i]);
+        dlist_insert(d,&elements[i],dlist_first(d));
+        list_insert(l,&elements[i],list_first(l));
+        q=queue_enqueue(q,&elements[i]);
+        s=stack_push(s,&elements[i]);
+    }
+    table_kill(t);
+    dlist_kill(d);
+    list_kill(l);
+    queue_kill(q);
+    stack_kill(s);
+    if (kill_count!=6*100) {
+        printf("The kill functions were called %d times, expected %d.\n",
+               kill_count,6*100);
+        exit(EXIT_FAILURE);
+    }
+    arena_kill(a);
+    printf("Kill functions of containers in an arena are called. - OK\n");
+}
+
+/*  Tests the arena by performing a set of tests. Program exits if any
+ *  error is found.
+ */
+void correctness_test()
+{
+    test_allocations();
+    test_requests();
+    test_large_requests();
+    test_kill_functions();
+}
+
+// The containers of a request in the speed test.
+typedef struct request {
+    table *t;
+    list *l[3];
+    queue *q;
+} request;
+
+/* Builds the containers of a request with n elements, using the
+ * allocator alloc, or the heap if alloc is NULL.
+ */
+void build_request(request *r, int *elements, int n, const allocator *alloc)
+{
+    r->t=table_empty_with_allocator(int_compare,NULL,TABLE_KEY_INT,NULL,NULL,alloc);
+    for(int j=0;j<3;j++) {
+        r->l[j]=list_empty_with_allocator(NULL,alloc);
+    }
+    r->q=queue_empty_with_allocator(NULL,alloc);
+    for(int i=0;i<n;i++) {
+        table_insert(r->t,&elements[i],&elements[i]);
+        for(int j=0;j<3;j++) {
+            list_insert(r->l[j],&elements[i],list_first(r->l[j]));
+        }
+        r->q=queue_enqueue(r->q,&elements[i]);
+    }
+}
+
+/* Destroys the containers of a request.
+ */
+void kill_request(request *r)
+{
+    table_kill(r->t);
+    for(int j=0;j<3;j++) {
+        list_kill(r->l[j]);
+    }
+    queue_kill(r->q);
+}
+
+/* Prints one line of the speed test.
+ *    id - the id of the measurement in the machine-readable table
+ *    name - the name of the allocation mode
+ *    n - the number of elements per request
+ *    requests - the number of requests
+ *    build_us - the time to build the containers of all requests
+ *    teardown_us - the time to destroy the containers of all requests
+ *    machine_table - true if we should output a machine-readable table
+ */
+void print_speed(int id, const char *name, int n, int requests, unsigned long build_us,
+                 unsigned long teardown_us, bool machine_table)
+{
+    double build_ns=1000.0*build_us/requests;
+    double teardown_ns=1000.0*teardown_us/requests;
+    if (machine_table) {
+        printf("%d, %d, %lu, %.1f, %.1f\n",id,n,teardown_us/1000,
+               build_ns,teardown_ns);
+    } else {
+        printf("%-6s: %10.0f ns/request to build, %10.0f ns/request "
+               "to destroy\n",name,build_ns,teardown_ns);
+    }
+}
+
+/* Measures the time to build and destroy the containers of requests
+ * with n elements each, on the heap and in an arena.
+ *    id - the id of the first measurement in the machine-readable table
+ *    n - the number of elements per request
+ *    machine_table - true if we should output a machine-readable table
+ */
+void get_speed(int id, int n, bool machine_table)
+{
+    int *elements=malloc(n*sizeof(int));
+    for(int i=0;i<n;i++) {
+        elements[i]=rand();
+    }
+    int requests=TOTAL_ELEMENTS/n;
+    if (!machine_table) {
+        printf("\n%d requests with %d elements each:\n",requests,n);
+    }
+
+    // The containers on the heap, killed one by one.
+    unsigned long build_us=0, teardown_us=0;
+    for(int k=0;k<requests;k++) {
+        request r;
+        unsigned long start=get_microseconds();
+        build_request(&r,elements,n,NULL);
+        unsigned long middle=get_microseconds();
+        kill_request(&r);
+        unsigned long end=get_microseconds();
+        build_us+=middle-start;
+        teardown_us+=end-middle;
+    }
+    print_speed(id,"heap",n,requests,build_us,teardown_us,machine_table);
+
+    // The containers in an arena, returned with one reset. The
+    // kills are kept, as a program that does not know where its
+    // containers are would call them.
+    arena *a=arena_create(0);
+    build_us=teardown_us=0;
+    for(int k=0;k<requests;k++) {
+        request r;
+        unsigned long start=get_microseconds();
+        build_request(&r,elements,n,arena_allocator(a));
+        unsigned long middle=get_microseconds();
+        kill_request(&r);
+        arena_reset(a);
+        unsigned long end=get_microseconds();
+        build_us+=middle-start;
+        teardown_us+=end-middle;
+    }
+    print_speed(id+1,"arena",n,requests,build_us,teardown_us,machine_table);
+    arena_kill(a);
+
+    free(elements);
+}
+
+/* Tests the time to build and destroy the containers of requests of
+ * different sizes up to n elements. The machine-readable table has
+ * the columns id, elements per request, total teardown time in ms,
+ * build time per request in ns and teardown time per request in ns.
+ * The ids come in pairs: the heap and the arena.
+ */
+void speed_test(int n,bool machine_table)
+{
+    int id=1;
+    for(int size=10;size<=n;size*=10) {
+        get_speed(id,size,machine_table);
+        id+=2;
+    }
+}
+
+#define NAME "arena_test"
+
+int main(int argc,char **argv)
+{
+    bool do_test=true; // Should we run the testing code?
+    bool machine_table=false; // Should we output a machine-readable table?
+    int n=-1;
+
+    fprintf(stderr,NAME " " VERSION " (" VERSION_DATE ")\n");
+    fprintf(stderr, "Code base version %s.\n\n", CODE_BASE_VERSION);
+
+    for (int i=1; i<argc; i++) {
+        // Parse each argument
+        char *s=argv[i];
+        if (strlen(s)>0 && s[0]=='-') {
+            switch (s[1]) {
+            case 'n':
+                do_test=false;
+                break;
+            case 't':
+                machine_table=true;
+                break;
+            default:
+                fprintf(stderr,"%s: Bad switch: %s.\n",
+                        argv[0],s);
+                exit(EXIT_FAILURE);
+            }
+        } else {
+            // Convert string to integer.
+            n=atoi(s);
+            break;
+        }
+    }
+
+    if (n<0) {
+        fprintf(stderr,"Usage:\n\t%s [-n] [-t] n\n"
+                "\twhere n is the largest number of elements per request, "
+                "an integer from 10 to %d.\n\n"
+                "\tUse -n (no-test) to skip the testing.\n"
+                "\tUse -t (table) to output a machine-readable table with the timings.\n",
+                argv[0],KEYSIZE);
+        exit(EXIT_FAILURE);
+    }
+    if (n<10 || n>KEYSIZE) {
+        fprintf(stderr,"Error: supplied value of n (%d) is outside "
+                "allowed range 10-%d.\n",n,KEYSIZE);
+        exit(EXIT_FAILURE);
+    }
+    if (do_test) {
+        printf("Testing...\n");
+        correctness_test();
+        printf("All correctness tests succeeded!\n\n");
+    }
+    speed_test(n,machine_table);
+    if (!machine_table) {
+        printf("Test completed.\n");
+    }
+    return 0;
+}
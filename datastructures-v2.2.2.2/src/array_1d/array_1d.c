@@ -19,6 +19,7 @@
  *   v1.0  2018-01-28: First public version.
  *   v1.5  2024-03-13: Renamed free_* stuff to kill_*. Converted to 4-tabs.
  *   v2.0  2024-05-10: Added print_internal.
+ *   v2.1  2026-10-18: Added array_1d_create_with_allocator.
  */
 
 // =========== INTERNAL DATA TYPES ============
@@ -29,6 +30,7 @@ struct array_1d {
     int array_size; // Number of array elements.
     void **values; // Pointer to where the actual values are stored.
     kill_function kill_func;
+    const allocator *alloc; // Allocator for the array
 };
 
 // =========== INTERNAL FUNCTION IMPLEMENTATIONS ============
@@ -48,8 +50,32 @@ struct array_1d {
  */
 array_1d *array_1d_create(int lo, int hi, kill_function kill_func)
 {
+    return array_1d_create_with_allocator(lo, hi, kill_func, NULL);
+}
+
+/**
+ * array_1d_create_with_allocator() - Create an array with a given allocator.
+ * @lo: low index limit.
+ * @hi: high index limit.
+ * @kill_func: A pointer to a function (or NULL) to be called to
+ *             de-allocate memory on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the
+ *         array. Must remain valid until the array is killed.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_1d *array_1d_create_with_allocator(int lo, int hi, kill_function kill_func,
+                                         const allocator *alloc)
+{
+    if (alloc == NULL) {
+        alloc = default_allocator();
+    }
     // Allocate array structure.
-    array_1d *a = calloc(1, sizeof(*a));
+    array_1d *a = alloc->allocate(alloc->context, sizeof(*a));
+    if (a == NULL) {
+        return NULL;
+    }
     // Store index limit.
     a->low = lo;
     a->high = hi;
@@ -57,14 +83,15 @@ array_1d *array_1d_create(int lo, int hi, kill_function kill_func)
     // Number of elements.
     a->array_size = hi - lo + 1;
 
-    // Store kill function.
+    // Store kill function and allocator.
     a->kill_func = kill_func;
+    a->alloc = alloc;
 
-    a->values = calloc(a->array_size, sizeof(void *));
+    a->values = alloc->allocate(alloc->context, a->array_size * sizeof(void *));
 
     // Check whether the allocation succeeded.
     if (a->values == NULL) {
-        free(a);
+        allocator_deallocate(alloc, a, sizeof(*a));
         a = NULL;
     }
     return a;
@@ -163,9 +190,9 @@ void array_1d_kill(array_1d *a)
         }
     }
     // Return memory for value pointers.
-    free(a->values);
+    allocator_deallocate(a->alloc, a->values, a->array_size * sizeof(void *));
     // Return memory for array structure.
-    free(a);
+    allocator_deallocate(a->alloc, a, sizeof(*a));
 }
 
 /**
@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <array_2d.h>
+#include "bench.h"
+
+/*
+ * Benchmark for array_2d.c. The n elements fill the rows of an array
+ * with about sqrt(n) columns, where the last row may be partly empty.
+ * Times setting the elements row by row, and inspecting them row by
+ * row and column by column, with the harness of ../bench/bench.h.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First public version.
+ */
+
+// The sum of the inspected values, so the reads are not optimized away.
+static volatile long sink;
+
+// The shape of an array with n elements: rows full rows of cols
+// elements, and a last row with rest elements.
+typedef struct shape {
+    int rows;
+    int cols;
+    int rest;
+} shape;
+
+// Return the shape of an array with n elements.
+static shape shape_of(int n)
+{
+    shape s;
+    s.cols = (int)sqrt((double)n);
+    s.rows = n / s.cols;
+    s.rest = n - s.rows * s.cols;
+    return s;
+}
+
+// Create an empty array with room for the shape.
+static array_2d *empty_array(shape s)
+{
+    return array_2d_create(0, s.rows - (s.rest == 0), 0, s.cols - 1, NULL);
+}
+
+// Create an array with the values 0..n-1, for the array_2d to point to.
+static int *make_values(int n)
+{
+    int *values = malloc(n * sizeof(values[0]));
+    for (int i = 0; i < n; i++) {
+        values[i] = i;
+    }
+    return values;
+}
+
+// Set the n elements of an array row by row.
+static void set_rows(array_2d *a, int *values, shape s)
+{
+    int k = 0;
+    for (int i = 0; i < s.rows; i++) {
+        for (int j = 0; j < s.cols; j++) {
+            array_2d_set_value(a, &values[k++], i, j);
+        }
+    }
+    for (int j = 0; j < s.rest; j++) {
+        array_2d_set_value(a, &values[k++], s.rows, j);
+    }
+}
+
+// Time setting the n elements of an empty array, row by row.
+static unsigned long long time_set(int n)
+{
+    shape s = shape_of(n);
+    int *values = make_values(n);
+    array_2d *a = empty_array(s);
+    unsigned long long start = bench_nanoseconds();
+    set_rows(a, values, s);
+    unsigned long long end = bench_nanoseconds();
+    array_2d_kill(a);
+    free(values);
+    return end - start;
+}
+
+// Time inspecting the n elements of an array, row by row.
+static unsigned long long time_get_rows(int n)
+{
+    shape s = shape_of(n);
+    int *values = make_values(n);
+    array_2d *a = empty_array(s);
+    set_rows(a, values, s);
+    long sum = 0;
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < s.rows; i++) {
+        for (int j = 0; j < s.cols; j++) {
+            sum += *(int *)array_2d_inspect_value(a, i, j);
+        }
+    }
+    for (int j = 0; j < s.rest; j++) {
+        sum += *(int *)array_2d_inspect_value(a, s.rows, j);
+    }
+    unsigned long long end = bench_nanoseconds();
+    sink = sum;
+    array_2d_kill(a);
+    free(values);
+    return end - start;
+}
+
+// Time inspecting the n elements of an array, column by column.
+static unsigned long long time_get_columns(int n)
+{
+    shape s = shape_of(n);
+    int *values = make_values(n);
+    array_2d *a = empty_array(s);
+    set_rows(a, values, s);
+    long sum = 0;
+    unsigned long long start = bench_nanoseconds();
+    for (int j = 0; j < s.cols; j++) {
+        // The first rest columns have an element in the last row.
+        int rows = j < s.rest ? s.rows + 1 : s.rows;
+        for (int i = 0; i < rows; i++) {
+            sum += *(int *)array_2d_inspect_value(a, i, j);
+        }
+    }
+    unsigned long long end = bench_nanoseconds();
+    sink = sum;
+    array_2d_kill(a);
+    free(values);
+    return end - start;
+}
+
+static const bench_phase phases[] = {
+    { "set", time_set },
+    { "get_rows", time_get_rows },
+    { "get_columns", time_get_columns },
+};
+
+int main(int argc, char *argv[])
+{
+    return bench_main("array_2d", phases, sizeof(phases) / sizeof(phases[0]),
+                      argc, argv);
+}
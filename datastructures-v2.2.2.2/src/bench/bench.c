@@ -0,0 +1,203 @@
+// clock_gettime is a POSIX function.
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "bench.h"
+
+/*
+ * Implementation of a small harness for the benchmarks of the
+ * containers of the code base for the "Datastructures and algorithms"
+ * courses at the Department of Computing Science, Umea University.
+ *
+ * Must be linked with -lm.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// ===========INTERNAL DATA TYPES ============
+
+// The default sizes.
+static const int default_sizes[] = { 1000, 10000, 100000 };
+
+#define DEFAULT_SIZE_COUNT ((int)(sizeof(default_sizes) / sizeof(default_sizes[0])))
+
+// Statistics of the timed runs of a phase, in nanoseconds.
+typedef struct stats {
+    double min;
+    double median;
+    double mean;
+    double stddev;
+} stats;
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+// Compare two times, for qsort.
+static int time_compare(const void *p1, const void *p2)
+{
+    unsigned long long t1 = *(const unsigned long long *)p1;
+    unsigned long long t2 = *(const unsigned long long *)p2;
+    return (t1 > t2) - (t1 < t2);
+}
+
+/**
+ * compute_stats() - Compute the statistics of the times of the runs.
+ * @times: The times in nanoseconds. They are sorted.
+ * @reps: The number of times, at least 1.
+ *
+ * Returns: The statistics, with the sample standard deviation.
+ */
+static stats compute_stats(unsigned long long *times, int reps)
+{
+    stats s;
+    qsort(times, reps, sizeof(times[0]), time_compare);
+    s.min = times[0];
+    if (reps % 2 == 1) {
+        s.median = times[reps / 2];
+    } else {
+        s.median = (times[reps / 2 - 1] + (double)times[reps / 2]) / 2;
+    }
+    double sum = 0;
+    for (int i = 0; i < reps; i++) {
+        sum += times[i];
+    }
+    s.mean = sum / reps;
+    double squares = 0;
+    for (int i = 0; i < reps; i++) {
+        squares += (times[i] - s.mean) * (times[i] - s.mean);
+    }
+    s.stddev = reps > 1 ? sqrt(squares / (reps - 1)) : 0;
+    return s;
+}
+
+/**
+ * run_phase() - Run a phase for one size and print its line.
+ * @impl: The name of the container.
+ * @p: The phase.
+ * @n: The size.
+ * @warmups: The number of untimed runs.
+ * @times: Room for the times of the timed runs.
+ * @reps: The number of timed runs.
+ *
+ * Returns: Nothing.
+ */
+static void run_phase(const char *impl, const bench_phase *p, int n,
+                      int warmups, unsigned long long *times, int reps)
+{
+    for (int i = 0; i < warmups; i++) {
+        p->run(n);
+    }
+    for (int i = 0; i < reps; i++) {
+        times[i] = p->run(n);
+    }
+    stats s = compute_stats(times, reps);
+    printf("%s, %s, %d, %.6f, %.6f, %.6f, %.6f, %.2f\n", impl, p->name, n,
+           s.median / 1e6, s.min / 1e6, s.mean / 1e6, s.stddev / 1e6,
+           s.median / n);
+    // Keep the lines in order with the output of other programs.
+    fflush(stdout);
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * bench_nanoseconds() - Return the time of the monotonic clock.
+ *
+ * Returns: The time of the monotonic clock in nanoseconds.
+ */
+unsigned long long bench_nanoseconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * bench_shuffled() - Create a random permutation of 0..n-1.
+ * @n: The number of numbers.
+ *
+ * The permutation is the same in every run, so that all runs access
+ * the elements in the same order. The caller must free the array.
+ *
+ * Returns: A dynamic array with the numbers 0..n-1 in random order.
+ */
+int *bench_shuffled(int n)
+{
+    int *a = malloc(n * sizeof(a[0]));
+    for (int i = 0; i < n; i++) {
+        a[i] = i;
+    }
+    // Fisher-Yates shuffle with a fixed xorshift64* generator.
+    unsigned long long x = 0x9e3779b97f4a7c15ULL;
+    for (int i = n - 1; i > 0; i--) {
+        x ^= x >> 12;
+        x ^= x << 25;
+        x ^= x >> 27;
+        int j = (x * 0x2545f4914f6cdd1dULL >> 33) % (i + 1);
+        int tmp = a[i];
+        a[i] = a[j];
+        a[j] = tmp;
+    }
+    return a;
+}
+
+/**
+ * bench_main() - Run the phases of a benchmark and print the results.
+ * @impl: The name of the container, printed first on each line.
+ * @phases: The phases, run in order for each size.
+ * @count: The number of phases.
+ * @argc, @argv: The arguments of the program.
+ *
+ * Returns: The exit status of the program.
+ */
+int bench_main(const char *impl, const bench_phase phases[], int count,
+               int argc, char *argv[])
+{
+    int reps = 5;
+    int warmups = 1;
+    int first_size = argc;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            reps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            warmups = atoi(argv[++i]);
+        } else if (argv[i][0] != '-') {
+            first_size = i;
+            break;
+        } else {
+            fprintf(stderr, "Usage: %s [-r reps] [-w warmups] [n ...]\n",
+                    argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (reps < 1 || warmups < 0) {
+        fprintf(stderr, "%s: Need at least one timed run and no negative "
+                "number of warm-up runs.\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    for (int i = first_size; i < argc; i++) {
+        if (atoi(argv[i]) < 1) {
+            fprintf(stderr, "%s: Bad size: %s.\n", argv[0], argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    unsigned long long *times = malloc(reps * sizeof(times[0]));
+    printf("# impl, phase, n, median_ms, min_ms, mean_ms, stddev_ms, "
+           "median_ns_per_op\n");
+    int size_count = first_size < argc ? argc - first_size : DEFAULT_SIZE_COUNT;
+    for (int i = 0; i < size_count; i++) {
+        int n = first_size < argc ? atoi(argv[first_size + i]) : default_sizes[i];
+        for (int k = 0; k < count; k++) {
+            run_phase(impl, &phases[k], n, warmups, times, reps);
+        }
+    }
+    free(times);
+    return EXIT_SUCCESS;
+}
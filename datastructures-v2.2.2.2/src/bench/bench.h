@@ -0,0 +1,75 @@
+#ifndef __BENCH_H
+#define __BENCH_H
+
+/*
+ * Declaration of a small harness for the benchmarks of the containers
+ * of the code base for the "Datastructures and algorithms" courses at
+ * the Department of Computing Science, Umea University.
+ *
+ * Each benchmark program, e.g. list/list_bench.c, is compiled together
+ * with bench.c and hands a list of phases to bench_main. Each phase is
+ * run for a number of sizes n, first a number of untimed warm-up runs
+ * and then a number of timed runs. Each phase performs n operations,
+ * and one line is printed for each phase and size, in the format of
+ * the sweeps of ou3/tabletest:
+ *
+ *   impl, phase, n, median_ms, min_ms, mean_ms, stddev_ms, median_ns_per_op
+ *
+ * The lines are preceded by a comment line, starting with #, with the
+ * names of the columns. The programs take the arguments
+ *
+ *   [-r reps] [-w warmups] [n ...]
+ *
+ * with 5 timed runs, 1 warm-up run and the sizes 1000, 10000 and
+ * 100000 by default.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// A timed phase of a benchmark. It builds what it needs for n
+// elements, performs n timed operations, cleans up, and returns the
+// time of the timed operations in nanoseconds.
+typedef unsigned long long bench_function(int n);
+
+// A named phase of a benchmark.
+typedef struct bench_phase {
+    const char *name;
+    bench_function *run;
+} bench_phase;
+
+// ==========PUBLIC FUNCTIONS============
+
+/**
+ * bench_nanoseconds() - Return the time of the monotonic clock.
+ *
+ * Returns: The time of the monotonic clock in nanoseconds.
+ */
+unsigned long long bench_nanoseconds(void);
+
+/**
+ * bench_shuffled() - Create a random permutation of 0..n-1.
+ * @n: The number of numbers.
+ *
+ * The permutation is the same in every run, so that all runs access
+ * the elements in the same order. The caller must free the array.
+ *
+ * Returns: A dynamic array with the numbers 0..n-1 in random order.
+ */
+int *bench_shuffled(int n);
+
+/**
+ * bench_main() - Run the phases of a benchmark and print the results.
+ * @impl: The name of the container, printed first on each line.
+ * @phases: The phases, run in order for each size.
+ * @count: The number of phases.
+ * @argc, @argv: The arguments of the program.
+ *
+ * Returns: The exit status of the program.
+ */
+int bench_main(const char *impl, const bench_phase phases[], int count,
+               int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,1165 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#include <cache.h>
+#include <queue.h>
+
+/*
+ * Implementation of a generic, bounded cache for the "Datastructures
+ * and algorithms" courses at the Department of Computing Science,
+ * Umea University.
+ *
+ * Each key/value pair is stored in an entry. All entries are linked
+ * into a hash index, i.e. an array of buckets where each bucket is a
+ * singly linked chain of entries. The capacity is fixed, so the
+ * number of buckets is chosen once as the smallest power of two that
+ * is at least twice the capacity, to leave room for ghost entries
+ * (see below). In addition, each entry is kept in the
+ * structure used by the eviction policy:
+ *
+ * - LRU: A recency list, i.e. a circular doubly linked list ordered
+ *   from the most recently used to the least recently used entry. As
+ *   in dlist.c, the list has a head cell without a value. The links
+ *   are stored in the entries themselves, so a hit moves an entry to
+ *   the front without any allocation.
+ *
+ * - CLOCK: An array of slots with one reference bit per slot. A hit
+ *   sets the bit. To evict, the clock hand sweeps over the slots and
+ *   clears the bits until it finds a slot whose bit is not set. A
+ *   removed entry is replaced by the entry in the last slot.
+ *
+ * - 2Q: New entries are put in a FIFO queue (A1in). When an entry is
+ *   evicted from A1in, its key hash is remembered in a FIFO queue of
+ *   ghost entries (A1out). A key that is put again while it has a
+ *   ghost goes into the recency list (Am) instead. Entries are
+ *   evicted from A1in while it holds more than a quarter of the
+ *   capacity, otherwise from Am.
+ *
+ * - S3-FIFO: New entries are put in a small FIFO queue (S) holding a
+ *   tenth of the capacity, and the other entries in a main FIFO queue
+ *   (M). Each entry has a frequency counter, from 0 to 3, that a hit
+ *   increments. An entry leaving S with a frequency above 1 moves to
+ *   M, otherwise it is evicted and gets a ghost entry (G). An entry
+ *   leaving M with a non-zero frequency is put back into M with a
+ *   decremented frequency. A key with a ghost goes directly into M.
+ *
+ * The FIFO queues are queues from queue.h. A queue only supports
+ * removal at the front, so an entry removed from the middle of a
+ * queue is marked as dead and deallocated when it reaches the front.
+ * The queues are compacted if the number of dead entries exceeds the
+ * capacity. A ghost entry has no key, so it matches any key with the
+ * same hash.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: Added the CLOCK, 2Q and S3-FIFO eviction policies.
+ */
+
+// Maximum value of the frequency counter of the S3-FIFO policy.
+#define MAX_FREQ 3
+
+// ===========INTERNAL DATA TYPES ============
+
+// Where an entry is kept, apart from the hash index.
+typedef enum entry_place {
+    IN_NONE,  // Detached, about to be removed
+    IN_LIST,  // In the recency list
+    IN_SLOT,  // In a CLOCK slot
+    IN_SMALL, // In the small queue (A1in or S)
+    IN_LARGE, // In the main queue (M)
+    IN_GHOST, // In the ghost queue (A1out or G)
+    DEAD      // Removed, but still in a queue
+} entry_place;
+
+typedef struct cache_entry {
+    struct cache_entry *prev;  // Previous entry in the recency list
+    struct cache_entry *next;  // Next entry in the recency list
+    struct cache_entry *chain; // Next entry in the same bucket
+    void *key;
+    void *value;
+    unsigned long hash;        // Cached hash of the key
+    entry_place place;
+    int slot;                  // Slot index of the CLOCK policy
+    int freq;                  // Frequency counter of the S3-FIFO policy
+} cache_entry;
+
+struct cache {
+    cache_policy policy;
+    int capacity;          // Maximum number of entries
+    int size;              // Number of entries, excluding ghosts
+    int bucket_count;      // Number of buckets, a power of two
+    cache_entry **buckets; // Chains of entries with the same bucket
+    cache_entry head;      // Head of the recency list, head.next is the most recent
+    cache_entry **slots;   // The slots of the CLOCK policy...
+    unsigned char *ref_bits; // ...their reference bits...
+    int hand;              // ...and the position of the clock hand
+    queue *small;          // A1in or S
+    queue *large;          // M
+    queue *ghosts;         // A1out or G
+    int small_size;        // Number of live entries in small...
+    int large_size;        // ...large...
+    int ghost_size;        // ...and ghosts
+    int small_capacity;    // Target size of small
+    int ghost_capacity;    // Maximum size of ghosts
+    int dead_count;        // Number of dead entries in the queues
+    long hits;             // Number of cache_get calls that found the key
+    long misses;           // Number of cache_get calls that did not
+    compare_function *key_cmp_func;
+    hash_function *key_hash_func;
+    kill_function key_kill_func;
+    kill_function value_kill_func;
+    inspect_callback_pair evict_func; // Called for evicted pairs, or NULL
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * mix() - Scramble the bits of a 64-bit value.
+ * @x: Value to scramble.
+ *
+ * Uses the finalizer of the splitmix64 generator, so that the low
+ * bits used to select a bucket depend on all bits of the hash.
+ *
+ * Returns: The scrambled value.
+ */
+static unsigned long long mix(unsigned long long x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Internal function to return the bucket chain of a hash value.
+static cache_entry **bucket_of(const cache *c, unsigned long hash)
+{
+    return &c->buckets[mix(hash) & (c->bucket_count - 1)];
+}
+
+/**
+ * find_link() - Find the link to the entry with a given key.
+ * @c: Cache to inspect.
+ * @key: Key to look for.
+ * @hash: The hash of the key.
+ *
+ * Ghost entries are skipped.
+ *
+ * Returns: A pointer to the link in the bucket chain that points to
+ * the entry with the key, or to the NULL link ending the chain if the
+ * key is not found.
+ */
+static cache_entry **find_link(const cache *c, const void *key, unsigned long hash)
+{
+    cache_entry **link = bucket_of(c, hash);
+    while (*link != NULL) {
+        cache_entry *e = *link;
+        if (e->place != IN_GHOST && e->hash == hash
+            && c->key_cmp_func(e->key, key) == 0) {
+            break;
+        }
+        link = &e->chain;
+    }
+    return link;
+}
+
+// Internal function to find the link to a given entry in its bucket chain.
+static cache_entry **entry_link(const cache *c, const cache_entry *e)
+{
+    cache_entry **link = bucket_of(c, e->hash);
+    while (*link != e) {
+        link = &(*link)->chain;
+    }
+    return link;
+}
+
+// Internal function to unlink an entry from the recency list.
+static void list_unlink(cache_entry *e)
+{
+    e->prev->next = e->next;
+    e->next->prev = e->prev;
+}
+
+// Internal function to link an entry first in the recency list.
+static void list_push_front(cache *c, cache_entry *e)
+{
+    e->prev = &c->head;
+    e->next = c->head.next;
+    c->head.next->prev = e;
+    c->head.next = e;
+    e->place = IN_LIST;
+}
+
+// Internal function to put an entry in a given CLOCK slot.
+static void slot_append(cache *c, cache_entry *e, int slot)
+{
+    c->slots[slot] = e;
+    c->ref_bits[slot] = 0;
+    e->slot = slot;
+    e->place = IN_SLOT;
+}
+
+/**
+ * slot_remove() - Remove an entry from its CLOCK slot.
+ * @c: Cache to manipulate.
+ * @e: Entry to remove.
+ *
+ * The entry in the last slot is moved to the free slot, so the used
+ * slots stay packed. The size of the cache is not yet decremented.
+ *
+ * Returns: Nothing.
+ */
+static void slot_remove(cache *c, cache_entry *e)
+{
+    int last = c->size - 1;
+    if (e->slot != last) {
+        unsigned char ref = c->ref_bits[last];
+        slot_append(c, c->slots[last], e->slot);
+        c->ref_bits[e->slot] = ref;
+    }
+    c->slots[last] = NULL;
+    if (c->hand >= last) {
+        c->hand = 0;
+    }
+}
+
+// Internal function to put an entry last in a queue.
+static void queue_put(cache *c, cache_entry *e, entry_place place)
+{
+    e->place = place;
+    if (place == IN_SMALL) {
+        c->small = queue_enqueue(c->small, e);
+        c->small_size++;
+    } else if (place == IN_LARGE) {
+        c->large = queue_enqueue(c->large, e);
+        c->large_size++;
+    } else {
+        c->ghosts = queue_enqueue(c->ghosts, e);
+        c->ghost_size++;
+    }
+}
+
+/**
+ * queue_take() - Take the first live entry from a queue.
+ * @c: Cache to manipulate.
+ * @q: The queue, i.e. small, large or ghosts.
+ *
+ * Dead entries before the first live entry are deallocated.
+ *
+ * Returns: The detached entry, or NULL if there are no live entries.
+ */
+static cache_entry *queue_take(cache *c, queue *q)
+{
+    while (!queue_is_empty(q)) {
+        cache_entry *e = queue_front(q);
+        queue_dequeue(q);
+        if (e->place == DEAD) {
+            free(e);
+            c->dead_count--;
+            continue;
+        }
+        if (e->place == IN_SMALL) {
+            c->small_size--;
+        } else if (e->place == IN_LARGE) {
+            c->large_size--;
+        } else {
+            c->ghost_size--;
+        }
+        e->place = IN_NONE;
+        return e;
+    }
+    return NULL;
+}
+
+// Internal function to deallocate the dead entries of a queue and keep
+// the order of the live entries.
+static void queue_compact(cache *c, queue *q)
+{
+    // A NULL element marks the end of the original queue.
+    q = queue_enqueue(q, NULL);
+    while (queue_front(q) != NULL) {
+        cache_entry *e = queue_front(q);
+        queue_dequeue(q);
+        if (e->place == DEAD) {
+            free(e);
+            c->dead_count--;
+        } else {
+            queue_enqueue(q, e);
+        }
+    }
+    queue_dequeue(q);
+}
+
+/**
+ * mark_dead() - Mark an entry in a queue as removed.
+ * @c: Cache to manipulate.
+ * @e: Entry to mark.
+ *
+ * The entry is deallocated when it reaches the front of its queue, or
+ * when the queues are compacted.
+ *
+ * Returns: Nothing.
+ */
+static void mark_dead(cache *c, cache_entry *e)
+{
+    if (e->place == IN_SMALL) {
+        c->small_size--;
+    } else if (e->place == IN_LARGE) {
+        c->large_size--;
+    } else {
+        c->ghost_size--;
+    }
+    e->place = DEAD;
+    e->key = NULL;
+    e->value = NULL;
+    c->dead_count++;
+
+    if (c->dead_count > c->capacity) {
+        queue_compact(c, c->small);
+        queue_compact(c, c->large);
+        queue_compact(c, c->ghosts);
+    }
+}
+
+/**
+ * remove_entry() - Remove an entry from a cache.
+ * @c: Cache to manipulate.
+ * @e: Entry to remove, not a ghost.
+ * @evicted: If true, call the evict callback before the kill functions.
+ *
+ * Returns: Nothing.
+ */
+static void remove_entry(cache *c, cache_entry *e, bool evicted)
+{
+    cache_entry **link = entry_link(c, e);
+    *link = e->chain;
+
+    if (evicted && c->evict_func != NULL) {
+        c->evict_func(e->key, e->value);
+    }
+    if (c->key_kill_func != NULL) {
+        c->key_kill_func(e->key);
+    }
+    if (c->value_kill_func != NULL) {
+        c->value_kill_func(e->value);
+    }
+
+    if (e->place == IN_LIST) {
+        list_unlink(e);
+    } else if (e->place == IN_SLOT) {
+        slot_remove(c, e);
+    }
+    c->size--;
+    if (e->place == IN_SMALL || e->place == IN_LARGE) {
+        mark_dead(c, e);
+    } else {
+        free(e);
+    }
+}
+
+/**
+ * add_ghost() - Remember the hash of an evicted key.
+ * @c: Cache to manipulate.
+ * @hash: The hash of the key.
+ *
+ * The oldest ghost is dropped if there are too many.
+ *
+ * Returns: Nothing.
+ */
+static void add_ghost(cache *c, unsigned long hash)
+{
+    cache_entry *g = calloc(1, sizeof(*g));
+    g->hash = hash;
+    cache_entry **bucket = bucket_of(c, hash);
+    g->chain = *bucket;
+    *bucket = g;
+    queue_put(c, g, IN_GHOST);
+
+    if (c->ghost_size > c->ghost_capacity) {
+        g = queue_take(c, c->ghosts);
+        *entry_link(c, g) = g->chain;
+        free(g);
+    }
+}
+
+/**
+ * take_ghost() - Check for and remove a ghost with a given hash.
+ * @c: Cache to manipulate.
+ * @hash: The hash of the key.
+ *
+ * Returns: True if a ghost was found.
+ */
+static bool take_ghost(cache *c, unsigned long hash)
+{
+    cache_entry **link = bucket_of(c, hash);
+    while (*link != NULL) {
+        cache_entry *g = *link;
+        if (g->place == IN_GHOST && g->hash == hash) {
+            *link = g->chain;
+            mark_dead(c, g);
+            return true;
+        }
+        link = &g->chain;
+    }
+    return false;
+}
+
+/**
+ * mark_used() - Record a hit according to the policy of a cache.
+ * @c: Cache to manipulate.
+ * @e: The entry that was hit.
+ *
+ * Returns: Nothing.
+ */
+static void mark_used(cache *c, cache_entry *e)
+{
+    switch (c->policy) {
+    case CACHE_LRU:
+    case CACHE_2Q:
+        // Entries in A1in are not moved.
+        if (e->place == IN_LIST) {
+            list_unlink(e);
+            list_push_front(c, e);
+        }
+        break;
+    case CACHE_CLOCK:
+        c->ref_bits[e->slot] = 1;
+        break;
+    case CACHE_S3_FIFO:
+        if (e->freq < MAX_FREQ) {
+            e->freq++;
+        }
+        break;
+    }
+}
+
+/**
+ * choose_victim() - Choose the entry to evict.
+ * @c: Cache to manipulate. Must not be empty.
+ *
+ * Entries taken from a queue are detached, and the S3-FIFO entries
+ * that are passed over are moved to their new queue.
+ *
+ * Returns: The entry to evict.
+ */
+static cache_entry *choose_victim(cache *c)
+{
+    cache_entry *e;
+
+    switch (c->policy) {
+    case CACHE_LRU:
+        // The least recently used entry is last in the recency list.
+        return c->head.prev;
+    case CACHE_CLOCK:
+        // Give the entries with the reference bit set a second chance.
+        while (c->ref_bits[c->hand]) {
+            c->ref_bits[c->hand] = 0;
+            c->hand = (c->hand + 1) % c->size;
+        }
+        return c->slots[c->hand];
+    case CACHE_2Q:
+        if (c->small_size > c->small_capacity || c->head.next == &c->head) {
+            e = queue_take(c, c->small);
+            add_ghost(c, e->hash);
+            return e;
+        }
+        return c->head.prev;
+    case CACHE_S3_FIFO:
+        if (c->small_size >= c->small_capacity || c->large_size == 0) {
+            // Move the frequently used entries from S to M.
+            while ((e = queue_take(c, c->small)) != NULL) {
+                if (e->freq <= 1) {
+                    add_ghost(c, e->hash);
+                    return e;
+                }
+                e->freq = 0;
+                queue_put(c, e, IN_LARGE);
+            }
+        }
+        // Reinsert the entries in M until one is not used.
+        while ((e = queue_take(c, c->large))->freq > 0) {
+            e->freq--;
+            queue_put(c, e, IN_LARGE);
+        }
+        return e;
+    }
+    return NULL;
+}
+
+/**
+ * place_entry() - Put a new entry in the structure of the policy.
+ * @c: Cache to manipulate.
+ * @e: The new entry.
+ * @had_ghost: True if the key had a ghost entry.
+ *
+ * Returns: Nothing.
+ */
+static void place_entry(cache *c, cache_entry *e, bool had_ghost)
+{
+    switch (c->policy) {
+    case CACHE_LRU:
+        list_push_front(c, e);
+        break;
+    case CACHE_CLOCK:
+        slot_append(c, e, c->size);
+        break;
+    case CACHE_2Q:
+        if (had_ghost) {
+            list_push_front(c, e);
+        } else {
+            queue_put(c, e, IN_SMALL);
+        }
+        break;
+    case CACHE_S3_FIFO:
+        queue_put(c, e, had_ghost ? IN_LARGE : IN_SMALL);
+        break;
+    }
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * cache_empty() - Create an empty LRU cache.
+ * @capacity: The maximum number of key/value pairs in the cache.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function to be used to hash keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/evict/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/evict/kill.
+ *
+ * Returns: Pointer to a new cache, or NULL if capacity is not positive.
+ */
+cache *cache_empty(int capacity, compare_function *key_cmp_func,
+                   hash_function *key_hash_func, kill_function key_kill_func,
+                   kill_function value_kill_func)
+{
+    return cache_empty_with_policy(capacity, CACHE_LRU, key_cmp_func,
+                                   key_hash_func, key_kill_func, value_kill_func);
+}
+
+/**
+ * cache_empty_with_policy() - Create an empty cache with a given eviction policy.
+ * @capacity: The maximum number of key/value pairs in the cache.
+ * @policy: The eviction policy.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function to be used to hash keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/evict/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/evict/kill.
+ *
+ * Returns: Pointer to a new cache, or NULL if capacity is not positive.
+ */
+cache *cache_empty_with_policy(int capacity, cache_policy policy,
+                               compare_function *key_cmp_func,
+                               hash_function *key_hash_func,
+                               kill_function key_kill_func,
+                               kill_function value_kill_func)
+{
+    if (capacity < 1) {
+        return NULL;
+    }
+    // Allocate the cache header.
+    cache *c = calloc(1, sizeof(*c));
+    c->policy = policy;
+    c->capacity = capacity;
+
+    // Allocate the buckets, at least one per entry and ghost.
+    c->bucket_count = 1;
+    while (c->bucket_count < 2 * capacity) {
+        c->bucket_count *= 2;
+    }
+    c->buckets = calloc(c->bucket_count, sizeof(*c->buckets));
+
+    // The recency list is initially empty, i.e. the head links to itself.
+    c->head.prev = &c->head;
+    c->head.next = &c->head;
+
+    // Allocate the structures of the policy.
+    if (policy == CACHE_CLOCK) {
+        c->slots = calloc(capacity, sizeof(*c->slots));
+        c->ref_bits = calloc(capacity, sizeof(*c->ref_bits));
+    } else if (policy == CACHE_2Q || policy == CACHE_S3_FIFO) {
+        c->small = queue_empty(NULL);
+        c->large = queue_empty(NULL);
+        c->ghosts = queue_empty(NULL);
+        if (policy == CACHE_2Q) {
+            c->small_capacity = capacity / 4;
+            c->ghost_capacity = capacity / 2;
+        } else {
+            c->small_capacity = capacity / 10;
+            c->ghost_capacity = capacity - c->small_capacity;
+        }
+        if (c->small_capacity < 1) {
+            c->small_capacity = 1;
+        }
+        if (c->ghost_capacity < 1) {
+            c->ghost_capacity = 1;
+        }
+    }
+
+    // Store the key compare/hash functions and key/value kill functions.
+    c->key_cmp_func = key_cmp_func;
+    c->key_hash_func = key_hash_func;
+    c->key_kill_func = key_kill_func;
+    c->value_kill_func = value_kill_func;
+
+    return c;
+}
+
+/**
+ * cache_set_evict_callback() - Register a function to call on eviction.
+ * @c: Cache to manipulate.
+ * @evict_func: Function (or NULL) called with the key and value of
+ *              each evicted pair.
+ *
+ * Returns: Nothing.
+ */
+void cache_set_evict_callback(cache *c, inspect_callback_pair evict_func)
+{
+    c->evict_func = evict_func;
+}
+
+/**
+ * cache_is_empty() - Check if a cache is empty.
+ * @c: Cache to check.
+ *
+ * Returns: True if the cache contains no key/value pairs, false otherwise.
+ */
+bool cache_is_empty(const cache *c)
+{
+    return c->size == 0;
+}
+
+/**
+ * cache_size() - Return the number of key/value pairs in a cache.
+ * @c: Cache to inspect.
+ *
+ * Returns: The number of key/value pairs.
+ */
+int cache_size(const cache *c)
+{
+    return c->size;
+}
+
+/**
+ * cache_capacity() - Return the capacity of a cache.
+ * @c: Cache to inspect.
+ *
+ * Returns: The maximum number of key/value pairs.
+ */
+int cache_capacity(const cache *c)
+{
+    return c->capacity;
+}
+
+/**
+ * cache_get() - Look up a given key in a cache.
+ * @c: Cache to manipulate.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to the key, or NULL if the key is
+ * not found in the cache.
+ */
+void *cache_get(cache *c, const void *key)
+{
+    cache_entry *e = *find_link(c, key, c->key_hash_func(key));
+    if (e == NULL) {
+        c->misses++;
+        return NULL;
+    }
+    c->hits++;
+    mark_used(c, e);
+
+    return e->value;
+}
+
+/**
+ * cache_peek() - Look up a given key without updating the cache.
+ * @c: Cache to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to the key, or NULL if the key is
+ * not found in the cache.
+ */
+void *cache_peek(const cache *c, const void *key)
+{
+    cache_entry *e = *find_link(c, key, c->key_hash_func(key));
+    return e == NULL ? NULL : e->value;
+}
+
+/**
+ * cache_put() - Add a key/value pair to a cache.
+ * @c: Cache to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ *
+ * Returns: 1 if a pair was evicted, otherwise 0.
+ */
+int cache_put(cache *c, void *key, void *value)
+{
+    unsigned long hash = c->key_hash_func(key);
+    cache_entry *e = *find_link(c, key, hash);
+
+    if (e != NULL) {
+        // Duplicate. Kill the old pair unless the memory is reused.
+        if (c->key_kill_func != NULL && e->key != key) {
+            c->key_kill_func(e->key);
+        }
+        if (c->value_kill_func != NULL && e->value != value) {
+            c->value_kill_func(e->value);
+        }
+        e->key = key;
+        e->value = value;
+        mark_used(c, e);
+        return 0;
+    }
+
+    int evicted = 0;
+    if (c->size == c->capacity) {
+        cache_evict(c);
+        evicted = 1;
+    }
+    bool had_ghost = c->ghosts != NULL && take_ghost(c, hash);
+
+    // Link a new entry first in its bucket chain.
+    e = calloc(1, sizeof(*e));
+    e->key = key;
+    e->value = value;
+    e->hash = hash;
+    cache_entry **bucket = bucket_of(c, hash);
+    e->chain = *bucket;
+    *bucket = e;
+    place_entry(c, e, had_ghost);
+    c->size++;
+
+    return evicted;
+}
+
+/**
+ * cache_remove() - Remove a key/value pair from a cache.
+ * @c: Cache to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Returns: Nothing.
+ */
+void cache_remove(cache *c, const void *key)
+{
+    cache_entry *e = *find_link(c, key, c->key_hash_func(key));
+    if (e != NULL) {
+        remove_entry(c, e, false);
+    }
+}
+
+/**
+ * cache_evict() - Evict a pair from a cache according to its policy.
+ * @c: Cache to manipulate.
+ *
+ * Returns: 0 on success, -1 if the cache is empty.
+ */
+int cache_evict(cache *c)
+{
+    if (c->size == 0) {
+        return -1;
+    }
+    remove_entry(c, choose_victim(c), true);
+
+    return 0;
+}
+
+/**
+ * cache_hits() - Return the number of lookups that found their key.
+ * @c: Cache to inspect.
+ *
+ * Returns: The number of hits.
+ */
+long cache_hits(const cache *c)
+{
+    return c->hits;
+}
+
+/**
+ * cache_misses() - Return the number of lookups that did not find their key.
+ * @c: Cache to inspect.
+ *
+ * Returns: The number of misses.
+ */
+long cache_misses(const cache *c)
+{
+    return c->misses;
+}
+
+/**
+ * cache_reset_stats() - Reset the hit and miss counters.
+ * @c: Cache to manipulate.
+ *
+ * Returns: Nothing.
+ */
+void cache_reset_stats(cache *c)
+{
+    c->hits = 0;
+    c->misses = 0;
+}
+
+/**
+ * cache_kill() - Destroy a cache.
+ * @c: Cache to destroy.
+ *
+ * Returns: Nothing.
+ */
+void cache_kill(cache *c)
+{
+    if (c->small != NULL) {
+        // Kill the dead entries, which are only found in the queues...
+        queue *queues[] = { c->small, c->large, c->ghosts };
+        for (int i = 0; i < 3; i++) {
+            while (!queue_is_empty(queues[i])) {
+                cache_entry *e = queue_front(queues[i]);
+                queue_dequeue(queues[i]);
+                if (e->place == DEAD) {
+                    free(e);
+                }
+            }
+            queue_kill(queues[i]);
+        }
+    }
+    // ...and the live entries and ghosts, which are all in the buckets.
+    for (int i = 0; i < c->bucket_count; i++) {
+        while (c->buckets[i] != NULL) {
+            cache_entry *e = c->buckets[i];
+            c->buckets[i] = e->chain;
+            if (e->place != IN_GHOST) {
+                if (c->key_kill_func != NULL) {
+                    c->key_kill_func(e->key);
+                }
+                if (c->value_kill_func != NULL) {
+                    c->value_kill_func(e->value);
+                }
+            }
+            free(e);
+        }
+    }
+    free(c->slots);
+    free(c->ref_bits);
+    free(c->buckets);
+    free(c);
+}
+
+/**
+ * cache_print() - Print the given cache.
+ * @c: Cache to print.
+ * @print_func: Function called for each key/value pair in the cache.
+ *
+ * Returns: Nothing.
+ */
+void cache_print(const cache *c, inspect_callback_pair print_func)
+{
+    if (c->policy == CACHE_LRU) {
+        for (const cache_entry *e = c->head.next; e != &c->head; e = e->next) {
+            print_func(e->key, e->value);
+        }
+        return;
+    }
+    for (int i = 0; i < c->bucket_count; i++) {
+        for (const cache_entry *e = c->buckets[i]; e != NULL; e = e->chain) {
+            if (e->place != IN_GHOST) {
+                print_func(e->key, e->value);
+            }
+        }
+    }
+}
+
+// ===========INTERNAL FUNCTIONS USED BY cache_print_internal ============
+
+// The functions below output code in the dot language, used by
+// GraphViz. For documention of the dot language, see graphviz.org.
+
+/**
+ * indent() - Output indentation string.
+ * @n: Indentation level.
+ *
+ * Print n tab characters.
+ *
+ * Returns: Nothing.
+ */
+static void indent(int n)
+{
+    for (int i=0; i<n; i++) {
+        printf("\t");
+    }
+}
+
+/**
+ * iprintf(...) - Indent and print.
+ * @n: Indentation level
+ * @...: printf arguments
+ *
+ * Print n tab characters and calls printf.
+ *
+ * Returns: Nothing.
+ */
+static void iprintf(int n, const char *fmt, ...)
+{
+    // Indent...
+    indent(n);
+    // ...and call printf
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * print_edge() - Print a edge between two addresses.
+ * @from: The address of the start of the edge. Should be non-NULL.
+ * @to: The address of the destination for the edge, including NULL.
+ * @port: The name of the port on the source node, or NULL.
+ * @label: The label for the edge, or NULL.
+ * @options: A string with other edge options, or NULL.
+ *
+ * Print an edge from port PORT on node FROM to TO with label
+ * LABEL. If to is NULL, the destination is the NULL node, otherwise a
+ * memory node. If the port is NULL, the edge starts at the node, not
+ * a specific port on it. If label is NULL, no label is used. The
+ * options string, if non-NULL, is printed before the label.
+ *
+ * Returns: Nothing.
+ */
+static void print_edge(int indent_level, const void *from, const void *to, const char *port,
+                       const char *label, const char *options)
+{
+    indent(indent_level);
+    if (port) {
+        printf("m%04lx:%s -> ", PTR2ADDR(from), port);
+    } else {
+        printf("m%04lx -> ", PTR2ADDR(from));
+    }
+    if (to == NULL) {
+        printf("NULL");
+    } else {
+        printf("m%04lx", PTR2ADDR(to));
+    }
+    printf(" [");
+    if (options != NULL) {
+        printf("%s", options);
+    }
+    if (label != NULL) {
+        printf(" label=\"%s\"",label);
+    }
+    printf("]\n");
+}
+
+// Internal function to print the head node in dot format. The head
+// cell of the recency list is part of the head node.
+static void print_head_node(int indent_level, const cache *c)
+{
+    iprintf(indent_level, "m%04lx [shape=record "
+            "label=\"policy\\n%d|capacity\\n%d|size\\n%d|<b>buckets\\n%04lx"
+            "|<n>head.next\\n%04lx|<p>head.prev\\n%04lx|<s>small\\n%04lx"
+            "|<l>large\\n%04lx|<g>ghosts\\n%04lx|hits\\n%ld|misses\\n%ld\"]\n",
+            PTR2ADDR(c), c->policy, c->capacity, c->size, PTR2ADDR(c->buckets),
+            PTR2ADDR(c->head.next), PTR2ADDR(c->head.prev), PTR2ADDR(c->small),
+            PTR2ADDR(c->large), PTR2ADDR(c->ghosts), c->hits, c->misses);
+}
+
+// Internal function to print the bucket array in dot format.
+static void print_buckets(int indent_level, const cache *c)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"", PTR2ADDR(c->buckets));
+    for (int i = 0; i < c->bucket_count; i++) {
+        printf("<%02d>%02d\\n%04lx", i, i, PTR2ADDR(c->buckets[i]));
+        if (i < c->bucket_count - 1) {
+            printf("|");
+        }
+    }
+    printf("\"]\n");
+}
+
+// Internal function to print an entry node in dot format.
+static void print_entry_node(int indent_level, const cache_entry *e)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"<p>prev\\n%04lx|<n>next\\n%04lx"
+            "|<c>chain\\n%04lx|<k>key\\n%04lx|<v>value\\n%04lx|place\\n%d|slot\\n%d"
+            "|freq\\n%d\"]\n",
+            PTR2ADDR(e), PTR2ADDR(e->prev), PTR2ADDR(e->next), PTR2ADDR(e->chain),
+            PTR2ADDR(e->key), PTR2ADDR(e->value), e->place, e->slot, e->freq);
+}
+
+// Internal function to print a key or value node in dot format.
+static void print_payload_node(int indent_level, const void *p, inspect_callback print_func)
+{
+    iprintf(indent_level, "m%04lx [label=\"", PTR2ADDR(p));
+    if (print_func != NULL) {
+        print_func(p);
+    }
+    printf("\" xlabel=\"%04lx\"]\n", PTR2ADDR(p));
+}
+
+// Create an escaped version of the input string. The most common
+// control characters - newline, horizontal tab, backslash, and double
+// quote - are replaced by their escape sequence. The returned pointer
+// must be deallocated by the caller.
+static char *escape_chars(const char *s)
+{
+    int i, j;
+    int escaped = 0; // The number of chars that must be escaped.
+
+    // Count how many chars need to be escaped, i.e. how much longer
+    // the output string will be.
+    for (i = escaped = 0; s[i] != '\0'; i++) {
+        if (s[i] == '\n' || s[i] == '\t' || s[i] == '\\' || s[i] == '\"') {
+            escaped++;
+        }
+    }
+    // Allocate space for the escaped string. The variable i holds the input
+    // length, escaped how much the string will grow.
+    char *t = malloc(i + escaped + 1);
+
+    // Copy-and-escape loop
+    for (i = j = 0; s[i] != '\0'; i++) {
+        // Convert each control character by its escape sequence.
+        // Non-control characters are copied as-is.
+        switch (s[i]) {
+        case '\n': t[i+j] = '\\'; t[i+j+1] = 'n';  j++; break;
+        case '\t': t[i+j] = '\\'; t[i+j+1] = 't';  j++; break;
+        case '\\': t[i+j] = '\\'; t[i+j+1] = '\\'; j++; break;
+        case '\"': t[i+j] = '\\'; t[i+j+1] = '\"'; j++; break;
+        default:   t[i+j] = s[i]; break;
+        }
+    }
+    // Terminal the output string
+    t[i+j] = '\0';
+    return t;
+}
+
+/**
+ * cache_print_internal() - Output the internal structure of the cache.
+ * @c: Cache to print.
+ * @key_print_func: Function called for each key in the cache.
+ * @value_print_func: Function called for each value in the cache.
+ * @desc: String with a description/state of the cache.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the cache and prints code that shows its' internal structure.
+ *
+ * Returns: Nothing.
+ */
+void cache_print_internal(const cache *c, inspect_callback key_print_func,
+                          inspect_callback value_print_func, const char *desc,
+                          int indent_level)
+{
+    static int graph_number = 0;
+    graph_number++;
+    int il = indent_level;
+
+    if (indent_level == 0) {
+        // If this is the outermost datatype, start a graph and set up defaults
+        printf("digraph CACHE_%d {\n", graph_number);
+
+        // Specify default shape and fontname
+        il++;
+        iprintf(il, "node [shape=rectangle fontname=\"Courier New\"]\n");
+        iprintf(il, "ranksep=0.01\n");
+        iprintf(il, "subgraph cluster_nullspace {\n");
+        iprintf(il+1, "NULL\n");
+        iprintf(il, "}\n");
+    }
+
+    if (desc != NULL) {
+        // Escape the string before printout
+        char *escaped = escape_chars(desc);
+        // Use different names on inner description nodes
+        if (indent_level == 0) {
+            iprintf(il, "description [label=\"%s\"]\n", escaped);
+        } else {
+            iprintf(il, "cluster_cache_%d_description [label=\"%s\"]\n",
+                    graph_number, escaped);
+        }
+        free(escaped);
+    }
+
+    if (indent_level == 0) {
+        // Use a single "pointer" edge as a starting point for the
+        // outermost datatype
+        iprintf(il, "c [label=\"%04lx\" xlabel=\"c\"]\n", PTR2ADDR(c));
+        iprintf(il, "c -> m%04lx\n", PTR2ADDR(c));
+
+        // Put the user nodes in userspace
+        iprintf(il, "subgraph cluster_userspace { label=\"User space\"\n");
+        for (int i = 0; i < c->bucket_count; i++) {
+            for (const cache_entry *e = c->buckets[i]; e != NULL; e = e->chain) {
+                if (e->place != IN_GHOST) {
+                    print_payload_node(il + 1, e->key, key_print_func);
+                    print_payload_node(il + 1, e->value, value_print_func);
+                }
+            }
+        }
+        iprintf(il, "}\n");
+    }
+
+    // Print the subgraph to surround the cache content
+    iprintf(il, "subgraph cluster_cache_%d { label=\"Cache\"\n", graph_number);
+    il++;
+    print_head_node(il, c);
+    print_buckets(il, c);
+    for (int i = 0; i < c->bucket_count; i++) {
+        for (const cache_entry *e = c->buckets[i]; e != NULL; e = e->chain) {
+            print_entry_node(il, e);
+        }
+    }
+    if (c->small != NULL) {
+        // The queues refer to the entries, including any dead entries.
+        queue_print_internal(c->small, NULL, "small", il);
+        queue_print_internal(c->large, NULL, "large", il);
+        queue_print_internal(c->ghosts, NULL, "ghosts", il);
+    }
+    il--;
+    iprintf(il, "}\n");
+
+    // Output the edges from the head, the buckets and the entries.
+    // The links to the head cell are drawn to the head node.
+    print_edge(il, c, c->buckets, "b", "buckets", NULL);
+    print_edge(il, c, c->head.next == &c->head ? (const void *)c : c->head.next,
+               "n", "head.next", NULL);
+    print_edge(il, c, c->head.prev == &c->head ? (const void *)c : c->head.prev,
+               "p", "head.prev", NULL);
+    for (int i = 0; i < c->bucket_count; i++) {
+        if (c->buckets[i] != NULL) {
+            char port[15];
+            sprintf(port, "%02d", i);
+            print_edge(il, c->buckets, c->buckets[i], port, NULL, NULL);
+        }
+    }
+    if (c->small != NULL) {
+        print_edge(il, c, c->small, "s", "small", NULL);
+        print_edge(il, c, c->large, "l", "large", NULL);
+        print_edge(il, c, c->ghosts, "g", "ghosts", NULL);
+    }
+    for (int i = 0; i < c->bucket_count; i++) {
+        for (const cache_entry *e = c->buckets[i]; e != NULL; e = e->chain) {
+            if (e->place == IN_LIST) {
+                print_edge(il, e, e->prev == &c->head ? (const void *)c : e->prev,
+                           "p", "prev", NULL);
+                print_edge(il, e, e->next == &c->head ? (const void *)c : e->next,
+                           "n", "next", NULL);
+            }
+            if (e->chain != NULL) {
+                print_edge(il, e, e->chain, "c", "chain", NULL);
+            }
+            if (e->place != IN_GHOST) {
+                print_edge(il, e, e->key, "k", "key",
+                           c->key_kill_func ? "color=red" : "color=red style=dashed");
+                print_edge(il, e, e->value, "v", "value",
+                           c->value_kill_func ? "color=red" : "color=red style=dashed");
+            }
+        }
+    }
+
+    if (indent_level == 0) {
+        // Termination of graph
+        printf("}\n");
+    }
+}
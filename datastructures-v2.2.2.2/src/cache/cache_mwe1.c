@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cache.h>
+
+/*
+ * Minimum working example for cache.c. Puts (postal code, town) pairs
+ * into a cache with room for 3 pairs, and shows which pairs are
+ * evicted when the cache is full and how lookups change the order of
+ * eviction. The cache is responsible for deallocating the keys and
+ * values.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+// Create a dynamic copy of the string str.
+char* string_copy(const char *str)
+{
+    // Use calloc to ensure a '\0' termination.
+    char *copy = calloc(strlen(str) + 1, sizeof(*copy));
+    strcpy(copy, str);
+    return copy;
+}
+
+// Create a dynamic copy of the integer i.
+int *int_create(int i)
+{
+    // Allocate memory for an integer and set the value
+    int *v = malloc(sizeof(*v));
+    *v = i;
+    return v;
+}
+
+// Interpret the supplied key and value pointers and print their content.
+void print_int_string_pair(const void *key, const void *value)
+{
+    const int *k=key;
+    const char *s=value;
+    printf("[%d, %s]\n", *k, s);
+}
+
+// Called by the cache for each evicted pair.
+void print_evicted(const void *key, const void *value)
+{
+    printf("Evicted ");
+    print_int_string_pair(key, value);
+}
+
+// Compare two keys (int *).
+int compare_ints(const void *k1, const void *k2)
+{
+    int key1 = *(int *)k1;
+    int key2 = *(int *)k2;
+
+    if ( key1 == key2 )
+        return 0;
+    if ( key1 < key2 )
+        return -1;
+    return 1;
+}
+
+// Hash a key (int *).
+unsigned long hash_int(const void *k)
+{
+    return *(const int *)k;
+}
+
+// Look up a postal code and print the result.
+void lookup(cache *c, int key)
+{
+    const char *s = cache_get(c, &key);
+    printf("Lookup of postal code %d: %s.\n", key, s ? s : "(not cached)");
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Cache (integer, string) pairs.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    // Hand over the deallocation responsibility to the cache.
+    cache *c = cache_empty(3, compare_ints, hash_int, free, free);
+    cache_set_evict_callback(c, print_evicted);
+
+    cache_put(c, int_create(90187), string_copy("Umea"));
+    cache_put(c, int_create(98185), string_copy("Kiruna"));
+    cache_put(c, int_create(11120), string_copy("Stockholm"));
+
+    printf("Cache after putting 3 pairs, most recently used first:\n");
+    cache_print(c, print_int_string_pair);
+
+    // Use the oldest pair, which makes Kiruna the least recently used.
+    lookup(c, 90187);
+    cache_put(c, int_create(41296), string_copy("Goteborg"));
+    lookup(c, 98185);
+    lookup(c, 11120);
+
+    printf("Cache after putting a 4th pair:\n");
+    cache_print(c, print_int_string_pair);
+    printf("Hits: %ld, misses: %ld.\n", cache_hits(c), cache_misses(c));
+
+    // Kill the cache, including the keys and values.
+    cache_kill(c);
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
@@ -0,0 +1,484 @@
+/*
+ * cache_test - test the cache implementation.
+ *
+ * Should be compiled together with the cache implementation that
+ * follows the interface in cache.h of the code base for the
+ * Datastructures and Algorithms courses at the Department of
+ * Computing Science, Umea University.
+ *
+ * The program is modelled on tabletest. It first runs a number of
+ * correctness tests and then measures the hit ratio and the time per
+ * operation for lookups that follow a Zipf distribution, i.e. where
+ * the key with rank r is looked up with a probability proportional
+ * to 1/r^s.
+ *
+ * 2026-10-18 v1.0  First public version.
+ * 2026-10-18 v1.1  Added the CLOCK, 2Q and S3-FIFO policies, and
+ *                  lookups interleaved with scans.
+ * 2026-10-18 v1.2  The helpers shared with the other tests, and the
+ *                  monotonic clock of the timing, come from testutil.c.
+ * 2026-10-18 v1.3  Moved from ou3/cachetest.c to src/cache/cache_test.c.
+*/
+
+#define VERSION "v1.3"
+#define VERSION_DATE "2026-10-18"
+
+/*
+ * Correctness testing algorithm:
+ *
+ * 1. Tests that a new cache is empty, and that a cache cannot be
+ *    created without room for any pairs.
+ * 2. Tests that the least recently used pair is evicted when a full
+ *    cache is filled further, and that a lookup or a put of a
+ *    duplicate key makes a pair the most recently used.
+ * 3. Tests that the evict callback is called for evicted pairs only,
+ *    and that the hit and miss counters are updated by cache_get but
+ *    not by cache_peek.
+ * 4. Tests each policy with a random sequence of puts, lookups and
+ *    removes, and checks that the cache never holds more pairs than
+ *    its capacity, that a pair is found directly after it is put, and
+ *    that a removed pair is not found.
+ * 5. Tests that the 2Q and S3-FIFO policies keep a set of frequently
+ *    used pairs while a scan of keys used only once passes through.
+ *
+ * There is also a module measuring the hit ratio and the time per
+ * operation.
+ * */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "cache.h"
+#include "testutil.h"
+
+// Maximum number of distinct keys to generate
+#define KEYSIZE 1000000
+
+// The names of the policies, indexed by cache_policy.
+const char *policy_names[] = { "LRU", "CLOCK", "2Q", "S3-FIFO" };
+
+#define POLICY_COUNT 4
+
+/* Creates a cache with int keys and values owned by the cache.
+ *    capacity - the maximum number of pairs in the cache
+ */
+cache *int_cache(int capacity)
+{
+    return cache_empty(capacity, int_compare, int_hash, free, free);
+}
+
+/* Creates a cache with int keys and values owned by the cache, and a
+ *  given eviction policy.
+ *    capacity - the maximum number of pairs in the cache
+ *    policy - the eviction policy
+ */
+cache *int_cache_with_policy(int capacity, cache_policy policy)
+{
+    return cache_empty_with_policy(capacity, policy, int_compare,
+                                   int_hash, free, free);
+}
+
+/* Puts the pair (key, value) into a cache with int keys and values.
+ *    c - the cache
+ *    key, value - the pair
+ * Returns the return value of cache_put.
+ */
+int put_int(cache *c, int key, int value)
+{
+    return cache_put(c, int_ptr_from_int(key), int_ptr_from_int(value));
+}
+
+/* Checks that a key is in a cache with int keys and values, and has
+ *  the expected value. The lookup is done with cache_peek, so the
+ *  cache is not updated.
+ *    c - the cache
+ *    key - the key to look up
+ *    expected - the expected value, or -1 if the key should be missing
+ */
+void check_int(const cache *c, int key, int expected)
+{
+    const int *v=cache_peek(c, &key);
+    if (expected < 0 && v != NULL) {
+        printf("Key %d should have been evicted.\n", key);
+        exit(EXIT_FAILURE);
+    }
+    if (expected >= 0 && (v == NULL || *v != expected)) {
+        printf("Key %d should have the value %d.\n", key, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Tests that a new cache is empty.
+ */
+void test_isempty()
+{
+    cache *c = int_cache(3);
+
+    if (!cache_is_empty(c) || cache_size(c) != 0
+        || cache_capacity(c) != 3) {
+        printf("A newly created cache is not empty.\n");
+        exit(EXIT_FAILURE);
+    }
+    cache_kill(c);
+    if (cache_empty(0, int_compare, int_hash, NULL, NULL) != NULL) {
+        printf("A cache without room for any pairs was created.\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("A new cache is empty. - OK\n");
+}
+
+/* Tests the eviction order.
+ */
+void test_eviction_order()
+{
+    cache *c = int_cache(3);
+    int key;
+
+    put_int(c, 1, 10);
+    put_int(c, 2, 20);
+    put_int(c, 3, 30);
+    if (put_int(c, 4, 40) != 1 || cache_size(c) != 3) {
+        printf("Putting a pair into a full cache did not evict.\n");
+        exit(EXIT_FAILURE);
+    }
+    check_int(c, 1, -1);
+
+    // A lookup of 2 makes 3 the least recently used.
+    key = 2;
+    cache_get(c, &key);
+    put_int(c, 5, 50);
+    check_int(c, 3, -1);
+    check_int(c, 2, 20);
+
+    // A duplicate put of 4 makes 2 the least recently used.
+    if (put_int(c, 4, 41) != 0) {
+        printf("Putting a duplicate key evicted a pair.\n");
+        exit(EXIT_FAILURE);
+    }
+    put_int(c, 6, 60);
+    check_int(c, 2, -1);
+    check_int(c, 4, 41);
+    check_int(c, 5, 50);
+    check_int(c, 6, 60);
+
+    // Remove and evict explicitly.
+    key = 5;
+    cache_remove(c, &key);
+    check_int(c, 5, -1);
+    if (cache_evict(c) != 0 || cache_evict(c) != 0
+        || cache_evict(c) == 0 || !cache_is_empty(c)) {
+        printf("Explicit eviction failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    cache_kill(c);
+    printf("The least recently used pair is evicted. - OK\n");
+}
+
+// The number of evicted pairs, counted by count_evicted.
+int evicted_count;
+
+// Evict callback used by test_callback_and_counters.
+void count_evicted(const void *key, const void *value)
+{
+    evicted_count++;
+}
+
+/* Tests the evict callback and the hit and miss counters.
+ */
+void test_callback_and_counters()
+{
+    cache *c = int_cache(2);
+    cache_set_evict_callback(c, count_evicted);
+    evicted_count = 0;
+
+    for (int i = 0; i < 5; i++) {
+        put_int(c, i, i);
+    }
+    int key = 4;
+    cache_remove(c, &key);
+    for (key = 0; key < 5; key++) {
+        cache_get(c, &key);
+        cache_peek(c, &key);
+    }
+    if (evicted_count != 3) {
+        printf("The evict callback was called %d times, expected 3.\n",
+               evicted_count);
+        exit(EXIT_FAILURE);
+    }
+    if (cache_hits(c) != 1 || cache_misses(c) != 4) {
+        printf("The cache counted %ld hits and %ld misses, expected "
+               "1 and 4.\n", cache_hits(c), cache_misses(c));
+        exit(EXIT_FAILURE);
+    }
+    cache_reset_stats(c);
+    if (cache_hits(c) != 0 || cache_misses(c) != 0) {
+        printf("The counters were not reset.\n");
+        exit(EXIT_FAILURE);
+    }
+    cache_kill(c);
+    if (evicted_count != 3) {
+        printf("The evict callback was called by cache_kill.\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("The evict callback and the hit/miss counters work. - OK\n");
+}
+
+/* Tests each policy with a random sequence of operations.
+ */
+void test_random_operations()
+{
+    for (int p = 0; p < POLICY_COUNT; p++) {
+        cache *c = int_cache_with_policy(10, p);
+        for (int i = 0; i < 10000; i++) {
+            int key = rand() % 40;
+            int op = rand() % 4;
+            if (op == 0) {
+                cache_remove(c, &key);
+                check_int(c, key, -1);
+            } else if (op == 1) {
+                put_int(c, key, i);
+                check_int(c, key, i);
+            } else if (cache_get(c, &key) == NULL) {
+                put_int(c, key, i);
+                check_int(c, key, i);
+            }
+            if (cache_size(c) > cache_capacity(c)) {
+                printf("A %s cache holds %d pairs, more than "
+                       "its capacity.\n", policy_names[p],
+                       cache_size(c));
+                exit(EXIT_FAILURE);
+            }
+        }
+        while (cache_evict(c) == 0) {
+        }
+        cache_kill(c);
+    }
+    printf("Random puts, lookups and removes for all policies. - OK\n");
+}
+
+/* Tests that the scan resistant policies keep the frequently used
+ *  pairs during a scan.
+ */
+void test_scan_resistance()
+{
+    const cache_policy policies[] = { CACHE_2Q, CACHE_S3_FIFO };
+    for (int p = 0; p < 2; p++) {
+        cache *c = int_cache_with_policy(100, policies[p]);
+        // Use the hot keys 0-19 once per round, followed by a
+        // scan of 100 keys used only once...
+        for (int round = 0; round < 5; round++) {
+            for (int key = 0; key < 20; key++) {
+                if (cache_get(c, &key) == NULL) {
+                    put_int(c, key, key);
+                }
+            }
+            for (int key = 1000 + 100 * round;
+                 key < 1100 + 100 * round; key++) {
+                if (cache_get(c, &key) == NULL) {
+                    put_int(c, key, key);
+                }
+            }
+        }
+        // ...and check that the hot keys are left.
+        int left = 0;
+        for (int key = 0; key < 20; key++) {
+            left += cache_peek(c, &key) != NULL;
+        }
+        if (left < 20) {
+            printf("Only %d of 20 hot keys survived a scan in a "
+                   "%s cache.\n", left,
+                   policy_names[policies[p]]);
+            exit(EXIT_FAILURE);
+        }
+        cache_kill(c);
+    }
+    printf("The 2Q and S3-FIFO policies keep the hot pairs during a "
+           "scan. - OK\n");
+}
+
+/*  Tests the cache by performing a set of tests. Program exits if any
+ *  error is found.
+ */
+void correctness_test()
+{
+    test_isempty();
+    test_eviction_order();
+    test_callback_and_counters();
+    test_random_operations();
+    test_scan_resistance();
+}
+
+/* Creates the cumulative distribution of a Zipf distribution.
+ *    cdf - array where cdf[r] is the probability of a rank <= r
+ *    n - the number of ranks
+ *    s - the exponent of the distribution, 0 for uniform
+ */
+void create_zipf_cdf(double *cdf, int n, double s)
+{
+    double sum=0;
+    for(int r=0;r<n;r++) {
+        sum += 1.0/pow(r+1, s);
+        cdf[r]=sum;
+    }
+    for(int r=0;r<n;r++) {
+        cdf[r] /= sum;
+    }
+}
+
+/* Draws a random rank from a Zipf distribution.
+ *    cdf - the cumulative distribution from create_zipf_cdf
+ *    n - the number of ranks
+ * Returns the rank, where rank 0 is the most frequent.
+ */
+int zipf_rank(const double *cdf, int n)
+{
+    double u=(double)rand()/RAND_MAX;
+    int lo=0;
+    int hi=n-1;
+    // Find the first rank whose cumulative probability is >= u.
+    while (lo<hi) {
+        int mid=(lo+hi)/2;
+        if (cdf[mid]<u) {
+            lo=mid+1;
+        } else {
+            hi=mid;
+        }
+    }
+    return lo;
+}
+
+/* Measures the hit ratio and time per operation for a cache where
+ *  each lookup that misses is followed by a put of the key.
+ *    id - the id of the measurement in the machine-readable table
+ *    n - the number of distinct keys
+ *    capacity - the capacity of the cache
+ *    policy - the eviction policy of the cache
+ *    s - the exponent of the Zipf distribution
+ *    scans - true if every tenth lookup should be replaced by a scan
+ *            of keys that are used only once
+ *    machine_table - true if we should output a machine-readable table
+ */
+void get_zipf_speed(int id, int n, int capacity, cache_policy policy,
+                    double s, bool scans, bool machine_table)
+{
+    int ops=10*n;
+    double *cdf=malloc(n*sizeof(double));
+    int *keys=malloc(ops*sizeof(int));
+    create_zipf_cdf(cdf, n, s);
+    // Draw the keys in advance so that only the cache is timed. The
+    // scanned keys are all >= n.
+    int next_scan_key=n;
+    for(int i=0;i<ops;i++) {
+        if (scans && i%10 == 0) {
+            keys[i]=next_scan_key++;
+        } else {
+            keys[i]=zipf_rank(cdf, n);
+        }
+    }
+
+    cache *c = int_cache_with_policy(capacity, policy);
+    unsigned long start = get_microseconds();
+    for(int i=0;i<ops;i++) {
+        if (cache_get(c, &keys[i]) == NULL) {
+            put_int(c, keys[i], i);
+        }
+    }
+    unsigned long end = get_microseconds();
+    double hit_ratio=(double)cache_hits(c)/ops;
+    double ns_per_op=1000.0*(end-start)/ops;
+    cache_kill(c);
+
+    if (machine_table) {
+        printf("%d, %d, %lu, %.4f, %.1f\n",id,n,(end-start)/1000,
+               hit_ratio,ns_per_op);
+    } else {
+        printf("%-7s %7d Zipf(%.1f) lookups%s, capacity %6d : ",
+               policy_names[policy],ops,s,scans ? " with scans" : "",
+               capacity);
+        printf("hit ratio %.3f, %.1f ns/op.\n",hit_ratio,ns_per_op);
+    }
+    free(keys);
+    free(cdf);
+}
+
+/* Tests the speed of the cache for each policy with different Zipf
+ * exponents and capacities, with and without scans. The
+ * machine-readable table has the columns id, n, total time in ms, hit
+ * ratio and time per operation in ns.
+ */
+void speed_test(int n,bool machine_table)
+{
+    const double exponents[] = { 0.0, 0.8, 1.0, 1.2 };
+    int id=1;
+    for(int p=0;p<POLICY_COUNT;p++) {
+        for(int scans=0;scans<=1;scans++) {
+            for(int i=0;i<sizeof(exponents)/sizeof(exponents[0]);i++) {
+                for(int capacity=n/100;capacity<=n/10;capacity*=10) {
+                    get_zipf_speed(id++, n, capacity, p,
+                                   exponents[i], scans,
+                                   machine_table);
+                }
+            }
+        }
+    }
+}
+
+#define NAME "cache_test"
+
+int main(int argc,char **argv)
+{
+    bool do_test=true; // Should we run the testing code?
+    bool machine_table=false; // Should we output a machine-readable table?
+    int n=-1;
+
+    fprintf(stderr,NAME " " VERSION " (" VERSION_DATE ")\n");
+    fprintf(stderr, "Code base version %s.\n\n", CODE_BASE_VERSION);
+
+    for (int i=1; i<argc; i++) {
+        // Parse each argument
+        char *s=argv[i];
+        if (strlen(s)>0 && s[0]=='-') {
+            switch (s[1]) {
+            case 'n':
+                do_test=false;
+                break;
+            case 't':
+                machine_table=true;
+                break;
+            default:
+                fprintf(stderr,"%s: Bad switch: %s.\n",
+                        argv[0],s);
+                exit(EXIT_FAILURE);
+            }
+        } else {
+            // Convert string to integer.
+            n=atoi(s);
+            break;
+        }
+    }
+
+    if (n<0) {
+        fprintf(stderr,"Usage:\n\t%s [-n] [-t] n\n"
+                "\twhere n is the number of distinct keys, an integer from 100 to %d.\n\n"
+                "\tUse -n (no-test) to skip the testing.\n"
+                "\tUse -t (table) to output a machine-readable table with the timings.\n",
+                argv[0],KEYSIZE);
+        exit(EXIT_FAILURE);
+    }
+    if (n<100 || n>KEYSIZE) {
+        fprintf(stderr,"Error: supplied value of n (%d) is outside "
+                "allowed range 100-%d.\n",n,KEYSIZE);
+        exit(EXIT_FAILURE);
+    }
+    if (do_test) {
+        printf("Testing...\n");
+        correctness_test();
+        printf("All correctness tests succeeded!\n\n");
+    }
+    speed_test(n,machine_table);
+    if (!machine_table) {
+        printf("Test completed.\n");
+    }
+    return 0;
+}
@@ -0,0 +1,334 @@
+// posix_memalign is a POSIX function.
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <cellcache.h>
+
+/*
+ * Implementation of an allocator with per-thread caches of small
+ * blocks for the "Datastructures and algorithms" courses at the
+ * Department of Computing Science, Umea University.
+ *
+ * The block sizes are rounded up to a multiple of CLASS_SIZE bytes,
+ * giving CLASS_COUNT size classes. Each thread cache has a free list
+ * per size class, which only the thread itself uses. An empty free
+ * list is refilled with a new slab of SLAB_SIZE bytes, allocated at an
+ * address that is a multiple of SLAB_SIZE. The slab starts with a
+ * header with the owning cache and the size class, and is divided
+ * into blocks of that class. The header of a block is thus found by
+ * rounding the address of the block down to a multiple of SLAB_SIZE.
+ *
+ * A block returned by its owner is pushed on a free list. Other
+ * threads push the block on a pending batch of their own, and the
+ * batch is moved to the returned list of the owner, under the lock of
+ * the owner, when it is full, when a block of another owner is
+ * returned, or when the thread calls cellcache_flush or exits. The
+ * owner moves the blocks of its returned list to its free lists when
+ * a free list is empty.
+ *
+ * All caches are kept in a chain. A thread takes over a cache that is
+ * not used by any thread, or adds a new cache to the chain. A
+ * pthread key with a destructor gives the cache back when the thread
+ * exits.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// The block sizes are rounded up to a multiple of CLASS_SIZE bytes,
+// which is also the alignment of the blocks.
+#define CLASS_SIZE 16
+
+// The number of size classes, i.e. blocks of up to 128 bytes are
+// handled by the caches.
+#define CLASS_COUNT 8
+
+// The size of a slab. Must be a power of two.
+#define SLAB_SIZE 65536
+
+// The number of blocks returned to another thread that are handed
+// back at once.
+#define BATCH_SIZE 64
+
+// ===========INTERNAL DATA TYPES ============
+
+typedef struct free_block {
+    struct free_block *next;
+} free_block;
+
+typedef struct thread_cache {
+    free_block *free[CLASS_COUNT]; // Free blocks, only used by the owner
+    pthread_mutex_t lock;          // Protects returned
+    free_block *returned;          // Blocks returned by other threads
+    struct slab *slabs;            // The slabs of the cache
+    int in_use;                    // Non-zero if used by a thread
+    struct thread_cache *next;     // The next cache of the chain
+} thread_cache;
+
+typedef struct slab {
+    thread_cache *owner;  // The cache that the blocks belong to
+    int size_class;       // The size class of the blocks
+    struct slab *next;    // The next slab of the owner
+} slab;
+
+// The blocks of a slab start after the header, at an aligned offset.
+#define SLAB_HEADER ((sizeof(slab) + CLASS_SIZE - 1) / CLASS_SIZE * CLASS_SIZE)
+
+// The chain of caches, and the lock that protects it and the in_use
+// flags.
+static thread_cache *caches = NULL;
+static pthread_mutex_t caches_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// The key whose destructor gives the cache back when a thread exits.
+static pthread_key_t exit_key;
+static pthread_once_t exit_key_once = PTHREAD_ONCE_INIT;
+
+// The cache of this thread, or NULL until the first allocation.
+static __thread thread_cache *own_cache = NULL;
+
+// The blocks returned by this thread to another cache that are not
+// yet handed back.
+static __thread thread_cache *pending_owner = NULL;
+static __thread free_block *pending_first = NULL;
+static __thread free_block *pending_last = NULL;
+static __thread int pending_count = 0;
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
+
+// Return the header of the slab that holds a block.
+static slab *slab_of(const void *p)
+{
+    return (slab *)((uintptr_t)p & ~(uintptr_t)(SLAB_SIZE - 1));
+}
+
+/**
+ * flush_pending() - Hand back the pending batch to its owner.
+ *
+ * Returns: Nothing.
+ */
+static void flush_pending(void)
+{
+    if (pending_count == 0) {
+        return;
+    }
+    pthread_mutex_lock(&pending_owner->lock);
+    pending_last->next = pending_owner->returned;
+    pending_owner->returned = pending_first;
+    pthread_mutex_unlock(&pending_owner->lock);
+
+    pending_owner = NULL;
+    pending_first = pending_last = NULL;
+    pending_count = 0;
+}
+
+/**
+ * release_cache() - Give back the cache of an exiting thread.
+ * @p: The cache.
+ *
+ * Called as the destructor of exit_key.
+ *
+ * Returns: Nothing.
+ */
+static void release_cache(void *p)
+{
+    thread_cache *c = p;
+
+    flush_pending();
+    pthread_mutex_lock(&caches_lock);
+    c->in_use = 0;
+    pthread_mutex_unlock(&caches_lock);
+    own_cache = NULL;
+}
+
+// Create the key whose destructor gives back the caches.
+static void create_exit_key(void)
+{
+    pthread_key_create(&exit_key, release_cache);
+}
+
+/**
+ * acquire_cache() - Get a cache for this thread.
+ *
+ * Takes over a cache that no thread uses, or adds a new cache to the
+ * chain.
+ *
+ * Returns: The cache, or NULL if not enough memory was available.
+ */
+static thread_cache *acquire_cache(void)
+{
+    pthread_once(&exit_key_once, create_exit_key);
+
+    pthread_mutex_lock(&caches_lock);
+    thread_cache *c = caches;
+    while (c != NULL && c->in_use) {
+        c = c->next;
+    }
+    if (c == NULL) {
+        c = calloc(1, sizeof(*c));
+        if (c == NULL) {
+            pthread_mutex_unlock(&caches_lock);
+            return NULL;
+        }
+        pthread_mutex_init(&c->lock, NULL);
+        c->next = caches;
+        caches = c;
+    }
+    c->in_use = 1;
+    pthread_mutex_unlock(&caches_lock);
+
+    pthread_setspecific(exit_key, c);
+    own_cache = c;
+
+    return c;
+}
+
+/**
+ * collect_returned() - Move the blocks returned by other threads to
+ *                      the free lists.
+ * @c: The cache of this thread.
+ *
+ * Returns: Nothing.
+ */
+static void collect_returned(thread_cache *c)
+{
+    pthread_mutex_lock(&c->lock);
+    free_block *b = c->returned;
+    c->returned = NULL;
+    pthread_mutex_unlock(&c->lock);
+
+    while (b != NULL) {
+        free_block *next = b->next;
+        int k = slab_of(b)->size_class;
+        b->next = c->free[k];
+        c->free[k] = b;
+        b = next;
+    }
+}
+
+/**
+ * add_slab() - Fill an empty free list with the blocks of a new slab.
+ * @c: The cache of this thread.
+ * @k: The size class.
+ *
+ * Returns: Nothing. The free list stays empty if not enough memory was
+ * available.
+ */
+static void add_slab(thread_cache *c, int k)
+{
+    void *p;
+    if (posix_memalign(&p, SLAB_SIZE, SLAB_SIZE) != 0) {
+        return;
+    }
+    slab *s = p;
+    s->owner = c;
+    s->size_class = k;
+    s->next = c->slabs;
+    c->slabs = s;
+
+    // Push the blocks in reverse order, so that they are handed out
+    // in address order.
+    size_t size = (k + 1) * CLASS_SIZE;
+    size_t count = (SLAB_SIZE - SLAB_HEADER) / size;
+    unsigned char *first = (unsigned char *)s + SLAB_HEADER;
+    for (size_t i = count; i > 0; i--) {
+        free_block *b = (free_block *)(first + (i - 1) * size);
+        b->next = c->free[k];
+        c->free[k] = b;
+    }
+}
+
+// Allocation function of the allocator.
+static void *cache_allocate(void *context, size_t size)
+{
+    if (size == 0 || size > CLASS_COUNT * CLASS_SIZE) {
+        return calloc(1, size == 0 ? 1 : size);
+    }
+    thread_cache *c = own_cache != NULL ? own_cache : acquire_cache();
+    if (c == NULL) {
+        return NULL;
+    }
+    int k = (size - 1) / CLASS_SIZE;
+    if (c->free[k] == NULL) {
+        // Take back the blocks returned by other threads first.
+        collect_returned(c);
+        if (c->free[k] == NULL) {
+            add_slab(c, k);
+            if (c->free[k] == NULL) {
+                return NULL;
+            }
+        }
+    }
+    free_block *b = c->free[k];
+    c->free[k] = b->next;
+    memset(b, 0, (k + 1) * CLASS_SIZE);
+
+    return b;
+}
+
+// De-allocation function of the allocator.
+static void cache_deallocate(void *context, void *p, size_t size)
+{
+    if (size == 0 || size > CLASS_COUNT * CLASS_SIZE) {
+        free(p);
+        return;
+    }
+    if (own_cache == NULL) {
+        // Get a cache, so that the pending batch is handed back when
+        // the thread exits.
+        acquire_cache();
+    }
+    free_block *b = p;
+    slab *s = slab_of(p);
+    if (s->owner == own_cache) {
+        // A block of this thread.
+        b->next = own_cache->free[s->size_class];
+        own_cache->free[s->size_class] = b;
+        return;
+    }
+    // A block of another thread, added to the pending batch.
+    if (pending_owner != s->owner) {
+        flush_pending();
+        pending_owner = s->owner;
+    }
+    b->next = pending_first;
+    pending_first = b;
+    if (pending_last == NULL) {
+        pending_last = b;
+    }
+    pending_count++;
+    if (pending_count == BATCH_SIZE) {
+        flush_pending();
+    }
+}
+
+// The allocator. It has no state of its own besides the caches.
+static const allocator cellcache = {
+    cache_allocate, cache_deallocate, NULL
+};
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * cellcache_allocator() - Return the allocator with per-thread caches.
+ *
+ * Returns: A pointer to the allocator.
+ */
+const allocator *cellcache_allocator(void)
+{
+    return &cellcache;
+}
+
+/**
+ * cellcache_flush() - Hand back the blocks returned by this thread to
+ *                     the caches of other threads.
+ *
+ * Returns: Nothing.
+ */
+void cellcache_flush(void)
+{
+    flush_pending();
+}
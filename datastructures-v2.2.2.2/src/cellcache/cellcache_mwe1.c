@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include <cellcache.h>
+#include <stack.h>
+#include <list.h>
+
+/*
+ * Minimum working example for cellcache.c. A producer thread pushes
+ * numbers on a stack whose cells come from the per-thread caches. A
+ * consumer thread then pops the numbers and inserts the even ones in
+ * a list that also uses the caches. The cells of the stack are thus
+ * allocated by one thread and returned by another, and are handed
+ * back to the cache of the producer in batches. Both threads call
+ * cellcache_flush when they are done.
+ *
+ * Must be linked with -pthread.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+#define N 20
+
+// The numbers, shared by the threads.
+static int numbers[N];
+
+// Push the numbers on a stack.
+void *produce(void *arg)
+{
+    stack *s = arg;
+    for (int i = 0; i < N; i++) {
+        numbers[i] = i;
+        s = stack_push(s, &numbers[i]);
+    }
+    cellcache_flush();
+    return s;
+}
+
+// Pop the numbers from the stack and insert the even ones in a list.
+void *consume(void *arg)
+{
+    stack *s = arg;
+    list *l = list_empty_with_allocator(NULL, cellcache_allocator());
+    while (!stack_is_empty(s)) {
+        int *v = stack_top(s);
+        if (*v % 2 == 0) {
+            list_insert(l, v, list_end(l));
+        }
+        s = stack_pop(s);
+    }
+    cellcache_flush();
+    return l;
+}
+
+// Print an int value.
+void print_int(const void *value)
+{
+    printf("%d", *(const int *)value);
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Stack and list cells shared by two threads.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    stack *s = stack_empty_with_allocator(NULL, cellcache_allocator());
+
+    pthread_t producer, consumer;
+    void *result;
+
+    pthread_create(&producer, NULL, produce, s);
+    pthread_join(producer, &result);
+    s = result;
+
+    pthread_create(&consumer, NULL, consume, s);
+    pthread_join(consumer, &result);
+    list *l = result;
+
+    printf("Even numbers in the order they were popped: ");
+    list_print(l, print_int);
+
+    stack_kill(s);
+    list_kill(l);
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
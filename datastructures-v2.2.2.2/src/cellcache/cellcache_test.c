@@ -0,0 +1,307 @@
+/*
+ * cellcache_test - test the allocator with per-thread cell caches.
+ *
+ * Should be compiled together with the allocator implementation that
+ * follows the interface in cellcache.h, and with the dlist, list and
+ * stack implementations, of the code base for the Datastructures and
+ * Algorithms courses at the Department of Computing Science, Umea
+ * University. Must be linked with -pthread.
+ *
+ * The program runs a number of correctness tests, and exits with an
+ * error message at the first failure.
+ *
+ * 2026-10-18 v1.0  First public version.
+ * 2026-10-18 v1.1  The helpers shared with the other tests, and the
+ *                  monotonic clock of the timing, come from testutil.c.
+ * 2026-10-18 v1.2  Moved from ou3/cellcachetest.c to
+ *                  src/cellcache/cellcache_test.c. The speed test and
+ *                  its command line arguments are removed.
+*/
+
+#define VERSION "v1.2"
+#define VERSION_DATE "2026-10-18"
+
+/*
+ * Correctness testing algorithm:
+ *
+ * 1. Tests that the blocks of the allocator are aligned,
+ *    zero-initialized and not shared between allocations, for sizes
+ *    handled by the caches and larger sizes, and that a block returned
+ *    by a thread is reused by its next allocation of the same size.
+ * 2. Tests that blocks allocated by one thread and returned by another
+ *    are handed back to the first thread, i.e. that the blocks used by
+ *    repeated rounds of such allocations do not grow.
+ * 3. Tests that the cache of a thread that has exited is taken over by
+ *    the next thread.
+ * 4. Tests that a dlist, a list and a stack built by one thread and
+ *    emptied and killed by another hold their elements, and that their
+ *    kill functions are called for each element.
+ * */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "cellcache.h"
+#include "dlist.h"
+#include "list.h"
+#include "stack.h"
+#include "testutil.h"
+
+// The number of blocks per round in test_cross_thread.
+#define ROUND_BLOCKS 10000
+
+// The number of calls to count_kill.
+static int kill_count;
+
+// Kill function that frees and counts the killed elements.
+void count_kill(void *p)
+{
+    free(p);
+    kill_count++;
+}
+
+/* Compares two addresses, for qsort.
+ */
+int address_compare(const void *p1, const void *p2)
+{
+    uintptr_t a1=*(const uintptr_t *)p1;
+    uintptr_t a2=*(const uintptr_t *)p2;
+    return (a1 > a2) - (a1 < a2);
+}
+
+/* Tests the alignment, zero-initialization and separation of the
+ * blocks, and the reuse of a returned block.
+ */
+void test_allocations()
+{
+    const allocator *alloc=cellcache_allocator();
+    const size_t sizes[]={ 1, 8, 16, 24, 33, 100, 128, 129, 1000 };
+    const int count=sizeof(sizes)/sizeof(sizes[0]);
+    unsigned char *p[3*9];
+
+    for(int round=0;round<2;round++) {
+        check_allocations(alloc,sizes,count,p,round);
+        for(int i=0;i<3*count;i++) {
+            alloc->deallocate(alloc->context,p[i],sizes[i%count]);
+        }
+    }
+
+    // A returned cell is the next one handed out for its size.
+    for(int i=0;i<count;i++) {
+        if (sizes[i]>128) {
+            continue;
+        }
+        void *q=alloc->allocate(alloc->context,sizes[i]);
+        alloc->deallocate(alloc->context,q,sizes[i]);
+        void *r=alloc->allocate(alloc->context,sizes[i]);
+        if (r!=q) {
+            printf("A returned block of %zu bytes is not reused.\n",sizes[i]);
+            exit(EXIT_FAILURE);
+        }
+        alloc->deallocate(alloc->context,r,sizes[i]);
+    }
+    printf("Blocks are aligned, zero-initialized, separate and reused. - OK\n");
+}
+
+/* Thread that checks and returns the blocks allocated by another
+ * thread. The blocks start with their index.
+ */
+void *return_blocks(void *arg)
+{
+    const allocator *alloc=cellcache_allocator();
+    void **blocks=arg;
+    for(int i=0;i<ROUND_BLOCKS;i++) {
+        if (*(int *)blocks[i]!=i) {
+            printf("Block %d was changed before it was returned.\n",i);
+            exit(EXIT_FAILURE);
+        }
+        alloc->deallocate(alloc->context,blocks[i],32);
+    }
+    cellcache_flush();
+    return NULL;
+}
+
+/* Tests that blocks returned by another thread are handed back to the
+ * cache of the thread that allocated them.
+ */
+void test_cross_thread()
+{
+    const allocator *alloc=cellcache_allocator();
+    const int rounds=5;
+    void **blocks=malloc(ROUND_BLOCKS*sizeof(void *));
+    uintptr_t *seen=malloc(rounds*ROUND_BLOCKS*sizeof(uintptr_t));
+
+    for(int r=0;r<rounds;r++) {
+        for(int i=0;i<ROUND_BLOCKS;i++) {
+            blocks[i]=alloc->allocate(alloc->context,32);
+            *(int *)blocks[i]=i;
+            seen[r*ROUND_BLOCKS+i]=(uintptr_t)blocks[i];
+        }
+        pthread_t t;
+        pthread_create(&t,NULL,return_blocks,blocks);
+        pthread_join(t,NULL);
+    }
+
+    // Count the distinct blocks used by all rounds. If the blocks
+    // were not handed back, each round would use new blocks.
+    qsort(seen,rounds*ROUND_BLOCKS,sizeof(uintptr_t),address_compare);
+    int distinct=0;
+    for(int i=0;i<rounds*ROUND_BLOCKS;i++) {
+        if (i==0 || seen[i]!=seen[i-1]) {
+            distinct++;
+        }
+    }
+    if (distinct>=2*ROUND_BLOCKS) {
+        printf("%d rounds of %d blocks returned by another thread used "
+               "%d distinct blocks.\n",rounds,ROUND_BLOCKS,distinct);
+        exit(EXIT_FAILURE);
+    }
+    free(blocks);
+    free(seen);
+    printf("Blocks returned by another thread are handed back. - OK\n");
+}
+
+/* Thread that allocates a block of 48 bytes and returns it, and
+ * passes on its address.
+ */
+void *allocate_and_return(void *arg)
+{
+    const allocator *alloc=cellcache_allocator();
+    void *p=alloc->allocate(alloc->context,48);
+    alloc->deallocate(alloc->context,p,48);
+    *(void **)arg=p;
+    return NULL;
+}
+
+/* Tests that the cache of a thread that has exited is taken over by
+ * the next thread.
+ */
+void test_thread_exit()
+{
+    void *first, *second;
+    pthread_t t;
+    pthread_create(&t,NULL,allocate_and_return,&first);
+    pthread_join(t,NULL);
+    pthread_create(&t,NULL,allocate_and_return,&second);
+    pthread_join(t,NULL);
+    if (first!=second) {
+        printf("The cache of an exited thread was not taken over.\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("The cache of an exited thread is taken over. - OK\n");
+}
+
+// The containers passed between the threads of test_containers.
+typedef struct containers {
+    int *elements;
+    int n;
+    dlist *d;
+    list *l;
+    stack *s;
+} containers;
+
+/* Thread that builds the containers.
+ */
+void *build_containers(void *arg)
+{
+    containers *c=arg;
+    const allocator *alloc=cellcache_allocator();
+    c->d=dlist_empty_with_allocator(count_kill,alloc);
+    c->l=list_empty_with_allocator(count_kill,alloc);
+    c->s=stack_empty_with_allocator(count_kill,alloc);
+    for(int i=0;i<c->n;i++) {
+        int *v=malloc(sizeof(int));
+        *v=c->elements[i];
+        dlist_insert(c->d,v,dlist_first(c->d));
+        v=malloc(sizeof(int));
+        *v=c->elements[i];
+        list_insert(c->l,v,list_end(c->l));
+        v=malloc(sizeof(int));
+        *v=c->elements[i];
+        c->s=stack_push(c->s,v);
+    }
+    return NULL;
+}
+
+/* Thread that checks the containers, removes half of the elements and
+ * kills the containers.
+ */
+void *empty_containers(void *arg)
+{
+    containers *c=arg;
+    dlist_pos dp=dlist_first(c->d);
+    list_pos lp=list_first(c->l);
+    for(int i=0;i<c->n;i++) {
+        int expected=c->elements[c->n-1-i];
+        if (*(int *)dlist_inspect(c->d,dp)!=expected
+            || *(int *)list_inspect(c->l,lp)!=c->elements[i]
+            || *(int *)stack_top(c->s)!=expected) {
+            printf("Element %d of a container built by another "
+                   "thread is wrong.\n",i);
+            exit(EXIT_FAILURE);
+        }
+        if (i%2==0) {
+            dp=dlist_remove(c->d,dp);
+            lp=list_remove(c->l,lp);
+            c->s=stack_pop(c->s);
+        } else {
+            dp=dlist_next(c->d,dp);
+            lp=list_next(c->l,lp);
+            c->s=stack_pop(c->s);
+        }
+    }
+    dlist_kill(c->d);
+    list_kill(c->l);
+    stack_kill(c->s);
+    return NULL;
+}
+
+/* Tests containers built by one thread and emptied by another.
+ */
+void test_containers()
+{
+    const int n=1000;
+    int elements[1000];
+    for(int i=0;i<n;i++) {
+        elements[i]=i*7919%1000;
+    }
+    containers c={ elements, n, NULL, NULL, NULL };
+    kill_count=0;
+
+    pthread_t t;
+    pthread_create(&t,NULL,build_containers,&c);
+    pthread_join(t,NULL);
+    pthread_create(&t,NULL,empty_containers,&c);
+    pthread_join(t,NULL);
+
+    if (kill_count!=3*n) {
+        printf("The kill functions were called %d times, expected %d.\n",
+               kill_count,3*n);
+        exit(EXIT_FAILURE);
+    }
+    printf("Containers built by one thread and emptied by another. - OK\n");
+}
+
+/*  Tests the allocator by performing a set of tests. Program exits if
+ *  any error is found.
+ */
+void correctness_test()
+{
+    test_allocations();
+    test_cross_thread();
+    test_thread_exit();
+    test_containers();
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Test program for the cellcache allocator.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s.\n\n", CODE_BASE_VERSION);
+
+    correctness_test();
+
+    printf("\nAll correctness tests succeeded! Normal exit.\n");
+    return 0;
+}
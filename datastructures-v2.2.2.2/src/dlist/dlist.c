@@ -23,6 +23,9 @@
  *   v2.0  2024-03-14: Added dlist_print_internal to output dot code for visualization.
  *                     Renamed free_* stuff to kill_*. Converted to 4-tabs.
  *   v2.1  2024-05-10: Updated print_internal with improved encapsulation.
+ *   v2.2  2026-10-18: Added dlist_empty_with_allocator.
+ *   v2.3  2026-10-18: dlist_kill returns at once if there is nothing to
+ *                     return cell by cell, e.g. for a list in an arena.
  */
 
 // ===========INTERNAL DATA TYPES============
@@ -41,6 +44,7 @@ typedef struct cell {
 struct dlist {
     cell *head;
     kill_function kill_func;
+    const allocator *alloc; // Allocator for the list and its cells
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
@@ -54,17 +58,35 @@ struct dlist {
  */
 dlist *dlist_empty(kill_function kill_func)
 {
+    return dlist_empty_with_allocator(kill_func, NULL);
+}
+
+/**
+ * dlist_empty_with_allocator() - Create an empty dlist with a given allocator.
+ * @kill_func: A pointer to a function (or NULL) to be called to
+ *             de-allocate memory on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the list
+ *         and its elements. Must remain valid until the list is killed.
+ *
+ * Returns: A pointer to the new list.
+ */
+dlist *dlist_empty_with_allocator(kill_function kill_func, const allocator *alloc)
+{
+    if (alloc == NULL) {
+        alloc = default_allocator();
+    }
     // Allocate memory for the list structure.
-    dlist *l = calloc(1, sizeof(*l));
+    dlist *l = alloc->allocate(alloc->context, sizeof(*l));
 
     // Allocate memory for the list head.
-    l->head = calloc(1, sizeof(cell));
+    l->head = alloc->allocate(alloc->context, sizeof(cell));
 
     // No elements in list so far.
     l->head->next = NULL;
 
-    // Store the kill function.
+    // Store the kill function and the allocator.
     l->kill_func = kill_func;
+    l->alloc = alloc;
 
     return l;
 }
@@ -155,7 +177,7 @@ void *dlist_inspect(const dlist *l, const dlist_pos p)
 dlist_pos dlist_insert(dlist *l, void *v, const dlist_pos p)
 {
     // Create new element.
-    dlist_pos new_pos=calloc(1, sizeof(cell));
+    dlist_pos new_pos=l->alloc->allocate(l->alloc->context, sizeof(cell));
     // Set value.
     new_pos->val=v;
 
@@ -191,7 +213,7 @@ dlist_pos dlist_remove(dlist *l, const dlist_pos p)
         l->kill_func(c->val);
     }
     // Free the memory allocated to the cell itself.
-    free(c);
+    allocator_deallocate(l->alloc, c, sizeof(cell));
     // Return the position of the next element.
     return p;
 }
@@ -208,6 +230,12 @@ dlist_pos dlist_remove(dlist *l, const dlist_pos p)
  */
 void dlist_kill(dlist *l)
 {
+    if (l->alloc->deallocate == NULL && l->kill_func == NULL) {
+        // No cell or element is returned on its own. The memory is
+        // returned at once by the owner of the allocator.
+        return;
+    }
+
     // Use public functions to traverse the list.
 
     // Start with the first element (will be defined even for an
@@ -220,8 +248,8 @@ void dlist_kill(dlist *l)
     }
 
     // Free the head and the list itself.
-    free(l->head);
-    free(l);
+    allocator_deallocate(l->alloc, l->head, sizeof(cell));
+    allocator_deallocate(l->alloc, l, sizeof(*l));
 }
 
 /**
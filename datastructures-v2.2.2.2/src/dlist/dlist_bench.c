@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <dlist.h>
+#include "bench.h"
+
+/*
+ * Benchmark for dlist.c. Times insertions at the front of a directed
+ * list, a traversal that inspects every element, and removals from
+ * the front, with the harness of ../bench/bench.h.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First public version.
+ */
+
+// The sum of the inspected values, so the traversal is not optimized away.
+static volatile long sink;
+
+// Create an array with the values 0..n-1, for the list to point to.
+static int *make_values(int n)
+{
+    int *values = malloc(n * sizeof(values[0]));
+    for (int i = 0; i < n; i++) {
+        values[i] = i;
+    }
+    return values;
+}
+
+// Create a list that points to the n values.
+static dlist *filled_dlist(int *values, int n)
+{
+    dlist *l = dlist_empty(NULL);
+    for (int i = 0; i < n; i++) {
+        dlist_insert(l, &values[i], dlist_first(l));
+    }
+    return l;
+}
+
+// Time n insertions at the front of an empty list.
+static unsigned long long time_insert(int n)
+{
+    int *values = make_values(n);
+    dlist *l = dlist_empty(NULL);
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        dlist_insert(l, &values[i], dlist_first(l));
+    }
+    unsigned long long end = bench_nanoseconds();
+    dlist_kill(l);
+    free(values);
+    return end - start;
+}
+
+// Time a traversal of a list with n elements.
+static unsigned long long time_iterate(int n)
+{
+    int *values = make_values(n);
+    dlist *l = filled_dlist(values, n);
+    long sum = 0;
+    unsigned long long start = bench_nanoseconds();
+    for (dlist_pos p = dlist_first(l); !dlist_is_end(l, p); p = dlist_next(l, p)) {
+        sum += *(int *)dlist_inspect(l, p);
+    }
+    unsigned long long end = bench_nanoseconds();
+    sink = sum;
+    dlist_kill(l);
+    free(values);
+    return end - start;
+}
+
+// Time the removal of all n elements of a list, from the front.
+static unsigned long long time_remove(int n)
+{
+    int *values = make_values(n);
+    dlist *l = filled_dlist(values, n);
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        dlist_remove(l, dlist_first(l));
+    }
+    unsigned long long end = bench_nanoseconds();
+    dlist_kill(l);
+    free(values);
+    return end - start;
+}
+
+static const bench_phase phases[] = {
+    { "insert", time_insert },
+    { "iterate", time_iterate },
+    { "remove", time_remove },
+};
+
+int main(int argc, char *argv[])
+{
+    return bench_main("dlist", phases, sizeof(phases) / sizeof(phases[0]),
+                      argc, argv);
+}
@@ -0,0 +1,728 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <eftable.h>
+
+/*
+ * Implementation of a compressed, read-only table with integer keys
+ * and integer values for the "Datastructures and algorithms" courses
+ * at the Department of Computing Science, Umea University.
+ *
+ * The keys are stored with Elias-Fano encoding. Each key x is first
+ * made relative to the smallest key, and then split into its
+ * low_bits lowest bits and the remaining high part h = x >> low_bits,
+ * where low_bits is about log2(u/n) for n keys in a range of u
+ * integers. The low parts are packed after each other in the array
+ * low. The high parts are stored in unary in the array high: the keys
+ * with the high part h form bucket h, and each bucket is written as
+ * one bit set per key followed by one bit unset. Key i thus sets bit
+ * h + i, and the bucket h starts directly after the h:th bit unset.
+ *
+ * To find bucket h without scanning the whole array, the position of
+ * every SAMPLE_RATE:th bit unset is stored in zero_samples. A lookup
+ * starts at the closest sample and counts the bits unset one word at
+ * a time. Since there are at most two buckets per key, a bucket holds
+ * about one key on average, and the low parts of the bucket are
+ * compared in order. The position of every SAMPLE_RATE:th bit set is
+ * stored in one_samples in the same way, and is used to find the key
+ * with a given index.
+ *
+ * The values are made relative to the smallest value and packed with
+ * value_bits bits each in the array values.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// The number of bits in a word of the bit arrays.
+#define WORD_BITS 64
+
+// The position of every SAMPLE_RATE:th bit set and bit unset of the
+// high array is sampled.
+#define SAMPLE_RATE 256
+
+// ===========INTERNAL DATA TYPES ============
+
+struct eftable {
+    int n;               // Number of key/value pairs
+    int min_key;         // The smallest key, subtracted from all keys
+    int low_bits;        // Number of low bits of each key
+    uint64_t *low;       // The low bits of the keys, n * low_bits bits
+    long high_len;       // Number of bits in high
+    int bucket_count;    // Number of buckets, i.e. bits unset in high
+    uint64_t *high;      // The high parts of the keys, in unary
+    long *one_samples;   // Position of bit set number k * SAMPLE_RATE
+    long *zero_samples;  // Position of bit unset number k * SAMPLE_RATE
+    int min_value;       // The smallest value, subtracted from all values
+    int value_bits;      // Number of bits of each value
+    uint64_t *values;    // The values, n * value_bits bits
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
+
+// Return the number of words allocated for a bit array of a given
+// number of bits. One extra word is kept, so that a bit array is
+// never empty.
+static long word_count(long bits)
+{
+    return bits / WORD_BITS + 1;
+}
+
+// Return the number of samples of an array with a given number of
+// sampled bits.
+static long sample_count(long bits)
+{
+    return (bits + SAMPLE_RATE - 1) / SAMPLE_RATE;
+}
+
+// Return the number of bits needed to store numbers from 0 to max.
+static int bits_needed(uint64_t max)
+{
+    int bits = 0;
+    while (bits < WORD_BITS && (max >> bits) != 0) {
+        bits++;
+    }
+    return bits;
+}
+
+// Return width bits from a bit array, starting at bit pos. The bits
+// may span two words.
+static uint64_t get_bits(const uint64_t *a, long pos, int width)
+{
+    if (width == 0) {
+        return 0;
+    }
+    long w = pos / WORD_BITS;
+    int offset = pos % WORD_BITS;
+    uint64_t v = a[w] >> offset;
+    if (offset + width > WORD_BITS) {
+        v |= a[w + 1] << (WORD_BITS - offset);
+    }
+    return width == WORD_BITS ? v : v & ((UINT64_C(1) << width) - 1);
+}
+
+// Store width bits in a bit array at bit pos. The bits must be unset
+// before the call.
+static void set_bits(uint64_t *a, long pos, int width, uint64_t v)
+{
+    if (width == 0) {
+        return;
+    }
+    long w = pos / WORD_BITS;
+    int offset = pos % WORD_BITS;
+    a[w] |= v << offset;
+    if (offset + width > WORD_BITS) {
+        a[w + 1] |= v >> (WORD_BITS - offset);
+    }
+}
+
+// Return true if bit pos of a bit array is set.
+static bool get_bit(const uint64_t *a, long pos)
+{
+    return (a[pos / WORD_BITS] >> (pos % WORD_BITS)) & 1;
+}
+
+// Return the number of bits set in a word.
+static int popcount(uint64_t x)
+{
+    x = x - ((x >> 1) & UINT64_C(0x5555555555555555));
+    x = (x & UINT64_C(0x3333333333333333)) + ((x >> 2) & UINT64_C(0x3333333333333333));
+    x = (x + (x >> 4)) & UINT64_C(0x0f0f0f0f0f0f0f0f);
+    return (x * UINT64_C(0x0101010101010101)) >> 56;
+}
+
+// Return the position in the word x of its bit set number r, counted
+// from 0. The word must have more than r bits set.
+static int select_in_word(uint64_t x, int r)
+{
+    // Skip whole bytes...
+    int pos = 0;
+    for (int count = popcount(x & 0xff); r >= count; count = popcount(x & 0xff)) {
+        r -= count;
+        x >>= 8;
+        pos += 8;
+    }
+    // ...and then single bits.
+    for (;; x >>= 1, pos++) {
+        if ((x & 1) && r-- == 0) {
+            return pos;
+        }
+    }
+}
+
+// Return the position in the high array of bit number r among the
+// bits set (if one is true) or the bits unset (if one is false),
+// counted from 0. Starts at the closest sample and counts the bits
+// of one word at a time.
+static long select_bit(const eftable *t, bool one, long r)
+{
+    const long *samples = one ? t->one_samples : t->zero_samples;
+    long pos = samples[r / SAMPLE_RATE];
+    r %= SAMPLE_RATE;
+
+    long w = pos / WORD_BITS;
+    uint64_t x = one ? t->high[w] : ~t->high[w];
+    // Skip the bits before the sampled position.
+    x &= ~UINT64_C(0) << (pos % WORD_BITS);
+    for (;;) {
+        int count = popcount(x);
+        if (r < count) {
+            return w * WORD_BITS + select_in_word(x, r);
+        }
+        r -= count;
+        w++;
+        x = one ? t->high[w] : ~t->high[w];
+    }
+}
+
+// Return the value of pair i.
+static int value_at(const eftable *t, long i)
+{
+    uint64_t v = get_bits(t->values, i * t->value_bits, t->value_bits);
+    return (int)((int64_t)t->min_value + (int64_t)v);
+}
+
+// Fill in the samples of the high array.
+static void sample_high(eftable *t)
+{
+    long ones = 0;
+    long zeros = 0;
+    for (long pos = 0; pos < t->high_len; pos++) {
+        if (get_bit(t->high, pos)) {
+            if (ones % SAMPLE_RATE == 0) {
+                t->one_samples[ones / SAMPLE_RATE] = pos;
+            }
+            ones++;
+        } else {
+            if (zeros % SAMPLE_RATE == 0) {
+                t->zero_samples[zeros / SAMPLE_RATE] = pos;
+            }
+            zeros++;
+        }
+    }
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * eftable_create() - Create a table from arrays of keys and values.
+ * @keys: The keys, in strictly increasing order.
+ * @values: The values, where values[i] belongs to keys[i].
+ * @n: The number of key/value pairs.
+ *
+ * The table keeps no reference to the arrays, which may be reused or
+ * deallocated directly after the call.
+ *
+ * Returns: A pointer to the new table, or NULL if n is negative, if
+ * the keys are not strictly increasing, or if not enough memory was
+ * available.
+ */
+eftable *eftable_create(const int *keys, const int *values, int n)
+{
+    if (n < 0) {
+        return NULL;
+    }
+    for (int i = 1; i < n; i++) {
+        if (keys[i] <= keys[i - 1]) {
+            return NULL;
+        }
+    }
+
+    eftable *t = calloc(1, sizeof(*t));
+    if (t == NULL) {
+        return NULL;
+    }
+    t->n = n;
+
+    // The keys are relative to the smallest key, and the values to
+    // the smallest value.
+    uint64_t universe = 0;
+    uint64_t value_range = 0;
+    if (n > 0) {
+        t->min_key = keys[0];
+        universe = (uint64_t)((int64_t)keys[n - 1] - keys[0]) + 1;
+        int max_value = values[0];
+        t->min_value = values[0];
+        for (int i = 1; i < n; i++) {
+            if (values[i] < t->min_value) {
+                t->min_value = values[i];
+            }
+            if (values[i] > max_value) {
+                max_value = values[i];
+            }
+        }
+        value_range = (uint64_t)((int64_t)max_value - t->min_value);
+        // Use floor(log2(u/n)) low bits, so that there are at most
+        // two buckets per key.
+        t->low_bits = bits_needed(universe / n) - 1;
+        t->bucket_count = ((universe - 1) >> t->low_bits) + 1;
+    }
+    t->value_bits = bits_needed(value_range);
+    t->high_len = (long)n + t->bucket_count;
+
+    t->low = calloc(word_count((long)n * t->low_bits), sizeof(*t->low));
+    t->high = calloc(word_count(t->high_len), sizeof(*t->high));
+    t->one_samples = calloc(sample_count(n) + 1, sizeof(*t->one_samples));
+    t->zero_samples = calloc(sample_count(t->bucket_count) + 1, sizeof(*t->zero_samples));
+    t->values = calloc(word_count((long)n * t->value_bits), sizeof(*t->values));
+    if (t->low == NULL || t->high == NULL || t->one_samples == NULL
+        || t->zero_samples == NULL || t->values == NULL) {
+        eftable_kill(t);
+        return NULL;
+    }
+
+    uint64_t low_mask = (UINT64_C(1) << t->low_bits) - 1;
+    for (long i = 0; i < n; i++) {
+        uint64_t x = (uint64_t)((int64_t)keys[i] - t->min_key);
+        set_bits(t->low, i * t->low_bits, t->low_bits, x & low_mask);
+        long pos = (long)(x >> t->low_bits) + i;
+        t->high[pos / WORD_BITS] |= UINT64_C(1) << (pos % WORD_BITS);
+        set_bits(t->values, i * t->value_bits, t->value_bits,
+                 (uint64_t)((int64_t)values[i] - t->min_value));
+    }
+    sample_high(t);
+
+    return t;
+}
+
+/**
+ * eftable_is_empty() - Check if a table is empty.
+ * @t: Table to check.
+ *
+ * Returns: True if the table contains no key/value pairs, false otherwise.
+ */
+bool eftable_is_empty(const eftable *t)
+{
+    return t->n == 0;
+}
+
+/**
+ * eftable_size() - Return the number of key/value pairs in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The number of key/value pairs.
+ */
+int eftable_size(const eftable *t)
+{
+    return t->n;
+}
+
+/**
+ * eftable_lookup() - Look up a given key in a table.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ * @value: Pointer to where the value of the key is stored, or NULL.
+ *
+ * Returns: True if the key is found in the table, false otherwise.
+ * The value is only stored if the key is found and value is non-NULL.
+ */
+bool eftable_lookup(const eftable *t, int key, int *value)
+{
+    if (t->n == 0 || key < t->min_key) {
+        return false;
+    }
+    uint64_t x = (uint64_t)((int64_t)key - t->min_key);
+    uint64_t h = x >> t->low_bits;
+    if (h >= (uint64_t)t->bucket_count) {
+        return false;
+    }
+    uint64_t low = x & ((UINT64_C(1) << t->low_bits) - 1);
+
+    // Bucket h starts directly after bit unset number h-1, and the
+    // bits before it are the keys of the earlier buckets.
+    long pos = h == 0 ? 0 : select_bit(t, false, h - 1) + 1;
+    long i = pos - (long)h;
+
+    // The low parts within a bucket are increasing.
+    while (get_bit(t->high, pos)) {
+        uint64_t l = get_bits(t->low, i * t->low_bits, t->low_bits);
+        if (l == low) {
+            if (value != NULL) {
+                *value = value_at(t, i);
+            }
+            return true;
+        }
+        if (l > low) {
+            return false;
+        }
+        pos++;
+        i++;
+    }
+    return false;
+}
+
+/**
+ * eftable_inspect_key() - Return the key of a given pair.
+ * @t: Table to inspect.
+ * @i: Index of the pair, 0 <= i < eftable_size(t).
+ *
+ * The pairs are indexed in increasing key order, i.e. in the order
+ * they were given to eftable_create.
+ *
+ * Returns: The key of pair i.
+ */
+int eftable_inspect_key(const eftable *t, int i)
+{
+    // Key i sets bit h + i of the high array.
+    uint64_t h = select_bit(t, true, i) - i;
+    uint64_t low = get_bits(t->low, (long)i * t->low_bits, t->low_bits);
+    return (int)((int64_t)t->min_key + (int64_t)((h << t->low_bits) | low));
+}
+
+/**
+ * eftable_inspect_value() - Return the value of a given pair.
+ * @t: Table to inspect.
+ * @i: Index of the pair, 0 <= i < eftable_size(t).
+ *
+ * Returns: The value of pair i.
+ */
+int eftable_inspect_value(const eftable *t, int i)
+{
+    return value_at(t, i);
+}
+
+/**
+ * eftable_bytes() - Return the memory used by a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The number of bytes allocated for the table, including
+ * the head.
+ */
+size_t eftable_bytes(const eftable *t)
+{
+    return sizeof(*t)
+        + word_count((long)t->n * t->low_bits) * sizeof(*t->low)
+        + word_count(t->high_len) * sizeof(*t->high)
+        + (sample_count(t->n) + 1) * sizeof(*t->one_samples)
+        + (sample_count(t->bucket_count) + 1) * sizeof(*t->zero_samples)
+        + word_count((long)t->n * t->value_bits) * sizeof(*t->values);
+}
+
+/**
+ * eftable_kill() - Destroy a table.
+ * @t: Table to destroy.
+ *
+ * Return all dynamic memory used by the table.
+ *
+ * Returns: Nothing.
+ */
+void eftable_kill(eftable *t)
+{
+    free(t->low);
+    free(t->high);
+    free(t->one_samples);
+    free(t->zero_samples);
+    free(t->values);
+    free(t);
+}
+
+/**
+ * eftable_print() - Iterate over the table and print its pairs.
+ * @t: Table to print.
+ *
+ * Prints the key/value pairs in increasing key order.
+ *
+ * Returns: Nothing.
+ */
+void eftable_print(const eftable *t)
+{
+    printf("[ ");
+    for (int i = 0; i < t->n; i++) {
+        printf("[%d, %d]", eftable_inspect_key(t, i), eftable_inspect_value(t, i));
+        if (i < t->n - 1) {
+            printf(", ");
+        }
+    }
+    printf(" ]\n");
+}
+
+// ===========INTERNAL FUNCTIONS USED BY eftable_print_internal ============
+
+// The functions below output code in the dot language, used by
+// GraphViz. For documention of the dot language, see graphviz.org.
+
+/**
+ * indent() - Output indentation string.
+ * @n: Indentation level.
+ *
+ * Print n tab characters.
+ *
+ * Returns: Nothing.
+ */
+static void indent(int n)
+{
+    for (int i=0; i<n; i++) {
+        printf("\t");
+    }
+}
+
+/**
+ * iprintf(...) - Indent and print.
+ * @n: Indentation level
+ * @...: printf arguments
+ *
+ * Print n tab characters and calls printf.
+ *
+ * Returns: Nothing.
+ */
+static void iprintf(int n, const char *fmt, ...)
+{
+    // Indent...
+    indent(n);
+    // ...and call printf
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * print_edge() - Print a edge between two addresses.
+ * @from: The address of the start of the edge. Should be non-NULL.
+ * @to: The address of the destination for the edge, including NULL.
+ * @port: The name of the port on the source node, or NULL.
+ * @label: The label for the edge, or NULL.
+ * @options: A string with other edge options, or NULL.
+ *
+ * Print an edge from port PORT on node FROM to TO with label
+ * LABEL. If to is NULL, the destination is the NULL node, otherwise a
+ * memory node. If the port is NULL, the edge starts at the node, not
+ * a specific port on it. If label is NULL, no label is used. The
+ * options string, if non-NULL, is printed before the label.
+ *
+ * Returns: Nothing.
+ */
+static void print_edge(int indent_level, const void *from, const void *to, const char *port,
+                       const char *label, const char *options)
+{
+    indent(indent_level);
+    if (port) {
+        printf("m%04lx:%s -> ", PTR2ADDR(from), port);
+    } else {
+        printf("m%04lx -> ", PTR2ADDR(from));
+    }
+    if (to == NULL) {
+        printf("NULL");
+    } else {
+        printf("m%04lx", PTR2ADDR(to));
+    }
+    printf(" [");
+    if (options != NULL) {
+        printf("%s", options);
+    }
+    if (label != NULL) {
+        printf(" label=\"%s\"",label);
+    }
+    printf("]\n");
+}
+
+// Print width bits of a number, most significant bit first.
+static void print_binary(uint64_t v, int width)
+{
+    for (int b = width - 1; b >= 0; b--) {
+        putchar((v >> b) & 1 ? '1' : '0');
+    }
+}
+
+// Internal function to print the head node in dot format.
+static void print_head_node(int indent_level, const eftable *t)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"n\\n%d|min_key\\n%d"
+            "|low_bits\\n%d|<l>low\\n%04lx|high_len\\n%ld|bucket_count\\n%d"
+            "|<h>high\\n%04lx|<o>one_samples\\n%04lx|<z>zero_samples\\n%04lx"
+            "|min_value\\n%d|value_bits\\n%d|<v>values\\n%04lx\"]\n",
+            PTR2ADDR(t), t->n, t->min_key, t->low_bits, PTR2ADDR(t->low),
+            t->high_len, t->bucket_count, PTR2ADDR(t->high),
+            PTR2ADDR(t->one_samples), PTR2ADDR(t->zero_samples),
+            t->min_value, t->value_bits, PTR2ADDR(t->values));
+}
+
+// Internal function to print the low bits of the first max_elems keys
+// in dot format, one field per key.
+static void print_low(int indent_level, const eftable *t, int max_elems)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"", PTR2ADDR(t->low));
+    for (int i = 0; i < t->n && i < max_elems; i++) {
+        printf("%d\\n", i);
+        print_binary(get_bits(t->low, (long)i * t->low_bits, t->low_bits), t->low_bits);
+        if (i < t->n - 1) {
+            printf("|");
+        }
+    }
+    if (t->n > max_elems) {
+        printf("...");
+    }
+    printf("\"]\n");
+}
+
+// Internal function to print the high bits in dot format, one field
+// per bucket. The first max_buckets buckets are printed.
+static void print_high(int indent_level, const eftable *t, int max_buckets)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"", PTR2ADDR(t->high));
+    int bucket = 0;
+    for (long pos = 0; pos < t->high_len && bucket < max_buckets; pos++) {
+        bool bit = get_bit(t->high, pos);
+        putchar(bit ? '1' : '0');
+        if (!bit) {
+            // A bit unset ends the bucket.
+            bucket++;
+            if (bucket < t->bucket_count) {
+                printf("|");
+            }
+        }
+    }
+    if (t->bucket_count > max_buckets) {
+        printf("...");
+    }
+    printf("\"]\n");
+}
+
+// Internal function to print the sampled positions in dot format.
+static void print_samples(int indent_level, const long *samples, long count)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"", PTR2ADDR(samples));
+    for (long k = 0; k < count; k++) {
+        printf("%ld", samples[k]);
+        if (k < count - 1) {
+            printf("|");
+        }
+    }
+    printf("\"]\n");
+}
+
+// Internal function to print the first max_elems values in dot
+// format, one field per value.
+static void print_values(int indent_level, const eftable *t, int max_elems)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"", PTR2ADDR(t->values));
+    for (int i = 0; i < t->n && i < max_elems; i++) {
+        printf("%d\\n%d", i, value_at(t, i));
+        if (i < t->n - 1) {
+            printf("|");
+        }
+    }
+    if (t->n > max_elems) {
+        printf("...");
+    }
+    printf("\"]\n");
+}
+
+// Create an escaped version of the input string. The most common
+// control characters - newline, horizontal tab, backslash, and double
+// quote - are replaced by their escape sequence. The returned pointer
+// must be deallocated by the caller.
+static char *escape_chars(const char *s)
+{
+    int i, j;
+    int escaped = 0; // The number of chars that must be escaped.
+
+    // Count how many chars need to be escaped, i.e. how much longer
+    // the output string will be.
+    for (i = escaped = 0; s[i] != '\0'; i++) {
+        if (s[i] == '\n' || s[i] == '\t' || s[i] == '\\' || s[i] == '\"') {
+            escaped++;
+        }
+    }
+    // Allocate space for the escaped string. The variable i holds the input
+    // length, escaped how much the string will grow.
+    char *t = malloc(i + escaped + 1);
+
+    // Copy-and-escape loop
+    for (i = j = 0; s[i] != '\0'; i++) {
+        // Convert each control character by its escape sequence.
+        // Non-control characters are copied as-is.
+        switch (s[i]) {
+        case '\n': t[i+j] = '\\'; t[i+j+1] = 'n';  j++; break;
+        case '\t': t[i+j] = '\\'; t[i+j+1] = 't';  j++; break;
+        case '\\': t[i+j] = '\\'; t[i+j+1] = '\\'; j++; break;
+        case '\"': t[i+j] = '\\'; t[i+j+1] = '\"'; j++; break;
+        default:   t[i+j] = s[i]; break;
+        }
+    }
+    // Terminal the output string
+    t[i+j] = '\0';
+    return t;
+}
+
+/**
+ * eftable_print_internal() - Print the internal structure of the table in dot format.
+ * @t: Table to print.
+ * @desc: String with a description/state of the table, or NULL for no description.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the table and prints code that shows its internal
+ * structure, i.e. the head and the bit arrays with the keys and
+ * values.
+ *
+ * Returns: Nothing.
+ */
+void eftable_print_internal(const eftable *t, const char *desc, int indent_level)
+{
+    static int graph_number = 0;
+    graph_number++;
+    int il = indent_level;
+
+    if (indent_level == 0) {
+        // If this is the outermost datatype, start a graph...
+        printf("digraph EFTABLE_%d {\n", graph_number);
+
+        // Specify default shape and fontname
+        il++;
+        iprintf(il, "node [shape=rectangle fontname=\"Courier New\"]\n");
+        iprintf(il, "ranksep=0.01\n");
+    }
+
+    if (desc != NULL) {
+        // Escape the string before printout
+        char *escaped = escape_chars(desc);
+        // Use different names on inner description nodes
+        if (indent_level == 0) {
+            iprintf(il, "description [label=\"%s\"]\n", escaped);
+        } else {
+            iprintf(il, "cluster_eftable_%d_description [label=\"%s\"]\n", graph_number,
+                    escaped);
+        }
+        // Return the memory used by the escaped string
+        free(escaped);
+    }
+
+    if (indent_level == 0) {
+        // Use a single "pointer" edge as a starting point for the
+        // outermost datatype
+        iprintf(il, "t [label=\"%04lx\" xlabel=\"t\"]\n", PTR2ADDR(t));
+        iprintf(il, "t -> m%04lx\n", PTR2ADDR(t));
+    }
+
+    // Print the subgraph to surround the table content
+    iprintf(il, "subgraph cluster_eftable_%d { label=\"Elias-Fano table\"\n", graph_number);
+    il++;
+
+    // Output the head node and the arrays. Limit output to 20
+    // elements.
+    print_head_node(il, t);
+    print_low(il, t, 20);
+    print_high(il, t, 20);
+    print_samples(il, t->one_samples, sample_count(t->n));
+    print_samples(il, t->zero_samples, sample_count(t->bucket_count));
+    print_values(il, t, 20);
+
+    // Close the subgraph
+    il--;
+    iprintf(il, "}\n");
+
+    // Output the edges from the head
+    print_edge(il, t, t->low, "l", "low", NULL);
+    print_edge(il, t, t->high, "h", "high", NULL);
+    print_edge(il, t, t->one_samples, "o", "one_samples", NULL);
+    print_edge(il, t, t->zero_samples, "z", "zero_samples", NULL);
+    print_edge(il, t, t->values, "v", "values", NULL);
+
+    if (indent_level == 0) {
+        // Termination of graph
+        printf("}\n");
+    }
+}
@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <eftable.h>
+
+/*
+ * Minimum working example for eftable.c. Builds a table of the first
+ * 25 primes, where the value of each prime is its number in the
+ * sequence of primes, and looks up the numbers from 1 to 12. The
+ * arrays used to build the table are local, since the table keeps
+ * its own compressed copy of the keys and values.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+int main(void)
+{
+    printf("%s, %s %s: Create (integer, integer) table of primes.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    // The keys must be given in increasing order.
+    int primes[25];
+    int numbers[25];
+    int n = 0;
+    for (int k = 2; n < 25; k++) {
+        bool is_prime = true;
+        for (int i = 0; i < n && primes[i] * primes[i] <= k; i++) {
+            if (k % primes[i] == 0) {
+                is_prime = false;
+            }
+        }
+        if (is_prime) {
+            primes[n] = k;
+            numbers[n] = n + 1;
+            n++;
+        }
+    }
+
+    eftable *t = eftable_create(primes, numbers, n);
+
+    printf("Table with %d pairs:\n", eftable_size(t));
+    eftable_print(t);
+    printf("The table uses %lu bytes.\n\n", (unsigned long)eftable_bytes(t));
+
+    for (int k = 1; k <= 12; k++) {
+        int number;
+        if (eftable_lookup(t, k, &number)) {
+            printf("%d is prime number %d.\n", k, number);
+        } else {
+            printf("%d is not a prime.\n", k);
+        }
+    }
+
+    eftable_kill(t);
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
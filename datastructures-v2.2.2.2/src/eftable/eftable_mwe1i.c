@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <eftable.h>
+
+/*
+ * Minimum working example for eftable.c. Builds a table of 8
+ * key/value pairs and outputs dot/graphviz code to show the internal
+ * structure of the table, i.e. how the keys are split into low bits
+ * and buckets of high bits.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+// Print cut lines before and after a call eftable_print_internal.
+void print_internal_with_cut_lines(const eftable *t, const char *desc)
+{
+    // Internal counter that will be remembered between calls.
+
+    // Used to generate sequentially numbered -- CUT HERE -- marker lines
+    // to enable automatic parsing of the output.
+    static int cut = 1;
+
+    // Print starting marker line.
+    printf("\n--- START CUT HERE %d ---\n", cut);
+
+    // Call the internal print function to get the actual dot code.
+    eftable_print_internal(t, desc, 0);
+
+    // Print ending marker line
+    printf("--- END CUT HERE %d ---\n\n", cut);
+
+    // Increment the cut number. Will be remembered next time the
+    // function is called since cut is a static variable.
+    cut++;
+}
+
+// Print a message with intructions how to use the dot output. prog is
+// the name of the executable.
+void print_dot_usage(char *prog)
+{
+    printf("\nGenerate dot code to visualize internal structure with GraphViz. ");
+    printf("Use\n\n%s ", prog);
+    printf("| sed -n '/START CUT HERE X/,/END CUT HERE X/{//!p}' | dot -Tsvg > /tmp/dot.svg\n\n");
+    printf("to generate an svg file of cut X (replace X by the requested cut number).\n");
+    printf("The generated file can then be visualized with\n\n");
+    printf("firefox /tmp/dot.svg\n\n");
+    printf("Use -Tpng to generate a .png file instead. "
+           "See graphviz.org and %s for documentation.\n", __FILE__);
+
+    printf("\n--- Start of normal output ---\n\n");
+}
+
+int main(int argc, char *argv[])
+{
+    printf("%s, %s %s: Create (integer, integer) table.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    print_dot_usage(argv[0]);
+
+    int keys[] = { 3, 4, 7, 13, 14, 15, 21, 43 };
+    int values[] = { -1, 5, 2, 0, 7, 7, 3, 1 };
+
+    eftable *t = eftable_create(keys, values, 8);
+
+    printf("Table from the outside:\n");
+    eftable_print(t);
+    print_internal_with_cut_lines(t, __FILE__ ": Elias-Fano table with 8 keys "
+                                  "showing the inside structure.");
+
+    eftable_kill(t);
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
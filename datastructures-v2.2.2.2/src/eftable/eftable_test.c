@@ -0,0 +1,403 @@
+/*
+ * eftable_test - test the compressed table with integer keys.
+ *
+ * Should be compiled together with the Elias-Fano table
+ * implementation that follows the interface in eftable.h, and with the
+ * int_array_1d and perfect_table implementations, of the code base
+ * for the Datastructures and Algorithms courses at the Department of
+ * Computing Science, Umea University.
+ *
+ * The program is modelled on cache_test. It first runs a number of
+ * correctness tests and then compares the memory per pair and the
+ * time per lookup with the other ways to store a read-only set of
+ * integer pairs in the code base: an int_array_1d indexed by the key,
+ * a perfect_table with pointers to the keys and values, and a sorted
+ * array of pairs searched with binary search.
+ *
+ * 2026-10-18 v1.0  First public version.
+ * 2026-10-18 v1.1  The helpers shared with the other tests, and the
+ *                  monotonic clock of the timing, come from testutil.c.
+ * 2026-10-18 v1.2  The int_array_1d of the speed test gets the values
+ *                  at the keys, and its lookups are checked.
+ * 2026-10-18 v1.3  Moved from ou3/eftabletest.c to
+ *                  src/eftable/eftable_test.c.
+*/
+
+#define VERSION "v1.3"
+#define VERSION_DATE "2026-10-18"
+
+/*
+ * Correctness testing algorithm:
+ *
+ * 1. Tests that an empty table is empty, and that unsorted keys and
+ *    repeated keys are refused.
+ * 2. Tests tables with a single key, negative keys, and the smallest
+ *    and largest integers as keys and values.
+ * 3. Tests tables of random sorted keys, from dense to sparse sets,
+ *    of sizes around the sampling rate of the table. Every key must
+ *    be found with its value and index, and random numbers that are
+ *    not keys must not be found.
+ *
+ * There is also a module measuring the memory and the lookup time.
+ * */
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "eftable.h"
+#include "int_array_1d.h"
+#include "perfect_table.h"
+#include "testutil.h"
+
+// Maximum number of keys
+#define KEYSIZE 1000000
+
+// The number of lookups of each key in the speed test.
+#define ROUNDS 10
+
+/* Fills keys with n random, strictly increasing keys from the range
+ * lo to lo + spread*n - 1, and values with random values.
+ */
+void random_pairs(int *keys, int *values, int n, int lo, int spread)
+{
+    int k=lo;
+    for(int i=0;i<n;i++) {
+        k+=1+rand()%(2*spread-1);
+        keys[i]=k-1;
+        values[i]=rand()%1000-500;
+    }
+}
+
+/* Checks every pair of a table against the arrays it was built from.
+ */
+void check_table(const eftable *t, const int *keys, const int *values, int n)
+{
+    if (eftable_size(t)!=n || eftable_is_empty(t)!=(n==0)) {
+        printf("The table has %d pairs, expected %d.\n",
+               eftable_size(t),n);
+        exit(EXIT_FAILURE);
+    }
+    for(int i=0;i<n;i++) {
+        int v=~values[i];
+        if (!eftable_lookup(t,keys[i],&v) || v!=values[i]) {
+            printf("Key %d was not found with value %d.\n",
+                   keys[i],values[i]);
+            exit(EXIT_FAILURE);
+        }
+        if (eftable_inspect_key(t,i)!=keys[i]
+            || eftable_inspect_value(t,i)!=values[i]) {
+            printf("Pair %d is (%d, %d), expected (%d, %d).\n",i,
+                   eftable_inspect_key(t,i),eftable_inspect_value(t,i),
+                   keys[i],values[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/* Tests that an empty table is empty and that bad keys are refused.
+ */
+void test_empty_and_bad_keys()
+{
+    eftable *t=eftable_create(NULL,NULL,0);
+    int v=17;
+    if (t==NULL || !eftable_is_empty(t) || eftable_size(t)!=0
+        || eftable_lookup(t,0,&v) || v!=17) {
+        printf("An empty table is not empty.\n");
+        exit(EXIT_FAILURE);
+    }
+    eftable_kill(t);
+
+    int unsorted[]={ 1, 3, 2 };
+    int repeated[]={ 1, 2, 2 };
+    int values[]={ 0, 0, 0 };
+    if (eftable_create(unsorted,values,3)!=NULL
+        || eftable_create(repeated,values,3)!=NULL
+        || eftable_create(values,values,-1)!=NULL) {
+        printf("A table was created from bad keys.\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("An empty table is empty and bad keys are refused. - OK\n");
+}
+
+/* Tests tables with extreme keys and values.
+ */
+void test_extremes()
+{
+    int single_key[]={ 42 };
+    int single_value[]={ -7 };
+    eftable *t=eftable_create(single_key,single_value,1);
+    check_table(t,single_key,single_value,1);
+    if (eftable_lookup(t,41,NULL) || eftable_lookup(t,43,NULL)) {
+        printf("A table with a single key finds other keys.\n");
+        exit(EXIT_FAILURE);
+    }
+    eftable_kill(t);
+
+    int keys[]={ INT_MIN, INT_MIN+1, -1000000, -1, 0, 1, 65536, INT_MAX-1, INT_MAX };
+    int values[]={ INT_MAX, INT_MIN, 0, -1, 1, INT_MAX, INT_MIN, 5, -5 };
+    int n=sizeof(keys)/sizeof(keys[0]);
+    t=eftable_create(keys,values,n);
+    check_table(t,keys,values,n);
+    int others[]={ INT_MIN+2, -999999, -2, 2, 65535, 65537, INT_MAX-2 };
+    for(int i=0;i<sizeof(others)/sizeof(others[0]);i++) {
+        if (eftable_lookup(t,others[i],NULL)) {
+            printf("Key %d was found, but is not in the table.\n",
+                   others[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    eftable_kill(t);
+
+    int same[]={ 3, 3, 3 };
+    t=eftable_create(keys+3,same,3);
+    check_table(t,keys+3,same,3);
+    eftable_kill(t);
+    printf("Single keys, negative keys and extreme keys and values. - OK\n");
+}
+
+/* Tests tables of random keys with different densities and sizes.
+ */
+void test_random_tables()
+{
+    const int sizes[]={ 1, 2, 255, 256, 257, 1000, 5000 };
+    const int spreads[]={ 1, 2, 3, 100, 100000 };
+    int *keys=malloc(5000*sizeof(int));
+    int *values=malloc(5000*sizeof(int));
+
+    for(int s=0;s<sizeof(sizes)/sizeof(sizes[0]);s++) {
+        for(int d=0;d<sizeof(spreads)/sizeof(spreads[0]);d++) {
+            int n=sizes[s];
+            random_pairs(keys,values,n,-rand()%1000,spreads[d]);
+            eftable *t=eftable_create(keys,values,n);
+            check_table(t,keys,values,n);
+            // Random numbers around the keys must only be
+            // found if they are keys.
+            for(int i=0;i<2*n;i++) {
+                int k=keys[rand()%n]+rand()%(2*spreads[d]+1)-spreads[d];
+                bool found=bsearch(&k,keys,n,sizeof(int),
+                                   int_compare)!=NULL;
+                if (eftable_lookup(t,k,NULL)!=found) {
+                    printf("Key %d is %s, but was %s.\n",k,
+                           found ? "in the table" : "not in the table",
+                           found ? "not found" : "found");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            eftable_kill(t);
+        }
+    }
+    free(keys);
+    free(values);
+    printf("Random tables from dense to sparse keys. - OK\n");
+}
+
+/*  Tests the table by performing a set of tests. Program exits if any
+ *  error is found.
+ */
+void correctness_test()
+{
+    test_empty_and_bad_keys();
+    test_extremes();
+    test_random_tables();
+}
+
+// Sink for the looked up values, so the lookups are not optimized away.
+static volatile long checksum;
+
+/* Prints one line of the speed test.
+ *    id - the id of the measurement in the machine-readable table
+ *    name - the name of the structure
+ *    n - the number of keys
+ *    bytes - the number of bytes used for the pairs
+ *    us - the time for all lookups in microseconds
+ *    machine_table - true if we should output a machine-readable table
+ */
+void print_speed(int id, const char *name, int n, double bytes, unsigned long us,
+                 bool machine_table)
+{
+    double ns=1000.0*us/((double)ROUNDS*n);
+    if (machine_table) {
+        printf("%d, %d, %lu, %.1f, %.1f\n",id,n,us/1000,bytes/n,ns);
+    } else {
+        printf("%-14s: %7.1f bytes/pair, %6.1f ns/lookup\n",name,bytes/n,ns);
+    }
+}
+
+/* Measures the memory per pair and the time per lookup for n keys
+ * with an average distance spread between the keys. Half of the
+ * looked up keys are in the table.
+ *    id - the id of the first measurement in the machine-readable table
+ *    n - the number of keys
+ *    spread - the average distance between the keys
+ *    machine_table - true if we should output a machine-readable table
+ */
+void get_speed(int id, int n, int spread, bool machine_table)
+{
+    int *keys=malloc(n*sizeof(int));
+    int *values=malloc(n*sizeof(int));
+    int *queries=malloc(n*sizeof(int));
+    random_pairs(keys,values,n,0,spread);
+    for(int i=0;i<n;i++) {
+        // int_array_1d uses 0 for no value.
+        values[i]=1+rand()%1000;
+        queries[i]=i%2==0 ? keys[rand()%n] : rand()%(keys[n-1]+1);
+    }
+    if (!machine_table) {
+        printf("\n%d keys from 0 to %d:\n",n,keys[n-1]);
+    }
+
+    // The Elias-Fano table.
+    eftable *t=eftable_create(keys,values,n);
+    unsigned long start=get_microseconds();
+    for(int r=0;r<ROUNDS;r++) {
+        for(int i=0;i<n;i++) {
+            int v=0;
+            eftable_lookup(t,queries[i],&v);
+            checksum+=v;
+        }
+    }
+    print_speed(id,"eftable",n,eftable_bytes(t),get_microseconds()-start,
+                machine_table);
+    eftable_kill(t);
+
+    // An array indexed by the key, with a slot for every possible key.
+    int_array_1d *a=int_array_1d_create(0,keys[n-1]);
+    for(int i=0;i<n;i++) {
+        int_array_1d_set_value(a,values[i],keys[i]);
+    }
+    for(int i=0;i<n;i++) {
+        if (int_array_1d_inspect_value(a,keys[i])!=values[i]) {
+            printf("The int_array_1d has value %d for key %d, "
+                   "expected %d.\n",
+                   int_array_1d_inspect_value(a,keys[i]),keys[i],
+                   values[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    start=get_microseconds();
+    for(int r=0;r<ROUNDS;r++) {
+        for(int i=0;i<n;i++) {
+            checksum+=int_array_1d_inspect_value(a,queries[i]);
+        }
+    }
+    print_speed(id+1,"int_array_1d",n,((double)keys[n-1]+1)*sizeof(int),
+                get_microseconds()-start,machine_table);
+    int_array_1d_kill(a);
+
+    // A perfect table with pointers into the key and value arrays.
+    // The memory is a lower bound: a key, a value and a hash per
+    // slot, and the keys and values themselves.
+    void **key_ptrs=malloc(n*sizeof(void *));
+    void **value_ptrs=malloc(n*sizeof(void *));
+    for(int i=0;i<n;i++) {
+        key_ptrs[i]=&keys[i];
+        value_ptrs[i]=&values[i];
+    }
+    perfect_table *p=perfect_table_create(int_compare,int_hash,NULL,NULL,n,
+                                          key_ptrs,value_ptrs);
+    start=get_microseconds();
+    for(int r=0;r<ROUNDS;r++) {
+        for(int i=0;i<n;i++) {
+            const int *v=perfect_table_lookup(p,&queries[i]);
+            checksum+=v ? *v : 0;
+        }
+    }
+    print_speed(id+2,"perfect_table",n,
+                (double)n*(2*sizeof(void *)+sizeof(unsigned long)+2*sizeof(int)),
+                get_microseconds()-start,machine_table);
+    perfect_table_kill(p);
+    free(key_ptrs);
+    free(value_ptrs);
+
+    // Binary search in the sorted keys, with the values alongside.
+    start=get_microseconds();
+    for(int r=0;r<ROUNDS;r++) {
+        for(int i=0;i<n;i++) {
+            const int *k=bsearch(&queries[i],keys,n,sizeof(int),
+                                 int_compare);
+            checksum+=k ? values[k-keys] : 0;
+        }
+    }
+    print_speed(id+3,"sorted array",n,(double)n*2*sizeof(int),
+                get_microseconds()-start,machine_table);
+
+    free(keys);
+    free(values);
+    free(queries);
+}
+
+/* Tests the memory and the lookup speed of the table and the other
+ * structures for dense and sparse keys. The machine-readable table
+ * has the columns id, n, total time in ms, bytes per pair and time
+ * per lookup in ns. The ids come in groups of four: the Elias-Fano
+ * table, int_array_1d, perfect_table and the sorted array.
+ */
+void speed_test(int n,bool machine_table)
+{
+    const int spreads[]={ 2, 8, 32 };
+    int id=1;
+    for(int i=0;i<sizeof(spreads)/sizeof(spreads[0]);i++) {
+        get_speed(id,n,spreads[i],machine_table);
+        id+=4;
+    }
+}
+
+#define NAME "eftable_test"
+
+int main(int argc,char **argv)
+{
+    bool do_test=true; // Should we run the testing code?
+    bool machine_table=false; // Should we output a machine-readable table?
+    int n=-1;
+
+    fprintf(stderr,NAME " " VERSION " (" VERSION_DATE ")\n");
+    fprintf(stderr, "Code base version %s.\n\n", CODE_BASE_VERSION);
+
+    for (int i=1; i<argc; i++) {
+        // Parse each argument
+        char *s=argv[i];
+        if (strlen(s)>0 && s[0]=='-') {
+            switch (s[1]) {
+            case 'n':
+                do_test=false;
+                break;
+            case 't':
+                machine_table=true;
+                break;
+            default:
+                fprintf(stderr,"%s: Bad switch: %s.\n",
+                        argv[0],s);
+                exit(EXIT_FAILURE);
+            }
+        } else {
+            // Convert string to integer.
+            n=atoi(s);
+            break;
+        }
+    }
+
+    if (n<0) {
+        fprintf(stderr,"Usage:\n\t%s [-n] [-t] n\n"
+                "\twhere n is the number of keys, an integer from 100 to %d.\n\n"
+                "\tUse -n (no-test) to skip the testing.\n"
+                "\tUse -t (table) to output a machine-readable table with the timings.\n",
+                argv[0],KEYSIZE);
+        exit(EXIT_FAILURE);
+    }
+    if (n<100 || n>KEYSIZE) {
+        fprintf(stderr,"Error: supplied value of n (%d) is outside "
+                "allowed range 100-%d.\n",n,KEYSIZE);
+        exit(EXIT_FAILURE);
+    }
+    if (do_test) {
+        printf("Testing...\n");
+        correctness_test();
+        printf("All correctness tests succeeded!\n\n");
+    }
+    speed_test(n,machine_table);
+    if (!machine_table) {
+        printf("Test completed.\n");
+    }
+    return 0;
+}
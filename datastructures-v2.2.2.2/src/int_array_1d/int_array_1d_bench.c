@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <int_array_1d.h>
+#include "bench.h"
+
+/*
+ * Benchmark for int_array_1d.c. Times setting the n elements of an
+ * array in index order, and inspecting them in index order and in
+ * random order, with the harness of ../bench/bench.h.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First public version.
+ */
+
+// The sum of the inspected values, so the reads are not optimized away.
+static volatile long sink;
+
+// Create an array with the values 0..n-1.
+static int_array_1d *filled_array(int n)
+{
+    int_array_1d *a = int_array_1d_create(0, n - 1);
+    for (int i = 0; i < n; i++) {
+        int_array_1d_set_value(a, i, i);
+    }
+    return a;
+}
+
+// Time setting the n elements of an empty array, in index order.
+static unsigned long long time_set(int n)
+{
+    int_array_1d *a = int_array_1d_create(0, n - 1);
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        int_array_1d_set_value(a, i, i);
+    }
+    unsigned long long end = bench_nanoseconds();
+    int_array_1d_kill(a);
+    return end - start;
+}
+
+// Time inspecting the n elements of an array, in index order.
+static unsigned long long time_get(int n)
+{
+    int_array_1d *a = filled_array(n);
+    long sum = 0;
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        sum += int_array_1d_inspect_value(a, i);
+    }
+    unsigned long long end = bench_nanoseconds();
+    sink = sum;
+    int_array_1d_kill(a);
+    return end - start;
+}
+
+// Time inspecting the n elements of an array, in random order.
+static unsigned long long time_get_random(int n)
+{
+    int_array_1d *a = filled_array(n);
+    int *order = bench_shuffled(n);
+    long sum = 0;
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        sum += int_array_1d_inspect_value(a, order[i]);
+    }
+    unsigned long long end = bench_nanoseconds();
+    sink = sum;
+    free(order);
+    int_array_1d_kill(a);
+    return end - start;
+}
+
+static const bench_phase phases[] = {
+    { "set", time_set },
+    { "get", time_get },
+    { "get_random", time_get_random },
+};
+
+int main(int argc, char *argv[])
+{
+    return bench_main("int_array_1d", phases, sizeof(phases) / sizeof(phases[0]),
+                      argc, argv);
+}
@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <int_list.h>
+#include "bench.h"
+
+/*
+ * Benchmark for int_list.c. Times insertions at the end of a list, a
+ * traversal that inspects every element, and removals from the front,
+ * with the harness of ../bench/bench.h.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First public version.
+ */
+
+// The sum of the inspected values, so the traversal is not optimized away.
+static volatile long sink;
+
+// Create a list with the values 0..n-1.
+static list *filled_list(int n)
+{
+    list *l = list_empty();
+    for (int i = 0; i < n; i++) {
+        list_insert(l, i, list_end(l));
+    }
+    return l;
+}
+
+// Time n insertions at the end of an empty list.
+static unsigned long long time_insert(int n)
+{
+    list *l = list_empty();
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        list_insert(l, i, list_end(l));
+    }
+    unsigned long long end = bench_nanoseconds();
+    list_kill(l);
+    return end - start;
+}
+
+// Time a traversal of a list with n elements.
+static unsigned long long time_iterate(int n)
+{
+    list *l = filled_list(n);
+    long sum = 0;
+    unsigned long long start = bench_nanoseconds();
+    for (list_pos p = list_first(l); !list_pos_is_equal(l, p, list_end(l));
+         p = list_next(l, p)) {
+        sum += list_inspect(l, p);
+    }
+    unsigned long long end = bench_nanoseconds();
+    sink = sum;
+    list_kill(l);
+    return end - start;
+}
+
+// Time the removal of all n elements of a list, from the front.
+static unsigned long long time_remove(int n)
+{
+    list *l = filled_list(n);
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        list_remove(l, list_first(l));
+    }
+    unsigned long long end = bench_nanoseconds();
+    list_kill(l);
+    return end - start;
+}
+
+static const bench_phase phases[] = {
+    { "insert", time_insert },
+    { "iterate", time_iterate },
+    { "remove", time_remove },
+};
+
+int main(int argc, char *argv[])
+{
+    return bench_main("int_list", phases, sizeof(phases) / sizeof(phases[0]),
+                      argc, argv);
+}
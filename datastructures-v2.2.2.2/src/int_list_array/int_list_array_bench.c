@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <int_list_array.h>
+#include "bench.h"
+
+/*
+ * Benchmark for int_list_array.c. Times insertions at the end of a
+ * list, a traversal that inspects every element, and removals from
+ * the front, with the harness of ../bench/bench.h. A list holds at
+ * most CAPACITY elements, so the n operations are done in rounds on
+ * lists of at most CAPACITY elements. Only the operations are timed,
+ * not the creation, filling and killing of the list of each round.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First public version.
+ */
+
+// The largest number of elements of a list, ARRAY_MAX_SIZE of
+// int_list_array.c.
+#define CAPACITY 100
+
+// The sum of the inspected values, so the traversal is not optimized away.
+static volatile long sink;
+
+// Create a list with the values 0..n-1.
+static list *filled_list(int n)
+{
+    list *l = list_empty();
+    for (int i = 0; i < n; i++) {
+        list_insert(l, i, list_end(l));
+    }
+    return l;
+}
+
+// Time n insertions at the end of lists.
+static unsigned long long time_insert(int n)
+{
+    unsigned long long total = 0;
+    for (int done = 0; done < n; done += CAPACITY) {
+        int m = n - done < CAPACITY ? n - done : CAPACITY;
+        list *l = list_empty();
+        unsigned long long start = bench_nanoseconds();
+        for (int i = 0; i < m; i++) {
+            list_insert(l, i, list_end(l));
+        }
+        total += bench_nanoseconds() - start;
+        list_kill(l);
+    }
+    return total;
+}
+
+// Time traversals of lists with n elements in all.
+static unsigned long long time_iterate(int n)
+{
+    unsigned long long total = 0;
+    long sum = 0;
+    for (int done = 0; done < n; done += CAPACITY) {
+        int m = n - done < CAPACITY ? n - done : CAPACITY;
+        list *l = filled_list(m);
+        unsigned long long start = bench_nanoseconds();
+        for (list_pos p = list_first(l); !list_pos_is_equal(l, p, list_end(l));
+             p = list_next(l, p)) {
+            sum += list_inspect(l, p);
+        }
+        total += bench_nanoseconds() - start;
+        list_kill(l);
+    }
+    sink = sum;
+    return total;
+}
+
+// Time the removal of n elements from the front of lists.
+static unsigned long long time_remove(int n)
+{
+    unsigned long long total = 0;
+    for (int done = 0; done < n; done += CAPACITY) {
+        int m = n - done < CAPACITY ? n - done : CAPACITY;
+        list *l = filled_list(m);
+        unsigned long long start = bench_nanoseconds();
+        for (int i = 0; i < m; i++) {
+            list_remove(l, list_first(l));
+        }
+        total += bench_nanoseconds() - start;
+        list_kill(l);
+    }
+    return total;
+}
+
+static const bench_phase phases[] = {
+    { "insert", time_insert },
+    { "iterate", time_iterate },
+    { "remove", time_remove },
+};
+
+int main(int argc, char *argv[])
+{
+    return bench_main("int_list_array", phases, sizeof(phases) / sizeof(phases[0]),
+                      argc, argv);
+}
@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <int_queue.h>
+#include "bench.h"
+
+/*
+ * Benchmark for int_queue.c. Times enqueueing n elements and
+ * dequeueing them again, with the harness of ../bench/bench.h. A
+ * queue holds at most MAX_QUEUE_SIZE elements, so the n operations
+ * are done in rounds on queues of at most MAX_QUEUE_SIZE elements.
+ * Only the operations are timed, not the filling and emptying of the
+ * queue of each round.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First public version.
+ */
+
+// The sum of the values at the front, so the reads are not optimized away.
+static volatile long sink;
+
+// Time n enqueues to queues.
+static unsigned long long time_enqueue(int n)
+{
+    unsigned long long total = 0;
+    for (int done = 0; done < n; done += MAX_QUEUE_SIZE) {
+        int m = n - done < MAX_QUEUE_SIZE ? n - done : MAX_QUEUE_SIZE;
+        queue q = queue_empty();
+        unsigned long long start = bench_nanoseconds();
+        for (int i = 0; i < m; i++) {
+            q = queue_enqueue(q, i);
+        }
+        total += bench_nanoseconds() - start;
+        queue_kill(q);
+    }
+    return total;
+}
+
+// Time reading the front and dequeueing of n elements of queues.
+static unsigned long long time_dequeue(int n)
+{
+    unsigned long long total = 0;
+    long sum = 0;
+    for (int done = 0; done < n; done += MAX_QUEUE_SIZE) {
+        int m = n - done < MAX_QUEUE_SIZE ? n - done : MAX_QUEUE_SIZE;
+        queue q = queue_empty();
+        for (int i = 0; i < m; i++) {
+            q = queue_enqueue(q, i);
+        }
+        unsigned long long start = bench_nanoseconds();
+        for (int i = 0; i < m; i++) {
+            sum += queue_front(q);
+            q = queue_dequeue(q);
+        }
+        total += bench_nanoseconds() - start;
+        queue_kill(q);
+    }
+    sink = sum;
+    return total;
+}
+
+static const bench_phase phases[] = {
+    { "enqueue", time_enqueue },
+    { "dequeue", time_dequeue },
+};
+
+int main(int argc, char *argv[])
+{
+    return bench_main("int_queue", phases, sizeof(phases) / sizeof(phases[0]),
+                      argc, argv);
+}
@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <int_stack.h>
+#include "bench.h"
+
+/*
+ * Benchmark for int_stack.c. Times pushing n elements and popping
+ * them again, with the harness of ../bench/bench.h. A stack holds
+ * at most MAX_STACK_SIZE elements, so the n operations are done in
+ * rounds on stacks of at most MAX_STACK_SIZE elements. Only the
+ * operations are timed, not the filling and emptying of the stack of
+ * each round.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First public version.
+ */
+
+// The sum of the values on top, so the reads are not optimized away.
+static volatile long sink;
+
+// Time n pushes on stacks.
+static unsigned long long time_push(int n)
+{
+    unsigned long long total = 0;
+    for (int done = 0; done < n; done += MAX_STACK_SIZE) {
+        int m = n - done < MAX_STACK_SIZE ? n - done : MAX_STACK_SIZE;
+        stack s = stack_empty();
+        unsigned long long start = bench_nanoseconds();
+        for (int i = 0; i < m; i++) {
+            s = stack_push(s, i);
+        }
+        total += bench_nanoseconds() - start;
+        stack_kill(s);
+    }
+    return total;
+}
+
+// Time reading the top and popping of n elements of stacks.
+static unsigned long long time_pop(int n)
+{
+    unsigned long long total = 0;
+    long sum = 0;
+    for (int done = 0; done < n; done += MAX_STACK_SIZE) {
+        int m = n - done < MAX_STACK_SIZE ? n - done : MAX_STACK_SIZE;
+        stack s = stack_empty();
+        for (int i = 0; i < m; i++) {
+            s = stack_push(s, i);
+        }
+        unsigned long long start = bench_nanoseconds();
+        for (int i = 0; i < m; i++) {
+            sum += stack_top(s);
+            s = stack_pop(s);
+        }
+        total += bench_nanoseconds() - start;
+        stack_kill(s);
+    }
+    sink = sum;
+    return total;
+}
+
+static const bench_phase phases[] = {
+    { "push", time_push },
+    { "pop", time_pop },
+};
+
+int main(int argc, char *argv[])
+{
+    return bench_main("int_stack", phases, sizeof(phases) / sizeof(phases[0]),
+                      argc, argv);
+}
@@ -24,6 +24,9 @@
  *   v1.5  2024-03-13: Renamed free_* stuff to kill_*. Converted to 4-tabs.
  *   v2.0  2024-03-14: Added list_print_internal to output dot code for visualization.
  *   v2.1  2024-05-10: Added/updated print_internal with improved encapsulation.
+ *   v2.2  2026-10-18: Added list_empty_with_allocator.
+ *   v2.3  2026-10-18: list_kill returns at once if there is nothing to
+ *                     return cell by cell, e.g. for a list in an arena.
  */
 
 // ===========INTERNAL DATA TYPES ============
@@ -43,6 +46,7 @@ struct list {
     cell *head;
     cell *tail;
     kill_function kill_func;
+    const allocator *alloc; // Allocator for the list and its cells
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
@@ -56,19 +60,37 @@ struct list {
  */
 list *list_empty(kill_function kill_func)
 {
+    return list_empty_with_allocator(kill_func, NULL);
+}
+
+/**
+ * list_empty_with_allocator() - Create an empty list with a given allocator.
+ * @kill_func: A pointer to a function (or NULL) to be called to
+ *             de-allocate memory on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the list
+ *         and its elements. Must remain valid until the list is killed.
+ *
+ * Returns: A pointer to the new list.
+ */
+list *list_empty_with_allocator(kill_function kill_func, const allocator *alloc)
+{
+    if (alloc == NULL) {
+        alloc = default_allocator();
+    }
     // Allocate memory for the list head.
-    list *l = calloc(1, sizeof(list));
+    list *l = alloc->allocate(alloc->context, sizeof(list));
 
     // Allocate memory for the border cells.
-    l->head = calloc(1, sizeof(cell));
-    l->tail = calloc(1, sizeof(cell));
+    l->head = alloc->allocate(alloc->context, sizeof(cell));
+    l->tail = alloc->allocate(alloc->context, sizeof(cell));
 
     // Set consistent links between border elements.
     l->head->next = l->tail;
     l->tail->prev = l->head;
 
-    // Store the kill function.
+    // Store the kill function and the allocator.
     l->kill_func = kill_func;
+    l->alloc = alloc;
 
     return l;
 }
@@ -179,7 +201,7 @@ void *list_inspect(const list *l, const list_pos p)
 list_pos list_insert(list *l, void *v, const list_pos p)
 {
     // Allocate memory for a new cell.
-    list_pos e = malloc(sizeof(cell));
+    list_pos e = l->alloc->allocate(l->alloc->context, sizeof(cell));
 
     // Store the value.
     e->val = v;
@@ -218,7 +240,7 @@ list_pos list_remove(list *l, const list_pos p)
         l->kill_func(p->val);
     }
     // Return the memory allocated to the cell itself.
-    free(p);
+    allocator_deallocate(l->alloc, p, sizeof(cell));
     // Return the position of the next element.
     return next_pos;
 }
@@ -236,6 +258,12 @@ list_pos list_remove(list *l, const list_pos p)
  */
 void list_kill(list *l)
 {
+    if (l->alloc->deallocate == NULL && l->kill_func == NULL) {
+        // No cell or element is returned on its own. The memory is
+        // returned at once by the owner of the allocator.
+        return;
+    }
+
     // Use public functions to traverse the list.
 
     // Start with the first element (will be defined even for an
@@ -248,9 +276,9 @@ void list_kill(list *l)
     }
 
     // Free border elements and the list head.
-    free(l->head);
-    free(l->tail);
-    free(l);
+    allocator_deallocate(l->alloc, l->head, sizeof(cell));
+    allocator_deallocate(l->alloc, l->tail, sizeof(cell));
+    allocator_deallocate(l->alloc, l, sizeof(list));
 }
 
 /**
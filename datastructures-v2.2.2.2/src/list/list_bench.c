@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <list.h>
+#include "bench.h"
+
+/*
+ * Benchmark for list.c. Times insertions at the end of a list, a
+ * traversal that inspects every element, and removals from the front,
+ * with the harness of ../bench/bench.h.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First public version.
+ */
+
+// The sum of the inspected values, so the traversal is not optimized away.
+static volatile long sink;
+
+// Create an array with the values 0..n-1, for the list to point to.
+static int *make_values(int n)
+{
+    int *values = malloc(n * sizeof(values[0]));
+    for (int i = 0; i < n; i++) {
+        values[i] = i;
+    }
+    return values;
+}
+
+// Create a list that points to the n values.
+static list *filled_list(int *values, int n)
+{
+    list *l = list_empty(NULL);
+    for (int i = 0; i < n; i++) {
+        list_insert(l, &values[i], list_end(l));
+    }
+    return l;
+}
+
+// Time n insertions at the end of an empty list.
+static unsigned long long time_insert(int n)
+{
+    int *values = make_values(n);
+    list *l = list_empty(NULL);
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        list_insert(l, &values[i], list_end(l));
+    }
+    unsigned long long end = bench_nanoseconds();
+    list_kill(l);
+    free(values);
+    return end - start;
+}
+
+// Time a traversal of a list with n elements.
+static unsigned long long time_iterate(int n)
+{
+    int *values = make_values(n);
+    list *l = filled_list(values, n);
+    long sum = 0;
+    unsigned long long start = bench_nanoseconds();
+    for (list_pos p = list_first(l); !list_pos_is_equal(l, p, list_end(l));
+         p = list_next(l, p)) {
+        sum += *(int *)list_inspect(l, p);
+    }
+    unsigned long long end = bench_nanoseconds();
+    sink = sum;
+    list_kill(l);
+    free(values);
+    return end - start;
+}
+
+// Time the removal of all n elements of a list, from the front.
+static unsigned long long time_remove(int n)
+{
+    int *values = make_values(n);
+    list *l = filled_list(values, n);
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        list_remove(l, list_first(l));
+    }
+    unsigned long long end = bench_nanoseconds();
+    list_kill(l);
+    free(values);
+    return end - start;
+}
+
+static const bench_phase phases[] = {
+    { "insert", time_insert },
+    { "iterate", time_iterate },
+    { "remove", time_remove },
+};
+
+int main(int argc, char *argv[])
+{
+    return bench_main("list", phases, sizeof(phases) / sizeof(phases[0]),
+                      argc, argv);
+}
@@ -0,0 +1,646 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#include <multimap.h>
+
+/*
+ * Implementation of a generic multimap for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University.
+ *
+ * There is one entry per distinct key. All entries are linked into a
+ * hash index, i.e. an array of buckets where each bucket is a singly
+ * linked chain of entries. The number of buckets is a power of two
+ * that is doubled when there are more entries than buckets.
+ *
+ * The values of a key are stored in a dynamic array in its entry, in
+ * insertion order. The array is doubled when it is full, so an insert
+ * takes O(1) amortized time, and visiting the values of a key only
+ * reads consecutive memory.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: The multimap_lookup_all callback gets a context
+ *                     argument from the caller.
+ */
+
+// The initial capacity of the value array of a new key.
+#define INITIAL_VALUE_CAPACITY 2
+
+// ===========INTERNAL DATA TYPES ============
+
+typedef struct multimap_entry {
+    struct multimap_entry *chain; // Next entry in the same bucket
+    void *key;
+    unsigned long hash;           // Cached hash of the key
+    int count;                    // Number of values
+    int capacity;                 // Allocated size of values
+    void **values;                // The values in insertion order
+} multimap_entry;
+
+struct multimap {
+    int size;                 // Number of key/value pairs
+    int key_count;            // Number of entries
+    int bucket_count;         // Number of buckets, a power of two
+    multimap_entry **buckets; // Chains of entries with the same bucket
+    compare_function *key_cmp_func;
+    hash_function *key_hash_func;
+    kill_function key_kill_func;
+    kill_function value_kill_func;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * mix() - Scramble the bits of a 64-bit value.
+ * @x: Value to scramble.
+ *
+ * Uses the finalizer of the splitmix64 generator, so that the low
+ * bits used to select a bucket depend on all bits of the hash.
+ *
+ * Returns: The scrambled value.
+ */
+static unsigned long long mix(unsigned long long x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Internal function to return the bucket chain of a hash value.
+static multimap_entry **bucket_of(const multimap *m, unsigned long hash)
+{
+    return &m->buckets[mix(hash) & (m->bucket_count - 1)];
+}
+
+/**
+ * find_link() - Find the link to the entry with a given key.
+ * @m: Multimap to inspect.
+ * @key: Key to look for.
+ * @hash: The hash of the key.
+ *
+ * Returns: A pointer to the link in the bucket chain that points to
+ * the entry with the key, or to the NULL link ending the chain if the
+ * key is not found.
+ */
+static multimap_entry **find_link(const multimap *m, const void *key,
+                                  unsigned long hash)
+{
+    multimap_entry **link = bucket_of(m, hash);
+    while (*link != NULL) {
+        multimap_entry *e = *link;
+        if (e->hash == hash && m->key_cmp_func(e->key, key) == 0) {
+            break;
+        }
+        link = &e->chain;
+    }
+    return link;
+}
+
+// Internal function to find the entry with a given key, or NULL.
+static multimap_entry *find_entry(const multimap *m, const void *key)
+{
+    return *find_link(m, key, m->key_hash_func(key));
+}
+
+/**
+ * grow() - Double the number of buckets of a multimap.
+ * @m: Multimap to manipulate.
+ *
+ * The entries are moved to their new buckets. The order within a
+ * chain is not preserved.
+ *
+ * Returns: Nothing.
+ */
+static void grow(multimap *m)
+{
+    multimap_entry **old_buckets = m->buckets;
+    int old_count = m->bucket_count;
+
+    m->bucket_count *= 2;
+    m->buckets = calloc(m->bucket_count, sizeof(*m->buckets));
+    for (int i = 0; i < old_count; i++) {
+        while (old_buckets[i] != NULL) {
+            multimap_entry *e = old_buckets[i];
+            old_buckets[i] = e->chain;
+            multimap_entry **bucket = bucket_of(m, e->hash);
+            e->chain = *bucket;
+            *bucket = e;
+        }
+    }
+    free(old_buckets);
+}
+
+// Internal function to kill the key and values of an entry and
+// deallocate it.
+static void kill_entry(const multimap *m, multimap_entry *e)
+{
+    if (m->key_kill_func != NULL) {
+        m->key_kill_func(e->key);
+    }
+    if (m->value_kill_func != NULL) {
+        for (int i = 0; i < e->count; i++) {
+            m->value_kill_func(e->values[i]);
+        }
+    }
+    free(e->values);
+    free(e);
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * multimap_empty() - Create an empty multimap.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function to be used to hash keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on insert/remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new multimap.
+ */
+multimap *multimap_empty(compare_function *key_cmp_func,
+                         hash_function *key_hash_func,
+                         kill_function key_kill_func,
+                         kill_function value_kill_func)
+{
+    // Allocate the multimap header.
+    multimap *m = calloc(1, sizeof(*m));
+
+    // Start with a few buckets, doubled as the multimap grows.
+    m->bucket_count = 8;
+    m->buckets = calloc(m->bucket_count, sizeof(*m->buckets));
+
+    // Store the key compare/hash functions and key/value kill functions.
+    m->key_cmp_func = key_cmp_func;
+    m->key_hash_func = key_hash_func;
+    m->key_kill_func = key_kill_func;
+    m->value_kill_func = value_kill_func;
+
+    return m;
+}
+
+/**
+ * multimap_is_empty() - Check if a multimap is empty.
+ * @m: Multimap to check.
+ *
+ * Returns: True if the multimap contains no key/value pairs, false otherwise.
+ */
+bool multimap_is_empty(const multimap *m)
+{
+    return m->size == 0;
+}
+
+/**
+ * multimap_size() - Return the number of key/value pairs in a multimap.
+ * @m: Multimap to inspect.
+ *
+ * Returns: The number of key/value pairs.
+ */
+int multimap_size(const multimap *m)
+{
+    return m->size;
+}
+
+/**
+ * multimap_key_count() - Return the number of distinct keys in a multimap.
+ * @m: Multimap to inspect.
+ *
+ * Returns: The number of distinct keys.
+ */
+int multimap_key_count(const multimap *m)
+{
+    return m->key_count;
+}
+
+/**
+ * multimap_insert() - Add a key/value pair to a multimap.
+ * @m: Multimap to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ *
+ * Returns: Nothing.
+ */
+void multimap_insert(multimap *m, void *key, void *value)
+{
+    unsigned long hash = m->key_hash_func(key);
+    multimap_entry *e = *find_link(m, key, hash);
+
+    if (e != NULL) {
+        // Keep the first key, unless the memory is reused.
+        if (m->key_kill_func != NULL && e->key != key) {
+            m->key_kill_func(key);
+        }
+    } else {
+        // Link a new entry first in its bucket chain.
+        if (m->key_count == m->bucket_count) {
+            grow(m);
+        }
+        e = calloc(1, sizeof(*e));
+        e->key = key;
+        e->hash = hash;
+        e->capacity = INITIAL_VALUE_CAPACITY;
+        e->values = malloc(e->capacity * sizeof(*e->values));
+        multimap_entry **bucket = bucket_of(m, hash);
+        e->chain = *bucket;
+        *bucket = e;
+        m->key_count++;
+    }
+    if (e->count == e->capacity) {
+        e->capacity *= 2;
+        e->values = realloc(e->values, e->capacity * sizeof(*e->values));
+    }
+    e->values[e->count++] = value;
+    m->size++;
+}
+
+/**
+ * multimap_lookup() - Look up the latest value of a given key.
+ * @m: Multimap to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value that was inserted last for the key, or NULL if
+ * the key is not found in the multimap.
+ */
+void *multimap_lookup(const multimap *m, const void *key)
+{
+    multimap_entry *e = find_entry(m, key);
+    return e == NULL ? NULL : e->values[e->count - 1];
+}
+
+/**
+ * multimap_lookup_all() - Visit all values of a given key.
+ * @m: Multimap to inspect.
+ * @key: Key to look up.
+ * @callback: Function called for each value of the key.
+ * @arg: Argument passed on to each call of callback.
+ *
+ * Returns: The number of values of the key.
+ */
+int multimap_lookup_all(const multimap *m, const void *key,
+                        multimap_value_callback callback, void *arg)
+{
+    multimap_entry *e = find_entry(m, key);
+    if (e == NULL) {
+        return 0;
+    }
+    for (int i = 0; i < e->count; i++) {
+        callback(e->values[i], arg);
+    }
+    return e->count;
+}
+
+/**
+ * multimap_count() - Return the number of values of a given key.
+ * @m: Multimap to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The number of values of the key.
+ */
+int multimap_count(const multimap *m, const void *key)
+{
+    multimap_entry *e = find_entry(m, key);
+    return e == NULL ? 0 : e->count;
+}
+
+/**
+ * multimap_remove() - Remove all key/value pairs of a given key.
+ * @m: Multimap to manipulate.
+ * @key: Key for which to remove pairs.
+ *
+ * Returns: Nothing.
+ */
+void multimap_remove(multimap *m, const void *key)
+{
+    multimap_entry **link = find_link(m, key, m->key_hash_func(key));
+    multimap_entry *e = *link;
+    if (e != NULL) {
+        *link = e->chain;
+        m->size -= e->count;
+        m->key_count--;
+        kill_entry(m, e);
+    }
+}
+
+/**
+ * multimap_kill() - Destroy a multimap.
+ * @m: Multimap to destroy.
+ *
+ * Returns: Nothing.
+ */
+void multimap_kill(multimap *m)
+{
+    for (int i = 0; i < m->bucket_count; i++) {
+        while (m->buckets[i] != NULL) {
+            multimap_entry *e = m->buckets[i];
+            m->buckets[i] = e->chain;
+            kill_entry(m, e);
+        }
+    }
+    free(m->buckets);
+    free(m);
+}
+
+/**
+ * multimap_print() - Print the given multimap.
+ * @m: Multimap to print.
+ * @print_func: Function called for each key/value pair in the multimap.
+ *
+ * Returns: Nothing.
+ */
+void multimap_print(const multimap *m, inspect_callback_pair print_func)
+{
+    for (int i = 0; i < m->bucket_count; i++) {
+        for (const multimap_entry *e = m->buckets[i]; e != NULL; e = e->chain) {
+            for (int j = 0; j < e->count; j++) {
+                print_func(e->key, e->values[j]);
+            }
+        }
+    }
+}
+
+// ===========INTERNAL FUNCTIONS USED BY multimap_print_internal ============
+
+// The functions below output code in the dot language, used by
+// GraphViz. For documention of the dot language, see graphviz.org.
+
+/**
+ * indent() - Output indentation string.
+ * @n: Indentation level.
+ *
+ * Print n tab characters.
+ *
+ * Returns: Nothing.
+ */
+static void indent(int n)
+{
+    for (int i=0; i<n; i++) {
+        printf("\t");
+    }
+}
+
+/**
+ * iprintf(...) - Indent and print.
+ * @n: Indentation level
+ * @...: printf arguments
+ *
+ * Print n tab characters and calls printf.
+ *
+ * Returns: Nothing.
+ */
+static void iprintf(int n, const char *fmt, ...)
+{
+    // Indent...
+    indent(n);
+    // ...and call printf
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * print_edge() - Print a edge between two addresses.
+ * @from: The address of the start of the edge. Should be non-NULL.
+ * @to: The address of the destination for the edge, including NULL.
+ * @port: The name of the port on the source node, or NULL.
+ * @label: The label for the edge, or NULL.
+ * @options: A string with other edge options, or NULL.
+ *
+ * Print an edge from port PORT on node FROM to TO with label
+ * LABEL. If to is NULL, the destination is the NULL node, otherwise a
+ * memory node. If the port is NULL, the edge starts at the node, not
+ * a specific port on it. If label is NULL, no label is used. The
+ * options string, if non-NULL, is printed before the label.
+ *
+ * Returns: Nothing.
+ */
+static void print_edge(int indent_level, const void *from, const void *to, const char *port,
+                       const char *label, const char *options)
+{
+    indent(indent_level);
+    if (port) {
+        printf("m%04lx:%s -> ", PTR2ADDR(from), port);
+    } else {
+        printf("m%04lx -> ", PTR2ADDR(from));
+    }
+    if (to == NULL) {
+        printf("NULL");
+    } else {
+        printf("m%04lx", PTR2ADDR(to));
+    }
+    printf(" [");
+    if (options != NULL) {
+        printf("%s", options);
+    }
+    if (label != NULL) {
+        printf(" label=\"%s\"",label);
+    }
+    printf("]\n");
+}
+
+// Internal function to print the head node in dot format.
+static void print_head_node(int indent_level, const multimap *m)
+{
+    iprintf(indent_level, "m%04lx [shape=record "
+            "label=\"size\\n%d|key_count\\n%d|<b>buckets\\n%04lx\"]\n",
+            PTR2ADDR(m), m->size, m->key_count, PTR2ADDR(m->buckets));
+}
+
+// Internal function to print the bucket array in dot format.
+static void print_buckets(int indent_level, const multimap *m)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"", PTR2ADDR(m->buckets));
+    for (int i = 0; i < m->bucket_count; i++) {
+        printf("<%02d>%02d\\n%04lx", i, i, PTR2ADDR(m->buckets[i]));
+        if (i < m->bucket_count - 1) {
+            printf("|");
+        }
+    }
+    printf("\"]\n");
+}
+
+// Internal function to print an entry node and its value array in dot
+// format.
+static void print_entry_node(int indent_level, const multimap_entry *e)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"<c>chain\\n%04lx"
+            "|<k>key\\n%04lx|count\\n%d|capacity\\n%d|<v>values\\n%04lx\"]\n",
+            PTR2ADDR(e), PTR2ADDR(e->chain), PTR2ADDR(e->key), e->count,
+            e->capacity, PTR2ADDR(e->values));
+    iprintf(indent_level, "m%04lx [shape=record label=\"", PTR2ADDR(e->values));
+    for (int i = 0; i < e->capacity; i++) {
+        if (i < e->count) {
+            printf("<%02d>%02d\\n%04lx", i, i, PTR2ADDR(e->values[i]));
+        } else {
+            printf("<%02d>%02d\\n", i, i);
+        }
+        if (i < e->capacity - 1) {
+            printf("|");
+        }
+    }
+    printf("\"]\n");
+}
+
+// Internal function to print a key or value node in dot format.
+static void print_payload_node(int indent_level, const void *p, inspect_callback print_func)
+{
+    iprintf(indent_level, "m%04lx [label=\"", PTR2ADDR(p));
+    if (print_func != NULL) {
+        print_func(p);
+    }
+    printf("\" xlabel=\"%04lx\"]\n", PTR2ADDR(p));
+}
+
+// Create an escaped version of the input string. The most common
+// control characters - newline, horizontal tab, backslash, and double
+// quote - are replaced by their escape sequence. The returned pointer
+// must be deallocated by the caller.
+static char *escape_chars(const char *s)
+{
+    int i, j;
+    int escaped = 0; // The number of chars that must be escaped.
+
+    // Count how many chars need to be escaped, i.e. how much longer
+    // the output string will be.
+    for (i = escaped = 0; s[i] != '\0'; i++) {
+        if (s[i] == '\n' || s[i] == '\t' || s[i] == '\\' || s[i] == '\"') {
+            escaped++;
+        }
+    }
+    // Allocate space for the escaped string. The variable i holds the input
+    // length, escaped how much the string will grow.
+    char *t = malloc(i + escaped + 1);
+
+    // Copy-and-escape loop
+    for (i = j = 0; s[i] != '\0'; i++) {
+        // Convert each control character by its escape sequence.
+        // Non-control characters are copied as-is.
+        switch (s[i]) {
+        case '\n': t[i+j] = '\\'; t[i+j+1] = 'n';  j++; break;
+        case '\t': t[i+j] = '\\'; t[i+j+1] = 't';  j++; break;
+        case '\\': t[i+j] = '\\'; t[i+j+1] = '\\'; j++; break;
+        case '\"': t[i+j] = '\\'; t[i+j+1] = '\"'; j++; break;
+        default:   t[i+j] = s[i]; break;
+        }
+    }
+    // Terminal the output string
+    t[i+j] = '\0';
+    return t;
+}
+
+/**
+ * multimap_print_internal() - Output the internal structure of the multimap.
+ * @m: Multimap to print.
+ * @key_print_func: Function called for each key in the multimap.
+ * @value_print_func: Function called for each value in the multimap.
+ * @desc: String with a description/state of the multimap.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the multimap and prints code that shows its' internal
+ * structure.
+ *
+ * Returns: Nothing.
+ */
+void multimap_print_internal(const multimap *m, inspect_callback key_print_func,
+                             inspect_callback value_print_func, const char *desc,
+                             int indent_level)
+{
+    static int graph_number = 0;
+    graph_number++;
+    int il = indent_level;
+
+    if (indent_level == 0) {
+        // If this is the outermost datatype, start a graph and set up defaults
+        printf("digraph MULTIMAP_%d {\n", graph_number);
+
+        // Specify default shape and fontname
+        il++;
+        iprintf(il, "node [shape=rectangle fontname=\"Courier New\"]\n");
+        iprintf(il, "ranksep=0.01\n");
+        iprintf(il, "subgraph cluster_nullspace {\n");
+        iprintf(il+1, "NULL\n");
+        iprintf(il, "}\n");
+    }
+
+    if (desc != NULL) {
+        // Escape the string before printout
+        char *escaped = escape_chars(desc);
+        // Use different names on inner description nodes
+        if (indent_level == 0) {
+            iprintf(il, "description [label=\"%s\"]\n", escaped);
+        } else {
+            iprintf(il, "cluster_multimap_%d_description [label=\"%s\"]\n",
+                    graph_number, escaped);
+        }
+        free(escaped);
+    }
+
+    if (indent_level == 0) {
+        // Use a single "pointer" edge as a starting point for the
+        // outermost datatype
+        iprintf(il, "m [label=\"%04lx\" xlabel=\"m\"]\n", PTR2ADDR(m));
+        iprintf(il, "m -> m%04lx\n", PTR2ADDR(m));
+
+        // Put the user nodes in userspace
+        iprintf(il, "subgraph cluster_userspace { label=\"User space\"\n");
+        for (int i = 0; i < m->bucket_count; i++) {
+            for (const multimap_entry *e = m->buckets[i]; e != NULL; e = e->chain) {
+                print_payload_node(il + 1, e->key, key_print_func);
+                for (int j = 0; j < e->count; j++) {
+                    print_payload_node(il + 1, e->values[j], value_print_func);
+                }
+            }
+        }
+        iprintf(il, "}\n");
+    }
+
+    // Print the subgraph to surround the multimap content
+    iprintf(il, "subgraph cluster_multimap_%d { label=\"Multimap\"\n", graph_number);
+    il++;
+    print_head_node(il, m);
+    print_buckets(il, m);
+    for (int i = 0; i < m->bucket_count; i++) {
+        for (const multimap_entry *e = m->buckets[i]; e != NULL; e = e->chain) {
+            print_entry_node(il, e);
+        }
+    }
+    il--;
+    iprintf(il, "}\n");
+
+    // Output the edges from the head, the buckets and the entries.
+    print_edge(il, m, m->buckets, "b", "buckets", NULL);
+    for (int i = 0; i < m->bucket_count; i++) {
+        if (m->buckets[i] != NULL) {
+            char port[15];
+            sprintf(port, "%02d", i);
+            print_edge(il, m->buckets, m->buckets[i], port, NULL, NULL);
+        }
+    }
+    for (int i = 0; i < m->bucket_count; i++) {
+        for (const multimap_entry *e = m->buckets[i]; e != NULL; e = e->chain) {
+            if (e->chain != NULL) {
+                print_edge(il, e, e->chain, "c", "chain", NULL);
+            }
+            print_edge(il, e, e->key, "k", "key",
+                       m->key_kill_func ? "color=red" : "color=red style=dashed");
+            print_edge(il, e, e->values, "v", "values", NULL);
+            for (int j = 0; j < e->count; j++) {
+                char port[15];
+                sprintf(port, "%02d", j);
+                print_edge(il, e->values, e->values[j], port, NULL,
+                           m->value_kill_func ? "color=red" : "color=red style=dashed");
+            }
+        }
+    }
+
+    if (indent_level == 0) {
+        // Termination of graph
+        printf("}\n");
+    }
+}
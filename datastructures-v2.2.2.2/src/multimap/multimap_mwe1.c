@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <multimap.h>
+
+/*
+ * Minimum working example for multimap.c. Keeps (topic, subscriber)
+ * pairs where each topic may have many subscribers, and sends a
+ * message to all subscribers of a topic. The multimap is responsible
+ * for deallocating the keys and values.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: The topic is passed to send_message as the
+ *                     context argument of multimap_lookup_all.
+ */
+
+#define VERSION "v1.1"
+#define VERSION_DATE "2026-10-18"
+
+// Create a dynamic copy of the string str.
+char* string_copy(const char *str)
+{
+    // Use calloc to ensure a '\0' termination.
+    char *copy = calloc(strlen(str) + 1, sizeof(*copy));
+    strcpy(copy, str);
+    return copy;
+}
+
+// Interpret the supplied key and value pointers and print their content.
+void print_string_string_pair(const void *key, const void *value)
+{
+    const char *k=key;
+    const char *s=value;
+    printf("[%s, %s]\n", k, s);
+}
+
+// Send a message on the topic arg to a subscriber.
+void send_message(const void *value, void *arg)
+{
+    const char *s=value;
+    const char *topic=arg;
+    printf("  Message on %s sent to %s.\n", topic, s);
+}
+
+// Compare two keys (char *).
+int compare_strings(const void *k1, const void *k2)
+{
+    const char *key1 = k1;
+    const char *key2 = k2;
+
+    return strcmp(key1, key2);
+}
+
+// Hash a key (char *) using the djb2 algorithm.
+unsigned long hash_string(const void *k)
+{
+    const unsigned char *s = k;
+    unsigned long hash = 5381;
+
+    while (*s != '\0') {
+        hash = hash * 33 + *s++;
+    }
+    return hash;
+}
+
+// Subscribe a user to a topic.
+void subscribe(multimap *m, const char *topic, const char *user)
+{
+    multimap_insert(m, string_copy(topic), string_copy(user));
+}
+
+// Send a message to all subscribers of a topic.
+void publish(const multimap *m, const char *topic)
+{
+    printf("Publishing to %s, with %d subscriber(s):\n", topic,
+           multimap_count(m, topic));
+    multimap_lookup_all(m, topic, send_message, (void *)topic);
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Multimap of (string, string) pairs.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    // Hand over the deallocation responsibility to the multimap.
+    multimap *m = multimap_empty(compare_strings, hash_string, free, free);
+
+    subscribe(m, "weather", "alice");
+    subscribe(m, "news", "bob");
+    subscribe(m, "weather", "carol");
+    subscribe(m, "weather", "dave");
+
+    printf("Multimap with %d pairs and %d keys:\n", multimap_size(m),
+           multimap_key_count(m));
+    multimap_print(m, print_string_string_pair);
+
+    publish(m, "weather");
+    publish(m, "news");
+    publish(m, "sports");
+
+    printf("Latest subscriber of weather: %s.\n",
+           (char *)multimap_lookup(m, "weather"));
+
+    // Remove all subscribers of a topic.
+    multimap_remove(m, "weather");
+    publish(m, "weather");
+
+    // Kill the multimap, including the keys and values.
+    multimap_kill(m);
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <multimap.h>
+
+/*
+ * Minimum working example for multimap.c. Inserts 4 key-value pairs
+ * with 2 distinct keys into a multimap. Output dot/graphviz code to
+ * show the internal structure of the multimap. In this version, the
+ * multimap "borrows" the payload memory, i.e., the user of the
+ * multimap is responsible for deallocating the payload memory.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version. Adapted from cache_mwe1i.c.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+// Create a dynamic copy of the string str.
+char* string_copy(const char *str)
+{
+    // Use calloc to ensure a '\0' termination.
+    char *copy = calloc(strlen(str) + 1, sizeof(*copy));
+    strcpy(copy, str);
+    return copy;
+}
+
+// Create a dynamic copy of the string str.
+void string_kill(void *v)
+{
+    // Convert pointer - useful in debugging.
+    char *s = v;
+    free(s);
+}
+
+// Create a dynamic copy of the integer i.
+int *int_create(int i)
+{
+    // Allocate memory for an integer and set the value
+    int *v = malloc(sizeof(*v));
+    *v = i;
+    return v;
+}
+
+// Return the memory used by the integer.
+void int_kill(void *v)
+{
+    int *p = v;
+    free(p);
+}
+
+// Interpret the supplied key and value pointers and print their content.
+void print_string_int_pair(const void *key, const void *value)
+{
+    const char *k=key;
+    const int *v=value;
+    printf("[%s, %d]\n", k, *v);
+}
+
+// Interpret the supplied value pointer and print its content.
+void print_int(const void *value)
+{
+    const int *v=value;
+    printf("%d", *v);
+}
+
+// Interpret the supplied key pointer and print its content.
+void print_string(const void *key)
+{
+    const char *k=key;
+    printf("\\\"%s\\\"", k);
+}
+
+// Compare two keys (char *).
+int compare_strings(const void *k1, const void *k2)
+{
+    const char *key1 = k1;
+    const char *key2 = k2;
+
+    return strcmp(key1, key2);
+}
+
+// Hash a key (char *) using the djb2 algorithm.
+unsigned long hash_string(const void *k)
+{
+    const unsigned char *s = k;
+    unsigned long hash = 5381;
+
+    while (*s != '\0') {
+        hash = hash * 33 + *s++;
+    }
+    return hash;
+}
+
+// Print cut lines before and after a call multimap_print_internal.
+void print_internal_with_cut_lines(const multimap *m, const char *desc)
+{
+    // Internal counter that will be remembered between calls.
+
+    // Used to generate sequentially numbered -- CUT HERE -- marker lines
+    // to enable automatic parsing of the output.
+    static int cut = 1;
+
+    // Print starting marker line.
+    printf("\n--- START CUT HERE %d ---\n", cut);
+
+    // Call the internal print function to get the actual dot code.
+    multimap_print_internal(m, print_string, print_int, desc, 0);
+
+    // Print ending marker line
+    printf("--- END CUT HERE %d ---\n\n", cut);
+
+    // Increment the cut number. Will be remembered next time the
+    // function is called since cut is a static variable.
+    cut++;
+}
+
+// Print a message with intructions how to use the dot output. prog is
+// the name of the executable.
+void print_dot_usage(char *prog)
+{
+    printf("\nGenerate dot code to visualize internal structure with GraphViz. ");
+    printf("Use\n\n%s ", prog);
+    printf("| sed -n '/START CUT HERE X/,/END CUT HERE X/{//!p}' | dot -Tsvg > /tmp/dot.svg\n\n");
+    printf("to generate an svg file of cut X (replace X by the requested cut number).\n");
+    printf("The generated file can then be visualized with\n\n");
+    printf("firefox /tmp/dot.svg\n\n");
+    printf("Use -Tpng to generate a .png file instead. "
+           "See graphviz.org and %s for documentation.\n", __FILE__);
+
+    printf("\n--- Start of normal output ---\n\n");
+}
+
+int main(int argc, char *argv[])
+{
+    printf("%s, %s %s: Create (string, integer) multimap without any kill_function.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    print_dot_usage(argv[0]);
+
+    // Keep track of the key-value pairs we allocate.
+    void *key[2];
+    void *value[4];
+
+    key[0] = string_copy("Odd");
+    key[1] = string_copy("Even");
+    for (int i = 0; i < 4; i++) {
+        value[i] = int_create(i + 1);
+    }
+
+    // Keep the deallocation responsibility of the keys/values we allocate.
+    multimap *m = multimap_empty(compare_strings, hash_string, NULL, NULL);
+
+    multimap_insert(m, key[0], value[0]);
+    multimap_insert(m, key[1], value[1]);
+    printf("Multimap from the outside after inserting 2 key-value pairs:\n");
+    multimap_print(m, print_string_int_pair);
+    print_internal_with_cut_lines(m, __FILE__ ": Multimap with 2 key-value pairs showing "
+                                  "the inside structure.");
+
+    // Add values to the existing keys. The value array of "Odd" grows.
+    multimap_insert(m, key[0], value[2]);
+    multimap_insert(m, key[1], value[3]);
+    multimap_insert(m, key[0], value[0]);
+    printf("Multimap from the outside after inserting 3 more key-value pairs:\n");
+    multimap_print(m, print_string_int_pair);
+    print_internal_with_cut_lines(m, __FILE__ ": Multimap with 5 key-value pairs and "
+                                  "2 keys.");
+
+    // Kill the multimap, excluding the keys and values we entered.
+    multimap_kill(m);
+
+    // Free key/value pairs that we put in the multimap.
+    for (int i = 0; i < sizeof(key)/sizeof(key[0]); i++) {
+        string_kill(key[i]);
+    }
+    for (int i = 0; i < sizeof(value)/sizeof(value[0]); i++) {
+        int_kill(value[i]);
+    }
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
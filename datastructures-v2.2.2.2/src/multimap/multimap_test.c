@@ -0,0 +1,196 @@
+/*
+ * multimap_test - test the multimap implementation.
+ *
+ * Should be compiled together with the multimap implementation that
+ * follows the interface in multimap.h of the code base for the
+ * Datastructures and Algorithms courses at the Department of
+ * Computing Science, Umea University.
+ *
+ * The program runs a number of correctness tests, and exits with an
+ * error message at the first failure.
+ *
+ * 2026-10-18 v1.0  First public version.
+ * 2026-10-18 v1.1  The helpers shared with the other tests, and the
+ *                  monotonic clock of the timing, come from testutil.c.
+ * 2026-10-18 v1.2  The callbacks get their state through the context
+ *                  argument of multimap_lookup_all instead of globals.
+ * 2026-10-18 v1.3  Moved from ou3/multimaptest.c to
+ *                  src/multimap/multimap_test.c. The speed test and
+ *                  its command line arguments are removed.
+*/
+
+#define VERSION "v1.3"
+#define VERSION_DATE "2026-10-18"
+
+/*
+ * Correctness testing algorithm:
+ *
+ * 1. Tests that a new multimap is empty.
+ * 2. Tests that all values of a key are kept, are visited in
+ *    insertion order, and that the latest value is returned by
+ *    multimap_lookup.
+ * 3. Tests the multimap with a random sequence of inserts and removes,
+ *    and compares the number of values of each key and the sum of the
+ *    values with simple arrays.
+ * */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "multimap.h"
+#include "testutil.h"
+
+/* Creates a multimap with int keys and values owned by the multimap.
+ */
+multimap *int_multimap()
+{
+    return multimap_empty(int_compare, int_hash, free, free);
+}
+
+/* Inserts the pair (key, value) into a multimap with int keys and values.
+ *    m - the multimap
+ *    key, value - the pair
+ */
+void insert_int(multimap *m, int key, int value)
+{
+    multimap_insert(m, int_ptr_from_int(key), int_ptr_from_int(value));
+}
+
+/* Tests that a new multimap is empty.
+ */
+void test_isempty()
+{
+    multimap *m = int_multimap();
+    int key = 1;
+
+    if (!multimap_is_empty(m) || multimap_size(m) != 0
+        || multimap_key_count(m) != 0 || multimap_count(m, &key) != 0
+        || multimap_lookup(m, &key) != NULL) {
+        printf("A newly created multimap is not empty.\n");
+        exit(EXIT_FAILURE);
+    }
+    multimap_kill(m);
+    printf("A new multimap is empty. - OK\n");
+}
+
+// The values visited by collect_value, in order.
+struct visited_values {
+    int values[100];
+    int count;
+};
+
+// Callback used by test_all_values. arg is a struct visited_values.
+void collect_value(const void *value, void *arg)
+{
+    const int *v=value;
+    struct visited_values *visited=arg;
+    visited->values[visited->count++]=*v;
+}
+
+/* Tests that all values of a key are kept in insertion order.
+ */
+void test_all_values()
+{
+    multimap *m = int_multimap();
+
+    // Interleave the values of two keys.
+    for (int i = 0; i < 100; i++) {
+        insert_int(m, i % 2, i);
+    }
+    int key = 1;
+    struct visited_values visited = { .count = 0 };
+    if (multimap_lookup_all(m, &key, collect_value, &visited) != 50
+        || visited.count != 50 || multimap_count(m, &key) != 50
+        || multimap_size(m) != 100 || multimap_key_count(m) != 2) {
+        printf("The multimap did not keep all values of a key.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < 50; i++) {
+        if (visited.values[i] != 2 * i + 1) {
+            printf("The values were not visited in insertion "
+                   "order.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    const int *v = multimap_lookup(m, &key);
+    if (v == NULL || *v != 99) {
+        printf("multimap_lookup did not return the latest value.\n");
+        exit(EXIT_FAILURE);
+    }
+    multimap_remove(m, &key);
+    if (multimap_count(m, &key) != 0 || multimap_size(m) != 50
+        || multimap_key_count(m) != 1) {
+        printf("Removing a key did not remove all its values.\n");
+        exit(EXIT_FAILURE);
+    }
+    multimap_kill(m);
+    printf("All values of a key are kept in insertion order. - OK\n");
+}
+
+// The number of keys in test_random_operations.
+#define RANDOM_KEYS 100
+
+// Callback used by test_random_operations. Adds the value to the
+// long that arg points to.
+void sum_value(const void *value, void *arg)
+{
+    const int *v=value;
+    long *sum=arg;
+    *sum+=*v;
+}
+
+/* Tests the multimap with a random sequence of operations.
+ */
+void test_random_operations()
+{
+    int count[RANDOM_KEYS] = { 0 };
+    long sum[RANDOM_KEYS] = { 0 };
+    int size = 0;
+    multimap *m = int_multimap();
+
+    for (int i = 0; i < 20000; i++) {
+        int key = rand() % RANDOM_KEYS;
+        if (rand() % 10 == 0) {
+            multimap_remove(m, &key);
+            size -= count[key];
+            count[key] = 0;
+            sum[key] = 0;
+        } else {
+            insert_int(m, key, i);
+            count[key]++;
+            sum[key] += i;
+            size++;
+        }
+        long value_sum = 0;
+        if (multimap_lookup_all(m, &key, sum_value, &value_sum)
+            != count[key]
+            || multimap_count(m, &key) != count[key]
+            || value_sum != sum[key] || multimap_size(m) != size) {
+            printf("Key %d has the wrong values.\n", key);
+            exit(EXIT_FAILURE);
+        }
+    }
+    multimap_kill(m);
+    printf("Random inserts and removes. - OK\n");
+}
+
+/*  Tests the multimap by performing a set of tests. Program exits if any
+ *  error is found.
+ */
+void correctness_test()
+{
+    test_isempty();
+    test_all_values();
+    test_random_operations();
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Test program for the multimap.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s.\n\n", CODE_BASE_VERSION);
+
+    correctness_test();
+
+    printf("\nAll correctness tests succeeded! Normal exit.\n");
+    return 0;
+}
@@ -0,0 +1,899 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#include <perfect_table.h>
+
+/*
+ * Implementation of a generic, immutable table indexed by a minimal
+ * perfect hash function for the "Datastructures and algorithms"
+ * courses at the Department of Computing Science, Umea University.
+ *
+ * The perfect hash function is built with the compress, hash and
+ * displace (CHD) algorithm. The keys are first distributed over
+ * bucket_count buckets. The buckets are then processed in order of
+ * decreasing size. For each bucket, the smallest displacement d is
+ * searched for that maps all keys of the bucket to free slots. The
+ * displacement is stored per bucket, so a lookup computes the bucket
+ * of the key, reads its displacement and computes the one slot where
+ * the key may be stored.
+ *
+ * The search for a displacement may fail for a bucket that is placed
+ * when few slots are left. The construction is then retried with a
+ * new seed, which is added to all hashes, and twice as many buckets,
+ * so that the last buckets to be placed hold a single key. Only two
+ * different keys with the same hash value make the construction fail.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: Added ordered queries min, max, floor, ceiling and range.
+ *   v1.2  2026-10-18: Retry the construction with a new seed and more buckets.
+ */
+
+// Average number of keys per bucket. A higher value gives a smaller
+// displacement array but a slower construction.
+#define KEYS_PER_BUCKET 4
+
+// Number of attempts to build the table, each with a new seed and
+// twice as many buckets as the attempt before.
+#define MAX_ATTEMPTS 8
+
+// Constant used to separate the hash values for different
+// displacements, 2^64 divided by the golden ratio.
+#define GOLDEN_RATIO_64 0x9e3779b97f4a7c15ULL
+
+// ===========INTERNAL DATA TYPES ============
+
+struct perfect_table {
+    int n;                        // Number of slots, i.e. of unique keys
+    int bucket_count;             // Number of buckets
+    unsigned long seed;           // Added to the hashes, see bucket_of
+    unsigned long *displacements; // Displacement for each bucket
+    void **keys;                  // The packed keys...
+    void **values;                // ...values...
+    unsigned long *hashes;        // ...and key hashes, one per slot
+    compare_function *key_cmp_func;
+    hash_function *key_hash_func;
+    kill_function key_kill_func;
+    kill_function value_kill_func;
+};
+
+// Scratch memory used during the construction of the table.
+typedef struct builder {
+    int n;                 // Number of input key/value pairs
+    void **keys;           // The input keys
+    unsigned long *hashes; // The hash of each input key
+    int *order;            // Input indices ordered by bucket
+    int *bucket_start;     // First position in order of each bucket
+    int *bucket_size;      // Number of unique keys in each bucket
+    int *kept;             // Index of the pair each input pair was merged with
+} builder;
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * mix() - Scramble the bits of a 64-bit value.
+ * @x: Value to scramble.
+ *
+ * Uses the finalizer of the splitmix64 generator. Every input bit
+ * affects every output bit.
+ *
+ * Returns: The scrambled value.
+ */
+static unsigned long long mix(unsigned long long x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Internal function to compute the bucket of a key hash.
+static int bucket_of(const perfect_table *pt, unsigned long hash)
+{
+    return mix(hash + pt->seed) % pt->bucket_count;
+}
+
+// Internal function to compute the slot of a key hash for a given
+// displacement.
+static int slot_of(const perfect_table *pt, unsigned long hash, unsigned long d)
+{
+    return mix(hash + pt->seed + (d + 1) * GOLDEN_RATIO_64) % pt->n;
+}
+
+/**
+ * sort_by_bucket() - Order the input pairs by bucket.
+ * @pt: Table under construction. Only bucket_count is used.
+ * @b: Builder with the input hashes.
+ *
+ * Fills in b->order and b->bucket_start using a counting sort. The
+ * sort is stable, i.e. the input pairs of each bucket are ordered by
+ * index.
+ *
+ * Returns: Nothing.
+ */
+static void sort_by_bucket(const perfect_table *pt, builder *b)
+{
+    int *next = calloc(pt->bucket_count, sizeof(*next));
+
+    // Count the number of keys in each bucket.
+    for (int i = 0; i < b->n; i++) {
+        b->bucket_start[bucket_of(pt, b->hashes[i]) + 1]++;
+    }
+    // Convert the counts to start positions.
+    for (int i = 0; i < pt->bucket_count; i++) {
+        b->bucket_start[i + 1] += b->bucket_start[i];
+        next[i] = b->bucket_start[i];
+    }
+    // Distribute the indices.
+    for (int i = 0; i < b->n; i++) {
+        b->order[next[bucket_of(pt, b->hashes[i])]++] = i;
+    }
+    free(next);
+}
+
+/**
+ * merge_duplicates() - Remove duplicate keys from each bucket.
+ * @pt: Table under construction. Only key_cmp_func and bucket_count are used.
+ * @b: Builder with the input pairs ordered by bucket.
+ *
+ * Equal keys have equal hashes and thus end up in the same bucket.
+ * The unique keys of each bucket are moved to the start of the
+ * bucket in b->order and counted in b->bucket_size. For each input
+ * pair, b->kept holds the index of the pair that is kept in its
+ * place.
+ *
+ * Returns: The number of unique keys, or -1 if two different keys
+ * have the same hash value.
+ */
+static int merge_duplicates(const perfect_table *pt, builder *b)
+{
+    int unique = 0;
+
+    for (int bucket = 0; bucket < pt->bucket_count; bucket++) {
+        int start = b->bucket_start[bucket];
+        int size = 0;
+        for (int p = start; p < b->bucket_start[bucket + 1]; p++) {
+            int i = b->order[p];
+            b->kept[i] = i;
+            // Compare with the unique keys found so far in the bucket.
+            for (int q = start; q < start + size; q++) {
+                int j = b->order[q];
+                if (b->hashes[i] != b->hashes[j]) {
+                    continue;
+                }
+                if (pt->key_cmp_func(b->keys[i], b->keys[j]) != 0) {
+                    // Two different keys with the same hash can never
+                    // be separated by the hash function.
+                    return -1;
+                }
+                b->kept[i] = j;
+                break;
+            }
+            if (b->kept[i] == i) {
+                b->order[start + size] = i;
+                size++;
+            }
+        }
+        b->bucket_size[bucket] = size;
+        unique += size;
+    }
+    return unique;
+}
+
+/**
+ * place_bucket() - Find a displacement for a bucket and fill its slots.
+ * @pt: Table under construction.
+ * @b: Builder with the unique keys of each bucket.
+ * @bucket: The bucket to place.
+ * @occupied: Array with a flag for each slot that is already used.
+ * @slots: Scratch array, large enough to hold the largest bucket.
+ * @values: The input values.
+ *
+ * Returns: True if a displacement was found, otherwise false.
+ */
+static bool place_bucket(perfect_table *pt, const builder *b, int bucket,
+                         bool *occupied, int *slots, void *values[])
+{
+    const int *members = b->order + b->bucket_start[bucket];
+    int size = b->bucket_size[bucket];
+    // The probability to find free slots for the last single-key
+    // buckets is about 1/n per try, so allow plenty of tries.
+    unsigned long max_tries = 64UL * pt->n + 1024;
+
+    for (unsigned long d = 0; d < max_tries; d++) {
+        bool ok = true;
+        for (int k = 0; k < size && ok; k++) {
+            slots[k] = slot_of(pt, b->hashes[members[k]], d);
+            ok = !occupied[slots[k]];
+            // The keys of the bucket must not collide with each other.
+            for (int j = 0; j < k && ok; j++) {
+                ok = slots[j] != slots[k];
+            }
+        }
+        if (ok) {
+            // Store the displacement and the key/value pairs.
+            pt->displacements[bucket] = d;
+            for (int k = 0; k < size; k++) {
+                int i = members[k];
+                occupied[slots[k]] = true;
+                pt->keys[slots[k]] = b->keys[i];
+                pt->values[slots[k]] = values[i];
+                pt->hashes[slots[k]] = b->hashes[i];
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * place_buckets() - Place all buckets in order of decreasing size.
+ * @pt: Table under construction.
+ * @b: Builder with the unique keys of each bucket.
+ * @values: The input values.
+ *
+ * Returns: True if all buckets were placed, otherwise false.
+ */
+static bool place_buckets(perfect_table *pt, const builder *b, void *values[])
+{
+    int max_size = 0;
+    for (int bucket = 0; bucket < pt->bucket_count; bucket++) {
+        if (b->bucket_size[bucket] > max_size) {
+            max_size = b->bucket_size[bucket];
+        }
+    }
+
+    bool *occupied = calloc(pt->n + 1, sizeof(*occupied));
+    int *slots = calloc(max_size + 1, sizeof(*slots));
+    bool ok = true;
+
+    // Large buckets are the hardest to place, so place them first
+    // while most slots are still free.
+    for (int size = max_size; size > 0 && ok; size--) {
+        for (int bucket = 0; bucket < pt->bucket_count && ok; bucket++) {
+            if (b->bucket_size[bucket] == size) {
+                ok = place_bucket(pt, b, bucket, occupied, slots, values);
+            }
+        }
+    }
+    free(slots);
+    free(occupied);
+    return ok;
+}
+
+/**
+ * kill_duplicates() - Kill the keys and values of discarded duplicates.
+ * @pt: The constructed table.
+ * @b: Builder with the result of merge_duplicates.
+ * @values: The input values.
+ *
+ * Memory that is shared with the kept pair is not killed.
+ *
+ * Returns: Nothing.
+ */
+static void kill_duplicates(const perfect_table *pt, const builder *b, void *values[])
+{
+    for (int i = 0; i < b->n; i++) {
+        int j = b->kept[i];
+        if (j == i) {
+            continue;
+        }
+        if (pt->key_kill_func != NULL && b->keys[i] != b->keys[j]) {
+            pt->key_kill_func(b->keys[i]);
+        }
+        if (pt->value_kill_func != NULL && values[i] != values[j]) {
+            pt->value_kill_func(values[i]);
+        }
+    }
+}
+
+// Internal function to return the memory used by the table struct
+// and arrays, but not by the keys and values.
+static void free_table(perfect_table *pt)
+{
+    free(pt->displacements);
+    free(pt->keys);
+    free(pt->values);
+    free(pt->hashes);
+    free(pt);
+}
+
+/**
+ * perfect_table_create() - Create a table from a set of key/value pairs.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function to be used to hash keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on kill.
+ * @n: The number of key/value pairs.
+ * @keys: Array with the n keys.
+ * @values: Array with the n values.
+ *
+ * Returns: Pointer to a new table, or NULL if the construction failed.
+ */
+perfect_table *perfect_table_create(compare_function *key_cmp_func,
+                                    hash_function *key_hash_func,
+                                    kill_function key_kill_func,
+                                    kill_function value_kill_func,
+                                    int n, void *keys[], void *values[])
+{
+    if (n < 0) {
+        return NULL;
+    }
+    // Allocate the table header and store the functions.
+    perfect_table *pt = calloc(1, sizeof(*pt));
+    pt->key_cmp_func = key_cmp_func;
+    pt->key_hash_func = key_hash_func;
+    pt->key_kill_func = key_kill_func;
+    pt->value_kill_func = value_kill_func;
+
+    // Hash each key once.
+    builder b = { .n = n, .keys = keys };
+    b.hashes = calloc(n + 1, sizeof(*b.hashes));
+    b.order = calloc(n + 1, sizeof(*b.order));
+    b.kept = calloc(n + 1, sizeof(*b.kept));
+    for (int i = 0; i < n; i++) {
+        b.hashes[i] = key_hash_func(keys[i]);
+    }
+
+    bool ok = false;
+    int bucket_count = n / KEYS_PER_BUCKET + 1;
+    for (int attempt = 0; attempt < MAX_ATTEMPTS && !ok; attempt++) {
+        // Group the keys by bucket.
+        pt->seed = attempt == 0 ? 0 : mix(attempt);
+        pt->bucket_count = bucket_count;
+        free(pt->displacements);
+        free(b.bucket_start);
+        free(b.bucket_size);
+        pt->displacements = calloc(pt->bucket_count, sizeof(*pt->displacements));
+        b.bucket_start = calloc(pt->bucket_count + 1, sizeof(*b.bucket_start));
+        b.bucket_size = calloc(pt->bucket_count, sizeof(*b.bucket_size));
+        sort_by_bucket(pt, &b);
+
+        // The number of slots is the number of unique keys.
+        pt->n = merge_duplicates(pt, &b);
+        if (pt->n < 0) {
+            // No seed can separate keys with the same hash.
+            break;
+        }
+        free(pt->keys);
+        free(pt->values);
+        free(pt->hashes);
+        pt->keys = calloc(pt->n + 1, sizeof(*pt->keys));
+        pt->values = calloc(pt->n + 1, sizeof(*pt->values));
+        pt->hashes = calloc(pt->n + 1, sizeof(*pt->hashes));
+        ok = place_buckets(pt, &b, values);
+        if (bucket_count <= n) {
+            bucket_count *= 2;
+        }
+    }
+    if (ok) {
+        // The table is complete, it is now safe to kill the duplicates.
+        kill_duplicates(pt, &b, values);
+    } else {
+        free_table(pt);
+        pt = NULL;
+    }
+
+    // Return the scratch memory.
+    free(b.hashes);
+    free(b.order);
+    free(b.kept);
+    free(b.bucket_start);
+    free(b.bucket_size);
+
+    return pt;
+}
+
+/**
+ * perfect_table_size() - Return the number of key/value pairs in a table.
+ * @pt: Table to inspect.
+ *
+ * Returns: The number of key/value pairs.
+ */
+int perfect_table_size(const perfect_table *pt)
+{
+    return pt->n;
+}
+
+/**
+ * perfect_table_lookup() - Look up a given key in a table.
+ * @pt: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to a given key, or NULL if the key
+ * is not found in the table.
+ */
+void *perfect_table_lookup(const perfect_table *pt, const void *key)
+{
+    if (pt->n == 0) {
+        return NULL;
+    }
+    // Compute the only slot where the key may be stored.
+    unsigned long hash = pt->key_hash_func(key);
+    int slot = slot_of(pt, hash, pt->displacements[bucket_of(pt, hash)]);
+
+    // The slot holds some key. Compare the hashes before the keys.
+    if (pt->hashes[slot] == hash && pt->key_cmp_func(pt->keys[slot], key) == 0) {
+        return pt->values[slot];
+    }
+    return NULL;
+}
+
+/**
+ * perfect_table_inspect_key() - Return the key stored in a given slot.
+ * @pt: Table to inspect.
+ * @i: Slot index, 0 <= i < perfect_table_size(pt).
+ *
+ * Returns: The key stored in slot i.
+ */
+void *perfect_table_inspect_key(const perfect_table *pt, int i)
+{
+    return pt->keys[i];
+}
+
+/**
+ * perfect_table_inspect_value() - Return the value stored in a given slot.
+ * @pt: Table to inspect.
+ * @i: Slot index, 0 <= i < perfect_table_size(pt).
+ *
+ * Returns: The value stored in slot i.
+ */
+void *perfect_table_inspect_value(const perfect_table *pt, int i)
+{
+    return pt->values[i];
+}
+
+/**
+ * perfect_table_kill() - Destroy a table.
+ * @pt: Table to destroy.
+ *
+ * Return all dynamic memory used by the table and its elements. If a
+ * kill_func was registered for keys and/or values at table creation,
+ * it is called each element to free any user-allocated memory
+ * occupied by the element values.
+ *
+ * Returns: Nothing.
+ */
+void perfect_table_kill(perfect_table *pt)
+{
+    for (int i = 0; i < pt->n; i++) {
+        // Kill key and/or value if given the authority to do so.
+        if (pt->key_kill_func != NULL) {
+            pt->key_kill_func(pt->keys[i]);
+        }
+        if (pt->value_kill_func != NULL) {
+            pt->value_kill_func(pt->values[i]);
+        }
+    }
+    free_table(pt);
+}
+
+/**
+ * perfect_table_print() - Print the given table.
+ * @pt: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Returns: Nothing.
+ */
+void perfect_table_print(const perfect_table *pt, inspect_callback_pair print_func)
+{
+    for (int i = 0; i < pt->n; i++) {
+        print_func(pt->keys[i], pt->values[i]);
+    }
+}
+
+/**
+ * closest_key() - Find the key closest to a bound on one side of it.
+ * @pt: Table to inspect.
+ * @bound: Bound key, or NULL for no bound.
+ * @dir: -1 to search for the largest key <= bound, +1 to search for
+ *       the smallest key >= bound.
+ *
+ * The slots are not ordered, so all keys are compared.
+ *
+ * Returns: The closest key, or NULL if there is none.
+ */
+static void *closest_key(const perfect_table *pt, const void *bound, int dir)
+{
+    void *best = NULL;
+    for (int i = 0; i < pt->n; i++) {
+        // Skip keys on the wrong side of the bound.
+        if (bound != NULL && dir * pt->key_cmp_func(pt->keys[i], bound) < 0) {
+            continue;
+        }
+        // Keep the key closest to the bound.
+        if (best == NULL || dir * pt->key_cmp_func(pt->keys[i], best) < 0) {
+            best = pt->keys[i];
+        }
+    }
+    return best;
+}
+
+/**
+ * sort_slots() - Sort slot indices by key.
+ * @pt: Table whose keys to compare.
+ * @a: Array with slot indices to sort.
+ * @tmp: Scratch array with room for n indices.
+ * @n: Number of indices.
+ *
+ * Returns: Nothing.
+ */
+static void sort_slots(const perfect_table *pt, int *a, int *tmp, int n)
+{
+    if (n < 2) {
+        return;
+    }
+    // Sort both halves...
+    int mid = n / 2;
+    sort_slots(pt, a, tmp, mid);
+    sort_slots(pt, a + mid, tmp, n - mid);
+
+    // ...and merge them.
+    int i = 0, j = mid, k = 0;
+    while (i < mid && j < n) {
+        if (pt->key_cmp_func(pt->keys[a[j]], pt->keys[a[i]]) < 0) {
+            tmp[k++] = a[j++];
+        } else {
+            tmp[k++] = a[i++];
+        }
+    }
+    while (i < mid) {
+        tmp[k++] = a[i++];
+    }
+    while (j < n) {
+        tmp[k++] = a[j++];
+    }
+    for (k = 0; k < n; k++) {
+        a[k] = tmp[k];
+    }
+}
+
+/**
+ * perfect_table_min() - Return the smallest key in a table.
+ * @pt: Table to inspect.
+ *
+ * Returns: The smallest key, or NULL if the table is empty.
+ */
+void *perfect_table_min(const perfect_table *pt)
+{
+    return closest_key(pt, NULL, 1);
+}
+
+/**
+ * perfect_table_max() - Return the largest key in a table.
+ * @pt: Table to inspect.
+ *
+ * Returns: The largest key, or NULL if the table is empty.
+ */
+void *perfect_table_max(const perfect_table *pt)
+{
+    return closest_key(pt, NULL, -1);
+}
+
+/**
+ * perfect_table_floor() - Return the largest key less than or equal to a key.
+ * @pt: Table to inspect.
+ * @key: Key to compare with.
+ *
+ * Returns: The largest key <= key, or NULL if there is none.
+ */
+void *perfect_table_floor(const perfect_table *pt, const void *key)
+{
+    return closest_key(pt, key, -1);
+}
+
+/**
+ * perfect_table_ceiling() - Return the smallest key greater than or equal to a key.
+ * @pt: Table to inspect.
+ * @key: Key to compare with.
+ *
+ * Returns: The smallest key >= key, or NULL if there is none.
+ */
+void *perfect_table_ceiling(const perfect_table *pt, const void *key)
+{
+    return closest_key(pt, key, 1);
+}
+
+/**
+ * perfect_table_range() - Iterate over the key/value pairs within an interval.
+ * @pt: Table to inspect.
+ * @lo: Lower bound of the interval, inclusive.
+ * @hi: Upper bound of the interval, inclusive.
+ * @callback: Function called for each key/value pair in the interval.
+ *
+ * Returns: Nothing.
+ */
+void perfect_table_range(const perfect_table *pt, const void *lo, const void *hi,
+                         inspect_callback_pair callback)
+{
+    // Collect the slots with keys in the interval...
+    int *slots = calloc(pt->n + 1, sizeof(*slots));
+    int *tmp = calloc(pt->n + 1, sizeof(*tmp));
+    int k = 0;
+    for (int i = 0; i < pt->n; i++) {
+        if (pt->key_cmp_func(pt->keys[i], lo) >= 0
+            && pt->key_cmp_func(pt->keys[i], hi) <= 0) {
+            slots[k++] = i;
+        }
+    }
+    // ...and visit them in key order.
+    sort_slots(pt, slots, tmp, k);
+    for (int i = 0; i < k; i++) {
+        callback(pt->keys[slots[i]], pt->values[slots[i]]);
+    }
+    free(slots);
+    free(tmp);
+}
+
+// ===========INTERNAL FUNCTIONS USED BY perfect_table_print_internal ============
+
+// The functions below output code in the dot language, used by
+// GraphViz. For documention of the dot language, see graphviz.org.
+
+/**
+ * indent() - Output indentation string.
+ * @n: Indentation level.
+ *
+ * Print n tab characters.
+ *
+ * Returns: Nothing.
+ */
+static void indent(int n)
+{
+    for (int i=0; i<n; i++) {
+        printf("\t");
+    }
+}
+
+/**
+ * iprintf(...) - Indent and print.
+ * @n: Indentation level
+ * @...: printf arguments
+ *
+ * Print n tab characters and calls printf.
+ *
+ * Returns: Nothing.
+ */
+static void iprintf(int n, const char *fmt, ...)
+{
+    // Indent...
+    indent(n);
+    // ...and call printf
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * print_edge() - Print a edge between two addresses.
+ * @from: The address of the start of the edge. Should be non-NULL.
+ * @to: The address of the destination for the edge, including NULL.
+ * @port: The name of the port on the source node, or NULL.
+ * @label: The label for the edge, or NULL.
+ * @options: A string with other edge options, or NULL.
+ *
+ * Print an edge from port PORT on node FROM to TO with label
+ * LABEL. If to is NULL, the destination is the NULL node, otherwise a
+ * memory node. If the port is NULL, the edge starts at the node, not
+ * a specific port on it. If label is NULL, no label is used. The
+ * options string, if non-NULL, is printed before the label.
+ *
+ * Returns: Nothing.
+ */
+static void print_edge(int indent_level, const void *from, const void *to, const char *port,
+                       const char *label, const char *options)
+{
+    indent(indent_level);
+    if (port) {
+        printf("m%04lx:%s -> ", PTR2ADDR(from), port);
+    } else {
+        printf("m%04lx -> ", PTR2ADDR(from));
+    }
+    if (to == NULL) {
+        printf("NULL");
+    } else {
+        printf("m%04lx", PTR2ADDR(to));
+    }
+    printf(" [");
+    if (options != NULL) {
+        printf("%s", options);
+    }
+    if (label != NULL) {
+        printf(" label=\"%s\"",label);
+    }
+    printf("]\n");
+}
+
+// Internal function to print the head node in dot format.
+static void print_head_node(int indent_level, const perfect_table *pt)
+{
+    iprintf(indent_level, "m%04lx [shape=record "
+            "label=\"n\\n%d|bucket_count\\n%d|<d>displacements\\n%04lx|<k>keys\\n%04lx"
+            "|<v>values\\n%04lx|cmp\\n%04lx|hash\\n%04lx|key_kill\\n%04lx|value_kill\\n%04lx\"]\n",
+            PTR2ADDR(pt), pt->n, pt->bucket_count, PTR2ADDR(pt->displacements),
+            PTR2ADDR(pt->keys), PTR2ADDR(pt->values), PTR2ADDR(pt->key_cmp_func),
+            PTR2ADDR(pt->key_hash_func), PTR2ADDR(pt->key_kill_func),
+            PTR2ADDR(pt->value_kill_func));
+}
+
+// Internal function to print the displacement array in dot format.
+static void print_displacements(int indent_level, const perfect_table *pt)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"", PTR2ADDR(pt->displacements));
+    for (int i = 0; i < pt->bucket_count; i++) {
+        printf("%02d\\n%lu", i, pt->displacements[i]);
+        if (i < pt->bucket_count - 1) {
+            printf("|");
+        }
+    }
+    printf("\"]\n");
+}
+
+// Internal function to print a key or value pointer array in dot format.
+static void print_pointers(int indent_level, void **a, int n)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"", PTR2ADDR(a));
+    for (int i = 0; i < n; i++) {
+        printf("<%02d>%02d\\n%04lx", i, i, PTR2ADDR(a[i]));
+        if (i < n - 1) {
+            printf("|");
+        }
+    }
+    printf("\"]\n");
+}
+
+// Internal function to print the edges from a pointer array to the
+// payload memory. Memory "owned" by the table is indicated by solid
+// red lines. Memory "borrowed" from the user is indicated by red
+// dashed lines.
+static void print_pointer_edges(int indent_level, void **a, int n, bool owned)
+{
+    for (int i = 0; i < n; i++) {
+        // Buffer to store port name in. Good for array up to 1e9 elements.
+        char port[15];
+        sprintf(port, "%02d", i);
+        print_edge(indent_level, a, a[i], port, port,
+                   owned ? "color=red" : "color=red style=dashed");
+    }
+}
+
+// Internal function to print the payload nodes in dot format.
+static void print_payload_nodes(int indent_level, void **a, int n,
+                                inspect_callback print_func)
+{
+    for (int i = 0; i < n; i++) {
+        if (a[i] != NULL) {
+            iprintf(indent_level, "m%04lx [label=\"", PTR2ADDR(a[i]));
+            if (print_func != NULL) {
+                print_func(a[i]);
+            }
+            printf("\" xlabel=\"%04lx\"]\n", PTR2ADDR(a[i]));
+        }
+    }
+}
+
+// Create an escaped version of the input string. The most common
+// control characters - newline, horizontal tab, backslash, and double
+// quote - are replaced by their escape sequence. The returned pointer
+// must be deallocated by the caller.
+static char *escape_chars(const char *s)
+{
+    int i, j;
+    int escaped = 0; // The number of chars that must be escaped.
+
+    // Count how many chars need to be escaped, i.e. how much longer
+    // the output string will be.
+    for (i = escaped = 0; s[i] != '\0'; i++) {
+        if (s[i] == '\n' || s[i] == '\t' || s[i] == '\\' || s[i] == '\"') {
+            escaped++;
+        }
+    }
+    // Allocate space for the escaped string. The variable i holds the input
+    // length, escaped how much the string will grow.
+    char *t = malloc(i + escaped + 1);
+
+    // Copy-and-escape loop
+    for (i = j = 0; s[i] != '\0'; i++) {
+        // Convert each control character by its escape sequence.
+        // Non-control characters are copied as-is.
+        switch (s[i]) {
+        case '\n': t[i+j] = '\\'; t[i+j+1] = 'n';  j++; break;
+        case '\t': t[i+j] = '\\'; t[i+j+1] = 't';  j++; break;
+        case '\\': t[i+j] = '\\'; t[i+j+1] = '\\'; j++; break;
+        case '\"': t[i+j] = '\\'; t[i+j+1] = '\"'; j++; break;
+        default:   t[i+j] = s[i]; break;
+        }
+    }
+    // Terminal the output string
+    t[i+j] = '\0';
+    return t;
+}
+
+/**
+ * perfect_table_print_internal() - Output the internal structure of the table.
+ * @pt: Table to print.
+ * @key_print_func: Function called for each key in the table.
+ * @value_print_func: Function called for each value in the table.
+ * @desc: String with a description/state of the table.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the table and prints code that shows its' internal structure.
+ *
+ * Returns: Nothing.
+ */
+void perfect_table_print_internal(const perfect_table *pt, inspect_callback key_print_func,
+                                  inspect_callback value_print_func, const char *desc,
+                                  int indent_level)
+{
+    static int graph_number = 0;
+    graph_number++;
+    int il = indent_level;
+
+    if (indent_level == 0) {
+        // If this is the outermost datatype, start a graph and set up defaults
+        printf("digraph PERFECT_TABLE_%d {\n", graph_number);
+
+        // Specify default shape and fontname
+        il++;
+        iprintf(il, "node [shape=rectangle fontname=\"Courier New\"]\n");
+        iprintf(il, "ranksep=0.01\n");
+        iprintf(il, "subgraph cluster_nullspace {\n");
+        iprintf(il+1, "NULL\n");
+        iprintf(il, "}\n");
+    }
+
+    if (desc != NULL) {
+        // Escape the string before printout
+        char *escaped = escape_chars(desc);
+        // Use different names on inner description nodes
+        if (indent_level == 0) {
+            iprintf(il, "description [label=\"%s\"]\n", escaped);
+        } else {
+            iprintf(il, "cluster_perfect_table_%d_description [label=\"%s\"]\n",
+                    graph_number, escaped);
+        }
+        free(escaped);
+    }
+
+    if (indent_level == 0) {
+        // Use a single "pointer" edge as a starting point for the
+        // outermost datatype
+        iprintf(il, "pt [label=\"%04lx\" xlabel=\"pt\"]\n", PTR2ADDR(pt));
+        iprintf(il, "pt -> m%04lx\n", PTR2ADDR(pt));
+
+        // Put the user nodes in userspace
+        iprintf(il, "subgraph cluster_userspace { label=\"User space\"\n");
+        print_payload_nodes(il + 1, pt->keys, pt->n, key_print_func);
+        print_payload_nodes(il + 1, pt->values, pt->n, value_print_func);
+        iprintf(il, "}\n");
+    }
+
+    // Print the subgraph to surround the table content
+    iprintf(il, "subgraph cluster_perfect_table_%d { label=\"Perfect_table\"\n",
+            graph_number);
+    il++;
+    print_head_node(il, pt);
+    print_displacements(il, pt);
+    print_pointers(il, pt->keys, pt->n);
+    print_pointers(il, pt->values, pt->n);
+    il--;
+    iprintf(il, "}\n");
+
+    // Output the edges from the head and the arrays
+    print_edge(il, pt, pt->displacements, "d", "displacements", NULL);
+    print_edge(il, pt, pt->keys, "k", "keys", NULL);
+    print_edge(il, pt, pt->values, "v", "values", NULL);
+    print_pointer_edges(il, pt->keys, pt->n, pt->key_kill_func != NULL);
+    print_pointer_edges(il, pt->values, pt->n, pt->value_kill_func != NULL);
+
+    if (indent_level == 0) {
+        // Termination of graph
+        printf("}\n");
+    }
+}
@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <perfect_table.h>
+
+/*
+ * Minimum working example for perfect_table.c. Builds a table from 6
+ * key/value pairs, including one duplicate. Makes three lookups and
+ * prints the result. The responsibility to deallocate the key/value
+ * pairs is handed over to the table, including the duplicate that is
+ * discarded during the construction.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+// Create a dynamic copy of the string str.
+char* string_copy(const char *str)
+{
+    // Use calloc to ensure a '\0' termination.
+    char *copy = calloc(strlen(str) + 1, sizeof(*copy));
+    strcpy(copy, str);
+    return copy;
+}
+
+// Return the memory used by the string.
+void string_kill(void *v)
+{
+    // Convert pointer - useful in debugging.
+    char *s = v;
+    free(s);
+}
+
+// Create a dynamic copy of the integer i.
+int *int_create(int i)
+{
+    // Allocate memory for an integer and set the value
+    int *v = malloc(sizeof(*v));
+    *v = i;
+    return v;
+}
+
+// Return the memory used by the integer.
+void int_kill(void *v)
+{
+    int *p = v;
+    free(p);
+}
+
+// Interpret the supplied key and value pointers and print their content.
+void print_int_string_pair(const void *key, const void *value)
+{
+    const int *k=key;
+    const char *s=value;
+    printf("[%d, %s]\n", *k, s);
+}
+
+// Compare two keys (int *).
+int compare_ints(const void *k1, const void *k2)
+{
+    int key1 = *(int *)k1;
+    int key2 = *(int *)k2;
+
+    if ( key1 == key2 )
+        return 0;
+    if ( key1 < key2 )
+        return -1;
+    return 1;
+}
+
+// Hash a key (int *). Equal keys give equal hashes.
+unsigned long hash_int(const void *k)
+{
+    return *(const int *)k;
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Create (integer, string) table with kill_functions.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    const int codes[] = { 90187, 90184, 98185, 11122, 41296, 90187 };
+    const char *towns[] = { "Umea (Universitet)", "Umea", "Kiruna", "Stockholm",
+                            "Goteborg", "Umea" };
+    void *key[6];
+    void *value[6];
+
+    for (int i = 0; i < sizeof(key)/sizeof(key[0]); i++) {
+        key[i] = int_create(codes[i]);
+        value[i] = string_copy(towns[i]);
+    }
+
+    // Hand over the deallocation responsibility to the table. The
+    // last pair is a duplicate of the first and will be discarded.
+    perfect_table *pt = perfect_table_create(compare_ints, hash_int, int_kill,
+                                             string_kill, 6, key, value);
+    if (pt == NULL) {
+        fprintf(stderr, "Failed to build perfect table.\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("Table with %d pairs built from 6 pairs:\n", perfect_table_size(pt));
+    perfect_table_print(pt, print_int_string_pair);
+
+    int v = 90187;
+    const char *s = perfect_table_lookup(pt, &v);
+    printf("Lookup of postal code %d: %s.\n", v, s);
+
+    v = 98185;
+    s = perfect_table_lookup(pt, &v);
+    printf("Lookup of postal code %d: %s.\n", v, s);
+
+    v = 12345;
+    s = perfect_table_lookup(pt, &v);
+    printf("Lookup of postal code %d: %s.\n", v, s ? s : "(not found)");
+
+    // Kill the table, including the keys and values.
+    perfect_table_kill(pt);
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
@@ -21,6 +21,7 @@
  *   v2.0  2024-03-14: Added queue_print_internal to output dot code for visualization.
  *                     Renamed free_* stuff to kill_*. Converted to 4-tabs.
  *   v2.1  2024-05-10: Updated print_internal with improved encapsulation.
+ *   v2.2  2026-10-18: Added queue_empty_with_allocator.
  */
 
 // ===========INTERNAL DATA TYPES ============
@@ -32,6 +33,7 @@
 
 struct queue {
     list *elements;
+    const allocator *alloc; // Allocator for the queue and its list
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
@@ -45,10 +47,28 @@ struct queue {
  */
 queue *queue_empty(kill_function kill_func)
 {
+    return queue_empty_with_allocator(kill_func, NULL);
+}
+
+/**
+ * queue_empty_with_allocator() - Create an empty queue with a given allocator.
+ * @kill_func: A pointer to a function (or NULL) to be called to
+ *             de-allocate memory on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the queue
+ *         and its elements. Must remain valid until the queue is killed.
+ *
+ * Returns: A pointer to the new queue.
+ */
+queue *queue_empty_with_allocator(kill_function kill_func, const allocator *alloc)
+{
+    if (alloc == NULL) {
+        alloc = default_allocator();
+    }
     // Allocate the queue head.
-    queue *q = calloc(1, sizeof(*q));
-    // Create an empty list.
-    q->elements = list_empty(kill_func);
+    queue *q = alloc->allocate(alloc->context, sizeof(*q));
+    // Create an empty list with the same allocator.
+    q->elements = list_empty_with_allocator(kill_func, alloc);
+    q->alloc = alloc;
 
     return q;
 }
@@ -116,7 +136,7 @@ void *queue_front(const queue *q)
 void queue_kill(queue *q)
 {
     list_kill(q->elements);
-    free(q);
+    allocator_deallocate(q->alloc, q, sizeof(*q));
 }
 
 /**
@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <queue.h>
+#include "bench.h"
+
+/*
+ * Benchmark for queue.c. Times enqueueing n elements and dequeueing
+ * them again, with the harness of ../bench/bench.h.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First public version.
+ */
+
+// The sum of the values at the front, so the reads are not optimized away.
+static volatile long sink;
+
+// Create an array with the values 0..n-1, for the queue to point to.
+static int *make_values(int n)
+{
+    int *values = malloc(n * sizeof(values[0]));
+    for (int i = 0; i < n; i++) {
+        values[i] = i;
+    }
+    return values;
+}
+
+// Time n enqueues to an empty queue.
+static unsigned long long time_enqueue(int n)
+{
+    int *values = make_values(n);
+    queue *q = queue_empty(NULL);
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        q = queue_enqueue(q, &values[i]);
+    }
+    unsigned long long end = bench_nanoseconds();
+    queue_kill(q);
+    free(values);
+    return end - start;
+}
+
+// Time reading the front and dequeueing of all n elements of a queue.
+static unsigned long long time_dequeue(int n)
+{
+    int *values = make_values(n);
+    queue *q = queue_empty(NULL);
+    for (int i = 0; i < n; i++) {
+        q = queue_enqueue(q, &values[i]);
+    }
+    long sum = 0;
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        sum += *(int *)queue_front(q);
+        q = queue_dequeue(q);
+    }
+    unsigned long long end = bench_nanoseconds();
+    sink = sum;
+    queue_kill(q);
+    free(values);
+    return end - start;
+}
+
+static const bench_phase phases[] = {
+    { "enqueue", time_enqueue },
+    { "dequeue", time_dequeue },
+};
+
+int main(int argc, char *argv[])
+{
+    return bench_main("queue", phases, sizeof(phases) / sizeof(phases[0]),
+                      argc, argv);
+}
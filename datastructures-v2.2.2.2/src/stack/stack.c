@@ -20,6 +20,8 @@
  *   v2.0  2024-03-14: Added stack_print_internal to output dot code for visualization.
  *                     Renamed free_* stuff to kill_*. Converted to 4-tabs.
  *   v2.1  2024-05-10: Updated print_internal with improved encapsulation.
+ *   v2.2  2026-10-18: Added stack_empty_with_allocator.
+ *   v2.3  2026-10-18: stack_kill returns at once for a stack in an arena.
  */
 
 // ===========INTERNAL DATA TYPES============
@@ -36,6 +38,7 @@ typedef struct cell {
 struct stack {
     cell *top;
     kill_function kill_func;
+    const allocator *alloc; // Allocator for the stack and its cells
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
@@ -49,10 +52,28 @@ struct stack {
  */
 stack *stack_empty(kill_function kill_func)
 {
+    return stack_empty_with_allocator(kill_func, NULL);
+}
+
+/**
+ * stack_empty_with_allocator() - Create an empty stack with a given allocator.
+ * @kill_func: A pointer to a function (or NULL) to be called to
+ *             de-allocate memory on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the stack
+ *         and its elements. Must remain valid until the stack is killed.
+ *
+ * Returns: A pointer to the new stack.
+ */
+stack *stack_empty_with_allocator(kill_function kill_func, const allocator *alloc)
+{
+    if (alloc == NULL) {
+        alloc = default_allocator();
+    }
     // Allocate memory for stack structure.
-    stack *s = calloc(1, sizeof(stack));
+    stack *s = alloc->allocate(alloc->context, sizeof(stack));
     s->top = NULL;
     s->kill_func = kill_func;
+    s->alloc = alloc;
 
     return s;
 }
@@ -79,7 +100,7 @@ bool stack_is_empty(const stack *s)
 stack *stack_push(stack *s, void *v)
 {
     // Allocate memory for element.
-    cell *e = calloc(1, sizeof(*e));
+    cell *e = s->alloc->allocate(s->alloc->context, sizeof(*e));
     // Set element value.
     e->val = v;
     // Link to current top.
@@ -113,7 +134,7 @@ stack *stack_pop(stack *s)
             s->kill_func(e->val);
         }
         // De-allocate element memory.
-        free(e);
+        allocator_deallocate(s->alloc, e, sizeof(*e));
     }
     return s;
 }
@@ -145,10 +166,15 @@ void *stack_top(const stack *s)
  */
 void stack_kill(stack *s)
 {
+    if (s->alloc->deallocate == NULL && s->kill_func == NULL) {
+        // Nothing to pop. The cells are returned at once by the owner
+        // of the allocator.
+        return;
+    }
     while (!stack_is_empty(s)) {
         s = stack_pop(s);
     }
-    free(s);
+    allocator_deallocate(s->alloc, s, sizeof(stack));
 }
 
 /**
@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <stack.h>
+#include "bench.h"
+
+/*
+ * Benchmark for stack.c. Times pushing n elements and popping them
+ * again, with the harness of ../bench/bench.h.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First public version.
+ */
+
+// The sum of the values on top, so the reads are not optimized away.
+static volatile long sink;
+
+// Create an array with the values 0..n-1, for the stack to point to.
+static int *make_values(int n)
+{
+    int *values = malloc(n * sizeof(values[0]));
+    for (int i = 0; i < n; i++) {
+        values[i] = i;
+    }
+    return values;
+}
+
+// Time n pushes on an empty stack.
+static unsigned long long time_push(int n)
+{
+    int *values = make_values(n);
+    stack *s = stack_empty(NULL);
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        s = stack_push(s, &values[i]);
+    }
+    unsigned long long end = bench_nanoseconds();
+    stack_kill(s);
+    free(values);
+    return end - start;
+}
+
+// Time reading the top and popping of all n elements of a stack.
+static unsigned long long time_pop(int n)
+{
+    int *values = make_values(n);
+    stack *s = stack_empty(NULL);
+    for (int i = 0; i < n; i++) {
+        s = stack_push(s, &values[i]);
+    }
+    long sum = 0;
+    unsigned long long start = bench_nanoseconds();
+    for (int i = 0; i < n; i++) {
+        sum += *(int *)stack_top(s);
+        s = stack_pop(s);
+    }
+    unsigned long long end = bench_nanoseconds();
+    sink = sum;
+    stack_kill(s);
+    free(values);
+    return end - start;
+}
+
+static const bench_phase phases[] = {
+    { "push", time_push },
+    { "pop", time_pop },
+};
+
+int main(int argc, char *argv[])
+{
+    return bench_main("stack", phases, sizeof(phases) / sizeof(phases[0]),
+                      argc, argv);
+}
@@ -0,0 +1,666 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include <strtable.h>
+
+/*
+ * Implementation of a table with string keys for the "Datastructures
+ * and algorithms" courses at the Department of Computing Science,
+ * Umea University.
+ *
+ * The pairs are stored in an array of slots with open addressing and
+ * linear probing: a key is put in the first free slot at or after its
+ * home slot, given by its hash. The number of slots is a power of two
+ * that is doubled when more than 70% of the slots are used. A removed
+ * pair is filled in by moving later pairs of the same probe sequence
+ * backwards, so there are no "deleted" markers.
+ *
+ * Each slot holds the hash and the length of its key. A key shorter
+ * than INLINE_KEY_SIZE characters is stored in the slot itself.
+ * Longer keys are appended to an arena, a single character array that
+ * is only grown, and the slot holds the offset of the key in the
+ * arena. A removed long key leaves a hole in the arena that is
+ * reclaimed when the arena is compacted, i.e. when more than half of
+ * it is unused, or when the slots are reallocated. A lookup compares
+ * the hash and the length before any characters.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+// The size of the inline key storage, including the '\0'.
+#define INLINE_KEY_SIZE 24
+
+// The length of the key of an empty slot.
+#define EMPTY_SLOT -1
+
+// The arena is compacted when it has more unused bytes than this and
+// more than half of it is unused.
+#define MIN_ARENA_GARBAGE 4096
+
+// ===========INTERNAL DATA TYPES ============
+
+typedef struct slot {
+    unsigned long hash;  // Hash of the key
+    void *value;
+    int len;             // Length of the key, or EMPTY_SLOT
+    union {
+        char chars[INLINE_KEY_SIZE]; // A key shorter than INLINE_KEY_SIZE...
+        size_t offset;               // ...or the arena offset of a longer key
+    } key;
+} slot;
+
+struct strtable {
+    int size;              // Number of pairs
+    int slot_count;        // Number of slots, a power of two
+    slot *slots;
+    char *arena;           // The long keys, each followed by a '\0'
+    size_t arena_size;     // Number of used bytes in the arena...
+    size_t arena_capacity; // ...allocated bytes...
+    size_t arena_garbage;  // ...and bytes of removed keys
+    kill_function value_kill_func;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * mix() - Scramble the bits of a 64-bit value.
+ * @x: Value to scramble.
+ *
+ * Uses the finalizer of the splitmix64 generator, so that the low
+ * bits used to select a slot depend on all bits of the hash.
+ *
+ * Returns: The scrambled value.
+ */
+static unsigned long long mix(unsigned long long x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * hash_key() - Hash a string and compute its length.
+ * @key: The string.
+ * @len: Output parameter for the length of the string.
+ *
+ * Uses the 64-bit FNV-1a hash.
+ *
+ * Returns: The hash value.
+ */
+static unsigned long hash_key(const char *key, int *len)
+{
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    const unsigned char *s = (const unsigned char *)key;
+    while (*s != '\0') {
+        hash ^= *s++;
+        hash *= 0x100000001b3ULL;
+    }
+    *len = (const char *)s - key;
+    return hash;
+}
+
+// Internal function to return the home slot index of a hash value.
+static int home_of(const strtable *t, unsigned long hash)
+{
+    return mix(hash) & (t->slot_count - 1);
+}
+
+// Internal function to return the key stored for a slot.
+static const char *slot_key(const strtable *t, const slot *s)
+{
+    return s->len < INLINE_KEY_SIZE ? s->key.chars : t->arena + s->key.offset;
+}
+
+/**
+ * find_slot() - Find the slot of a given key.
+ * @t: Table to inspect.
+ * @key: Key to look for.
+ * @hash: The hash of the key.
+ * @len: The length of the key.
+ *
+ * Returns: The index of the slot with the key, or of the empty slot
+ * where the key would be inserted if the key is not found.
+ */
+static int find_slot(const strtable *t, const char *key, unsigned long hash, int len)
+{
+    int mask = t->slot_count - 1;
+    int i = home_of(t, hash);
+    while (t->slots[i].len != EMPTY_SLOT) {
+        const slot *s = &t->slots[i];
+        if (s->hash == hash && s->len == len
+            && memcmp(slot_key(t, s), key, len) == 0) {
+            break;
+        }
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+/**
+ * arena_append() - Append a key to the arena.
+ * @t: Table to manipulate.
+ * @key: The key.
+ * @len: The length of the key.
+ *
+ * The arena is doubled if it is full.
+ *
+ * Returns: The offset of the key in the arena.
+ */
+static size_t arena_append(strtable *t, const char *key, int len)
+{
+    while (t->arena_size + len + 1 > t->arena_capacity) {
+        t->arena_capacity = t->arena_capacity == 0 ? 256 : 2 * t->arena_capacity;
+        t->arena = realloc(t->arena, t->arena_capacity);
+    }
+    size_t offset = t->arena_size;
+    memcpy(t->arena + offset, key, len + 1);
+    t->arena_size += len + 1;
+    return offset;
+}
+
+/**
+ * rebuild() - Reallocate the slots and compact the arena.
+ * @t: Table to manipulate.
+ * @slot_count: The new number of slots, a power of two.
+ *
+ * All pairs are moved to their new slots, and the long keys are
+ * copied to a new arena without the removed keys.
+ *
+ * Returns: Nothing.
+ */
+static void rebuild(strtable *t, int slot_count)
+{
+    slot *old_slots = t->slots;
+    int old_count = t->slot_count;
+    char *old_arena = t->arena;
+
+    t->slot_count = slot_count;
+    t->slots = malloc(slot_count * sizeof(*t->slots));
+    for (int i = 0; i < slot_count; i++) {
+        t->slots[i].len = EMPTY_SLOT;
+    }
+    t->arena = NULL;
+    t->arena_size = 0;
+    t->arena_capacity = 0;
+    t->arena_garbage = 0;
+
+    int mask = slot_count - 1;
+    for (int i = 0; i < old_count; i++) {
+        slot *s = &old_slots[i];
+        if (s->len == EMPTY_SLOT) {
+            continue;
+        }
+        int j = home_of(t, s->hash);
+        while (t->slots[j].len != EMPTY_SLOT) {
+            j = (j + 1) & mask;
+        }
+        t->slots[j] = *s;
+        if (s->len >= INLINE_KEY_SIZE) {
+            t->slots[j].key.offset = arena_append(t, old_arena + s->key.offset, s->len);
+        }
+    }
+    free(old_slots);
+    free(old_arena);
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * strtable_empty() - Create an empty string table.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+strtable *strtable_empty(kill_function value_kill_func)
+{
+    // Allocate the table header.
+    strtable *t = calloc(1, sizeof(*t));
+
+    // Start with a few empty slots, doubled as the table grows.
+    t->slot_count = 8;
+    t->slots = malloc(t->slot_count * sizeof(*t->slots));
+    for (int i = 0; i < t->slot_count; i++) {
+        t->slots[i].len = EMPTY_SLOT;
+    }
+
+    // Store the value kill function.
+    t->value_kill_func = value_kill_func;
+
+    return t;
+}
+
+/**
+ * strtable_is_empty() - Check if a table is empty.
+ * @t: Table to check.
+ *
+ * Returns: True if the table contains no key/value pairs, false otherwise.
+ */
+bool strtable_is_empty(const strtable *t)
+{
+    return t->size == 0;
+}
+
+/**
+ * strtable_size() - Return the number of key/value pairs in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The number of key/value pairs.
+ */
+int strtable_size(const strtable *t)
+{
+    return t->size;
+}
+
+/**
+ * strtable_insert() - Add a key/value pair to a table.
+ * @t: Table to manipulate.
+ * @key: The key, a '\0'-terminated string. The table stores a copy.
+ * @value: A pointer to the value value.
+ *
+ * Returns: Nothing.
+ */
+void strtable_insert(strtable *t, const char *key, void *value)
+{
+    int len;
+    unsigned long hash = hash_key(key, &len);
+    int i = find_slot(t, key, hash, len);
+    slot *s = &t->slots[i];
+
+    if (s->len != EMPTY_SLOT) {
+        // Duplicate. Kill the old value unless the memory is reused.
+        if (t->value_kill_func != NULL && s->value != value) {
+            t->value_kill_func(s->value);
+        }
+        s->value = value;
+        return;
+    }
+    if (10 * (t->size + 1) > 7 * t->slot_count) {
+        rebuild(t, 2 * t->slot_count);
+        s = &t->slots[find_slot(t, key, hash, len)];
+    }
+    s->hash = hash;
+    s->value = value;
+    s->len = len;
+    if (len < INLINE_KEY_SIZE) {
+        memcpy(s->key.chars, key, len + 1);
+    } else {
+        s->key.offset = arena_append(t, key, len);
+    }
+    t->size++;
+}
+
+/**
+ * strtable_lookup() - Look up a given key in a table.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to the key, or NULL if the key is
+ * not found in the table.
+ */
+void *strtable_lookup(const strtable *t, const char *key)
+{
+    int len;
+    unsigned long hash = hash_key(key, &len);
+    const slot *s = &t->slots[find_slot(t, key, hash, len)];
+    return s->len == EMPTY_SLOT ? NULL : s->value;
+}
+
+/**
+ * strtable_remove() - Remove a key/value pair from a table.
+ * @t: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Returns: Nothing.
+ */
+void strtable_remove(strtable *t, const char *key)
+{
+    int len;
+    unsigned long hash = hash_key(key, &len);
+    int i = find_slot(t, key, hash, len);
+    if (t->slots[i].len == EMPTY_SLOT) {
+        return;
+    }
+    if (t->value_kill_func != NULL) {
+        t->value_kill_func(t->slots[i].value);
+    }
+    if (len >= INLINE_KEY_SIZE) {
+        t->arena_garbage += len + 1;
+    }
+    t->size--;
+
+    // Move later pairs of the probe sequence into the hole, unless
+    // their home slot is cyclically in (hole, pair].
+    int mask = t->slot_count - 1;
+    int j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (t->slots[j].len == EMPTY_SLOT) {
+            break;
+        }
+        int home = home_of(t, t->slots[j].hash);
+        bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+        if (!stays) {
+            t->slots[i] = t->slots[j];
+            i = j;
+        }
+    }
+    t->slots[i].len = EMPTY_SLOT;
+
+    if (t->arena_garbage > MIN_ARENA_GARBAGE && 2 * t->arena_garbage > t->arena_size) {
+        rebuild(t, t->slot_count);
+    }
+}
+
+/**
+ * strtable_kill() - Destroy a table.
+ * @t: Table to destroy.
+ *
+ * Returns: Nothing.
+ */
+void strtable_kill(strtable *t)
+{
+    if (t->value_kill_func != NULL) {
+        for (int i = 0; i < t->slot_count; i++) {
+            if (t->slots[i].len != EMPTY_SLOT) {
+                t->value_kill_func(t->slots[i].value);
+            }
+        }
+    }
+    free(t->slots);
+    free(t->arena);
+    free(t);
+}
+
+/**
+ * strtable_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Returns: Nothing.
+ */
+void strtable_print(const strtable *t, inspect_callback_pair print_func)
+{
+    for (int i = 0; i < t->slot_count; i++) {
+        const slot *s = &t->slots[i];
+        if (s->len != EMPTY_SLOT) {
+            print_func(slot_key(t, s), s->value);
+        }
+    }
+}
+
+// ===========INTERNAL FUNCTIONS USED BY strtable_print_internal ============
+
+// The functions below output code in the dot language, used by
+// GraphViz. For documention of the dot language, see graphviz.org.
+
+/**
+ * indent() - Output indentation string.
+ * @n: Indentation level.
+ *
+ * Print n tab characters.
+ *
+ * Returns: Nothing.
+ */
+static void indent(int n)
+{
+    for (int i=0; i<n; i++) {
+        printf("\t");
+    }
+}
+
+/**
+ * iprintf(...) - Indent and print.
+ * @n: Indentation level
+ * @...: printf arguments
+ *
+ * Print n tab characters and calls printf.
+ *
+ * Returns: Nothing.
+ */
+static void iprintf(int n, const char *fmt, ...)
+{
+    // Indent...
+    indent(n);
+    // ...and call printf
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * print_edge() - Print a edge between two addresses.
+ * @from: The address of the start of the edge. Should be non-NULL.
+ * @to: The address of the destination for the edge, including NULL.
+ * @port: The name of the port on the source node, or NULL.
+ * @label: The label for the edge, or NULL.
+ * @options: A string with other edge options, or NULL.
+ *
+ * Print an edge from port PORT on node FROM to TO with label
+ * LABEL. If to is NULL, the destination is the NULL node, otherwise a
+ * memory node. If the port is NULL, the edge starts at the node, not
+ * a specific port on it. If label is NULL, no label is used. The
+ * options string, if non-NULL, is printed before the label.
+ *
+ * Returns: Nothing.
+ */
+static void print_edge(int indent_level, const void *from, const void *to, const char *port,
+                       const char *label, const char *options)
+{
+    indent(indent_level);
+    if (port) {
+        printf("m%04lx:%s -> ", PTR2ADDR(from), port);
+    } else {
+        printf("m%04lx -> ", PTR2ADDR(from));
+    }
+    if (to == NULL) {
+        printf("NULL");
+    } else {
+        printf("m%04lx", PTR2ADDR(to));
+    }
+    printf(" [");
+    if (options != NULL) {
+        printf("%s", options);
+    }
+    if (label != NULL) {
+        printf(" label=\"%s\"",label);
+    }
+    printf("]\n");
+}
+
+// Internal function to print the head node in dot format.
+static void print_head_node(int indent_level, const strtable *t)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"size\\n%d|slot_count\\n%d"
+            "|<s>slots\\n%04lx|<a>arena\\n%04lx|arena_size\\n%lu|arena_garbage\\n%lu\"]\n",
+            PTR2ADDR(t), t->size, t->slot_count, PTR2ADDR(t->slots),
+            PTR2ADDR(t->arena), (unsigned long)t->arena_size,
+            (unsigned long)t->arena_garbage);
+}
+
+// Internal function to print a string inside a record label, with the
+// characters that have a special meaning in records escaped.
+static void print_record_string(const char *s)
+{
+    for (; *s != '\0'; s++) {
+        if (strchr("\"\\|{}<> ", *s) != NULL) {
+            printf("\\%c", *s);
+        } else if (*s == '\n') {
+            printf("\\\\n");
+        } else if (*s == '\t') {
+            printf("\\\\t");
+        } else {
+            putchar(*s);
+        }
+    }
+}
+
+// Internal function to print the slot array in dot format. Each used
+// slot shows its key, and the arena offset of a long key.
+static void print_slots(int indent_level, const strtable *t)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"", PTR2ADDR(t->slots));
+    for (int i = 0; i < t->slot_count; i++) {
+        const slot *s = &t->slots[i];
+        printf("<%02d>%02d\\n", i, i);
+        if (s->len != EMPTY_SLOT) {
+            printf("\\\"");
+            print_record_string(slot_key(t, s));
+            printf("\\\"");
+            if (s->len >= INLINE_KEY_SIZE) {
+                printf("\\n@%lu", (unsigned long)s->key.offset);
+            }
+        }
+        if (i < t->slot_count - 1) {
+            printf("|");
+        }
+    }
+    printf("\"]\n");
+}
+
+// Internal function to print a value node in dot format.
+static void print_payload_node(int indent_level, const void *p, inspect_callback print_func)
+{
+    iprintf(indent_level, "m%04lx [label=\"", PTR2ADDR(p));
+    if (print_func != NULL) {
+        print_func(p);
+    }
+    printf("\" xlabel=\"%04lx\"]\n", PTR2ADDR(p));
+}
+
+// Create an escaped version of the input string. The most common
+// control characters - newline, horizontal tab, backslash, and double
+// quote - are replaced by their escape sequence. The returned pointer
+// must be deallocated by the caller.
+static char *escape_chars(const char *s)
+{
+    int i, j;
+    int escaped = 0; // The number of chars that must be escaped.
+
+    // Count how many chars need to be escaped, i.e. how much longer
+    // the output string will be.
+    for (i = escaped = 0; s[i] != '\0'; i++) {
+        if (s[i] == '\n' || s[i] == '\t' || s[i] == '\\' || s[i] == '\"') {
+            escaped++;
+        }
+    }
+    // Allocate space for the escaped string. The variable i holds the input
+    // length, escaped how much the string will grow.
+    char *t = malloc(i + escaped + 1);
+
+    // Copy-and-escape loop
+    for (i = j = 0; s[i] != '\0'; i++) {
+        // Convert each control character by its escape sequence.
+        // Non-control characters are copied as-is.
+        switch (s[i]) {
+        case '\n': t[i+j] = '\\'; t[i+j+1] = 'n';  j++; break;
+        case '\t': t[i+j] = '\\'; t[i+j+1] = 't';  j++; break;
+        case '\\': t[i+j] = '\\'; t[i+j+1] = '\\'; j++; break;
+        case '\"': t[i+j] = '\\'; t[i+j+1] = '\"'; j++; break;
+        default:   t[i+j] = s[i]; break;
+        }
+    }
+    // Terminal the output string
+    t[i+j] = '\0';
+    return t;
+}
+
+/**
+ * strtable_print_internal() - Output the internal structure of the table.
+ * @t: Table to print.
+ * @value_print_func: Function called for each value in the table.
+ * @desc: String with a description/state of the table.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the table and prints code that shows its' internal
+ * structure.
+ *
+ * Returns: Nothing.
+ */
+void strtable_print_internal(const strtable *t, inspect_callback value_print_func,
+                             const char *desc, int indent_level)
+{
+    static int graph_number = 0;
+    graph_number++;
+    int il = indent_level;
+
+    if (indent_level == 0) {
+        // If this is the outermost datatype, start a graph and set up defaults
+        printf("digraph STRTABLE_%d {\n", graph_number);
+
+        // Specify default shape and fontname
+        il++;
+        iprintf(il, "node [shape=rectangle fontname=\"Courier New\"]\n");
+        iprintf(il, "ranksep=0.01\n");
+        iprintf(il, "subgraph cluster_nullspace {\n");
+        iprintf(il+1, "NULL\n");
+        iprintf(il, "}\n");
+    }
+
+    if (desc != NULL) {
+        // Escape the string before printout
+        char *escaped = escape_chars(desc);
+        // Use different names on inner description nodes
+        if (indent_level == 0) {
+            iprintf(il, "description [label=\"%s\"]\n", escaped);
+        } else {
+            iprintf(il, "cluster_strtable_%d_description [label=\"%s\"]\n",
+                    graph_number, escaped);
+        }
+        free(escaped);
+    }
+
+    if (indent_level == 0) {
+        // Use a single "pointer" edge as a starting point for the
+        // outermost datatype
+        iprintf(il, "t [label=\"%04lx\" xlabel=\"t\"]\n", PTR2ADDR(t));
+        iprintf(il, "t -> m%04lx\n", PTR2ADDR(t));
+
+        // Put the user nodes in userspace
+        iprintf(il, "subgraph cluster_userspace { label=\"User space\"\n");
+        for (int i = 0; i < t->slot_count; i++) {
+            if (t->slots[i].len != EMPTY_SLOT) {
+                print_payload_node(il + 1, t->slots[i].value, value_print_func);
+            }
+        }
+        iprintf(il, "}\n");
+    }
+
+    // Print the subgraph to surround the table content
+    iprintf(il, "subgraph cluster_strtable_%d { label=\"String table\"\n", graph_number);
+    il++;
+    print_head_node(il, t);
+    print_slots(il, t);
+    if (t->arena != NULL) {
+        iprintf(il, "m%04lx [label=\"arena\\n%lu of %lu bytes used\"]\n",
+                PTR2ADDR(t->arena), (unsigned long)t->arena_size,
+                (unsigned long)t->arena_capacity);
+    }
+    il--;
+    iprintf(il, "}\n");
+
+    // Output the edges from the head and the slots.
+    print_edge(il, t, t->slots, "s", "slots", NULL);
+    print_edge(il, t, t->arena, "a", "arena", NULL);
+    for (int i = 0; i < t->slot_count; i++) {
+        const slot *s = &t->slots[i];
+        if (s->len != EMPTY_SLOT) {
+            char port[15];
+            sprintf(port, "%02d", i);
+            print_edge(il, t->slots, s->value, port, "value",
+                       t->value_kill_func ? "color=red" : "color=red style=dashed");
+        }
+    }
+
+    if (indent_level == 0) {
+        // Termination of graph
+        printf("}\n");
+    }
+}
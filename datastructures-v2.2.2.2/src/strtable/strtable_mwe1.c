@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <strtable.h>
+
+/*
+ * Minimum working example for strtable.c. Counts the words of a text
+ * in a table with string keys. The words are copied into a local
+ * buffer that is reused for every word, since the table stores its
+ * own copies of the keys. The table is responsible for deallocating
+ * the values.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+// Create a dynamic copy of the integer i.
+int *int_create(int i)
+{
+    // Allocate memory for an integer and set the value
+    int *v = malloc(sizeof(*v));
+    *v = i;
+    return v;
+}
+
+// Interpret the supplied key and value pointers and print their content.
+void print_string_int_pair(const void *key, const void *value)
+{
+    const char *k=key;
+    const int *v=value;
+    printf("[%s, %d]\n", k, *v);
+}
+
+// Count one occurrence of a word.
+void count_word(strtable *t, const char *word)
+{
+    int *count = strtable_lookup(t, word);
+    if (count != NULL) {
+        (*count)++;
+    } else {
+        strtable_insert(t, word, int_create(1));
+    }
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Count words with a (string, integer) table.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    const char *text = "the quick brown fox jumps over the lazy dog and "
+        "the incomprehensibilities of the dog";
+
+    // Hand over the deallocation responsibility of the values to the table.
+    strtable *t = strtable_empty(free);
+
+    // Split the text into words in a reused buffer.
+    char word[64];
+    const char *p = text;
+    while (*p != '\0') {
+        int len = strcspn(p, " ");
+        memcpy(word, p, len);
+        word[len] = '\0';
+        count_word(t, word);
+        p += len;
+        p += strspn(p, " ");
+    }
+
+    printf("Table with %d distinct words:\n", strtable_size(t));
+    strtable_print(t, print_string_int_pair);
+
+    strtable_remove(t, "the");
+    printf("Count of \"the\" after removing it: %s.\n",
+           strtable_lookup(t, "the") == NULL ? "(not found)" : "found");
+
+    // Kill the table, including the values.
+    strtable_kill(t);
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <strtable.h>
+
+/*
+ * Minimum working example for strtable.c. Inserts 3 key-value pairs
+ * into a table with string keys, where one key is too long to be
+ * stored in its slot. Output dot/graphviz code to show the internal
+ * structure of the table. The table stores its own copies of the
+ * keys. In this version, the table "borrows" the value memory, i.e.,
+ * the user of the table is responsible for deallocating the values.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version. Adapted from cache_mwe1i.c.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+// Create a dynamic copy of the integer i.
+int *int_create(int i)
+{
+    // Allocate memory for an integer and set the value
+    int *v = malloc(sizeof(*v));
+    *v = i;
+    return v;
+}
+
+// Return the memory used by the integer.
+void int_kill(void *v)
+{
+    int *p = v;
+    free(p);
+}
+
+// Interpret the supplied key and value pointers and print their content.
+void print_string_int_pair(const void *key, const void *value)
+{
+    const char *k=key;
+    const int *v=value;
+    printf("[%s, %d]\n", k, *v);
+}
+
+// Interpret the supplied value pointer and print its content.
+void print_int(const void *value)
+{
+    const int *v=value;
+    printf("%d", *v);
+}
+
+// Print cut lines before and after a call strtable_print_internal.
+void print_internal_with_cut_lines(const strtable *t, const char *desc)
+{
+    // Internal counter that will be remembered between calls.
+
+    // Used to generate sequentially numbered -- CUT HERE -- marker lines
+    // to enable automatic parsing of the output.
+    static int cut = 1;
+
+    // Print starting marker line.
+    printf("\n--- START CUT HERE %d ---\n", cut);
+
+    // Call the internal print function to get the actual dot code.
+    strtable_print_internal(t, print_int, desc, 0);
+
+    // Print ending marker line
+    printf("--- END CUT HERE %d ---\n\n", cut);
+
+    // Increment the cut number. Will be remembered next time the
+    // function is called since cut is a static variable.
+    cut++;
+}
+
+// Print a message with intructions how to use the dot output. prog is
+// the name of the executable.
+void print_dot_usage(char *prog)
+{
+    printf("\nGenerate dot code to visualize internal structure with GraphViz. ");
+    printf("Use\n\n%s ", prog);
+    printf("| sed -n '/START CUT HERE X/,/END CUT HERE X/{//!p}' | dot -Tsvg > /tmp/dot.svg\n\n");
+    printf("to generate an svg file of cut X (replace X by the requested cut number).\n");
+    printf("The generated file can then be visualized with\n\n");
+    printf("firefox /tmp/dot.svg\n\n");
+    printf("Use -Tpng to generate a .png file instead. "
+           "See graphviz.org and %s for documentation.\n", __FILE__);
+
+    printf("\n--- Start of normal output ---\n\n");
+}
+
+int main(int argc, char *argv[])
+{
+    printf("%s, %s %s: Create (string, integer) table without any kill_function.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    print_dot_usage(argv[0]);
+
+    // Keep track of the values we allocate.
+    void *value[3];
+
+    value[0] = int_create(31);
+    value[1] = int_create(28);
+    value[2] = int_create(30);
+
+    // Keep the deallocation responsibility of the values we allocate.
+    strtable *t = strtable_empty(NULL);
+
+    strtable_insert(t, "Jan", value[0]);
+    strtable_insert(t, "Feb", value[1]);
+    printf("Table from the outside after inserting 2 key-value pairs:\n");
+    strtable_print(t, print_string_int_pair);
+    print_internal_with_cut_lines(t, __FILE__ ": String table with 2 short keys "
+                                  "showing the inside structure.");
+
+    // This key is stored in the arena.
+    strtable_insert(t, "The month after the leap day", value[2]);
+    printf("Table from the outside after inserting a long key:\n");
+    strtable_print(t, print_string_int_pair);
+    print_internal_with_cut_lines(t, __FILE__ ": String table with a long key.");
+
+    // Kill the table, excluding the values we entered.
+    strtable_kill(t);
+
+    // Free the values that we put in the table.
+    for (int i = 0; i < sizeof(value)/sizeof(value[0]); i++) {
+        int_kill(value[i]);
+    }
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
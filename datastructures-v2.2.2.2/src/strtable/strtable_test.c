@@ -0,0 +1,212 @@
+/*
+ * strtable_test - test the table with string keys.
+ *
+ * Should be compiled together with the string table implementation
+ * that follows the interface in strtable.h of the code base for the
+ * Datastructures and Algorithms courses at the Department of
+ * Computing Science, Umea University.
+ *
+ * The program runs a number of correctness tests, and exits with an
+ * error message at the first failure.
+ *
+ * 2026-10-18 v1.0  First public version.
+ * 2026-10-18 v1.1  The helpers shared with the other tests, and the
+ *                  monotonic clock of the timing, come from testutil.c.
+ * 2026-10-18 v1.2  Moved from ou3/strtabletest.c to
+ *                  src/strtable/strtable_test.c. The comparison of the
+ *                  speed with a table from table.h, and its command
+ *                  line arguments, are removed.
+*/
+
+#define VERSION "v1.2"
+#define VERSION_DATE "2026-10-18"
+
+/*
+ * Correctness testing algorithm:
+ *
+ * 1. Tests that a new table is empty, and that the table keeps its own
+ *    copies of the keys.
+ * 2. Tests keys with lengths around the limit for keys stored in the
+ *    slots, and the empty key.
+ * 3. Tests the table with a random sequence of inserts, lookups and
+ *    removes of short and long keys, and compares the contents with a
+ *    simple array. Many long keys are removed, so the arena is
+ *    compacted.
+ * */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "strtable.h"
+
+/**
+ * copy_string() - Create a dynamic copy of a string.
+ * @s: String to be copied.
+ *
+ * Allocates memory for a dynamic copy of s and copies the contents of
+ * s into the copy.
+ *
+ * Returns: Pointer to the copy of s.
+ */
+char *copy_string(const char *s)
+{
+    int len=strlen(s);
+
+    /* Allocate memory for new string, with an extra char for \0 */
+    char *dest = malloc(sizeof(char)*(len+1));
+
+    /* Malloc failed, return NULL */
+    if (dest == NULL) {
+        return NULL;
+    }
+
+    /* Copy content to new memory */
+    strncpy(dest, s, len);
+
+    /* Strings should always be null terminated */
+    dest[len] = '\0';
+    return dest;
+}
+
+/* Creates a key of a given length from a number.
+ *    buf - the buffer for the key, with room for len+1 characters
+ *    i - the number, which must fit in len characters
+ *    len - the length of the key
+ */
+void make_key(char *buf, int i, int len)
+{
+    // Pad the number with a letter, so that keys of different
+    // lengths differ.
+    int n = sprintf(buf, "%d", i);
+    memset(buf + n, 'a' + len % 26, len - n);
+    buf[len] = '\0';
+}
+
+/* Tests that a new table is empty, and that keys are copied.
+ */
+void test_isempty()
+{
+    strtable *t = strtable_empty(NULL);
+    int v = 1;
+
+    if (!strtable_is_empty(t) || strtable_size(t) != 0
+        || strtable_lookup(t, "key") != NULL) {
+        printf("A newly created table is not empty.\n");
+        exit(EXIT_FAILURE);
+    }
+    char key[] = "key";
+    strtable_insert(t, key, &v);
+    key[0] = 'K';
+    if (strtable_lookup(t, "key") != &v || strtable_lookup(t, key) != NULL) {
+        printf("The table does not keep its own copy of the key.\n");
+        exit(EXIT_FAILURE);
+    }
+    strtable_kill(t);
+    printf("A new table is empty and copies the keys. - OK\n");
+}
+
+/* Tests keys with lengths around the inline limit.
+ */
+void test_key_lengths()
+{
+    strtable *t = strtable_empty(free);
+    char key[64];
+
+    for (int len = 0; len < 40; len++) {
+        memset(key, 'x', len);
+        key[len] = '\0';
+        strtable_insert(t, key, copy_string(key));
+    }
+    for (int len = 0; len < 40; len++) {
+        memset(key, 'x', len);
+        key[len] = '\0';
+        const char *v = strtable_lookup(t, key);
+        if (v == NULL || strcmp(v, key) != 0) {
+            printf("The key of length %d was not found.\n", len);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (strtable_size(t) != 40) {
+        printf("The table has %d pairs, expected 40.\n",
+               strtable_size(t));
+        exit(EXIT_FAILURE);
+    }
+    strtable_kill(t);
+    printf("Keys of length 0 to 39 are stored correctly. - OK\n");
+}
+
+// The number of keys in test_random_operations.
+#define RANDOM_KEYS 500
+
+/* Tests the table with a random sequence of operations.
+ */
+void test_random_operations()
+{
+    int expected[RANDOM_KEYS];
+    int lengths[RANDOM_KEYS];
+    int size = 0;
+    char key[128];
+    strtable *t = strtable_empty(free);
+
+    for (int i = 0; i < RANDOM_KEYS; i++) {
+        expected[i] = -1;
+        // Half of the keys are too long for the slots.
+        lengths[i] = i % 2 == 0 ? 4 + rand() % 19 : 24 + rand() % 100;
+    }
+    for (int i = 0; i < 50000; i++) {
+        int k = rand() % RANDOM_KEYS;
+        make_key(key, k, lengths[k]);
+        int op = rand() % 3;
+        if (op == 0) {
+            strtable_remove(t, key);
+            size -= expected[k] >= 0;
+            expected[k] = -1;
+        } else if (op == 1) {
+            int *v = malloc(sizeof(int));
+            *v = i;
+            strtable_insert(t, key, v);
+            size += expected[k] < 0;
+            expected[k] = i;
+        }
+        const int *v = strtable_lookup(t, key);
+        if ((expected[k] < 0 && v != NULL)
+            || (expected[k] >= 0 && (v == NULL || *v != expected[k]))
+            || strtable_size(t) != size) {
+            printf("Key %s has the wrong value.\n", key);
+            exit(EXIT_FAILURE);
+        }
+    }
+    // Check all keys, after any compactions of the arena.
+    for (int k = 0; k < RANDOM_KEYS; k++) {
+        make_key(key, k, lengths[k]);
+        const int *v = strtable_lookup(t, key);
+        if ((expected[k] < 0) != (v == NULL)) {
+            printf("Key %s has the wrong value.\n", key);
+            exit(EXIT_FAILURE);
+        }
+    }
+    strtable_kill(t);
+    printf("Random inserts, lookups and removes. - OK\n");
+}
+
+/*  Tests the table by performing a set of tests. Program exits if any
+ *  error is found.
+ */
+void correctness_test()
+{
+    test_isempty();
+    test_key_lengths();
+    test_random_operations();
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Test program for the string table.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s.\n\n", CODE_BASE_VERSION);
+
+    correctness_test();
+
+    printf("\nAll correctness tests succeeded! Normal exit.\n");
+    return 0;
+}
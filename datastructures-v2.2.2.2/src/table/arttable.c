@@ -0,0 +1,2369 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h> // For isspace()
+#include <stdarg.h>
+
+#include <table.h>
+#include <perfect_table.h>
+
+/*
+ * Implementation of a generic table for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University.
+ *
+ * The table entries are stored in an adaptive radix tree (ART). Each
+ * key is seen as a sequence of bytes, and each inner node branches on
+ * one byte of the key. Depending on the number of children, an inner
+ * node is one of four types: NODE4 and NODE16 store the bytes of the
+ * children in sorted arrays, NODE48 maps each byte to one of 48 child
+ * slots, and NODE256 has one child pointer per byte. A node grows to
+ * the next type when it is full, and shrinks when it has few children
+ * left. A sequence of bytes shared by all keys below a node is stored
+ * as a prefix in the node instead of as a chain of nodes with one
+ * child each. Insert, lookup and remove thus take O(k) time for keys
+ * of k bytes, independently of the number of keys in the table.
+ *
+ * String keys are stored as their bytes including the terminating
+ * '\0', so no key is a prefix of another key. Int keys, see
+ * table_empty_with_key_type, are stored as their big-endian bytes
+ * with the sign bit flipped. In both cases, the byte order of the
+ * keys is the same as the order of the keys, so the ordered queries
+ * and table_prefix_scan visit the keys in order without sorting.
+ *
+ * The bytes of opaque keys, the default of table_empty and
+ * table_empty_with_hash, are not known. They are stored as the
+ * big-endian bytes of their hash, or as no bytes at all without a
+ * hash function. Different keys with the same bytes are kept in a
+ * BUCKET node, ordered by key_cmp_func, in place of a leaf. The byte
+ * order of opaque keys is not their order, so the ordered queries
+ * compare all keys with key_cmp_func.
+ *
+ * Duplicates are handled by insert, i.e. a duplicate key replaces the
+ * stored key/value pair. A key is a duplicate if it has the same
+ * bytes as a stored key and key_cmp_func finds them equal.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: Added table_empty_with_allocator.
+ *   v1.2  2026-10-18: table_kill returns at once for a table in an arena.
+ *   v1.3  2026-10-18: Opaque keys by default, and buckets for different
+ *                     keys with the same bytes.
+ *   v1.4  2026-10-18: table_merge only drops reused memory from a leaf
+ *                     that no clone refers to.
+ */
+
+// ===========INTERNAL DATA TYPES ============
+
+// The number of prefix bytes stored in an inner node. Longer prefixes
+// are checked against a key stored below the node.
+#define MAX_PREFIX 10
+
+typedef enum node_type {
+    LEAF,
+    NODE4,
+    NODE16,
+    NODE48,
+    NODE256,
+    BUCKET,
+} node_type;
+
+// Common header of all nodes.
+typedef struct art_node {
+    node_type type;
+    int refs; // Number of parents and roots referring to the node
+} art_node;
+
+// A leaf holds one key/value pair.
+typedef struct art_leaf {
+    art_node n;
+    void *key;
+    void *value;
+} art_leaf;
+
+// A bucket holds the leaves of different keys with the same bytes. It
+// is never modified, but replaced by a new bucket.
+typedef struct art_bucket {
+    art_node n;
+    int count;         // Number of leaves, at least 2
+    art_leaf **leaves; // The leaves, ordered by key_cmp_func
+} art_bucket;
+
+// Common header of all inner nodes.
+typedef struct art_inner {
+    art_node n;
+    int children;   // Number of children
+    int prefix_len; // Number of bytes shared by all keys below the node
+    unsigned char prefix[MAX_PREFIX]; // The first of the shared bytes
+} art_inner;
+
+typedef struct node4 {
+    art_inner h;
+    unsigned char bytes[4]; // Sorted bytes of the children
+    art_node *child[4];
+} node4;
+
+typedef struct node16 {
+    art_inner h;
+    unsigned char bytes[16]; // Sorted bytes of the children
+    art_node *child[16];
+} node16;
+
+typedef struct node48 {
+    art_inner h;
+    unsigned char slot[256]; // 1 + the index of the child of each byte, or 0
+    art_node *child[48];
+} node48;
+
+typedef struct node256 {
+    art_inner h;
+    art_node *child[256];
+} node256;
+
+// The bytes of a key.
+typedef struct art_key {
+    const unsigned char *bytes;
+    int len;
+    unsigned char buf[sizeof(unsigned long)]; // The bytes of an int key or hash
+} art_key;
+
+struct table {
+    art_node *root; // The table entries are stored in a radix tree
+    int size;       // Number of keys in the tree
+    table_key_type key_type;
+    compare_function *key_cmp_func;
+    hash_function *key_hash_func; // NULL if the table cannot be frozen
+    kill_function key_kill_func;
+    kill_function value_kill_func;
+    perfect_table *frozen; // Non-NULL once the table has been frozen
+    int *frozen_refs; // Number of tables sharing frozen, see table_clone
+    const allocator *alloc; // Allocator for the head and nodes
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
+
+
+/**
+ * encode_key() - Compute the bytes of a key.
+ * @t: Table with the key type.
+ * @key: The key.
+ * @k: Output parameter for the bytes. Must not be copied, as the bytes
+ *     of an int key are stored in k itself.
+ *
+ * Returns: Nothing.
+ */
+static void encode_key(const table *t, const void *key, art_key *k)
+{
+    if (t->key_type == TABLE_KEY_OPAQUE) {
+        // The bytes of the key are unknown. Use the hash, if any.
+        k->bytes = k->buf;
+        k->len = 0;
+        if (t->key_hash_func != NULL) {
+            unsigned long h = t->key_hash_func(key);
+            k->len = sizeof(h);
+            for (int i = sizeof(h) - 1; i >= 0; i--) {
+                k->buf[i] = h & 0xff;
+                h >>= 8;
+            }
+        }
+    } else if (t->key_type == TABLE_KEY_INT) {
+        // Flip the sign bit so that negative keys come first.
+        unsigned int v = (unsigned int)*(const int *)key ^ (~0u ^ (~0u >> 1));
+        for (int i = sizeof(int) - 1; i >= 0; i--) {
+            k->buf[i] = v & 0xff;
+            v >>= 8;
+        }
+        k->bytes = k->buf;
+        k->len = sizeof(int);
+    } else {
+        k->bytes = key;
+        k->len = strlen(key) + 1;
+    }
+}
+
+// Internal function to return byte i of a key, or 0 beyond its end.
+static unsigned char key_byte(const art_key *k, int i)
+{
+    return i < k->len ? k->bytes[i] : 0;
+}
+
+// Internal function to compare the bytes of two keys like memcmp.
+static int compare_bytes(const art_key *a, const art_key *b)
+{
+    int len = a->len < b->len ? a->len : b->len;
+    int c = memcmp(a->bytes, b->bytes, len);
+    return c != 0 ? c : a->len - b->len;
+}
+
+// Internal function to compare two keys in the order of the leaves,
+// i.e. in byte order and then, for the keys of a bucket, by key_cmp_func.
+static int compare_keys(const table *t, const void *a, const void *b)
+{
+    art_key ka, kb;
+    encode_key(t, a, &ka);
+    encode_key(t, b, &kb);
+    int c = compare_bytes(&ka, &kb);
+    return c != 0 ? c : t->key_cmp_func(a, b);
+}
+
+// Internal function to return the size of a node of a given type.
+static size_t node_size(node_type type)
+{
+    switch (type) {
+    case LEAF:   return sizeof(art_leaf);
+    case NODE4:  return sizeof(node4);
+    case NODE16: return sizeof(node16);
+    case NODE48: return sizeof(node48);
+    case BUCKET: return sizeof(art_bucket);
+    default:     return sizeof(node256);
+    }
+}
+
+// Internal function to allocate an empty node of a given type.
+static art_node *node_create(const allocator *alloc, node_type type)
+{
+    // The allocator returns zeroed memory, so all child pointers and
+    // slots are empty.
+    art_node *n = alloc->allocate(alloc->context, node_size(type));
+    n->type = type;
+    n->refs = 1;
+
+    return n;
+}
+
+// Internal function to allocate a leaf.
+static art_leaf *leaf_create(const allocator *alloc, void *key, void *value)
+{
+    art_leaf *l = (art_leaf *)node_create(alloc, LEAF);
+    l->key = key;
+    l->value = value;
+
+    return l;
+}
+
+// Internal function to check if a node is a leaf or a bucket, i.e. not
+// an inner node.
+static bool is_terminal(const art_node *n)
+{
+    return n->type == LEAF || n->type == BUCKET;
+}
+
+/**
+ * bucket_create() - Allocate a bucket.
+ * @alloc: The allocator of the table.
+ * @count: The number of leaves, at least 2.
+ *
+ * Returns: A bucket with room for count leaves, to be filled in by
+ * the caller.
+ */
+static art_bucket *bucket_create(const allocator *alloc, int count)
+{
+    art_bucket *b = (art_bucket *)node_create(alloc, BUCKET);
+    b->count = count;
+    b->leaves = alloc->allocate(alloc->context, count * sizeof(*b->leaves));
+
+    return b;
+}
+
+/**
+ * bucket_find() - Find the position of a key in a bucket.
+ * @t: Table with the key compare function.
+ * @b: The bucket.
+ * @key: The key.
+ * @found: Output parameter, set to true if the key is in the bucket.
+ *
+ * Returns: The position of the key, or of the first larger key.
+ */
+static int bucket_find(const table *t, const art_bucket *b, const void *key, bool *found)
+{
+    // Binary search for the first key >= key.
+    int lo = 0, hi = b->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (t->key_cmp_func(b->leaves[mid]->key, key) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    *found = lo < b->count && t->key_cmp_func(b->leaves[lo]->key, key) == 0;
+    return lo;
+}
+
+/**
+ * child_slots() - Return the number of child positions of an inner node.
+ * @n: The node.
+ *
+ * The positions are the indices of the sorted arrays of a NODE4 or
+ * NODE16, and the byte values of a NODE48 or NODE256. In both cases,
+ * the children are in byte order.
+ *
+ * Returns: The number of positions.
+ */
+static int child_slots(const art_inner *n)
+{
+    return n->n.type == NODE4 || n->n.type == NODE16 ? n->children : 256;
+}
+
+/**
+ * child_at() - Return the child at a given position of an inner node.
+ * @n: The node.
+ * @i: The position, see child_slots.
+ * @byte: Output parameter for the byte of the child.
+ *
+ * Returns: The child, or NULL if there is no child at the position.
+ */
+static art_node *child_at(const art_inner *n, int i, unsigned char *byte)
+{
+    switch (n->n.type) {
+    case NODE4:
+        *byte = ((const node4 *)n)->bytes[i];
+        return ((const node4 *)n)->child[i];
+    case NODE16:
+        *byte = ((const node16 *)n)->bytes[i];
+        return ((const node16 *)n)->child[i];
+    case NODE48: {
+        const node48 *n48 = (const node48 *)n;
+        *byte = i;
+        return n48->slot[i] == 0 ? NULL : n48->child[n48->slot[i] - 1];
+    }
+    default:
+        *byte = i;
+        return ((const node256 *)n)->child[i];
+    }
+}
+
+/**
+ * find_child() - Find the child pointer of an inner node for a byte.
+ * @n: The node.
+ * @byte: The byte.
+ *
+ * Returns: A pointer to the child pointer, or NULL if there is no child
+ * for the byte.
+ */
+static art_node **find_child(art_inner *n, unsigned char byte)
+{
+    switch (n->n.type) {
+    case NODE4: {
+        node4 *n4 = (node4 *)n;
+        for (int i = 0; i < n->children; i++) {
+            if (n4->bytes[i] == byte) {
+                return &n4->child[i];
+            }
+        }
+        return NULL;
+    }
+    case NODE16: {
+        node16 *n16 = (node16 *)n;
+        for (int i = 0; i < n->children && n16->bytes[i] <= byte; i++) {
+            if (n16->bytes[i] == byte) {
+                return &n16->child[i];
+            }
+        }
+        return NULL;
+    }
+    case NODE48: {
+        node48 *n48 = (node48 *)n;
+        return n48->slot[byte] == 0 ? NULL : &n48->child[n48->slot[byte] - 1];
+    }
+    default: {
+        node256 *n256 = (node256 *)n;
+        return n256->child[byte] == NULL ? NULL : &n256->child[byte];
+    }
+    }
+}
+
+// Internal function to return the first leaf below a node in the order
+// of the leaves, see compare_keys.
+static const art_leaf *min_leaf(const art_node *n)
+{
+    while (n != NULL && !is_terminal(n)) {
+        unsigned char byte;
+        const art_inner *in = (const art_inner *)n;
+        const art_node *first = NULL;
+        for (int i = 0; first == NULL; i++) {
+            first = child_at(in, i, &byte);
+        }
+        n = first;
+    }
+    if (n != NULL && n->type == BUCKET) {
+        return ((const art_bucket *)n)->leaves[0];
+    }
+    return (const art_leaf *)n;
+}
+
+// Internal function to return the last leaf below a node in the order
+// of the leaves, see compare_keys.
+static const art_leaf *max_leaf(const art_node *n)
+{
+    while (n != NULL && !is_terminal(n)) {
+        unsigned char byte;
+        const art_inner *in = (const art_inner *)n;
+        const art_node *last = NULL;
+        for (int i = child_slots(in) - 1; last == NULL; i--) {
+            last = child_at(in, i, &byte);
+        }
+        n = last;
+    }
+    if (n != NULL && n->type == BUCKET) {
+        const art_bucket *b = (const art_bucket *)n;
+        return b->leaves[b->count - 1];
+    }
+    return (const art_leaf *)n;
+}
+
+/**
+ * prefix_mismatch() - Compare the prefix of an inner node with a key.
+ * @t: Table with the key type.
+ * @n: The node.
+ * @k: The key.
+ * @depth: The index of the key byte matching the first prefix byte.
+ *
+ * Prefix bytes beyond MAX_PREFIX are taken from a key below the node.
+ *
+ * Returns: The number of prefix bytes that match the key.
+ */
+static int prefix_mismatch(const table *t, const art_inner *n, const art_key *k, int depth)
+{
+    int stored = n->prefix_len < MAX_PREFIX ? n->prefix_len : MAX_PREFIX;
+    int i;
+    for (i = 0; i < stored; i++) {
+        if (n->prefix[i] != key_byte(k, depth + i)) {
+            return i;
+        }
+    }
+    if (n->prefix_len > MAX_PREFIX) {
+        art_key lk;
+        encode_key(t, min_leaf(&n->n)->key, &lk);
+        for (; i < n->prefix_len; i++) {
+            if (lk.bytes[depth + i] != key_byte(k, depth + i)) {
+                return i;
+            }
+        }
+    }
+    return n->prefix_len;
+}
+
+/**
+ * own() - Make an inner node safe to modify.
+ * @alloc: The allocator of the table.
+ * @n: A node referred to by a node or root that is safe to modify.
+ *
+ * A node shared with a clone is copied. The copy refers to the same
+ * children as the node, and replaces the reference to it.
+ *
+ * Returns: The node, or a copy of it.
+ */
+static art_node *own(const allocator *alloc, art_node *n)
+{
+    if (n->refs == 1) {
+        return n;
+    }
+    art_node *c = alloc->allocate(alloc->context, node_size(n->type));
+    memcpy(c, n, node_size(n->type));
+    c->refs = 1;
+    art_inner *in = (art_inner *)c;
+    for (int i = 0; i < child_slots(in); i++) {
+        unsigned char byte;
+        art_node *child = child_at(in, i, &byte);
+        if (child != NULL) {
+            child->refs++;
+        }
+    }
+    n->refs--;
+
+    return c;
+}
+
+/**
+ * release() - Drop a reference to a subtree.
+ * @t: Table with the kill functions.
+ * @n: Root of the subtree, or NULL.
+ *
+ * Nodes without references are deallocated. For leaves, the key and
+ * value are killed if kill functions are set.
+ *
+ * Returns: Nothing.
+ */
+static void release(const table *t, art_node *n)
+{
+    if (n == NULL) {
+        return;
+    }
+    n->refs--;
+    if (n->refs > 0) {
+        // The subtree is still used by a clone.
+        return;
+    }
+    if (n->type == LEAF) {
+        art_leaf *l = (art_leaf *)n;
+        if (t->key_kill_func != NULL && l->key != NULL) {
+            t->key_kill_func(l->key);
+        }
+        if (t->value_kill_func != NULL && l->value != NULL) {
+            t->value_kill_func(l->value);
+        }
+    } else if (n->type == BUCKET) {
+        art_bucket *b = (art_bucket *)n;
+        for (int i = 0; i < b->count; i++) {
+            release(t, &b->leaves[i]->n);
+        }
+        allocator_deallocate(t->alloc, b->leaves, b->count * sizeof(*b->leaves));
+    } else {
+        art_inner *in = (art_inner *)n;
+        for (int i = 0; i < child_slots(in); i++) {
+            unsigned char byte;
+            release(t, child_at(in, i, &byte));
+        }
+    }
+    allocator_deallocate(t->alloc, n, node_size(n->type));
+}
+
+/**
+ * grow() - Replace a full inner node by a node of the next larger type.
+ * @alloc: The allocator of the table.
+ * @n: The node, safe to modify. Deallocated.
+ *
+ * Returns: The new node, with the same prefix and children.
+ */
+static art_inner *grow(const allocator *alloc, art_inner *n)
+{
+    art_inner *g = (art_inner *)node_create(alloc, n->n.type + 1);
+    g->children = n->children;
+    g->prefix_len = n->prefix_len;
+    memcpy(g->prefix, n->prefix, MAX_PREFIX);
+
+    if (n->n.type == NODE4) {
+        node4 *n4 = (node4 *)n;
+        node16 *n16 = (node16 *)g;
+        memcpy(n16->bytes, n4->bytes, sizeof(n4->bytes));
+        memcpy(n16->child, n4->child, sizeof(n4->child));
+    } else if (n->n.type == NODE16) {
+        node16 *n16 = (node16 *)n;
+        node48 *n48 = (node48 *)g;
+        for (int i = 0; i < n->children; i++) {
+            n48->slot[n16->bytes[i]] = i + 1;
+            n48->child[i] = n16->child[i];
+        }
+    } else {
+        node48 *n48 = (node48 *)n;
+        node256 *n256 = (node256 *)g;
+        for (int b = 0; b < 256; b++) {
+            if (n48->slot[b] != 0) {
+                n256->child[b] = n48->child[n48->slot[b] - 1];
+            }
+        }
+    }
+    allocator_deallocate(alloc, n, node_size(n->n.type));
+    return g;
+}
+
+/**
+ * add_child() - Add a child to an inner node.
+ * @alloc: The allocator of the table.
+ * @n: The node, safe to modify. Deallocated if it grows.
+ * @byte: The byte of the child. The node has no child for the byte.
+ * @child: The child. The node takes over the reference.
+ *
+ * Returns: The node, or the larger node that replaced it.
+ */
+static art_inner *add_child(const allocator *alloc, art_inner *n, unsigned char byte, art_node *child)
+{
+    static const int capacity[] = { 0, 4, 16, 48, 256 };
+    if (n->children == capacity[n->n.type]) {
+        n = grow(alloc, n);
+    }
+    if (n->n.type == NODE4 || n->n.type == NODE16) {
+        unsigned char *bytes = n->n.type == NODE4 ? ((node4 *)n)->bytes : ((node16 *)n)->bytes;
+        art_node **children = n->n.type == NODE4 ? ((node4 *)n)->child : ((node16 *)n)->child;
+        // Shift the larger bytes to keep the array sorted.
+        int i = n->children;
+        while (i > 0 && bytes[i - 1] > byte) {
+            bytes[i] = bytes[i - 1];
+            children[i] = children[i - 1];
+            i--;
+        }
+        bytes[i] = byte;
+        children[i] = child;
+    } else if (n->n.type == NODE48) {
+        node48 *n48 = (node48 *)n;
+        int i = 0;
+        while (n48->child[i] != NULL) {
+            i++;
+        }
+        n48->slot[byte] = i + 1;
+        n48->child[i] = child;
+    } else {
+        ((node256 *)n)->child[byte] = child;
+    }
+    n->children++;
+
+    return n;
+}
+
+/**
+ * shrink() - Replace an inner node by a node of the next smaller type.
+ * @alloc: The allocator of the table.
+ * @n: The node, safe to modify. Deallocated.
+ *
+ * Returns: The new node, with the same prefix and children.
+ */
+static art_inner *shrink(const allocator *alloc, art_inner *n)
+{
+    art_inner *s = (art_inner *)node_create(alloc, n->n.type - 1);
+    s->prefix_len = n->prefix_len;
+    memcpy(s->prefix, n->prefix, MAX_PREFIX);
+
+    // Add the children in byte order.
+    for (int i = 0; i < child_slots(n); i++) {
+        unsigned char byte;
+        art_node *child = child_at(n, i, &byte);
+        if (child != NULL) {
+            s = add_child(alloc, s, byte, child);
+        }
+    }
+    allocator_deallocate(alloc, n, node_size(n->n.type));
+    return s;
+}
+
+/**
+ * remove_child() - Remove a child from an inner node.
+ * @alloc: The allocator of the table.
+ * @n: The node, safe to modify. Deallocated if it shrinks.
+ * @byte: The byte of the child. The child is not released.
+ *
+ * Returns: The node, or the smaller node that replaced it.
+ */
+static art_inner *remove_child(const allocator *alloc, art_inner *n, unsigned char byte)
+{
+    if (n->n.type == NODE4 || n->n.type == NODE16) {
+        unsigned char *bytes = n->n.type == NODE4 ? ((node4 *)n)->bytes : ((node16 *)n)->bytes;
+        art_node **children = n->n.type == NODE4 ? ((node4 *)n)->child : ((node16 *)n)->child;
+        int i = 0;
+        while (bytes[i] != byte) {
+            i++;
+        }
+        for (; i < n->children - 1; i++) {
+            bytes[i] = bytes[i + 1];
+            children[i] = children[i + 1];
+        }
+        children[i] = NULL;
+    } else if (n->n.type == NODE48) {
+        node48 *n48 = (node48 *)n;
+        n48->child[n48->slot[byte] - 1] = NULL;
+        n48->slot[byte] = 0;
+    } else {
+        ((node256 *)n)->child[byte] = NULL;
+    }
+    n->children--;
+
+    // Shrink well below the capacity of the smaller type, so that a
+    // node does not grow and shrink on every other insert and remove.
+    if ((n->n.type == NODE256 && n->children <= 36)
+        || (n->n.type == NODE48 && n->children <= 12)
+        || (n->n.type == NODE16 && n->children <= 3)) {
+        n = shrink(alloc, n);
+    }
+    return n;
+}
+
+// Internal function to keep a leaf that is about to be released from
+// killing the key or value that a new leaf reuses.
+static void forget_reused(art_leaf *old, const art_leaf *l)
+{
+    if (old->key == l->key) {
+        old->key = NULL;
+    }
+    if (old->value == l->value) {
+        old->value = NULL;
+    }
+}
+
+/**
+ * insert_terminal() - Insert a leaf at a leaf or bucket with the same bytes.
+ * @t: Table to manipulate.
+ * @n: The leaf or bucket.
+ * @l: The leaf. The tree takes over the reference.
+ *
+ * A leaf with an equal key, by key_cmp_func, is replaced. Otherwise,
+ * the leaf is added to the bucket, or a bucket is made of the two
+ * leaves.
+ *
+ * Returns: The leaf or bucket that replaces n.
+ */
+static art_node *insert_terminal(table *t, art_node *n, art_leaf *l)
+{
+    if (n->type == LEAF) {
+        art_leaf *old = (art_leaf *)n;
+        int c = t->key_cmp_func(old->key, l->key);
+        if (c == 0) {
+            // Duplicate. Drop the old pair, but do not kill memory that
+            // is reused.
+            if (n->refs == 1) {
+                forget_reused(old, l);
+            }
+            release(t, n);
+            return &l->n;
+        }
+        art_bucket *b = bucket_create(t->alloc, 2);
+        b->leaves[c < 0 ? 0 : 1] = old;
+        b->leaves[c < 0 ? 1 : 0] = l;
+        t->size++;
+        return &b->n;
+    }
+
+    // The bucket may be shared with a clone, so it is replaced by a new
+    // bucket that refers to the same leaves, except the duplicate.
+    art_bucket *b = (art_bucket *)n;
+    bool found;
+    int pos = bucket_find(t, b, l->key, &found);
+    art_bucket *nb = bucket_create(t->alloc, b->count + (found ? 0 : 1));
+    for (int i = 0, j = 0; i < nb->count; i++) {
+        if (i == pos) {
+            nb->leaves[i] = l;
+            j += found ? 1 : 0;
+        } else {
+            nb->leaves[i] = b->leaves[j++];
+            nb->leaves[i]->n.refs++;
+        }
+    }
+    if (found) {
+        if (n->refs == 1 && b->leaves[pos]->n.refs == 1) {
+            forget_reused(b->leaves[pos], l);
+        }
+    } else {
+        t->size++;
+    }
+    release(t, n);
+    return &nb->n;
+}
+
+/**
+ * insert_node() - Insert a leaf into a subtree.
+ * @t: Table to manipulate.
+ * @n: Root of the subtree, or NULL.
+ * @l: The leaf. The tree takes over the reference.
+ * @k: The bytes of the key of the leaf.
+ * @depth: The number of key bytes matched above the subtree.
+ *
+ * The nodes on the path to the leaf are copied if they are shared
+ * with a clone.
+ *
+ * Returns: The new root of the subtree.
+ */
+static art_node *insert_node(table *t, art_node *n, art_leaf *l, const art_key *k, int depth)
+{
+    if (n == NULL) {
+        t->size++;
+        return &l->n;
+    }
+
+    if (is_terminal(n)) {
+        art_key ok;
+        encode_key(t, min_leaf(n)->key, &ok);
+        if (compare_bytes(&ok, k) == 0) {
+            return insert_terminal(t, n, l);
+        }
+        // Split the leaf. The new node gets the bytes shared by both keys
+        // as its prefix, and the leaves as children.
+        art_inner *split = (art_inner *)node_create(t->alloc, NODE4);
+        int shared = 0;
+        while (key_byte(&ok, depth + shared) == key_byte(k, depth + shared)) {
+            if (shared < MAX_PREFIX) {
+                split->prefix[shared] = key_byte(k, depth + shared);
+            }
+            shared++;
+        }
+        split->prefix_len = shared;
+        split = add_child(t->alloc, split, key_byte(&ok, depth + shared), n);
+        split = add_child(t->alloc, split, key_byte(k, depth + shared), &l->n);
+        t->size++;
+        return &split->n;
+    }
+
+    art_inner *in = (art_inner *)own(t->alloc, n);
+    if (in->prefix_len > 0) {
+        int match = prefix_mismatch(t, in, k, depth);
+        if (match < in->prefix_len) {
+            // The key leaves the prefix. Split the prefix at the first
+            // byte that differs.
+            art_inner *split = (art_inner *)node_create(t->alloc, NODE4);
+            split->prefix_len = match;
+            memcpy(split->prefix, in->prefix, match < MAX_PREFIX ? match : MAX_PREFIX);
+
+            // The node keeps the part of the prefix after the byte that
+            // differs. The bytes beyond MAX_PREFIX are read from a key.
+            unsigned char byte;
+            if (in->prefix_len <= MAX_PREFIX) {
+                byte = in->prefix[match];
+                memmove(in->prefix, in->prefix + match + 1, in->prefix_len - match - 1);
+            } else {
+                art_key lk;
+                encode_key(t, min_leaf(&in->n)->key, &lk);
+                byte = lk.bytes[depth + match];
+                int rest = in->prefix_len - match - 1;
+                memcpy(in->prefix, lk.bytes + depth + match + 1,
+                       rest < MAX_PREFIX ? rest : MAX_PREFIX);
+            }
+            in->prefix_len -= match + 1;
+
+            split = add_child(t->alloc, split, byte, &in->n);
+            split = add_child(t->alloc, split, key_byte(k, depth + match), &l->n);
+            t->size++;
+            return &split->n;
+        }
+        depth += in->prefix_len;
+    }
+
+    unsigned char byte = key_byte(k, depth);
+    art_node **child = find_child(in, byte);
+    if (child != NULL) {
+        *child = insert_node(t, *child, l, k, depth + 1);
+    } else {
+        in = add_child(t->alloc, in, byte, &l->n);
+        t->size++;
+    }
+    return &in->n;
+}
+
+/**
+ * find_leaf() - Find the leaf with a given key.
+ * @t: Table to inspect.
+ * @key: The key.
+ * @k: The bytes of the key.
+ *
+ * Only the stored prefix bytes are compared on the way down. The
+ * whole key is compared with the key of the leaf at the end, first
+ * by its bytes and then by key_cmp_func.
+ *
+ * Returns: The leaf, or NULL if the key is not in the table.
+ */
+static const art_leaf *find_leaf(const table *t, const void *key, const art_key *k)
+{
+    const art_node *n = t->root;
+    int depth = 0;
+
+    while (n != NULL && !is_terminal(n)) {
+        const art_inner *in = (const art_inner *)n;
+        int stored = in->prefix_len < MAX_PREFIX ? in->prefix_len : MAX_PREFIX;
+        for (int i = 0; i < stored; i++) {
+            if (in->prefix[i] != key_byte(k, depth + i)) {
+                return NULL;
+            }
+        }
+        depth += in->prefix_len;
+        art_node **child = find_child((art_inner *)in, key_byte(k, depth));
+        n = child == NULL ? NULL : *child;
+        depth++;
+    }
+    if (n == NULL) {
+        return NULL;
+    }
+    const art_leaf *l = min_leaf(n);
+    art_key lk;
+    encode_key(t, l->key, &lk);
+    if (compare_bytes(&lk, k) != 0) {
+        return NULL;
+    }
+    if (n->type == BUCKET) {
+        const art_bucket *b = (const art_bucket *)n;
+        bool found;
+        int i = bucket_find(t, b, key, &found);
+        return found ? b->leaves[i] : NULL;
+    }
+    return t->key_cmp_func(l->key, key) == 0 ? l : NULL;
+}
+
+/**
+ * leaf_is_private() - Check if a clone refers to the leaf of a key.
+ * @t: Table to inspect.
+ * @key: A key in the table.
+ *
+ * A clone may share the leaf itself, its bucket or any inner node
+ * above it. Releasing the tree releases the leaf only if none of them
+ * is shared.
+ *
+ * Returns: True if no node on the path to the leaf, the leaf
+ * included, is shared with a clone.
+ */
+static bool leaf_is_private(const table *t, const void *key)
+{
+    art_key k;
+    encode_key(t, key, &k);
+    const art_node *n = t->root;
+    int depth = 0;
+
+    while (!is_terminal(n)) {
+        if (n->refs > 1) {
+            return false;
+        }
+        const art_inner *in = (const art_inner *)n;
+        depth += in->prefix_len;
+        n = *find_child((art_inner *)in, key_byte(&k, depth));
+        depth++;
+    }
+    if (n->refs > 1) {
+        return false;
+    }
+    if (n->type == BUCKET) {
+        const art_bucket *b = (const art_bucket *)n;
+        bool found;
+        n = &b->leaves[bucket_find(t, b, key, &found)]->n;
+    }
+    return n->refs == 1;
+}
+
+/**
+ * remove_node() - Remove the leaf with a given key from a subtree.
+ * @t: Table to manipulate.
+ * @n: Root of a subtree that holds the key.
+ * @key: The key.
+ * @k: The bytes of the key.
+ * @depth: The number of key bytes matched above the subtree.
+ *
+ * An inner node left with a single child is replaced by the child,
+ * whose prefix is extended with the prefix of the node and the byte
+ * of the child. A bucket left with a single leaf is replaced by the
+ * leaf.
+ *
+ * Returns: The new root of the subtree, or NULL if it is empty.
+ */
+static art_node *remove_node(table *t, art_node *n, const void *key,
+                             const art_key *k, int depth)
+{
+    if (n->type == LEAF) {
+        release(t, n);
+        t->size--;
+        return NULL;
+    }
+    if (n->type == BUCKET) {
+        // Replace the bucket, as it may be shared with a clone.
+        art_bucket *b = (art_bucket *)n;
+        bool found;
+        int pos = bucket_find(t, b, key, &found);
+        art_node *rest;
+        if (b->count == 2) {
+            rest = &b->leaves[1 - pos]->n;
+            rest->refs++;
+        } else {
+            art_bucket *nb = bucket_create(t->alloc, b->count - 1);
+            for (int i = 0, j = 0; i < nb->count; i++, j++) {
+                j += j == pos ? 1 : 0;
+                nb->leaves[i] = b->leaves[j];
+                nb->leaves[i]->n.refs++;
+            }
+            rest = &nb->n;
+        }
+        release(t, n);
+        t->size--;
+        return rest;
+    }
+
+    art_inner *in = (art_inner *)own(t->alloc, n);
+    depth += in->prefix_len;
+    unsigned char byte = key_byte(k, depth);
+    art_node **child = find_child(in, byte);
+    *child = remove_node(t, *child, key, k, depth + 1);
+    if (*child != NULL) {
+        return &in->n;
+    }
+
+    in = remove_child(t->alloc, in, byte);
+    if (in->children > 1) {
+        return &in->n;
+    }
+
+    // Collapse the node into its only child.
+    unsigned char last_byte;
+    art_node *last = NULL;
+    for (int i = 0; last == NULL; i++) {
+        last = child_at(in, i, &last_byte);
+    }
+    if (!is_terminal(last)) {
+        art_inner *c = (art_inner *)own(t->alloc, last);
+        unsigned char prefix[MAX_PREFIX];
+        int len = in->prefix_len < MAX_PREFIX ? in->prefix_len : MAX_PREFIX;
+        memcpy(prefix, in->prefix, len);
+        if (len < MAX_PREFIX) {
+            prefix[len++] = last_byte;
+        }
+        int rest = c->prefix_len < MAX_PREFIX - len ? c->prefix_len : MAX_PREFIX - len;
+        memcpy(prefix + len, c->prefix, rest);
+        memcpy(c->prefix, prefix, len + rest);
+        c->prefix_len += in->prefix_len + 1;
+        last = &c->n;
+    }
+    allocator_deallocate(t->alloc, in, node_size(in->n.type));
+    return last;
+}
+
+/**
+ * visit_range() - Visit the leaves of a subtree within bounds in order.
+ * @t: Table to inspect.
+ * @n: Root of the subtree, or NULL.
+ * @depth: The number of key bytes matched above the subtree.
+ * @lo: Lower bound, inclusive, or NULL if the subtree is above it.
+ * @hi: Upper bound, inclusive, or NULL if the subtree is below it.
+ * @dir: 1 to visit the leaves in ascending order, -1 for descending.
+ * @callback: Function called for each key/value pair, or NULL.
+ *
+ * A bound is compared byte by byte on the way down, and dropped as
+ * soon as the path leaves it. Subtrees that are entirely outside the
+ * bounds are never visited. If callback is NULL, the traversal stops
+ * at the first leaf within the bounds.
+ *
+ * Returns: The first leaf within the bounds if callback is NULL,
+ * otherwise NULL.
+ */
+static const art_leaf *visit_range(const table *t, const art_node *n, int depth,
+                                   const art_key *lo, const art_key *hi, int dir,
+                                   inspect_callback_pair callback)
+{
+    if (n == NULL) {
+        return NULL;
+    }
+
+    if (is_terminal(n)) {
+        const art_leaf *l = min_leaf(n);
+        if (lo != NULL || hi != NULL) {
+            art_key lk;
+            encode_key(t, l->key, &lk);
+            if ((lo != NULL && compare_bytes(&lk, lo) < 0)
+                || (hi != NULL && compare_bytes(&lk, hi) > 0)) {
+                return NULL;
+            }
+        }
+        if (n->type == BUCKET) {
+            // The leaves share their bytes, so all are within the bounds.
+            const art_bucket *b = (const art_bucket *)n;
+            if (callback == NULL) {
+                return b->leaves[dir > 0 ? 0 : b->count - 1];
+            }
+            for (int i = 0; i < b->count; i++) {
+                l = b->leaves[dir > 0 ? i : b->count - 1 - i];
+                callback(l->key, l->value);
+            }
+            return NULL;
+        }
+        if (callback == NULL) {
+            return l;
+        }
+        callback(l->key, l->value);
+        return NULL;
+    }
+
+    const art_inner *in = (const art_inner *)n;
+    if (in->prefix_len > 0 && (lo != NULL || hi != NULL)) {
+        // Compare the whole prefix with the bounds.
+        art_key lk;
+        encode_key(t, min_leaf(n)->key, &lk);
+        for (int i = depth; i < depth + in->prefix_len; i++) {
+            if (lo != NULL && lk.bytes[i] != key_byte(lo, i)) {
+                if (lk.bytes[i] < key_byte(lo, i)) {
+                    return NULL;
+                }
+                lo = NULL;
+            }
+            if (hi != NULL && lk.bytes[i] != key_byte(hi, i)) {
+                if (lk.bytes[i] > key_byte(hi, i)) {
+                    return NULL;
+                }
+                hi = NULL;
+            }
+        }
+    }
+    depth += in->prefix_len;
+
+    int slots = child_slots(in);
+    for (int j = 0; j < slots; j++) {
+        unsigned char byte;
+        const art_node *child = child_at(in, dir > 0 ? j : slots - 1 - j, &byte);
+        if (child == NULL) {
+            continue;
+        }
+        // Skip the children outside the bounds, and drop the bounds
+        // that the child is strictly within.
+        if ((lo != NULL && byte < key_byte(lo, depth))
+            || (hi != NULL && byte > key_byte(hi, depth))) {
+            continue;
+        }
+        const art_key *child_lo = lo != NULL && byte == key_byte(lo, depth) ? lo : NULL;
+        const art_key *child_hi = hi != NULL && byte == key_byte(hi, depth) ? hi : NULL;
+        const art_leaf *l = visit_range(t, child, depth + 1, child_lo, child_hi, dir, callback);
+        if (l != NULL) {
+            return l;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * collect_leaves() - Copy the leaf pointers of a subtree in key order.
+ * @n: Root of the subtree, or NULL.
+ * @leaves: Output array for the leaves.
+ * @i: Index of the first free position in the array.
+ *
+ * Returns: The index of the first free position after the subtree.
+ */
+static int collect_leaves(const art_node *n, art_leaf **leaves, int i)
+{
+    if (n == NULL) {
+        return i;
+    }
+    if (n->type == LEAF) {
+        leaves[i] = (art_leaf *)n;
+        return i + 1;
+    }
+    if (n->type == BUCKET) {
+        const art_bucket *b = (const art_bucket *)n;
+        for (int j = 0; j < b->count; j++) {
+            leaves[i++] = b->leaves[j];
+        }
+        return i;
+    }
+    const art_inner *in = (const art_inner *)n;
+    for (int j = 0; j < child_slots(in); j++) {
+        unsigned char byte;
+        i = collect_leaves(child_at(in, j, &byte), leaves, i);
+    }
+    return i;
+}
+
+/**
+ * closest_leaf() - Find the key closest to a bound on one side of it.
+ * @t: Table to inspect. The keys must be opaque.
+ * @n: Root of the subtree, or NULL.
+ * @bound: The bound, or NULL to find the smallest or largest key.
+ * @dir: 1 for the smallest key >= bound, -1 for the largest key <= bound.
+ * @best: The closest leaf found so far, or NULL.
+ *
+ * The byte order of opaque keys is not their order, so all keys are
+ * compared with key_cmp_func.
+ *
+ * Returns: The closest leaf of the subtree and best, or NULL if there
+ * is none.
+ */
+static const art_leaf *closest_leaf(const table *t, const art_node *n, const void *bound,
+                                    int dir, const art_leaf *best)
+{
+    if (n == NULL) {
+        return best;
+    }
+    if (is_terminal(n)) {
+        int count = n->type == BUCKET ? ((const art_bucket *)n)->count : 1;
+        for (int i = 0; i < count; i++) {
+            const art_leaf *l = n->type == BUCKET ? ((const art_bucket *)n)->leaves[i]
+                : (const art_leaf *)n;
+            // Skip keys on the wrong side of the bound and keep the key
+            // closest to the bound.
+            if ((bound == NULL || dir * t->key_cmp_func(l->key, bound) >= 0)
+                && (best == NULL || dir * t->key_cmp_func(l->key, best->key) < 0)) {
+                best = l;
+            }
+        }
+        return best;
+    }
+    const art_inner *in = (const art_inner *)n;
+    for (int j = 0; j < child_slots(in); j++) {
+        unsigned char byte;
+        best = closest_leaf(t, child_at(in, j, &byte), bound, dir, best);
+    }
+    return best;
+}
+
+/**
+ * sort_leaves() - Sort leaves by key with a merge sort.
+ * @t: Table with the key compare function.
+ * @a: The leaves to sort.
+ * @tmp: Scratch array with room for n leaves.
+ * @n: The number of leaves.
+ *
+ * Returns: Nothing.
+ */
+static void sort_leaves(const table *t, art_leaf **a, art_leaf **tmp, int n)
+{
+    if (n < 2) {
+        return;
+    }
+    // Sort both halves...
+    int mid = n / 2;
+    sort_leaves(t, a, tmp, mid);
+    sort_leaves(t, a + mid, tmp, n - mid);
+
+    // ...and merge them.
+    int i = 0, j = mid, k = 0;
+    while (i < mid && j < n) {
+        if (t->key_cmp_func(a[j]->key, a[i]->key) < 0) {
+            tmp[k++] = a[j++];
+        } else {
+            tmp[k++] = a[i++];
+        }
+    }
+    while (i < mid) {
+        tmp[k++] = a[i++];
+    }
+    while (j < n) {
+        tmp[k++] = a[j++];
+    }
+    for (k = 0; k < n; k++) {
+        a[k] = tmp[k];
+    }
+}
+
+/**
+ * visit_sorted() - Visit the matching pairs of a table with opaque keys in order.
+ * @t: Table to inspect.
+ * @lo: Lower bound, inclusive, or NULL to match on prefix.
+ * @hi: Upper bound, inclusive. Ignored if lo is NULL.
+ * @prefix: Prefix of the string keys to visit. Ignored unless lo is NULL.
+ * @callback: Function called for each matching key/value pair.
+ *
+ * The matching leaves are collected and sorted with key_cmp_func.
+ *
+ * Returns: Nothing.
+ */
+static void visit_sorted(const table *t, const void *lo, const void *hi,
+                         const char *prefix, inspect_callback_pair callback)
+{
+    int len = lo == NULL ? strlen(prefix) : 0;
+    int n = t->size;
+    art_leaf **matches = calloc(n + 1, sizeof(*matches));
+    art_leaf **tmp = calloc(n + 1, sizeof(*tmp));
+    collect_leaves(t->root, matches, 0);
+
+    // Keep the matching leaves...
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        art_leaf *l = matches[i];
+        if (lo == NULL ? strncmp(l->key, prefix, len) == 0
+            : t->key_cmp_func(l->key, lo) >= 0 && t->key_cmp_func(l->key, hi) <= 0) {
+            matches[k++] = l;
+        }
+    }
+
+    // ...and visit them in order.
+    sort_leaves(t, matches, tmp, k);
+    for (int i = 0; i < k; i++) {
+        callback(matches[i]->key, matches[i]->value);
+    }
+    free(matches);
+    free(tmp);
+}
+
+/**
+ * build_tree() - Build a new tree over leaves.
+ * @t: Table to put the tree in. The old tree must have been collected.
+ * @leaves: Array with the leaves.
+ * @n: Number of leaves, with different keys.
+ *
+ * The tree takes a new reference to each leaf.
+ *
+ * Returns: Nothing.
+ */
+static void build_tree(table *t, art_leaf **leaves, int n)
+{
+    t->root = NULL;
+    t->size = 0;
+    for (int i = 0; i < n; i++) {
+        art_key k;
+        encode_key(t, leaves[i]->key, &k);
+        leaves[i]->n.refs++;
+        t->root = insert_node(t, t->root, leaves[i], &k, 0);
+    }
+}
+
+/**
+ * filter_keys() - Remove the pairs depending on whether their keys are in another table.
+ * @t: Table to manipulate.
+ * @other: Table to look up the keys in.
+ * @keep_found: If true, keep the pairs whose keys are in other. If
+ *              false, keep the pairs whose keys are not in other.
+ *
+ * Both key sequences are ordered, so they are compared in a single
+ * pass. The kept leaves are then put in a new tree, and the old tree
+ * is released. The tree of a frozen table is kept, so other may be
+ * frozen.
+ *
+ * Returns: 0 on success, -1 if t is frozen.
+ */
+static int filter_keys(table *t, const table *other, bool keep_found)
+{
+    if (t->frozen != NULL) {
+        // A frozen table cannot be modified.
+        return -1;
+    }
+    if (t == other) {
+        // Every key of t is found in t itself.
+        if (!keep_found) {
+            release(t, t->root);
+            t->root = NULL;
+            t->size = 0;
+        }
+        return 0;
+    }
+
+    int n = t->size;
+    int m = other->size;
+    art_leaf **leaves = calloc(n + 1, sizeof(*leaves));
+    art_leaf **others = calloc(m + 1, sizeof(*others));
+    collect_leaves(t->root, leaves, 0);
+    collect_leaves(other->root, others, 0);
+
+    int kept = 0;
+    int j = 0;
+    for (int i = 0; i < n; i++) {
+        // Skip the keys of other that are smaller than the current key.
+        while (j < m && compare_keys(t, others[j]->key, leaves[i]->key) < 0) {
+            j++;
+        }
+        bool found = j < m && compare_keys(t, others[j]->key, leaves[i]->key) == 0;
+        if (found == keep_found) {
+            leaves[kept++] = leaves[i];
+        }
+    }
+    art_node *old = t->root;
+    build_tree(t, leaves, kept);
+    release(t, old);
+
+    free(leaves);
+    free(others);
+    return 0;
+}
+
+/**
+ * table_empty() - Create an empty table.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * The keys are opaque. Without a hash function, they are all kept in
+ * a single bucket, so table_empty_with_key_type should be preferred.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty(compare_function *key_cmp_func,
+                   kill_function key_kill_func,
+                   kill_function value_kill_func)
+{
+    return table_empty_with_key_type(key_cmp_func, NULL, TABLE_KEY_OPAQUE,
+                                     key_kill_func, value_kill_func);
+}
+
+/**
+ * table_empty_with_hash() - Create an empty table with cached key hashes.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * The keys are opaque, so the tree is indexed by the bytes of their
+ * hashes. Use table_empty_with_key_type to index string or int keys
+ * by their own bytes, in order.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_with_hash(compare_function *key_cmp_func,
+                             hash_function *key_hash_func,
+                             kill_function key_kill_func,
+                             kill_function value_kill_func)
+{
+    return table_empty_with_key_type(key_cmp_func, key_hash_func, TABLE_KEY_OPAQUE,
+                                     key_kill_func, value_kill_func);
+}
+
+/**
+ * table_empty_with_key_type() - Create an empty table for a given type of keys.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash keys.
+ * @key_type: The type of the keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * String and int keys are indexed by their bytes, opaque keys by the
+ * bytes of their hashes. A key found by its bytes is checked with
+ * key_cmp_func.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_with_key_type(compare_function *key_cmp_func,
+                                 hash_function *key_hash_func,
+                                 table_key_type key_type,
+                                 kill_function key_kill_func,
+                                 kill_function value_kill_func)
+{
+    return table_empty_with_allocator(key_cmp_func, key_hash_func, key_type,
+                                      key_kill_func, value_kill_func, NULL);
+}
+
+/**
+ * table_empty_with_allocator() - Create an empty table with a given allocator.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash keys.
+ * @key_type: The type of the keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the table
+ *         and its elements.
+ *
+ * String and int keys are indexed by their bytes, opaque keys by the
+ * bytes of their hashes. A key found by its bytes is checked with
+ * key_cmp_func.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_with_allocator(compare_function *key_cmp_func,
+                                  hash_function *key_hash_func,
+                                  table_key_type key_type,
+                                  kill_function key_kill_func,
+                                  kill_function value_kill_func,
+                                  const allocator *alloc)
+{
+    if (alloc == NULL) {
+        alloc = default_allocator();
+    }
+    // Allocate the table header. The tree is initially empty.
+    table *t = alloc->allocate(alloc->context, sizeof(table));
+    // Store the key type, the key compare/hash functions and
+    // key/value kill functions.
+    t->key_type = key_type;
+    t->key_cmp_func = key_cmp_func;
+    t->key_hash_func = key_hash_func;
+    t->key_kill_func = key_kill_func;
+    t->value_kill_func = value_kill_func;
+    t->alloc = alloc;
+
+    return t;
+}
+
+/**
+ * table_is_empty() - Check if a table is empty.
+ * @table: Table to check.
+ *
+ * Returns: True if table contains no key/value pairs, false otherwise.
+ */
+bool table_is_empty(const table *t)
+{
+    return t->root == NULL;
+}
+
+/**
+ * table_insert() - Add a key/value pair to a table.
+ * @table: Table to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ *
+ * Insert the key/value pair into the table. If the key is a
+ * duplicate, the stored key/value pair is killed and replaced.
+ *
+ * Returns: 0 on success, -1 if the table is frozen.
+ */
+int table_insert(table *t, void *key, void *value)
+{
+    if (t->frozen != NULL) {
+        // A frozen table cannot be modified.
+        return -1;
+    }
+    art_key k;
+    encode_key(t, key, &k);
+    t->root = insert_node(t, t->root, leaf_create(t->alloc, key, value), &k, 0);
+
+    return 0;
+}
+
+/**
+ * table_lookup() - Look up a given key in a table.
+ * @table: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to a given key, or NULL if the key
+ * is not found in the table.
+ */
+void *table_lookup(const table *t, const void *key)
+{
+    if (t->frozen != NULL) {
+        // A single probe into the frozen table.
+        return perfect_table_lookup(t->frozen, key);
+    }
+    art_key k;
+    encode_key(t, key, &k);
+    const art_leaf *l = find_leaf(t, key, &k);
+
+    return l == NULL ? NULL : l->value;
+}
+
+/**
+ * table_choose_key() - Return an arbitrary key.
+ * @t: Table to inspect.
+ *
+ * Return an arbitrary key stored in the table. Can be used together
+ * with table_remove() to deconstruct the table. Undefined for an
+ * empty table.
+ *
+ * Returns: An arbitrary key stored in the table.
+ */
+void *table_choose_key(const table *t)
+{
+    // Return the smallest key.
+    return min_leaf(t->root)->key;
+}
+
+/**
+ * table_remove() - Remove a key/value pair in the table.
+ * @table: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Will call any kill functions set for keys/values. Does nothing if
+ * key is not found in the table.
+ *
+ * Returns: 0 on success, -1 if the table is frozen.
+ */
+int table_remove(table *t, const void *key)
+{
+    if (t->frozen != NULL) {
+        // A frozen table cannot be modified.
+        return -1;
+    }
+    art_key k;
+    encode_key(t, key, &k);
+    // Look for the key first, so that no nodes are copied from a
+    // clone for a missing key.
+    if (find_leaf(t, key, &k) != NULL) {
+        t->root = remove_node(t, t->root, key, &k, 0);
+    }
+
+    return 0;
+}
+
+/**
+ * table_freeze() - Make a table immutable.
+ * @t: Table to freeze.
+ *
+ * A perfect_table is built over the pairs for constant time lookups.
+ * The tree is kept for the ordered queries, and is still responsible
+ * for killing the keys/values.
+ *
+ * Returns: 0 on success, -1 if the table has no hash function, -2
+ * if two different keys have the same hash value.
+ */
+int table_freeze(table *t)
+{
+    if (t->frozen != NULL) {
+        // Already frozen, nothing to do.
+        return 0;
+    }
+    if (t->key_hash_func == NULL) {
+        return -1;
+    }
+
+    // Copy the key/value pointers to arrays.
+    int n = t->size;
+    art_leaf **leaves = calloc(n + 1, sizeof(*leaves));
+    void **keys = calloc(n + 1, sizeof(*keys));
+    void **values = calloc(n + 1, sizeof(*values));
+    collect_leaves(t->root, leaves, 0);
+    for (int i = 0; i < n; i++) {
+        keys[i] = leaves[i]->key;
+        values[i] = leaves[i]->value;
+    }
+
+    // Build the frozen table. It does not own the keys/values.
+    t->frozen = perfect_table_create(t->key_cmp_func, t->key_hash_func,
+                                     NULL, NULL, n, keys, values);
+    free(leaves);
+    free(keys);
+    free(values);
+    if (t->frozen == NULL) {
+        return -2;
+    }
+    t->frozen_refs = malloc(sizeof(*t->frozen_refs));
+    *t->frozen_refs = 1;
+
+    return 0;
+}
+
+/**
+ * table_is_frozen() - Check if a table is frozen.
+ * @t: Table to check.
+ *
+ * Returns: True if the table is frozen, otherwise false.
+ */
+bool table_is_frozen(const table *t)
+{
+    return t->frozen != NULL;
+}
+
+/**
+ * table_clone() - Create a copy of a table in constant time.
+ * @t: Table to copy.
+ *
+ * The copy shares the tree, and the frozen table if any, with t.
+ * The nodes are copied on the path from the root to a modified node,
+ * i.e. O(k) nodes per modification for keys of k bytes, while
+ * unmodified subtrees and the key/value pairs stay shared.
+ *
+ * Returns: Pointer to the new table.
+ */
+table *table_clone(const table *t)
+{
+    table *c = t->alloc->allocate(t->alloc->context, sizeof(*c));
+    *c = *t;
+    if (c->root != NULL) {
+        c->root->refs++;
+    }
+    if (c->frozen != NULL) {
+        (*c->frozen_refs)++;
+    }
+
+    return c;
+}
+
+/**
+ * table_min() - Return the smallest key in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The smallest key, or NULL if the table is empty.
+ */
+void *table_min(const table *t)
+{
+    const art_leaf *l = t->key_type == TABLE_KEY_OPAQUE
+        ? closest_leaf(t, t->root, NULL, 1, NULL) : min_leaf(t->root);
+    return l == NULL ? NULL : l->key;
+}
+
+/**
+ * table_max() - Return the largest key in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The largest key, or NULL if the table is empty.
+ */
+void *table_max(const table *t)
+{
+    const art_leaf *l = t->key_type == TABLE_KEY_OPAQUE
+        ? closest_leaf(t, t->root, NULL, -1, NULL) : max_leaf(t->root);
+    return l == NULL ? NULL : l->key;
+}
+
+/**
+ * table_floor() - Return the largest key less than or equal to a key.
+ * @t: Table to inspect.
+ * @key: Key to compare with.
+ *
+ * Returns: The largest key <= key, or NULL if there is none.
+ */
+void *table_floor(const table *t, const void *key)
+{
+    if (t->key_type == TABLE_KEY_OPAQUE) {
+        const art_leaf *l = closest_leaf(t, t->root, key, -1, NULL);
+        return l == NULL ? NULL : l->key;
+    }
+    // The first leaf <= key in descending order.
+    art_key k;
+    encode_key(t, key, &k);
+    const art_leaf *l = visit_range(t, t->root, 0, NULL, &k, -1, NULL);
+    return l == NULL ? NULL : l->key;
+}
+
+/**
+ * table_ceiling() - Return the smallest key greater than or equal to a key.
+ * @t: Table to inspect.
+ * @key: Key to compare with.
+ *
+ * Returns: The smallest key >= key, or NULL if there is none.
+ */
+void *table_ceiling(const table *t, const void *key)
+{
+    if (t->key_type == TABLE_KEY_OPAQUE) {
+        const art_leaf *l = closest_leaf(t, t->root, key, 1, NULL);
+        return l == NULL ? NULL : l->key;
+    }
+    // The first leaf >= key in ascending order.
+    art_key k;
+    encode_key(t, key, &k);
+    const art_leaf *l = visit_range(t, t->root, 0, &k, NULL, 1, NULL);
+    return l == NULL ? NULL : l->key;
+}
+
+/**
+ * table_range() - Iterate over the key/value pairs within an interval.
+ * @t: Table to inspect.
+ * @lo: Lower bound of the interval, inclusive.
+ * @hi: Upper bound of the interval, inclusive.
+ * @callback: Function called for each key/value pair in the interval.
+ *
+ * The pairs are visited in ascending key order.
+ *
+ * Returns: Nothing.
+ */
+void table_range(const table *t, const void *lo, const void *hi,
+                 inspect_callback_pair callback)
+{
+    if (t->key_type == TABLE_KEY_OPAQUE) {
+        visit_sorted(t, lo, hi, NULL, callback);
+        return;
+    }
+    art_key klo, khi;
+    encode_key(t, lo, &klo);
+    encode_key(t, hi, &khi);
+    visit_range(t, t->root, 0, &klo, &khi, 1, callback);
+}
+
+/**
+ * table_prefix_scan() - Iterate over the key/value pairs with keys starting with a prefix.
+ * @t: Table to inspect. The keys must be strings.
+ * @prefix: The prefix. The empty string matches all keys.
+ * @callback: Function called for each key/value pair with a matching key.
+ *
+ * The tree is descended along the bytes of the prefix, and the
+ * subtree where the prefix ends is visited in order. The time is thus
+ * O(m + k) for a prefix of m bytes and k matching keys.
+ *
+ * Returns: Nothing.
+ */
+void table_prefix_scan(const table *t, const char *prefix,
+                       inspect_callback_pair callback)
+{
+    if (t->key_type == TABLE_KEY_OPAQUE) {
+        // The keys must be strings, but are not indexed by their bytes.
+        visit_sorted(t, NULL, NULL, prefix, callback);
+        return;
+    }
+    if (t->key_type != TABLE_KEY_STRING) {
+        return;
+    }
+    // The prefix without its '\0', which is not part of the matching keys.
+    art_key p;
+    p.bytes = (const unsigned char *)prefix;
+    p.len = strlen(prefix);
+
+    const art_node *n = t->root;
+    int depth = 0;
+    while (n != NULL && depth < p.len) {
+        if (is_terminal(n)) {
+            art_key lk;
+            encode_key(t, min_leaf(n)->key, &lk);
+            if (lk.len <= p.len || memcmp(lk.bytes, p.bytes, p.len) != 0) {
+                return;
+            }
+            break;
+        }
+        const art_inner *in = (const art_inner *)n;
+        int match = prefix_mismatch(t, in, &p, depth);
+        if (match < in->prefix_len) {
+            // The prefix either ends inside the node prefix, in which
+            // case all keys below the node match, or differs from it.
+            if (depth + match < p.len) {
+                return;
+            }
+            break;
+        }
+        depth += in->prefix_len;
+        if (depth >= p.len) {
+            break;
+        }
+        art_node **child = find_child((art_inner *)in, p.bytes[depth]);
+        n = child == NULL ? NULL : *child;
+        depth++;
+    }
+    visit_range(t, n, depth, NULL, NULL, 1, callback);
+}
+
+/**
+ * table_merge() - Move all key/value pairs from one table to another.
+ * @dst: Table to merge into.
+ * @src: Table to merge from. Empty after the call.
+ * @policy: Which pair to keep for keys found in both tables.
+ *
+ * The leaves of both trees are merged in key order in a single pass
+ * and put in a new tree. The old trees are then released. The leaves
+ * are reused, and may be shared with clones of either table.
+ *
+ * Returns: 0 on success, -1 if either table is frozen.
+ */
+int table_merge(table *dst, table *src, table_merge_policy policy)
+{
+    if (dst->frozen != NULL || src->frozen != NULL) {
+        // A frozen table cannot be modified.
+        return -1;
+    }
+    if (dst == src) {
+        // Nothing to move.
+        return 0;
+    }
+
+    int n = dst->size;
+    int m = src->size;
+    art_leaf **a = calloc(n + 1, sizeof(*a));
+    art_leaf **b = calloc(m + 1, sizeof(*b));
+    art_leaf **merged = calloc(n + m + 1, sizeof(*merged));
+    collect_leaves(dst->root, a, 0);
+    collect_leaves(src->root, b, 0);
+
+    int i = 0, j = 0, k = 0;
+    while (i < n && j < m) {
+        int c = compare_keys(dst, a[i]->key, b[j]->key);
+        if (c < 0) {
+            merged[k++] = a[i++];
+        } else if (c > 0) {
+            merged[k++] = b[j++];
+        } else {
+            // Keep one leaf. The other is killed with its tree below,
+            // but must not kill memory that is reused. A clone of the
+            // other table may share the leaf, or a node above it, and
+            // then still uses the leaf after the tree is released.
+            art_leaf *keep = policy == TABLE_MERGE_KEEP_SRC ? b[j] : a[i];
+            art_leaf *discard = keep == a[i] ? b[j] : a[i];
+            const table *owner = discard == a[i] ? dst : src;
+            if (discard != keep && leaf_is_private(owner, discard->key)) {
+                if (discard->key == keep->key) {
+                    discard->key = NULL;
+                }
+                if (discard->value == keep->value) {
+                    discard->value = NULL;
+                }
+            }
+            merged[k++] = keep;
+            i++;
+            j++;
+        }
+    }
+    while (i < n) {
+        merged[k++] = a[i++];
+    }
+    while (j < m) {
+        merged[k++] = b[j++];
+    }
+    art_node *old = dst->root;
+    build_tree(dst, merged, k);
+    release(dst, old);
+    release(src, src->root);
+    src->root = NULL;
+    src->size = 0;
+
+    free(a);
+    free(b);
+    free(merged);
+    return 0;
+}
+
+/**
+ * table_intersect() - Keep only the keys that are found in another table.
+ * @t: Table to manipulate.
+ * @other: Table with the keys to keep. Not modified.
+ *
+ * Returns: 0 on success, -1 if t is frozen.
+ */
+int table_intersect(table *t, const table *other)
+{
+    return filter_keys(t, other, true);
+}
+
+/**
+ * table_difference() - Remove the keys that are found in another table.
+ * @t: Table to manipulate.
+ * @other: Table with the keys to remove. Not modified.
+ *
+ * Returns: 0 on success, -1 if t is frozen.
+ */
+int table_difference(table *t, const table *other)
+{
+    return filter_keys(t, other, false);
+}
+
+/*
+ * table_kill() - Destroy a table.
+ * @table: Table to destroy.
+ *
+ * Return all dynamic memory used by the table and its elements. If a
+ * kill_func was registered for keys and/or values at table creation,
+ * it is called each element to kill any user-allocated memory
+ * occupied by the element values.
+ *
+ * Returns: Nothing.
+ */
+void table_kill(table *t)
+{
+    if (t->frozen != NULL) {
+        (*t->frozen_refs)--;
+        if (*t->frozen_refs == 0) {
+            perfect_table_kill(t->frozen);
+            free(t->frozen_refs);
+        }
+    }
+    if (t->alloc->deallocate == NULL && t->key_kill_func == NULL
+        && t->value_kill_func == NULL) {
+        // No node, key or value is returned on its own. The memory is
+        // returned at once by the owner of the allocator.
+        return;
+    }
+    // Release the tree. Nodes shared with a clone are kept...
+    release(t, t->root);
+    // ...and the table struct.
+    allocator_deallocate(t->alloc, t, sizeof(*t));
+}
+
+/**
+ * table_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Iterates over the key/value pairs in the table in ascending key
+ * order and prints them.
+ *
+ * Returns: Nothing.
+ */
+void table_print(const table *t, inspect_callback_pair print_func)
+{
+    if (t->key_type == TABLE_KEY_OPAQUE) {
+        visit_sorted(t, NULL, NULL, "", print_func);
+        return;
+    }
+    visit_range(t, t->root, 0, NULL, NULL, 1, print_func);
+}
+
+// ===========INTERNAL FUNCTIONS USED BY table_print_internal ============
+
+// The functions below output code in the dot language, used by
+// GraphViz. For documention of the dot language, see graphviz.org.
+
+/**
+ * indent() - Output indentation string.
+ * @n: Indentation level.
+ *
+ * Print n tab characters.
+ *
+ * Returns: Nothing.
+ */
+static void indent(int n)
+{
+    for (int i=0; i<n; i++) {
+        printf("\t");
+    }
+}
+
+/**
+ * iprintf(...) - Indent and print.
+ * @n: Indentation level
+ * @...: printf arguments
+ *
+ * Print n tab characters and calls printf.
+ *
+ * Returns: Nothing.
+ */
+static void iprintf(int n, const char *fmt, ...)
+{
+    // Indent...
+    indent(n);
+    // ...and call printf
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * print_edge() - Print a edge between two addresses.
+ * @from: The address of the start of the edge. Should be non-NULL.
+ * @to: The address of the destination for the edge, including NULL.
+ * @port: The name of the port on the source node, or NULL.
+ * @label: The label for the edge, or NULL.
+ * @options: A string with other edge options, or NULL.
+ *
+ * Print an edge from port PORT on node FROM to TO with label
+ * LABEL. If to is NULL, the destination is the NULL node, otherwise a
+ * memory node. If the port is NULL, the edge starts at the node, not
+ * a specific port on it. If label is NULL, no label is used. The
+ * options string, if non-NULL, is printed before the label.
+ *
+ * Returns: Nothing.
+ */
+static void print_edge(int indent_level, const void *from, const void *to, const char *port,
+                       const char *label, const char *options)
+{
+    indent(indent_level);
+    if (port) {
+        printf("m%04lx:%s -> ", PTR2ADDR(from), port);
+    } else {
+        printf("m%04lx -> ", PTR2ADDR(from));
+    }
+    if (to == NULL) {
+        printf("NULL");
+    } else {
+        printf("m%04lx", PTR2ADDR(to));
+    }
+    printf(" [");
+    if (options != NULL) {
+        printf("%s", options);
+    }
+    if (label != NULL) {
+        printf(" label=\"%s\"",label);
+    }
+    printf("]\n");
+}
+
+/**
+ * print_head_node() - Print a node corresponding to the table struct.
+ * @indent_level: Indentation level.
+ * @t: Table to inspect.
+ *
+ * Returns: Nothing.
+ */
+static void print_head_node(int indent_level, const table *t)
+{
+    static const char *key_type_names[] = { "string", "int", "opaque" };
+
+    iprintf(indent_level, "m%04lx [shape=record "
+            "label=\"<r>root\\n%04lx|size\\n%d|key_type\\n%s|cmp\\n%04lx|hash\\n%04lx"
+            "|key_kill\\n%04lx|value_kill\\n%04lx|<f>frozen\\n%04lx\"]\n",
+            PTR2ADDR(t), PTR2ADDR(t->root), t->size,
+            key_type_names[t->key_type], PTR2ADDR(t->key_cmp_func),
+            PTR2ADDR(t->key_hash_func), PTR2ADDR(t->key_kill_func),
+            PTR2ADDR(t->value_kill_func), PTR2ADDR(t->frozen));
+}
+
+// Internal function to print the edges from the head in dot format.
+static void print_head_edges(int indent_level, const table *t)
+{
+    print_edge(indent_level, t, t->root, "r", "root", NULL);
+    if (t->frozen != NULL) {
+        print_edge(indent_level, t, t->frozen, "f", "frozen", NULL);
+    }
+}
+
+// Internal function to print the key and value nodes of a subtree in dot format.
+static void print_payload_nodes(int indent_level, const art_node *n,
+                                inspect_callback key_print_func,
+                                inspect_callback value_print_func)
+{
+    if (n == NULL) {
+        return;
+    }
+    if (n->type == BUCKET) {
+        const art_bucket *b = (const art_bucket *)n;
+        for (int i = 0; i < b->count; i++) {
+            print_payload_nodes(indent_level, &b->leaves[i]->n, key_print_func,
+                                value_print_func);
+        }
+        return;
+    }
+    if (n->type != LEAF) {
+        const art_inner *in = (const art_inner *)n;
+        for (int i = 0; i < child_slots(in); i++) {
+            unsigned char byte;
+            print_payload_nodes(indent_level, child_at(in, i, &byte), key_print_func,
+                                value_print_func);
+        }
+        return;
+    }
+    const art_leaf *l = (const art_leaf *)n;
+    if (l->key != NULL) {
+        iprintf(indent_level, "m%04lx [label=\"", PTR2ADDR(l->key));
+        if (key_print_func != NULL) {
+            key_print_func(l->key);
+        }
+        printf("\" xlabel=\"%04lx\"]\n", PTR2ADDR(l->key));
+    }
+    if (l->value != NULL) {
+        iprintf(indent_level, "m%04lx [label=\"", PTR2ADDR(l->value));
+        if (value_print_func != NULL) {
+            value_print_func(l->value);
+        }
+        printf("\" xlabel=\"%04lx\"]\n", PTR2ADDR(l->value));
+    }
+}
+
+// Internal function to print a key byte as an edge label. Printable
+// characters are printed as they are, other bytes in hexadecimal.
+static void byte_label(unsigned char byte, char *label)
+{
+    if (isalnum(byte) || byte == '/' || byte == '.' || byte == '-' || byte == '_') {
+        sprintf(label, "'%c'", byte);
+    } else {
+        sprintf(label, "0x%02x", byte);
+    }
+}
+
+// Internal function to print the tree nodes of a subtree in dot format.
+static void print_tree_nodes(int indent_level, const art_node *n)
+{
+    static const char *type_names[] = { "LEAF", "NODE4", "NODE16", "NODE48", "NODE256" };
+
+    if (n == NULL) {
+        return;
+    }
+    if (n->type == LEAF) {
+        const art_leaf *l = (const art_leaf *)n;
+        iprintf(indent_level, "m%04lx [shape=record label=\"LEAF|<k>key\\n%04lx"
+                "|<v>value\\n%04lx|refs\\n%d\"]\n",
+                PTR2ADDR(n), PTR2ADDR(l->key), PTR2ADDR(l->value), n->refs);
+        return;
+    }
+    if (n->type == BUCKET) {
+        const art_bucket *b = (const art_bucket *)n;
+        iprintf(indent_level, "m%04lx [shape=record label=\"BUCKET|count\\n%d"
+                "|refs\\n%d\"]\n", PTR2ADDR(n), b->count, n->refs);
+        for (int i = 0; i < b->count; i++) {
+            print_tree_nodes(indent_level, &b->leaves[i]->n);
+        }
+        return;
+    }
+    const art_inner *in = (const art_inner *)n;
+    iprintf(indent_level, "m%04lx [shape=record label=\"%s|children\\n%d"
+            "|prefix_len\\n%d|refs\\n%d\"]\n", PTR2ADDR(n), type_names[n->type],
+            in->children, in->prefix_len, n->refs);
+    for (int i = 0; i < child_slots(in); i++) {
+        unsigned char byte;
+        print_tree_nodes(indent_level, child_at(in, i, &byte));
+    }
+}
+
+// Internal function to print edges from the tree nodes in dot format.
+// Memory "owned" by the table is indicated by solid red lines. Memory
+// "borrowed" from the user is indicated by red dashed lines.
+static void print_tree_edges(int indent_level, const table *t, const art_node *n)
+{
+    if (n == NULL) {
+        return;
+    }
+    if (n->type == LEAF) {
+        const art_leaf *l = (const art_leaf *)n;
+        print_edge(indent_level, n, l->key, "k", "key",
+                   t->key_kill_func ? "color=red" : "color=red style=dashed");
+        print_edge(indent_level, n, l->value, "v", "value",
+                   t->value_kill_func ? "color=red" : "color=red style=dashed");
+        return;
+    }
+    if (n->type == BUCKET) {
+        const art_bucket *b = (const art_bucket *)n;
+        for (int i = 0; i < b->count; i++) {
+            print_edge(indent_level, n, b->leaves[i], NULL, NULL, NULL);
+            print_tree_edges(indent_level, t, &b->leaves[i]->n);
+        }
+        return;
+    }
+    const art_inner *in = (const art_inner *)n;
+    for (int i = 0; i < child_slots(in); i++) {
+        unsigned char byte;
+        const art_node *child = child_at(in, i, &byte);
+        if (child != NULL) {
+            char label[8];
+            byte_label(byte, label);
+            print_edge(indent_level, n, child, NULL, label, NULL);
+            print_tree_edges(indent_level, t, child);
+        }
+    }
+}
+
+// Create an escaped version of the input string. The most common
+// control characters - newline, horizontal tab, backslash, and double
+// quote - are replaced by their escape sequence. The returned pointer
+// must be deallocated by the caller.
+static char *escape_chars(const char *s)
+{
+    int i, j;
+    int escaped = 0; // The number of chars that must be escaped.
+
+    // Count how many chars need to be escaped, i.e. how much longer
+    // the output string will be.
+    for (i = escaped = 0; s[i] != '\0'; i++) {
+        if (s[i] == '\n' || s[i] == '\t' || s[i] == '\\' || s[i] == '\"') {
+            escaped++;
+        }
+    }
+    // Allocate space for the escaped string. The variable i holds the input
+    // length, escaped how much the string will grow.
+    char *t = malloc(i + escaped + 1);
+
+    // Copy-and-escape loop
+    for (i = j = 0; s[i] != '\0'; i++) {
+        // Convert each control character by its escape sequence.
+        // Non-control characters are copied as-is.
+        switch (s[i]) {
+        case '\n': t[i+j] = '\\'; t[i+j+1] = 'n';  j++; break;
+        case '\t': t[i+j] = '\\'; t[i+j+1] = 't';  j++; break;
+        case '\\': t[i+j] = '\\'; t[i+j+1] = '\\'; j++; break;
+        case '\"': t[i+j] = '\\'; t[i+j+1] = '\"'; j++; break;
+        default:   t[i+j] = s[i]; break;
+        }
+    }
+    // Terminal the output string
+    t[i+j] = '\0';
+    return t;
+}
+
+/**
+ * first_white_spc() - Return pointer to first white-space char.
+ * @s: String.
+ *
+ * Returns: A pointer to the first white-space char in s, or NULL if none is found.
+ *
+ */
+static const char *find_white_spc(const char *s)
+{
+    const char *t = s;
+    while (*t != '\0') {
+        if (isspace(*t)) {
+            // We found a white-space char, return a point to it.
+            return t;
+        }
+        // Advance to next char
+        t++;
+    }
+    // No white-space found
+    return NULL;
+}
+
+/**
+ * insert_table_name() - Maybe insert the name of the table src file in the description string.
+ * @s: Description string.
+ *
+ * Parses the description string to find of if it starts with a c file
+ * name. In that case, the file name of this file is spliced into the
+ * description string. The parsing is not very intelligent: If the
+ * sequence ".c:" (case insensitive) is found before the first
+ * white-space, the string up to and including ".c" is taken to be a c
+ * file name.
+ *
+ * Returns: A dynamic copy of s, optionally including with the table src file name.
+ */
+static char *insert_table_name(const char *s)
+{
+    // First, determine if the description string starts with a c file name
+    // a) Search for the string ".c:"
+    const char *dot_c = strstr(s, ".c:");
+    // b) Search for the first white-space
+    const char *spc = find_white_spc(s);
+
+    bool prefix_found;
+    int output_length;
+
+    // If both a) and b) are found AND a) is before b, we assume that
+    // s starts with a file name
+    if (dot_c != NULL && spc != NULL && dot_c < spc) {
+        // We found a match. Output string is input + 3 chars + __FILE__
+        prefix_found = true;
+        output_length = strlen(s) + 3 + strlen(__FILE__);
+    } else {
+        // No match found. Output string is just input
+        prefix_found = false;
+        output_length = strlen(s);
+    }
+
+    // Allocate space for the whole string
+    char *out = calloc(1, output_length + 1);
+    strcpy(out, s);
+    if (prefix_found) {
+        // Overwrite the output buffer from the ":"
+        strcpy(out + (dot_c - s + 2), " (");
+        // Now out will be 0-terminated after "(", append the file name and ")"
+        strcat(out, __FILE__);
+        strcat(out, ")");
+        // Finally append the input string from the : onwards
+        strcat(out, dot_c + 2);
+    }
+    return out;
+}
+
+/**
+ * table_print_internal() - Output the internal structure of the table.
+ * @t: Table to print.
+ * @key_print_func: Function called for each key in the table.
+ * @value_print_func: Function called for each value in the table.
+ * @desc: String with a description/state of the list.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the tree and prints code that shows its' internal
+ * structure. The edges between the tree nodes are labelled with the
+ * key bytes.
+ *
+ * Returns: Nothing.
+ */
+void table_print_internal(const table *t, inspect_callback key_print_func,
+                          inspect_callback value_print_func, const char *desc,
+                          int indent_level)
+{
+    static int graph_number = 0;
+    graph_number++;
+    int il = indent_level;
+
+    if (indent_level == 0) {
+        // If this is the outermost datatype, start a graph and set up defaults
+        printf("digraph TABLE_%d {\n", graph_number);
+
+        // Specify default shape and fontname
+        il++;
+        iprintf(il, "node [shape=rectangle fontname=\"Courier New\"]\n");
+        iprintf(il, "ranksep=0.01\n");
+        iprintf(il, "subgraph cluster_nullspace {\n");
+        iprintf(il+1, "NULL\n");
+        iprintf(il, "}\n");
+    }
+
+    if (desc != NULL) {
+        // Escape the string before printout
+        char *escaped = escape_chars(desc);
+        // Optionally, splice the source file name
+        char *spliced = insert_table_name(escaped);
+
+        // Use different names on inner description nodes
+        if (indent_level == 0) {
+            iprintf(il, "description [label=\"%s\"]\n", spliced);
+        } else {
+            iprintf(il, "\tcluster_list_%d_description [label=\"%s\"]\n", graph_number, spliced);
+        }
+        // Return the memory used by the spliced and escaped strings
+        free(spliced);
+        free(escaped);
+    }
+
+    if (indent_level == 0) {
+        // Use a single "pointer" edge as a starting point for the
+        // outermost datatype
+        iprintf(il, "t [label=\"%04lx\" xlabel=\"t\"]\n", PTR2ADDR(t));
+        iprintf(il, "t -> m%04lx\n", PTR2ADDR(t));
+    }
+
+    if (indent_level == 0) {
+        // Put the user nodes in userspace
+        iprintf(il, "subgraph cluster_userspace { label=\"User space\"\n");
+        il++;
+
+        // Traverse the tree to print the payload nodes
+        print_payload_nodes(il, t->root, key_print_func, value_print_func);
+
+        // Close the subgraph
+        il--;
+        iprintf(il, "}\n");
+    }
+
+    // Print the subgraph to surround the tree content
+    iprintf(il, "subgraph cluster_table_%d { label=\"Table\"\n", graph_number);
+    il++;
+
+    // Output the head node and the tree nodes
+    print_head_node(il, t);
+    print_tree_nodes(il, t->root);
+    if (t->frozen != NULL) {
+        perfect_table_print_internal(t->frozen, NULL, NULL, NULL, il);
+    }
+
+    // Close the subgraph
+    il--;
+    iprintf(il, "}\n");
+
+    // Output the edges from the head and the tree nodes
+    print_head_edges(il, t);
+    print_tree_edges(il, t, t->root);
+
+    if (indent_level == 0) {
+        // Termination of graph
+        printf("}\n");
+    }
+}
@@ -0,0 +1,1561 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h> // For isspace()
+#include <stdarg.h>
+
+#include <table.h>
+#include <perfect_table.h>
+
+/*
+ * Implementation of a generic table for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University.
+ *
+ * The table entries are stored in an AVL tree, i.e. a binary search
+ * tree ordered by key_cmp_func where the heights of the two subtrees
+ * of any node differ by at most one. Insert, lookup and remove are
+ * thus O(log n), and the ordered queries table_min, table_max,
+ * table_floor, table_ceiling and table_range are O(log n + k). The
+ * set operations table_merge, table_intersect and table_difference
+ * are O(n + m).
+ *
+ * Duplicates are handled by insert, i.e. a duplicate key replaces the
+ * stored key/value pair.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: Added table_merge, table_intersect and table_difference.
+ *   v1.2  2026-10-18: Added table_clone with path copying of shared nodes.
+ *   v1.3  2026-10-18: Added table_empty_with_key_type and table_prefix_scan.
+ *   v1.4  2026-10-18: Added table_empty_with_allocator.
+ *   v1.5  2026-10-18: table_kill returns at once for a table in an arena.
+ *   v1.6  2026-10-18: table_remove searches before copying shared nodes.
+ *   v1.7  2026-10-18: table_merge copies the path of a discarded entry
+ *                     before it drops reused memory from the entry.
+ */
+
+// ===========INTERNAL DATA TYPES ============
+
+typedef struct table_entry {
+    void *key;
+    void *value;
+    unsigned long hash; // Cached hash of the key, 0 without hash function
+    int refs;           // Number of tree nodes referring to the entry
+} table_entry;
+
+typedef struct tree_node {
+    struct tree_node *left;  // Subtree with smaller keys
+    struct tree_node *right; // Subtree with larger keys
+    int height;              // Height of the subtree, 1 for a leaf
+    int refs;                // Number of parents and roots referring to the node
+    table_entry *entry;
+} tree_node;
+
+struct table {
+    tree_node *root; // The table entries are stored in an AVL tree
+    compare_function *key_cmp_func;
+    hash_function *key_hash_func; // NULL if no hashes are cached
+    kill_function key_kill_func;
+    kill_function value_kill_func;
+    perfect_table *frozen; // Non-NULL once the table has been frozen
+    int *frozen_refs; // Number of tables sharing frozen, see table_clone
+    const allocator *alloc; // Allocator for the head, nodes and entries
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
+
+
+/**
+ * table_entry_create() - Allocate and populate a table entry.
+ * @key: A pointer to the key.
+ * @value: A pointer to the value.
+ * @hash: The hash of the key.
+ * @alloc: The allocator of the table.
+ *
+ * Returns: A pointer to the newly created entry.
+ */
+static table_entry *table_entry_create(void *key, void *value, unsigned long hash,
+                                       const allocator *alloc)
+{
+    table_entry *e = alloc->allocate(alloc->context, sizeof(*e));
+    e->key = key;
+    e->value = value;
+    e->hash = hash;
+    e->refs = 1;
+
+    return e;
+}
+
+/**
+ * table_entry_release() - Drop a reference to a table entry.
+ * @t: Table with the kill functions.
+ * @e: The entry.
+ *
+ * When the last reference is dropped, the key and value are killed
+ * if kill functions are set, and the entry is deallocated.
+ *
+ * Returns: Nothing.
+ */
+static void table_entry_release(const table *t, table_entry *e)
+{
+    e->refs--;
+    if (e->refs > 0) {
+        return;
+    }
+    if (t->key_kill_func != NULL && e->key != NULL) {
+        t->key_kill_func(e->key);
+    }
+    if (t->value_kill_func != NULL && e->value != NULL) {
+        t->value_kill_func(e->value);
+    }
+    allocator_deallocate(t->alloc, e, sizeof(*e));
+}
+
+/**
+ * tree_node_create() - Allocate a tree node.
+ * @alloc: The allocator of the table.
+ * @e: The entry of the node. The node takes over the reference.
+ *
+ * Returns: A pointer to the newly created leaf node.
+ */
+static tree_node *tree_node_create(const allocator *alloc, table_entry *e)
+{
+    // Allocate space for a tree node. The allocator returns zeroed
+    // memory, so all pointers are initialized to NULL.
+    tree_node *n = alloc->allocate(alloc->context, sizeof(*n));
+    // Populate the node.
+    n->entry = e;
+    n->height = 1;
+    n->refs = 1;
+
+    return n;
+}
+
+/**
+ * own() - Make a node safe to modify.
+ * @alloc: The allocator of the table.
+ * @n: A node referred to by a node or root that is safe to modify.
+ *
+ * A node shared with a clone is copied. The copy refers to the same
+ * children and entry as the node, and replaces the reference to it.
+ *
+ * Returns: The node, or a copy of it.
+ */
+static tree_node *own(const allocator *alloc, tree_node *n)
+{
+    if (n->refs == 1) {
+        return n;
+    }
+    tree_node *c = tree_node_create(alloc, n->entry);
+    c->left = n->left;
+    c->right = n->right;
+    c->height = n->height;
+    n->entry->refs++;
+    if (c->left != NULL) {
+        c->left->refs++;
+    }
+    if (c->right != NULL) {
+        c->right->refs++;
+    }
+    n->refs--;
+
+    return c;
+}
+
+/**
+ * release() - Drop a reference to a subtree.
+ * @t: Table with the kill functions.
+ * @n: Root of the subtree, or NULL.
+ *
+ * Nodes without references are deallocated, and their entries
+ * released.
+ *
+ * Returns: Nothing.
+ */
+static void release(const table *t, tree_node *n)
+{
+    if (n == NULL) {
+        return;
+    }
+    n->refs--;
+    if (n->refs > 0) {
+        // The subtree is still used by a clone.
+        return;
+    }
+    release(t, n->left);
+    release(t, n->right);
+    table_entry_release(t, n->entry);
+    allocator_deallocate(t->alloc, n, sizeof(*n));
+}
+
+/**
+ * table_key_hash() - Compute the hash of a key.
+ * @t: Table whose hash function to use.
+ * @key: Key to hash.
+ *
+ * Returns: The hash of the key, or 0 if the table has no hash function.
+ */
+static unsigned long table_key_hash(const table *t, const void *key)
+{
+    if (t->key_hash_func == NULL) {
+        return 0;
+    }
+    return t->key_hash_func(key);
+}
+
+// Internal function to return the height of a possibly empty subtree.
+static int height(const tree_node *n)
+{
+    return n == NULL ? 0 : n->height;
+}
+
+// Internal function to recompute the height of a node from its children.
+static void update_height(tree_node *n)
+{
+    int hl = height(n->left);
+    int hr = height(n->right);
+    n->height = (hl > hr ? hl : hr) + 1;
+}
+
+/**
+ * rotate_right() - Rotate a subtree to the right.
+ * @alloc: The allocator of the table.
+ * @n: Root of the subtree. Must have a left child and be safe to modify.
+ *
+ * Returns: The new root of the subtree, i.e. the former left child.
+ */
+static tree_node *rotate_right(const allocator *alloc, tree_node *n)
+{
+    tree_node *l = own(alloc, n->left);
+    n->left = l->right;
+    l->right = n;
+    update_height(n);
+    update_height(l);
+    return l;
+}
+
+/**
+ * rotate_left() - Rotate a subtree to the left.
+ * @alloc: The allocator of the table.
+ * @n: Root of the subtree. Must have a right child and be safe to modify.
+ *
+ * Returns: The new root of the subtree, i.e. the former right child.
+ */
+static tree_node *rotate_left(const allocator *alloc, tree_node *n)
+{
+    tree_node *r = own(alloc, n->right);
+    n->right = r->left;
+    r->left = n;
+    update_height(n);
+    update_height(r);
+    return r;
+}
+
+/**
+ * rebalance() - Restore the AVL property of a subtree.
+ * @alloc: The allocator of the table.
+ * @n: Root of a subtree whose children are balanced and whose
+ *     heights differ by at most two. Must be safe to modify.
+ *
+ * Returns: The new root of the subtree.
+ */
+static tree_node *rebalance(const allocator *alloc, tree_node *n)
+{
+    update_height(n);
+    int balance = height(n->left) - height(n->right);
+
+    if (balance > 1) {
+        // Left-heavy. Convert the left-right case to the left-left case.
+        if (height(n->left->left) < height(n->left->right)) {
+            n->left = rotate_left(alloc, own(alloc, n->left));
+        }
+        return rotate_right(alloc, n);
+    }
+    if (balance < -1) {
+        // Right-heavy. Convert the right-left case to the right-right case.
+        if (height(n->right->right) < height(n->right->left)) {
+            n->right = rotate_right(alloc, own(alloc, n->right));
+        }
+        return rotate_left(alloc, n);
+    }
+    return n;
+}
+
+/**
+ * insert_node() - Insert a key/value pair into a subtree.
+ * @t: Table to manipulate.
+ * @n: Root of the subtree, or NULL.
+ * @key: A pointer to the key.
+ * @value: A pointer to the value.
+ * @hash: The hash of the key.
+ *
+ * If the key is already in the subtree, the stored key/value pair is
+ * replaced. The old pair is killed unless it is shared with a clone.
+ * Nodes shared with a clone are copied on the way down.
+ *
+ * Returns: The new root of the subtree.
+ */
+static tree_node *insert_node(table *t, tree_node *n, void *key, void *value,
+                              unsigned long hash)
+{
+    if (n == NULL) {
+        return tree_node_create(t->alloc, table_entry_create(key, value, hash, t->alloc));
+    }
+    int c = t->key_cmp_func(key, n->entry->key);
+    n = own(t->alloc, n);
+    if (c < 0) {
+        n->left = insert_node(t, n->left, key, value, hash);
+    } else if (c > 0) {
+        n->right = insert_node(t, n->right, key, value, hash);
+    } else {
+        // Duplicate. Drop the old pair, but do not kill memory that
+        // is reused.
+        table_entry *e = n->entry;
+        if (e->refs == 1 && e->key == key) {
+            e->key = NULL;
+        }
+        if (e->refs == 1 && e->value == value) {
+            e->value = NULL;
+        }
+        table_entry_release(t, e);
+        n->entry = table_entry_create(key, value, hash, t->alloc);
+        return n;
+    }
+    return rebalance(t->alloc, n);
+}
+
+/**
+ * find_node() - Find the node of a key.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The node with the key, or NULL if the key is not found.
+ */
+static const tree_node *find_node(const table *t, const void *key)
+{
+    // Descend from the root.
+    const tree_node *n = t->root;
+    while (n != NULL) {
+        int c = t->key_cmp_func(key, n->entry->key);
+        if (c == 0) {
+            return n;
+        }
+        n = c < 0 ? n->left : n->right;
+    }
+    return NULL;
+}
+
+/**
+ * own_path() - Make the path to a key safe to modify.
+ * @t: Table with the compare function.
+ * @n: Root of a subtree that contains the key.
+ * @key: Key to find.
+ *
+ * Nodes shared with a clone are copied on the way down, like in
+ * insert_node. Afterwards, the entry of the key has more than one
+ * reference if and only if a clone still refers to it.
+ *
+ * Returns: The new root of the subtree.
+ */
+static tree_node *own_path(const table *t, tree_node *n, const void *key)
+{
+    n = own(t->alloc, n);
+    int c = t->key_cmp_func(key, n->entry->key);
+    if (c < 0) {
+        n->left = own_path(t, n->left, key);
+    } else if (c > 0) {
+        n->right = own_path(t, n->right, key);
+    }
+    return n;
+}
+
+/**
+ * detach_min() - Detach the node with the smallest key from a subtree.
+ * @alloc: The allocator of the table.
+ * @n: Root of a non-empty subtree.
+ * @min: Output parameter for the detached node, safe to modify.
+ *
+ * Returns: The new root of the subtree.
+ */
+static tree_node *detach_min(const allocator *alloc, tree_node *n, tree_node **min)
+{
+    n = own(alloc, n);
+    if (n->left == NULL) {
+        *min = n;
+        return n->right;
+    }
+    n->left = detach_min(alloc, n->left, min);
+    return rebalance(alloc, n);
+}
+
+/**
+ * remove_node() - Remove a key from a subtree.
+ * @t: Table to manipulate.
+ * @n: Root of the subtree, or NULL.
+ * @key: Key to remove, should be in the subtree.
+ *
+ * Kills the key/value of the removed node if kill functions are set
+ * and the pair is not shared with a clone. Nodes shared with a clone
+ * are copied on the way down.
+ *
+ * Returns: The new root of the subtree.
+ */
+static tree_node *remove_node(table *t, tree_node *n, const void *key)
+{
+    if (n == NULL) {
+        // Key not found.
+        return NULL;
+    }
+    int c = t->key_cmp_func(key, n->entry->key);
+    n = own(t->alloc, n);
+    if (c < 0) {
+        n->left = remove_node(t, n->left, key);
+    } else if (c > 0) {
+        n->right = remove_node(t, n->right, key);
+    } else {
+        // Replace the node by the smallest node of the right subtree,
+        // or by the left subtree if there is no right subtree.
+        tree_node *replacement = n->left;
+        if (n->right != NULL) {
+            n->right = detach_min(t->alloc, n->right, &replacement);
+            replacement->left = n->left;
+            replacement->right = n->right;
+        }
+        // No more key comparisons are made, so it is safe to kill
+        // the key even if it is the search key.
+        table_entry_release(t, n->entry);
+        allocator_deallocate(t->alloc, n, sizeof(*n));
+        if (replacement == NULL) {
+            return NULL;
+        }
+        n = replacement;
+    }
+    return rebalance(t->alloc, n);
+}
+
+// Internal function to count the nodes of a subtree.
+static int count_nodes(const tree_node *n)
+{
+    if (n == NULL) {
+        return 0;
+    }
+    return count_nodes(n->left) + 1 + count_nodes(n->right);
+}
+
+/**
+ * collect_entries() - Copy the entry pointers of a subtree in key order.
+ * @n: Root of the subtree, or NULL.
+ * @entries: Output array for the entries.
+ * @i: Index of the first free position in the array.
+ *
+ * Returns: The index of the first free position after the subtree.
+ */
+static int collect_entries(const tree_node *n, table_entry **entries, int i)
+{
+    if (n == NULL) {
+        return i;
+    }
+    i = collect_entries(n->left, entries, i);
+    entries[i] = n->entry;
+    return collect_entries(n->right, entries, i + 1);
+}
+
+/**
+ * visit_range() - Call a function for each pair of a subtree within bounds.
+ * @t: Table to inspect.
+ * @n: Root of the subtree, or NULL.
+ * @lo: Lower bound, inclusive.
+ * @hi: Upper bound, inclusive.
+ * @callback: Function called for each key/value pair.
+ *
+ * Subtrees that are entirely outside the bounds are never visited.
+ *
+ * Returns: Nothing.
+ */
+static void visit_range(const table *t, const tree_node *n, const void *lo,
+                        const void *hi, inspect_callback_pair callback)
+{
+    if (n == NULL) {
+        return;
+    }
+    int c_lo = t->key_cmp_func(n->entry->key, lo);
+    int c_hi = t->key_cmp_func(n->entry->key, hi);
+
+    if (c_lo > 0) {
+        // There may be keys >= lo to the left.
+        visit_range(t, n->left, lo, hi, callback);
+    }
+    if (c_lo >= 0 && c_hi <= 0) {
+        callback(n->entry->key, n->entry->value);
+    }
+    if (c_hi < 0) {
+        // There may be keys <= hi to the right.
+        visit_range(t, n->right, lo, hi, callback);
+    }
+}
+
+/**
+ * visit_prefix() - Call a function for each pair of a subtree with a given key prefix.
+ * @n: Root of the subtree, or NULL.
+ * @prefix: The prefix.
+ * @len: The length of the prefix.
+ * @callback: Function called for each key/value pair.
+ *
+ * The keys with the prefix are consecutive in strcmp order, so only
+ * the subtrees that may hold such keys are visited.
+ *
+ * Returns: Nothing.
+ */
+static void visit_prefix(const tree_node *n, const char *prefix, int len,
+                         inspect_callback_pair callback)
+{
+    if (n == NULL) {
+        return;
+    }
+    int c = strncmp(n->entry->key, prefix, len);
+
+    if (c >= 0) {
+        // There may be matching keys to the left.
+        visit_prefix(n->left, prefix, len, callback);
+    }
+    if (c == 0) {
+        callback(n->entry->key, n->entry->value);
+    }
+    if (c <= 0) {
+        // There may be matching keys to the right.
+        visit_prefix(n->right, prefix, len, callback);
+    }
+}
+
+/**
+ * build_tree() - Build a balanced tree of new nodes over sorted entries.
+ * @alloc: The allocator of the table.
+ * @entries: Array with the entries in key order.
+ * @n: Number of entries.
+ *
+ * The middle entry becomes the root, so the heights of the two
+ * subtrees of any node differ by at most one. Each node takes a new
+ * reference to its entry.
+ *
+ * Returns: The root of the tree.
+ */
+static tree_node *build_tree(const allocator *alloc, table_entry **entries, int n)
+{
+    if (n == 0) {
+        return NULL;
+    }
+    int mid = n / 2;
+    entries[mid]->refs++;
+    tree_node *root = tree_node_create(alloc, entries[mid]);
+    root->left = build_tree(alloc, entries, mid);
+    root->right = build_tree(alloc, entries + mid + 1, n - mid - 1);
+    update_height(root);
+    return root;
+}
+
+/**
+ * filter_keys() - Remove the pairs depending on whether their keys are in another table.
+ * @t: Table to manipulate.
+ * @other: Table to look up the keys in.
+ * @keep_found: If true, keep the pairs whose keys are in other. If
+ *              false, keep the pairs whose keys are not in other.
+ *
+ * Both key sequences are ordered, so they are compared in a single
+ * pass. The kept entries are then put in a new balanced tree, and
+ * the old tree is released. The tree of a frozen table is kept, so
+ * other may be frozen.
+ *
+ * Returns: 0 on success, -1 if t is frozen.
+ */
+static int filter_keys(table *t, const table *other, bool keep_found)
+{
+    if (t->frozen != NULL) {
+        // A frozen table cannot be modified.
+        return -1;
+    }
+    if (t == other) {
+        // Every key of t is found in t itself.
+        if (!keep_found) {
+            release(t, t->root);
+            t->root = NULL;
+        }
+        return 0;
+    }
+
+    int n = count_nodes(t->root);
+    int m = count_nodes(other->root);
+    table_entry **entries = calloc(n + 1, sizeof(*entries));
+    table_entry **others = calloc(m + 1, sizeof(*others));
+    collect_entries(t->root, entries, 0);
+    collect_entries(other->root, others, 0);
+
+    int kept = 0;
+    int j = 0;
+    for (int i = 0; i < n; i++) {
+        // Skip the keys of other that are smaller than the current key.
+        while (j < m && t->key_cmp_func(others[j]->key, entries[i]->key) < 0) {
+            j++;
+        }
+        bool found = j < m && t->key_cmp_func(others[j]->key, entries[i]->key) == 0;
+        if (found == keep_found) {
+            entries[kept++] = entries[i];
+        }
+    }
+    tree_node *root = build_tree(t->alloc, entries, kept);
+    release(t, t->root);
+    t->root = root;
+
+    free(entries);
+    free(others);
+    return 0;
+}
+
+/**
+ * table_empty() - Create an empty table.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty(compare_function *key_cmp_func,
+                   kill_function key_kill_func,
+                   kill_function value_kill_func)
+{
+    // A table without a hash function.
+    return table_empty_with_hash(key_cmp_func, NULL, key_kill_func, value_kill_func);
+}
+
+/**
+ * table_empty_with_hash() - Create an empty table with cached key hashes.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * The tree is ordered by key_cmp_func, so the hashes are only used
+ * by table_freeze.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_with_hash(compare_function *key_cmp_func,
+                             hash_function *key_hash_func,
+                             kill_function key_kill_func,
+                             kill_function value_kill_func)
+{
+    return table_empty_with_allocator(key_cmp_func, key_hash_func, TABLE_KEY_OPAQUE,
+                                      key_kill_func, value_kill_func, NULL);
+}
+
+/**
+ * table_empty_with_key_type() - Create an empty table for a given type of keys.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash keys.
+ * @key_type: The type of the keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * The tree is ordered by key_cmp_func, so the key type is not used.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_with_key_type(compare_function *key_cmp_func,
+                                 hash_function *key_hash_func,
+                                 table_key_type key_type,
+                                 kill_function key_kill_func,
+                                 kill_function value_kill_func)
+{
+    return table_empty_with_hash(key_cmp_func, key_hash_func, key_kill_func, value_kill_func);
+}
+
+/**
+ * table_empty_with_allocator() - Create an empty table with a given allocator.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash keys.
+ * @key_type: The type of the keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the table
+ *         and its elements.
+ *
+ * The tree is ordered by key_cmp_func, so the key type is not used.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_with_allocator(compare_function *key_cmp_func,
+                                  hash_function *key_hash_func,
+                                  table_key_type key_type,
+                                  kill_function key_kill_func,
+                                  kill_function value_kill_func,
+                                  const allocator *alloc)
+{
+    if (alloc == NULL) {
+        alloc = default_allocator();
+    }
+    // Allocate the table header. The tree is initially empty.
+    table *t = alloc->allocate(alloc->context, sizeof(table));
+    // Store the key compare/hash functions and key/value kill functions.
+    t->key_cmp_func = key_cmp_func;
+    t->key_hash_func = key_hash_func;
+    t->key_kill_func = key_kill_func;
+    t->value_kill_func = value_kill_func;
+    t->alloc = alloc;
+
+    return t;
+}
+
+/**
+ * table_is_empty() - Check if a table is empty.
+ * @table: Table to check.
+ *
+ * Returns: True if table contains no key/value pairs, false otherwise.
+ */
+bool table_is_empty(const table *t)
+{
+    return t->root == NULL;
+}
+
+/**
+ * table_insert() - Add a key/value pair to a table.
+ * @table: Table to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ *
+ * Insert the key/value pair into the table. If the key is a
+ * duplicate, the stored key/value pair is killed and replaced.
+ *
+ * Returns: 0 on success, -1 if the table is frozen.
+ */
+int table_insert(table *t, void *key, void *value)
+{
+    if (t->frozen != NULL) {
+        // A frozen table cannot be modified.
+        return -1;
+    }
+    t->root = insert_node(t, t->root, key, value, table_key_hash(t, key));
+
+    return 0;
+}
+
+/**
+ * table_lookup() - Look up a given key in a table.
+ * @table: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to a given key, or NULL if the key
+ * is not found in the table.
+ */
+void *table_lookup(const table *t, const void *key)
+{
+    if (t->frozen != NULL) {
+        // A single probe into the frozen table.
+        return perfect_table_lookup(t->frozen, key);
+    }
+
+    const tree_node *n = find_node(t, key);
+    // Return NULL if no match is found.
+    return n == NULL ? NULL : n->entry->value;
+}
+
+/**
+ * table_choose_key() - Return an arbitrary key.
+ * @t: Table to inspect.
+ *
+ * Return an arbitrary key stored in the table. Can be used together
+ * with table_remove() to deconstruct the table. Undefined for an
+ * empty table.
+ *
+ * Returns: An arbitrary key stored in the table.
+ */
+void *table_choose_key(const table *t)
+{
+    // Return the root key.
+    return t->root->entry->key;
+}
+
+/**
+ * table_remove() - Remove a key/value pair in the table.
+ * @table: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Will call any kill functions set for keys/values. Does nothing if
+ * key is not found in the table.
+ *
+ * Returns: 0 on success, -1 if the table is frozen.
+ */
+int table_remove(table *t, const void *key)
+{
+    if (t->frozen != NULL) {
+        // A frozen table cannot be modified.
+        return -1;
+    }
+    if (find_node(t, key) == NULL) {
+        // Leave the tree, and any nodes shared with a clone, untouched.
+        return 0;
+    }
+    t->root = remove_node(t, t->root, key);
+
+    return 0;
+}
+
+/**
+ * table_freeze() - Make a table immutable.
+ * @t: Table to freeze.
+ *
+ * A perfect_table is built over the pairs for constant time lookups.
+ * The tree is kept for the ordered queries, and is still responsible
+ * for killing the keys/values.
+ *
+ * Returns: 0 on success, -1 if the table has no hash function, -2
+ * if two different keys have the same hash value.
+ */
+int table_freeze(table *t)
+{
+    if (t->frozen != NULL) {
+        // Already frozen, nothing to do.
+        return 0;
+    }
+    if (t->key_hash_func == NULL) {
+        return -1;
+    }
+
+    // Copy the key/value pointers to arrays.
+    int n = count_nodes(t->root);
+    table_entry **entries = calloc(n + 1, sizeof(*entries));
+    void **keys = calloc(n + 1, sizeof(*keys));
+    void **values = calloc(n + 1, sizeof(*values));
+    collect_entries(t->root, entries, 0);
+    for (int i = 0; i < n; i++) {
+        keys[i] = entries[i]->key;
+        values[i] = entries[i]->value;
+    }
+
+    // Build the frozen table. It does not own the keys/values.
+    t->frozen = perfect_table_create(t->key_cmp_func, t->key_hash_func,
+                                     NULL, NULL, n, keys, values);
+    free(entries);
+    free(keys);
+    free(values);
+    if (t->frozen == NULL) {
+        return -2;
+    }
+    t->frozen_refs = malloc(sizeof(*t->frozen_refs));
+    *t->frozen_refs = 1;
+
+    return 0;
+}
+
+/**
+ * table_is_frozen() - Check if a table is frozen.
+ * @t: Table to check.
+ *
+ * Returns: True if the table is frozen, otherwise false.
+ */
+bool table_is_frozen(const table *t)
+{
+    return t->frozen != NULL;
+}
+
+/**
+ * table_clone() - Create a copy of a table in constant time.
+ * @t: Table to copy.
+ *
+ * The copy shares the tree, and the frozen table if any, with t.
+ * The nodes are copied on the path from the root to a modified node,
+ * i.e. O(log n) nodes per modification, while unmodified subtrees
+ * and the key/value pairs stay shared.
+ *
+ * Returns: Pointer to the new table.
+ */
+table *table_clone(const table *t)
+{
+    table *c = t->alloc->allocate(t->alloc->context, sizeof(*c));
+    *c = *t;
+    if (c->root != NULL) {
+        c->root->refs++;
+    }
+    if (c->frozen != NULL) {
+        (*c->frozen_refs)++;
+    }
+
+    return c;
+}
+
+/**
+ * table_min() - Return the smallest key in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The smallest key, or NULL if the table is empty.
+ */
+void *table_min(const table *t)
+{
+    // Follow the left links from the root.
+    const tree_node *n = t->root;
+    if (n == NULL) {
+        return NULL;
+    }
+    while (n->left != NULL) {
+        n = n->left;
+    }
+    return n->entry->key;
+}
+
+/**
+ * table_max() - Return the largest key in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The largest key, or NULL if the table is empty.
+ */
+void *table_max(const table *t)
+{
+    // Follow the right links from the root.
+    const tree_node *n = t->root;
+    if (n == NULL) {
+        return NULL;
+    }
+    while (n->right != NULL) {
+        n = n->right;
+    }
+    return n->entry->key;
+}
+
+/**
+ * table_floor() - Return the largest key less than or equal to a key.
+ * @t: Table to inspect.
+ * @key: Key to compare with.
+ *
+ * Returns: The largest key <= key, or NULL if there is none.
+ */
+void *table_floor(const table *t, const void *key)
+{
+    // The best candidate is the last node where we went right.
+    void *best = NULL;
+    const tree_node *n = t->root;
+    while (n != NULL) {
+        int c = t->key_cmp_func(key, n->entry->key);
+        if (c == 0) {
+            return n->entry->key;
+        }
+        if (c < 0) {
+            n = n->left;
+        } else {
+            best = n->entry->key;
+            n = n->right;
+        }
+    }
+    return best;
+}
+
+/**
+ * table_ceiling() - Return the smallest key greater than or equal to a key.
+ * @t: Table to inspect.
+ * @key: Key to compare with.
+ *
+ * Returns: The smallest key >= key, or NULL if there is none.
+ */
+void *table_ceiling(const table *t, const void *key)
+{
+    // The best candidate is the last node where we went left.
+    void *best = NULL;
+    const tree_node *n = t->root;
+    while (n != NULL) {
+        int c = t->key_cmp_func(key, n->entry->key);
+        if (c == 0) {
+            return n->entry->key;
+        }
+        if (c > 0) {
+            n = n->right;
+        } else {
+            best = n->entry->key;
+            n = n->left;
+        }
+    }
+    return best;
+}
+
+/**
+ * table_range() - Iterate over the key/value pairs within an interval.
+ * @t: Table to inspect.
+ * @lo: Lower bound of the interval, inclusive.
+ * @hi: Upper bound of the interval, inclusive.
+ * @callback: Function called for each key/value pair in the interval.
+ *
+ * The pairs are visited in ascending key order.
+ *
+ * Returns: Nothing.
+ */
+void table_range(const table *t, const void *lo, const void *hi,
+                 inspect_callback_pair callback)
+{
+    visit_range(t, t->root, lo, hi, callback);
+}
+
+/**
+ * table_prefix_scan() - Iterate over the key/value pairs with keys starting with a prefix.
+ * @t: Table to inspect. The keys must be strings.
+ * @prefix: The prefix. The empty string matches all keys.
+ * @callback: Function called for each key/value pair with a matching key.
+ *
+ * The pairs are visited in ascending key order, in O(log n + k) time
+ * if key_cmp_func orders the keys as strcmp.
+ *
+ * Returns: Nothing.
+ */
+void table_prefix_scan(const table *t, const char *prefix,
+                       inspect_callback_pair callback)
+{
+    visit_prefix(t->root, prefix, strlen(prefix), callback);
+}
+
+/**
+ * table_merge() - Move all key/value pairs from one table to another.
+ * @dst: Table to merge into.
+ * @src: Table to merge from. Empty after the call.
+ * @policy: Which pair to keep for keys found in both tables.
+ *
+ * The entries of both trees are merged in key order in a single pass
+ * and put in a new balanced tree. The old trees are then released.
+ * The entries are reused, and may be shared with clones of either
+ * table.
+ *
+ * Returns: 0 on success, -1 if either table is frozen.
+ */
+int table_merge(table *dst, table *src, table_merge_policy policy)
+{
+    if (dst->frozen != NULL || src->frozen != NULL) {
+        // A frozen table cannot be modified.
+        return -1;
+    }
+    if (dst == src) {
+        // Nothing to move.
+        return 0;
+    }
+
+    int n = count_nodes(dst->root);
+    int m = count_nodes(src->root);
+    table_entry **a = calloc(n + 1, sizeof(*a));
+    table_entry **b = calloc(m + 1, sizeof(*b));
+    table_entry **merged = calloc(n + m + 1, sizeof(*merged));
+    collect_entries(dst->root, a, 0);
+    collect_entries(src->root, b, 0);
+
+    int i = 0, j = 0, k = 0;
+    while (i < n && j < m) {
+        int c = dst->key_cmp_func(a[i]->key, b[j]->key);
+        if (c < 0) {
+            merged[k++] = a[i++];
+        } else if (c > 0) {
+            merged[k++] = b[j++];
+        } else {
+            // Keep one entry. The other is killed with its tree below,
+            // but must not kill memory that is reused. A clone of the
+            // other table may share the entry, or a node on its path.
+            table_entry *keep = policy == TABLE_MERGE_KEEP_SRC ? b[j] : a[i];
+            table_entry *discard = keep == a[i] ? b[j] : a[i];
+            bool reused = discard->key == keep->key
+                || discard->value == keep->value;
+            if (discard != keep && reused) {
+                // Copy the shared nodes on the path, so the entry
+                // refs tell if a clone still uses the entry.
+                table *owner = discard == a[i] ? dst : src;
+                owner->root = own_path(owner, owner->root, discard->key);
+            }
+            if (discard != keep && reused && discard->refs == 1) {
+                if (discard->key == keep->key) {
+                    discard->key = NULL;
+                }
+                if (discard->value == keep->value) {
+                    discard->value = NULL;
+                }
+            }
+            merged[k++] = keep;
+            i++;
+            j++;
+        }
+    }
+    while (i < n) {
+        merged[k++] = a[i++];
+    }
+    while (j < m) {
+        merged[k++] = b[j++];
+    }
+    tree_node *root = build_tree(dst->alloc, merged, k);
+    release(dst, dst->root);
+    release(src, src->root);
+    dst->root = root;
+    src->root = NULL;
+
+    free(a);
+    free(b);
+    free(merged);
+    return 0;
+}
+
+/**
+ * table_intersect() - Keep only the keys that are found in another table.
+ * @t: Table to manipulate.
+ * @other: Table with the keys to keep. Not modified.
+ *
+ * Returns: 0 on success, -1 if t is frozen.
+ */
+int table_intersect(table *t, const table *other)
+{
+    return filter_keys(t, other, true);
+}
+
+/**
+ * table_difference() - Remove the keys that are found in another table.
+ * @t: Table to manipulate.
+ * @other: Table with the keys to remove. Not modified.
+ *
+ * Returns: 0 on success, -1 if t is frozen.
+ */
+int table_difference(table *t, const table *other)
+{
+    return filter_keys(t, other, false);
+}
+
+/*
+ * table_kill() - Destroy a table.
+ * @table: Table to destroy.
+ *
+ * Return all dynamic memory used by the table and its elements. If a
+ * kill_func was registered for keys and/or values at table creation,
+ * it is called each element to kill any user-allocated memory
+ * occupied by the element values.
+ *
+ * Returns: Nothing.
+ */
+void table_kill(table *t)
+{
+    if (t->frozen != NULL) {
+        (*t->frozen_refs)--;
+        if (*t->frozen_refs == 0) {
+            perfect_table_kill(t->frozen);
+            free(t->frozen_refs);
+        }
+    }
+    if (t->alloc->deallocate == NULL && t->key_kill_func == NULL
+        && t->value_kill_func == NULL) {
+        // No node, key or value is returned on its own. The memory is
+        // returned at once by the owner of the allocator.
+        return;
+    }
+    // Release the tree. Nodes shared with a clone are kept...
+    release(t, t->root);
+    // ...and the table struct.
+    allocator_deallocate(t->alloc, t, sizeof(*t));
+}
+
+// Internal function to call print_func for each pair of a subtree in key order.
+static void print_nodes(const tree_node *n, inspect_callback_pair print_func)
+{
+    if (n == NULL) {
+        return;
+    }
+    print_nodes(n->left, print_func);
+    print_func(n->entry->key, n->entry->value);
+    print_nodes(n->right, print_func);
+}
+
+/**
+ * table_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Iterates over the key/value pairs in the table in ascending key
+ * order and prints them.
+ *
+ * Returns: Nothing.
+ */
+void table_print(const table *t, inspect_callback_pair print_func)
+{
+    print_nodes(t->root, print_func);
+}
+
+// ===========INTERNAL FUNCTIONS USED BY table_print_internal ============
+
+// The functions below output code in the dot language, used by
+// GraphViz. For documention of the dot language, see graphviz.org.
+
+/**
+ * indent() - Output indentation string.
+ * @n: Indentation level.
+ *
+ * Print n tab characters.
+ *
+ * Returns: Nothing.
+ */
+static void indent(int n)
+{
+    for (int i=0; i<n; i++) {
+        printf("\t");
+    }
+}
+
+/**
+ * iprintf(...) - Indent and print.
+ * @n: Indentation level
+ * @...: printf arguments
+ *
+ * Print n tab characters and calls printf.
+ *
+ * Returns: Nothing.
+ */
+static void iprintf(int n, const char *fmt, ...)
+{
+    // Indent...
+    indent(n);
+    // ...and call printf
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * print_edge() - Print a edge between two addresses.
+ * @from: The address of the start of the edge. Should be non-NULL.
+ * @to: The address of the destination for the edge, including NULL.
+ * @port: The name of the port on the source node, or NULL.
+ * @label: The label for the edge, or NULL.
+ * @options: A string with other edge options, or NULL.
+ *
+ * Print an edge from port PORT on node FROM to TO with label
+ * LABEL. If to is NULL, the destination is the NULL node, otherwise a
+ * memory node. If the port is NULL, the edge starts at the node, not
+ * a specific port on it. If label is NULL, no label is used. The
+ * options string, if non-NULL, is printed before the label.
+ *
+ * Returns: Nothing.
+ */
+static void print_edge(int indent_level, const void *from, const void *to, const char *port,
+                       const char *label, const char *options)
+{
+    indent(indent_level);
+    if (port) {
+        printf("m%04lx:%s -> ", PTR2ADDR(from), port);
+    } else {
+        printf("m%04lx -> ", PTR2ADDR(from));
+    }
+    if (to == NULL) {
+        printf("NULL");
+    } else {
+        printf("m%04lx", PTR2ADDR(to));
+    }
+    printf(" [");
+    if (options != NULL) {
+        printf("%s", options);
+    }
+    if (label != NULL) {
+        printf(" label=\"%s\"",label);
+    }
+    printf("]\n");
+}
+
+/**
+ * print_head_node() - Print a node corresponding to the table struct.
+ * @indent_level: Indentation level.
+ * @t: Table to inspect.
+ *
+ * Returns: Nothing.
+ */
+static void print_head_node(int indent_level, const table *t)
+{
+    iprintf(indent_level, "m%04lx [shape=record "
+            "label=\"<r>root\\n%04lx|cmp\\n%04lx|hash\\n%04lx|key_kill\\n%04lx"
+            "|value_kill\\n%04lx|<f>frozen\\n%04lx\"]\n",
+            PTR2ADDR(t), PTR2ADDR(t->root), PTR2ADDR(t->key_cmp_func),
+            PTR2ADDR(t->key_hash_func), PTR2ADDR(t->key_kill_func),
+            PTR2ADDR(t->value_kill_func), PTR2ADDR(t->frozen));
+}
+
+// Internal function to print the edges from the head in dot format.
+static void print_head_edges(int indent_level, const table *t)
+{
+    print_edge(indent_level, t, t->root, "r", "root", NULL);
+    if (t->frozen != NULL) {
+        print_edge(indent_level, t, t->frozen, "f", "frozen", NULL);
+    }
+}
+
+// Internal function to print the key and value nodes in dot format.
+static void print_key_value_nodes(int indent_level, const void *key, const void *value,
+                                  inspect_callback key_print_func,
+                                  inspect_callback value_print_func)
+{
+    if (key != NULL) {
+        iprintf(indent_level, "m%04lx [label=\"", PTR2ADDR(key));
+        if (key_print_func != NULL) {
+            key_print_func(key);
+        }
+        printf("\" xlabel=\"%04lx\"]\n", PTR2ADDR(key));
+    }
+    if (value != NULL) {
+        iprintf(indent_level, "m%04lx [label=\"", PTR2ADDR(value));
+        if (value_print_func != NULL) {
+            value_print_func(value);
+        }
+        printf("\" xlabel=\"%04lx\"]\n", PTR2ADDR(value));
+    }
+}
+
+// Internal function to print the key and value nodes of a subtree in dot format.
+static void print_payload_nodes(int indent_level, const tree_node *n,
+                                inspect_callback key_print_func,
+                                inspect_callback value_print_func)
+{
+    if (n == NULL) {
+        return;
+    }
+    print_payload_nodes(indent_level, n->left, key_print_func, value_print_func);
+    print_key_value_nodes(indent_level, n->entry->key, n->entry->value, key_print_func,
+                          value_print_func);
+    print_payload_nodes(indent_level, n->right, key_print_func, value_print_func);
+}
+
+// Internal function to print the tree nodes of a subtree in dot format.
+static void print_tree_nodes(int indent_level, const tree_node *n)
+{
+    if (n == NULL) {
+        return;
+    }
+    iprintf(indent_level, "m%04lx [shape=record label=\"<l>left\\n%04lx|<k>key\\n%04lx"
+            "|<v>value\\n%04lx|height\\n%d|refs\\n%d|<r>right\\n%04lx\"]\n",
+            PTR2ADDR(n), PTR2ADDR(n->left), PTR2ADDR(n->entry->key),
+            PTR2ADDR(n->entry->value), n->height, n->refs, PTR2ADDR(n->right));
+    print_tree_nodes(indent_level, n->left);
+    print_tree_nodes(indent_level, n->right);
+}
+
+// Internal function to print edges from the tree nodes in dot format.
+// Memory "owned" by the table is indicated by solid red lines. Memory
+// "borrowed" from the user is indicated by red dashed lines.
+static void print_tree_edges(int indent_level, const table *t, const tree_node *n)
+{
+    if (n == NULL) {
+        return;
+    }
+    print_edge(indent_level, n, n->left, "l", "left", NULL);
+    print_edge(indent_level, n, n->right, "r", "right", NULL);
+    print_edge(indent_level, n, n->entry->key, "k", "key",
+               t->key_kill_func ? "color=red" : "color=red style=dashed");
+    print_edge(indent_level, n, n->entry->value, "v", "value",
+               t->value_kill_func ? "color=red" : "color=red style=dashed");
+    print_tree_edges(indent_level, t, n->left);
+    print_tree_edges(indent_level, t, n->right);
+}
+
+// Create an escaped version of the input string. The most common
+// control characters - newline, horizontal tab, backslash, and double
+// quote - are replaced by their escape sequence. The returned pointer
+// must be deallocated by the caller.
+static char *escape_chars(const char *s)
+{
+    int i, j;
+    int escaped = 0; // The number of chars that must be escaped.
+
+    // Count how many chars need to be escaped, i.e. how much longer
+    // the output string will be.
+    for (i = escaped = 0; s[i] != '\0'; i++) {
+        if (s[i] == '\n' || s[i] == '\t' || s[i] == '\\' || s[i] == '\"') {
+            escaped++;
+        }
+    }
+    // Allocate space for the escaped string. The variable i holds the input
+    // length, escaped how much the string will grow.
+    char *t = malloc(i + escaped + 1);
+
+    // Copy-and-escape loop
+    for (i = j = 0; s[i] != '\0'; i++) {
+        // Convert each control character by its escape sequence.
+        // Non-control characters are copied as-is.
+        switch (s[i]) {
+        case '\n': t[i+j] = '\\'; t[i+j+1] = 'n';  j++; break;
+        case '\t': t[i+j] = '\\'; t[i+j+1] = 't';  j++; break;
+        case '\\': t[i+j] = '\\'; t[i+j+1] = '\\'; j++; break;
+        case '\"': t[i+j] = '\\'; t[i+j+1] = '\"'; j++; break;
+        default:   t[i+j] = s[i]; break;
+        }
+    }
+    // Terminal the output string
+    t[i+j] = '\0';
+    return t;
+}
+
+/**
+ * first_white_spc() - Return pointer to first white-space char.
+ * @s: String.
+ *
+ * Returns: A pointer to the first white-space char in s, or NULL if none is found.
+ *
+ */
+static const char *find_white_spc(const char *s)
+{
+    const char *t = s;
+    while (*t != '\0') {
+        if (isspace(*t)) {
+            // We found a white-space char, return a point to it.
+            return t;
+        }
+        // Advance to next char
+        t++;
+    }
+    // No white-space found
+    return NULL;
+}
+
+/**
+ * insert_table_name() - Maybe insert the name of the table src file in the description string.
+ * @s: Description string.
+ *
+ * Parses the description string to find of if it starts with a c file
+ * name. In that case, the file name of this file is spliced into the
+ * description string. The parsing is not very intelligent: If the
+ * sequence ".c:" (case insensitive) is found before the first
+ * white-space, the string up to and including ".c" is taken to be a c
+ * file name.
+ *
+ * Returns: A dynamic copy of s, optionally including with the table src file name.
+ */
+static char *insert_table_name(const char *s)
+{
+    // First, determine if the description string starts with a c file name
+    // a) Search for the string ".c:"
+    const char *dot_c = strstr(s, ".c:");
+    // b) Search for the first white-space
+    const char *spc = find_white_spc(s);
+
+    bool prefix_found;
+    int output_length;
+
+    // If both a) and b) are found AND a) is before b, we assume that
+    // s starts with a file name
+    if (dot_c != NULL && spc != NULL && dot_c < spc) {
+        // We found a match. Output string is input + 3 chars + __FILE__
+        prefix_found = true;
+        output_length = strlen(s) + 3 + strlen(__FILE__);
+    } else {
+        // No match found. Output string is just input
+        prefix_found = false;
+        output_length = strlen(s);
+    }
+
+    // Allocate space for the whole string
+    char *out = calloc(1, output_length + 1);
+    strcpy(out, s);
+    if (prefix_found) {
+        // Overwrite the output buffer from the ":"
+        strcpy(out + (dot_c - s + 2), " (");
+        // Now out will be 0-terminated after "(", append the file name and ")"
+        strcat(out, __FILE__);
+        strcat(out, ")");
+        // Finally append the input string from the : onwards
+        strcat(out, dot_c + 2);
+    }
+    return out;
+}
+
+/**
+ * table_print_internal() - Output the internal structure of the table.
+ * @t: Table to print.
+ * @key_print_func: Function called for each key in the table.
+ * @value_print_func: Function called for each value in the table.
+ * @desc: String with a description/state of the list.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the tree and prints code that shows its' internal structure.
+ *
+ * Returns: Nothing.
+ */
+void table_print_internal(const table *t, inspect_callback key_print_func,
+                          inspect_callback value_print_func, const char *desc,
+                          int indent_level)
+{
+    static int graph_number = 0;
+    graph_number++;
+    int il = indent_level;
+
+    if (indent_level == 0) {
+        // If this is the outermost datatype, start a graph and set up defaults
+        printf("digraph TABLE_%d {\n", graph_number);
+
+        // Specify default shape and fontname
+        il++;
+        iprintf(il, "node [shape=rectangle fontname=\"Courier New\"]\n");
+        iprintf(il, "ranksep=0.01\n");
+        iprintf(il, "subgraph cluster_nullspace {\n");
+        iprintf(il+1, "NULL\n");
+        iprintf(il, "}\n");
+    }
+
+    if (desc != NULL) {
+        // Escape the string before printout
+        char *escaped = escape_chars(desc);
+        // Optionally, splice the source file name
+        char *spliced = insert_table_name(escaped);
+
+        // Use different names on inner description nodes
+        if (indent_level == 0) {
+            iprintf(il, "description [label=\"%s\"]\n", spliced);
+        } else {
+            iprintf(il, "\tcluster_list_%d_description [label=\"%s\"]\n", graph_number, spliced);
+        }
+        // Return the memory used by the spliced and escaped strings
+        free(spliced);
+        free(escaped);
+    }
+
+    if (indent_level == 0) {
+        // Use a single "pointer" edge as a starting point for the
+        // outermost datatype
+        iprintf(il, "t [label=\"%04lx\" xlabel=\"t\"]\n", PTR2ADDR(t));
+        iprintf(il, "t -> m%04lx\n", PTR2ADDR(t));
+    }
+
+    if (indent_level == 0) {
+        // Put the user nodes in userspace
+        iprintf(il, "subgraph cluster_userspace { label=\"User space\"\n");
+        il++;
+
+        // Traverse the tree to print the payload nodes
+        print_payload_nodes(il, t->root, key_print_func, value_print_func);
+
+        // Close the subgraph
+        il--;
+        iprintf(il, "}\n");
+    }
+
+    // Print the subgraph to surround the tree content
+    iprintf(il, "subgraph cluster_table_%d { label=\"Table\"\n", graph_number);
+    il++;
+
+    // Output the head node and the tree nodes
+    print_head_node(il, t);
+    print_tree_nodes(il, t->root);
+    if (t->frozen != NULL) {
+        perfect_table_print_internal(t->frozen, NULL, NULL, NULL, il);
+    }
+
+    // Close the subgraph
+    il--;
+    iprintf(il, "}\n");
+
+    // Output the edges from the head and the tree nodes
+    print_head_edges(il, t);
+    print_tree_edges(il, t, t->root);
+
+    if (indent_level == 0) {
+        // Termination of graph
+        printf("}\n");
+    }
+}
@@ -6,6 +6,7 @@
 
 #include <table.h>
 #include <dlist.h>
+#include <perfect_table.h>
 
 /*
  * Implementation of a generic table for the "Datastructures and
@@ -24,6 +25,14 @@
  *   v1.1  2019-03-04: Bugfix in table_remove.
  *   v1.2  2024-04-15: Added table_print_internal.
  *   v2.0  2024-05-10: Updated print_internal with improved encapsulation.
+ *   v2.1  2026-10-18: Added cached key hashes and table_empty_with_hash.
+ *   v2.2  2026-10-18: Added table_freeze.
+ *   v2.3  2026-10-18: Added ordered queries by scanning the list.
+ *   v2.4  2026-10-18: Added table_merge, table_intersect and table_difference.
+ *   v2.5  2026-10-18: Added table_clone with copy-on-write entry lists.
+ *   v2.6  2026-10-18: Added table_empty_with_key_type and table_prefix_scan.
+ *   v2.7  2026-10-18: Added table_empty_with_allocator.
+ *   v2.8  2026-10-18: table_kill returns at once for a table in an arena.
  */
 
 // ===========INTERNAL DATA TYPES ============
@@ -31,13 +40,20 @@
 struct table {
     dlist *entries; // The table entries are stored in a directed list
     compare_function *key_cmp_func;
+    hash_function *key_hash_func; // NULL if no hashes are cached
     kill_function key_kill_func;
     kill_function value_kill_func;
+    perfect_table *frozen; // Non-NULL once the table has been frozen
+    int *shared; // Number of tables sharing entries and frozen, see table_clone
+    const allocator *alloc; // Allocator for the head, entries and list
 };
 
 typedef struct table_entry {
     void *key;
     void *value;
+    unsigned long hash; // Cached hash of the key, 0 without hash function
+    int refs; // Number of entry lists referring to the entry
+    const allocator *alloc; // Allocator of the entry, used by table_entry_kill
 } table_entry;
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
@@ -47,24 +63,32 @@ typedef struct table_entry {
  * @key: A pointer to a function to be used to compare keys.
  * @value: A pointer to a function (or NULL) to be called to
  *                 de-allocate memory for keys on remove/kill.
+ * @hash: The hash of the key.
+ * @alloc: The allocator of the table.
  *
  * Returns: A pointer to the newly created table entry.
  */
-table_entry *table_entry_create(void *key, void *value)
+table_entry *table_entry_create(void *key, void *value, unsigned long hash,
+                                const allocator *alloc)
 {
-    // Allocate space for a table entry. Use calloc as a defensive
-    // measure to ensure that all pointers are initialized to NULL.
-    table_entry *e = calloc(1, sizeof(*e));
+    // Allocate space for a table entry. The allocator returns
+    // zero-initialized memory, so all pointers are initialized to NULL.
+    table_entry *e = alloc->allocate(alloc->context, sizeof(*e));
     // Populate the entry.
     e->key = key;
     e->value = value;
+    e->hash = hash;
+    e->refs = 1;
+    e->alloc = alloc;
 
     return e;
 }
 
 /**
- * table_entry_kill() - Return the memory allocated to a table entry.
- * @e: The table entry to deallocate.
+ * table_entry_kill() - Drop a reference to a table entry.
+ * @e: The table entry.
+ *
+ * The entry struct is deallocated when the last reference is dropped.
  *
  * Returns: Nothing.
  */
@@ -72,8 +96,80 @@ void table_entry_kill(void *v)
 {
     table_entry *e = v; // Convert the pointer (useful if debugging the code)
 
-    // All we need to do is to deallocate the struct.
-    free(e);
+    e->refs--;
+    if (e->refs == 0) {
+        // All we need to do is to deallocate the struct.
+        allocator_deallocate(e->alloc, e, sizeof(*e));
+    }
+}
+
+/**
+ * table_key_hash() - Compute the hash of a key.
+ * @t: Table whose hash function to use.
+ * @key: Key to hash.
+ *
+ * Returns: The hash of the key, or 0 if the table has no hash function.
+ */
+static unsigned long table_key_hash(const table *t, const void *key)
+{
+    if (t->key_hash_func == NULL) {
+        return 0;
+    }
+    return t->key_hash_func(key);
+}
+
+/**
+ * table_entry_matches() - Check if a table entry matches a key.
+ * @t: Table to which the entry belongs.
+ * @e: Table entry to check.
+ * @key: Key to compare with.
+ * @hash: The hash of the key, as returned by table_key_hash().
+ *
+ * The cached hashes are compared first. The key compare function is
+ * only called if the hashes are equal.
+ *
+ * Returns: True if the entry key is equal to key, otherwise false.
+ */
+static bool table_entry_matches(const table *t, const table_entry *e,
+                                const void *key, unsigned long hash)
+{
+    return e->hash == hash && t->key_cmp_func(e->key, key) == 0;
+}
+
+/**
+ * table_unshare() - Give a table its own entry list before it is modified.
+ * @t: Table to manipulate. Must not be frozen.
+ *
+ * A clone shares the entry list with the table it was cloned from. The
+ * whole list is copied on the first modification of either table, in
+ * O(n) time for n entries, as the cells cannot be shared one by one.
+ * The entries themselves stay shared, so only the list cells are
+ * copied.
+ *
+ * Returns: Nothing.
+ */
+static void table_unshare(table *t)
+{
+    if (*t->shared == 1) {
+        // Not shared, nothing to do.
+        return;
+    }
+    // Leave the shared list to the other tables.
+    (*t->shared)--;
+    t->shared = t->alloc->allocate(t->alloc->context, sizeof(*t->shared));
+    *t->shared = 1;
+
+    // Copy the list in order. Each entry gets one more reference.
+    dlist *entries = dlist_empty_with_allocator(table_entry_kill, t->alloc);
+    dlist_pos to = dlist_first(entries);
+    dlist_pos from = dlist_first(t->entries);
+    while (!dlist_is_end(t->entries, from)) {
+        table_entry *e = dlist_inspect(t->entries, from);
+        e->refs++;
+        to = dlist_next(entries, dlist_insert(entries, e, to));
+        from = dlist_next(t->entries, from);
+    }
+    t->entries = entries;
 }
 
 /**
@@ -90,14 +186,94 @@ table *table_empty(compare_function *key_cmp_func,
                    kill_function key_kill_func,
                    kill_function value_kill_func)
 {
+    // A table without a hash function.
+    return table_empty_with_hash(key_cmp_func, NULL, key_kill_func, value_kill_func);
+}
+
+/**
+ * table_empty_with_hash() - Create an empty table with cached key hashes.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_with_hash(compare_function *key_cmp_func,
+                             hash_function *key_hash_func,
+                             kill_function key_kill_func,
+                             kill_function value_kill_func)
+{
+    return table_empty_with_allocator(key_cmp_func, key_hash_func, TABLE_KEY_OPAQUE,
+                                      key_kill_func, value_kill_func, NULL);
+}
+
+/**
+ * table_empty_with_key_type() - Create an empty table for a given type of keys.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash keys.
+ * @key_type: The type of the keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ *
+ * The keys are only compared with key_cmp_func, so the key type is
+ * not used.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_with_key_type(compare_function *key_cmp_func,
+                                 hash_function *key_hash_func,
+                                 table_key_type key_type,
+                                 kill_function key_kill_func,
+                                 kill_function value_kill_func)
+{
+    return table_empty_with_hash(key_cmp_func, key_hash_func, key_kill_func, value_kill_func);
+}
+
+/**
+ * table_empty_with_allocator() - Create an empty table with a given allocator.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash keys.
+ * @key_type: The type of the keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/kill.
+ * @alloc: The allocator (or NULL for calloc/free) used for the table
+ *         and its elements.
+ *
+ * The keys are only compared with key_cmp_func, so the key type is
+ * not used.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_with_allocator(compare_function *key_cmp_func,
+                                  hash_function *key_hash_func,
+                                  table_key_type key_type,
+                                  kill_function key_kill_func,
+                                  kill_function value_kill_func,
+                                  const allocator *alloc)
+{
+    if (alloc == NULL) {
+        alloc = default_allocator();
+    }
     // Allocate the table header.
-    table *t = calloc(1, sizeof(table));
+    table *t = alloc->allocate(alloc->context, sizeof(table));
     // Create the list to hold the table_entry-ies.
-    t->entries = dlist_empty(table_entry_kill);
-    // Store the key compare function and key/value kill functions.
+    t->entries = dlist_empty_with_allocator(table_entry_kill, alloc);
+    // Store the key compare/hash functions and key/value kill functions.
     t->key_cmp_func = key_cmp_func;
+    t->key_hash_func = key_hash_func;
     t->key_kill_func = key_kill_func;
     t->value_kill_func = value_kill_func;
+    t->alloc = alloc;
+    // The table is not shared with any clone.
+    t->shared = alloc->allocate(alloc->context, sizeof(*t->shared));
+    *t->shared = 1;
 
     return t;
 }
@@ -110,6 +286,9 @@ table *table_empty(compare_function *key_cmp_func,
  */
 bool table_is_empty(const table *t)
 {
+    if (t->frozen != NULL) {
+        return perfect_table_size(t->frozen) == 0;
+    }
     return dlist_is_empty(t->entries);
 }
 
@@ -124,14 +303,21 @@ bool table_is_empty(const table *t)
  * added value for a duplicate key. table_remove() will remove all
  * duplicates for a given key.
  *
- * Returns: Nothing.
+ * Returns: 0 on success, -1 if the table is frozen.
  */
-void table_insert(table *t, void *key, void *value)
+int table_insert(table *t, void *key, void *value)
 {
-    // Allocate the key/value structure.
-    table_entry *e = table_entry_create(key, value);
+    if (t->frozen != NULL) {
+        // A frozen table cannot be modified.
+        return -1;
+    }
+    table_unshare(t);
+    // Allocate the key/value structure. Compute the key hash once.
+    table_entry *e = table_entry_create(key, value, table_key_hash(t, key), t->alloc);
 
     dlist_insert(t->entries, e, dlist_first(t->entries));
+
+    return 0;
 }
 
 /**
@@ -145,15 +331,22 @@ void table_insert(table *t, void *key, void *value)
  */
 void *table_lookup(const table *t, const void *key)
 {
-    // Iterate over the list. Return first match.
+    if (t->frozen != NULL) {
+        // A single probe into the frozen table.
+        return perfect_table_lookup(t->frozen, key);
+    }
 
+    // Hash the search key once.
+    unsigned long hash = table_key_hash(t, key);
+
+    // Iterate over the list. Return first match.
     dlist_pos pos = dlist_first(t->entries);
 
     while (!dlist_is_end(t->entries, pos)) {
         // Inspect the table entry
         table_entry *e = dlist_inspect(t->entries, pos);
         // Check if the entry key matches the search key.
-        if (t->key_cmp_func(e->key, key) == 0) {
+        if (table_entry_matches(t, e, key, hash)) {
             // If yes, return the corresponding value pointer.
             return e->value;
         }
@@ -176,6 +369,11 @@ void *table_lookup(const table *t, const void *key)
  */
 void *table_choose_key(const table *t)
 {
+    if (t->frozen != NULL) {
+        // Return the key in the first slot.
+        return perfect_table_inspect_key(t->frozen, 0);
+    }
+
     // Return first key value.
     dlist_pos pos = dlist_first(t->entries);
     table_entry *e = dlist_inspect(t->entries, pos);
@@ -192,12 +390,20 @@ void *table_choose_key(const table *t)
  * functions set for keys/values. Does nothing if key is not found in
  * the table.
  *
- * Returns: Nothing.
+ * Returns: 0 on success, -1 if the table is frozen.
  */
-void table_remove(table *t, const void *key)
+int table_remove(table *t, const void *key)
 {
+    if (t->frozen != NULL) {
+        // A frozen table cannot be modified.
+        return -1;
+    }
+    table_unshare(t);
+
     // Will be set if we need to delay a free.
     void *deferred_ptr = NULL;
+    // Hash the search key once.
+    unsigned long hash = table_key_hash(t, key);
 
     // Start at beginning of the list.
     dlist_pos pos = dlist_first(t->entries);
@@ -208,10 +414,11 @@ void table_remove(table *t, const void *key)
         table_entry *e = dlist_inspect(t->entries, pos);
 
         // Compare the supplied key with the key of this entry.
-        if (t->key_cmp_func(e->key, key) == 0) {
+        if (table_entry_matches(t, e, key, hash)) {
             // If we have a match, call kill on the key
-            // and/or value if given the responsiblity
-            if (t->key_kill_func != NULL) {
+            // and/or value if given the responsiblity,
+            // unless the entry is shared with a clone
+            if (t->key_kill_func != NULL && e->refs == 1) {
                 if (e->key == key) {
                     // The given key points to the same
                     // memory as entry->key. Freeing it here
@@ -223,7 +430,7 @@ void table_remove(table *t, const void *key)
                     t->key_kill_func(e->key);
                 }
             }
-            if (t->value_kill_func != NULL) {
+            if (t->value_kill_func != NULL && e->refs == 1) {
                 t->value_kill_func(e->value);
             }
             // Remove the list element itself.
@@ -237,6 +444,506 @@ void table_remove(table *t, const void *key)
         // Take care of the delayed free.
         t->key_kill_func(deferred_ptr);
     }
+
+    return 0;
+}
+
+/**
+ * table_freeze() - Make a table immutable.
+ * @t: Table to freeze.
+ *
+ * A perfect_table is built over the entries in list order, i.e. with
+ * the latest inserted entry first. The perfect_table keeps the first
+ * occurrence of each key, so the latest value is kept for any
+ * duplicate key. The entries stay in the list, which keeps the
+ * responsibility to kill the keys/values.
+ *
+ * Returns: 0 on success, -1 if the table has no hash function, -2
+ * if two different keys have the same hash value.
+ */
+int table_freeze(table *t)
+{
+    if (t->frozen != NULL) {
+        // Already frozen, nothing to do.
+        return 0;
+    }
+    if (t->key_hash_func == NULL) {
+        return -1;
+    }
+    // The frozen table must not be shared with any unfrozen clone.
+    table_unshare(t);
+
+    // Count the entries.
+    int n = 0;
+    dlist_pos pos = dlist_first(t->entries);
+    while (!dlist_is_end(t->entries, pos)) {
+        n++;
+        pos = dlist_next(t->entries, pos);
+    }
+
+    // Copy the key/value pointers to arrays.
+    void **keys = calloc(n + 1, sizeof(*keys));
+    void **values = calloc(n + 1, sizeof(*values));
+    pos = dlist_first(t->entries);
+    for (int i = 0; i < n; i++) {
+        table_entry *e = dlist_inspect(t->entries, pos);
+        keys[i] = e->key;
+        values[i] = e->value;
+        pos = dlist_next(t->entries, pos);
+    }
+
+    // Build the frozen table. The keys/values are owned by the list.
+    t->frozen = perfect_table_create(t->key_cmp_func, t->key_hash_func,
+                                     NULL, NULL, n, keys, values);
+    free(keys);
+    free(values);
+    if (t->frozen == NULL) {
+        return -2;
+    }
+
+    return 0;
+}
+
+/**
+ * table_is_frozen() - Check if a table is frozen.
+ * @t: Table to check.
+ *
+ * Returns: True if the table is frozen, otherwise false.
+ */
+bool table_is_frozen(const table *t)
+{
+    return t->frozen != NULL;
+}
+
+/**
+ * table_clone() - Create a copy of a table in constant time.
+ * @t: Table to copy.
+ *
+ * The copy shares the entry list, and the frozen table if any, with
+ * t. The whole list is copied, in O(n) time, by the first of the
+ * tables to be modified.
+ *
+ * Returns: Pointer to the new table.
+ */
+table *table_clone(const table *t)
+{
+    // Copy the table header, including the shared pointers.
+    table *c = t->alloc->allocate(t->alloc->context, sizeof(*c));
+    *c = *t;
+    (*c->shared)++;
+
+    return c;
+}
+
+/**
+ * closest_key() - Find the key closest to a bound on one side of it.
+ * @t: Table to inspect.
+ * @bound: Bound key, or NULL for no bound.
+ * @dir: -1 to search for the largest key <= bound, +1 to search for
+ *       the smallest key >= bound.
+ *
+ * The list is not ordered, so all entries are compared. Duplicates
+ * have equal keys and need no special handling.
+ *
+ * Returns: The closest key, or NULL if there is none.
+ */
+static void *closest_key(const table *t, const void *bound, int dir)
+{
+    void *best = NULL;
+    dlist_pos pos = dlist_first(t->entries);
+
+    while (!dlist_is_end(t->entries, pos)) {
+        table_entry *e = dlist_inspect(t->entries, pos);
+        // Skip keys on the wrong side of the bound and keep the key
+        // closest to the bound.
+        if ((bound == NULL || dir * t->key_cmp_func(e->key, bound) >= 0)
+            && (best == NULL || dir * t->key_cmp_func(e->key, best) < 0)) {
+            best = e->key;
+        }
+        pos = dlist_next(t->entries, pos);
+    }
+    return best;
+}
+
+/**
+ * sort_entries() - Sort table entries by key with a stable merge sort.
+ * @t: Table whose keys to compare.
+ * @a: Array with the entries to sort.
+ * @tmp: Scratch array with room for n entries.
+ * @n: Number of entries.
+ *
+ * Returns: Nothing.
+ */
+static void sort_entries(const table *t, table_entry **a, table_entry **tmp, int n)
+{
+    if (n < 2) {
+        return;
+    }
+    // Sort both halves...
+    int mid = n / 2;
+    sort_entries(t, a, tmp, mid);
+    sort_entries(t, a + mid, tmp, n - mid);
+
+    // ...and merge them. Take from the left half on ties to keep the
+    // sort stable.
+    int i = 0, j = mid, k = 0;
+    while (i < mid && j < n) {
+        if (t->key_cmp_func(a[j]->key, a[i]->key) < 0) {
+            tmp[k++] = a[j++];
+        } else {
+            tmp[k++] = a[i++];
+        }
+    }
+    while (i < mid) {
+        tmp[k++] = a[i++];
+    }
+    while (j < n) {
+        tmp[k++] = a[j++];
+    }
+    for (k = 0; k < n; k++) {
+        a[k] = tmp[k];
+    }
+}
+
+/**
+ * table_min() - Return the smallest key in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The smallest key, or NULL if the table is empty.
+ */
+void *table_min(const table *t)
+{
+    if (t->frozen != NULL) {
+        return perfect_table_min(t->frozen);
+    }
+    return closest_key(t, NULL, 1);
+}
+
+/**
+ * table_max() - Return the largest key in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The largest key, or NULL if the table is empty.
+ */
+void *table_max(const table *t)
+{
+    if (t->frozen != NULL) {
+        return perfect_table_max(t->frozen);
+    }
+    return closest_key(t, NULL, -1);
+}
+
+/**
+ * table_floor() - Return the largest key less than or equal to a key.
+ * @t: Table to inspect.
+ * @key: Key to compare with.
+ *
+ * Returns: The largest key <= key, or NULL if there is none.
+ */
+void *table_floor(const table *t, const void *key)
+{
+    if (t->frozen != NULL) {
+        return perfect_table_floor(t->frozen, key);
+    }
+    return closest_key(t, key, -1);
+}
+
+/**
+ * table_ceiling() - Return the smallest key greater than or equal to a key.
+ * @t: Table to inspect.
+ * @key: Key to compare with.
+ *
+ * Returns: The smallest key >= key, or NULL if there is none.
+ */
+void *table_ceiling(const table *t, const void *key)
+{
+    if (t->frozen != NULL) {
+        return perfect_table_ceiling(t->frozen, key);
+    }
+    return closest_key(t, key, 1);
+}
+
+/**
+ * visit_sorted() - Visit the matching pairs in ascending key order.
+ * @t: Table to inspect.
+ * @lo: Lower bound of the interval, inclusive, or NULL to match by prefix.
+ * @hi: Upper bound of the interval, inclusive.
+ * @prefix: The prefix of the keys to match if lo is NULL.
+ * @callback: Function called for each matching key/value pair.
+ *
+ * The matching entries are collected in list order, i.e. latest
+ * first, and sorted by key. After the stable sort, the first entry
+ * of each run of duplicates is the one to visit.
+ *
+ * Returns: Nothing.
+ */
+static void visit_sorted(const table *t, const void *lo, const void *hi,
+                         const char *prefix, inspect_callback_pair callback)
+{
+    int len = lo == NULL ? strlen(prefix) : 0;
+
+    // Count the entries to size the arrays.
+    int n = 0;
+    dlist_pos pos = dlist_first(t->entries);
+    while (!dlist_is_end(t->entries, pos)) {
+        n++;
+        pos = dlist_next(t->entries, pos);
+    }
+    table_entry **matches = calloc(n + 1, sizeof(*matches));
+    table_entry **tmp = calloc(n + 1, sizeof(*tmp));
+
+    // Collect the matching entries.
+    int k = 0;
+    pos = dlist_first(t->entries);
+    while (!dlist_is_end(t->entries, pos)) {
+        table_entry *e = dlist_inspect(t->entries, pos);
+        if (lo == NULL ? strncmp(e->key, prefix, len) == 0
+            : t->key_cmp_func(e->key, lo) >= 0 && t->key_cmp_func(e->key, hi) <= 0) {
+            matches[k++] = e;
+        }
+        pos = dlist_next(t->entries, pos);
+    }
+
+    // Sort them and skip the shadowed duplicates.
+    sort_entries(t, matches, tmp, k);
+    for (int i = 0; i < k; i++) {
+        if (i == 0 || t->key_cmp_func(matches[i - 1]->key, matches[i]->key) != 0) {
+            callback(matches[i]->key, matches[i]->value);
+        }
+    }
+    free(matches);
+    free(tmp);
+}
+
+/**
+ * table_range() - Iterate over the key/value pairs within an interval.
+ * @t: Table to inspect.
+ * @lo: Lower bound of the interval, inclusive.
+ * @hi: Upper bound of the interval, inclusive.
+ * @callback: Function called for each key/value pair in the interval.
+ *
+ * Returns: Nothing.
+ */
+void table_range(const table *t, const void *lo, const void *hi,
+                 inspect_callback_pair callback)
+{
+    if (t->frozen != NULL) {
+        perfect_table_range(t->frozen, lo, hi, callback);
+        return;
+    }
+    visit_sorted(t, lo, hi, NULL, callback);
+}
+
+/**
+ * table_prefix_scan() - Iterate over the key/value pairs with keys starting with a prefix.
+ * @t: Table to inspect. The keys must be strings.
+ * @prefix: The prefix. The empty string matches all keys.
+ * @callback: Function called for each key/value pair with a matching key.
+ *
+ * The list is kept when the table is frozen, so all keys are checked.
+ *
+ * Returns: Nothing.
+ */
+void table_prefix_scan(const table *t, const char *prefix,
+                       inspect_callback_pair callback)
+{
+    visit_sorted(t, NULL, NULL, prefix, callback);
+}
+
+/**
+ * key_index_create() - Build a hash index over the keys of a table.
+ * @t: Table whose keys to index.
+ *
+ * The index is a perfect_table that maps each key to itself, so a
+ * lookup returns non-NULL if and only if the key is in the table.
+ *
+ * Returns: The index, or NULL if the table has no hash function or
+ * two different keys have the same hash value.
+ */
+static perfect_table *key_index_create(const table *t)
+{
+    if (t->key_hash_func == NULL) {
+        return NULL;
+    }
+
+    // Copy the key pointers to an array.
+    int n = 0;
+    void **keys;
+    if (t->frozen != NULL) {
+        n = perfect_table_size(t->frozen);
+        keys = calloc(n + 1, sizeof(*keys));
+        for (int i = 0; i < n; i++) {
+            keys[i] = perfect_table_inspect_key(t->frozen, i);
+        }
+    } else {
+        dlist_pos pos = dlist_first(t->entries);
+        while (!dlist_is_end(t->entries, pos)) {
+            n++;
+            pos = dlist_next(t->entries, pos);
+        }
+        keys = calloc(n + 1, sizeof(*keys));
+        pos = dlist_first(t->entries);
+        for (int i = 0; i < n; i++) {
+            keys[i] = ((table_entry *)dlist_inspect(t->entries, pos))->key;
+            pos = dlist_next(t->entries, pos);
+        }
+    }
+
+    // The index does not own the keys, so no kill functions are given.
+    perfect_table *index = perfect_table_create(t->key_cmp_func, t->key_hash_func,
+                                                NULL, NULL, n, keys, keys);
+    free(keys);
+    return index;
+}
+
+/**
+ * table_has_key() - Check if a key is stored in a table.
+ * @t: Table to inspect.
+ * @index: Index created by key_index_create() for t, or NULL.
+ * @key: Key to look for.
+ *
+ * Without an index, the list is scanned. A frozen table always has an
+ * index.
+ *
+ * Returns: True if the key is stored in the table, otherwise false.
+ */
+static bool table_has_key(const table *t, const perfect_table *index, const void *key)
+{
+    if (index != NULL) {
+        return perfect_table_lookup(index, key) != NULL;
+    }
+
+    unsigned long hash = table_key_hash(t, key);
+    dlist_pos pos = dlist_first(t->entries);
+    while (!dlist_is_end(t->entries, pos)) {
+        if (table_entry_matches(t, dlist_inspect(t->entries, pos), key, hash)) {
+            return true;
+        }
+        pos = dlist_next(t->entries, pos);
+    }
+    return false;
+}
+
+/**
+ * filter_keys() - Remove the pairs depending on whether their keys are in another table.
+ * @t: Table to manipulate.
+ * @other: Table to look up the keys in.
+ * @keep_found: If true, keep the pairs whose keys are in other. If
+ *              false, keep the pairs whose keys are not in other.
+ *
+ * Returns: 0 on success, -1 if t is frozen.
+ */
+static int filter_keys(table *t, const table *other, bool keep_found)
+{
+    if (t->frozen != NULL) {
+        // A frozen table cannot be modified.
+        return -1;
+    }
+    if (t == other && keep_found) {
+        // Nothing to remove.
+        return 0;
+    }
+    table_unshare(t);
+
+    // Index the keys of the other table before any key is killed.
+    perfect_table *index = key_index_create(other);
+
+    dlist_pos pos = dlist_first(t->entries);
+    while (!dlist_is_end(t->entries, pos)) {
+        table_entry *e = dlist_inspect(t->entries, pos);
+        // Every key of t is found in t itself.
+        bool found = t == other || table_has_key(other, index, e->key);
+        if (found == keep_found) {
+            pos = dlist_next(t->entries, pos);
+        } else {
+            // Kill key and/or value if given the authority to do so,
+            // unless the entry is shared with a clone.
+            if (t->key_kill_func != NULL && e->refs == 1) {
+                t->key_kill_func(e->key);
+            }
+            if (t->value_kill_func != NULL && e->refs == 1) {
+                t->value_kill_func(e->value);
+            }
+            // Remove the list element. The list kills the entry struct.
+            pos = dlist_remove(t->entries, pos);
+        }
+    }
+    if (index != NULL) {
+        perfect_table_kill(index);
+    }
+
+    return 0;
+}
+
+/**
+ * table_merge() - Move all key/value pairs from one table to another.
+ * @dst: Table to merge into.
+ * @src: Table to merge from. Empty after the call.
+ * @policy: Which pair to keep for keys found in both tables.
+ *
+ * The list may hold duplicates, and an entry shadows any later entry
+ * with the same key. The source entries are therefore moved as they
+ * are, in order, to the front of the list to replace the destination
+ * pairs, or to the end of the list to keep them. No keys are compared.
+ *
+ * Returns: 0 on success, -1 if either table is frozen.
+ */
+int table_merge(table *dst, table *src, table_merge_policy policy)
+{
+    if (dst->frozen != NULL || src->frozen != NULL) {
+        // A frozen table cannot be modified.
+        return -1;
+    }
+    if (dst == src) {
+        // Nothing to move.
+        return 0;
+    }
+    table_unshare(dst);
+    table_unshare(src);
+
+    // Find where to insert the source entries.
+    dlist_pos pos = dlist_first(dst->entries);
+    if (policy == TABLE_MERGE_KEEP_DST) {
+        while (!dlist_is_end(dst->entries, pos)) {
+            pos = dlist_next(dst->entries, pos);
+        }
+    }
+
+    // Move the entries.
+    dlist_pos src_pos = dlist_first(src->entries);
+    while (!dlist_is_empty(src->entries)) {
+        table_entry *e = dlist_inspect(src->entries, src_pos);
+        // The source list drops its reference to the entry on removal.
+        e->refs++;
+        pos = dlist_next(dst->entries, dlist_insert(dst->entries, e, pos));
+        src_pos = dlist_remove(src->entries, src_pos);
+    }
+
+    return 0;
+}
+
+/**
+ * table_intersect() - Keep only the keys that are found in another table.
+ * @t: Table to manipulate.
+ * @other: Table with the keys to keep. Not modified.
+ *
+ * Returns: 0 on success, -1 if t is frozen.
+ */
+int table_intersect(table *t, const table *other)
+{
+    return filter_keys(t, other, true);
+}
+
+/**
+ * table_difference() - Remove the keys that are found in another table.
+ * @t: Table to manipulate.
+ * @other: Table with the keys to remove. Not modified.
+ *
+ * Returns: 0 on success, -1 if t is frozen.
+ */
+int table_difference(table *t, const table *other)
+{
+    return filter_keys(t, other, false);
 }
 
 /*
@@ -252,27 +959,47 @@ void table_remove(table *t, const void *key)
  */
 void table_kill(table *t)
 {
+    (*t->shared)--;
+    if (*t->shared > 0) {
+        // The entries and frozen table are still used by a clone.
+        allocator_deallocate(t->alloc, t, sizeof(*t));
+        return;
+    }
+    allocator_deallocate(t->alloc, t->shared, sizeof(*t->shared));
+
+    if (t->frozen != NULL) {
+        perfect_table_kill(t->frozen);
+    }
+    if (t->alloc->deallocate == NULL && t->key_kill_func == NULL
+        && t->value_kill_func == NULL) {
+        // No entry, key or value is returned on its own. The memory
+        // is returned at once by the owner of the allocator.
+        return;
+    }
+
     // Iterate over the list. Destroy all elements.
     dlist_pos pos = dlist_first(t->entries);
 
     while (!dlist_is_end(t->entries, pos)) {
         // Inspect the key/value pair.
         table_entry *e = dlist_inspect(t->entries, pos);
-        // Kill key and/or value if given the authority to do so.
-        if (t->key_kill_func != NULL) {
+        // Kill key and/or value if given the authority to do so,
+        // unless the entry is shared with a clone.
+        if (t->key_kill_func != NULL && e->refs == 1) {
             t->key_kill_func(e->key);
         }
-        if (t->value_kill_func != NULL) {
+        if (t->value_kill_func != NULL && e->refs == 1) {
             t->value_kill_func(e->value);
         }
-        // Move on to next element.
-        pos = dlist_next(t->entries, pos);
+        // Remove the element. The list drops its reference to the
+        // entry, so a later duplicate of the entry is seen as the last.
+        pos = dlist_remove(t->entries, pos);
     }
 
     // Kill what's left of the list...
     dlist_kill(t->entries);
     // ...and the table struct.
-    free(t);
+    allocator_deallocate(t->alloc, t, sizeof(*t));
 }
 
 /**
@@ -287,6 +1014,11 @@ void table_kill(table *t)
  */
 void table_print(const table *t, inspect_callback_pair print_func)
 {
+    if (t->frozen != NULL) {
+        perfect_table_print(t->frozen, print_func);
+        return;
+    }
+
     // Iterate over all elements. Call print_func on keys/values.
     dlist_pos pos = dlist_first(t->entries);
 
@@ -387,15 +1119,20 @@ static void print_edge(int indent_level, const void *from, const void *to, const
 static void print_head_node(int indent_level, const table *t)
 {
     iprintf(indent_level, "m%04lx [shape=record "
-            "label=\"<e>entries\\n%04lx|cmp\\n%04lx|key_kill\\n%04lx|value_kill\\n%04lx\"]\n",
+            "label=\"<e>entries\\n%04lx|cmp\\n%04lx|hash\\n%04lx|key_kill\\n%04lx"
+            "|value_kill\\n%04lx|<f>frozen\\n%04lx\"]\n",
             PTR2ADDR(t), PTR2ADDR(t->entries), PTR2ADDR(t->key_cmp_func),
-            PTR2ADDR(t->key_kill_func), PTR2ADDR(t->value_kill_func));
+            PTR2ADDR(t->key_hash_func), PTR2ADDR(t->key_kill_func),
+            PTR2ADDR(t->value_kill_func), PTR2ADDR(t->frozen));
 }
 
 // Internal function to print the head--entries edge in dot format.
 static void print_head_edge(int indent_level, const table *t)
 {
     print_edge(indent_level, t, t->entries, "e", "entries", NULL);
+    if (t->frozen != NULL) {
+        print_edge(indent_level, t, t->frozen, "f", "frozen", NULL);
+    }
 }
 
 // Internal function to print the table entry node in dot format.
@@ -672,6 +1409,10 @@ void table_print_internal(const table *t, inspect_callback key_print_func,
         // First, ask the dlist to output its internal structure.
         dlist_print_internal(t->entries, NULL, NULL, il);
     }
+    if (t->frozen != NULL) {
+        // Ditto for the frozen table.
+        perfect_table_print_internal(t->frozen, NULL, NULL, NULL, il);
+    }
 
     // Close the subgraph
     il--;
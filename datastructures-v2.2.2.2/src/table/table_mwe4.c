@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <table.h>
+
+/*
+ * Minimum working example of the ordered table queries. Inserts a
+ * number of (postal code, town) pairs into a table, including one
+ * duplicate, and lists the smallest and largest postal codes, the
+ * closest postal codes around a missing one, and all postal codes in
+ * an interval. The table is responsible for deallocating the keys and
+ * values.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+// Create a dynamic copy of the string str.
+char* string_copy(const char *str)
+{
+    // Use calloc to ensure a '\0' termination.
+    char *copy = calloc(strlen(str) + 1, sizeof(*copy));
+    strcpy(copy, str);
+    return copy;
+}
+
+// Create a dynamic copy of the integer i.
+int *int_create(int i)
+{
+    // Allocate memory for an integer and set the value
+    int *v = malloc(sizeof(*v));
+    *v = i;
+    return v;
+}
+
+// Interpret the supplied key and value pointers and print their content.
+void print_int_string_pair(const void *key, const void *value)
+{
+    const int *k=key;
+    const char *s=value;
+    printf("[%d, %s]\n", *k, s);
+}
+
+// Compare two keys (int *).
+int compare_ints(const void *k1, const void *k2)
+{
+    int key1 = *(int *)k1;
+    int key2 = *(int *)k2;
+
+    if ( key1 == key2 )
+        return 0;
+    if ( key1 < key2 )
+        return -1;
+    return 1;
+}
+
+// Print a key that may be NULL.
+void print_key(const char *label, const int *key)
+{
+    if (key == NULL) {
+        printf("%s: none.\n", label);
+    } else {
+        printf("%s: %d.\n", label, *key);
+    }
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Ordered queries on an (integer, string) table.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    // Hand over the deallocation responsibility to the table.
+    table *t = table_empty(compare_ints, free, free);
+
+    table_insert(t, int_create(90187), string_copy("Umea"));
+    table_insert(t, int_create(98185), string_copy("Kiruna"));
+    table_insert(t, int_create(11120), string_copy("Stockholm"));
+    table_insert(t, int_create(90184), string_copy("Umea"));
+    table_insert(t, int_create(41296), string_copy("Goteborg"));
+    table_insert(t, int_create(90187), string_copy("Umea (Universitet)"));
+
+    print_key("Smallest postal code", table_min(t));
+    print_key("Largest postal code", table_max(t));
+
+    int v = 90000;
+    printf("Postal code %d is not in the table.\n", v);
+    print_key("Closest postal code below", table_floor(t, &v));
+    print_key("Closest postal code above", table_ceiling(t, &v));
+
+    int lo = 41000;
+    int hi = 90187;
+    printf("Pairs with postal codes in [%d, %d]:\n", lo, hi);
+    table_range(t, &lo, &hi, print_int_string_pair);
+
+    // Kill the table, including the keys and values.
+    table_kill(t);
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
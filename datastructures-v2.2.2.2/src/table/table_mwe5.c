@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <table.h>
+
+/*
+ * Minimum working example of prefix scans. Inserts a number of
+ * (hierarchical identifier, description) pairs into a table and lists
+ * all pairs below a few nodes of the hierarchy. The table is
+ * responsible for deallocating the keys and values.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+// Create a dynamic copy of the string str.
+char* string_copy(const char *str)
+{
+    // Use calloc to ensure a '\0' termination.
+    char *copy = calloc(strlen(str) + 1, sizeof(*copy));
+    strcpy(copy, str);
+    return copy;
+}
+
+// Interpret the supplied key and value pointers and print their content.
+void print_string_string_pair(const void *key, const void *value)
+{
+    const char *k=key;
+    const char *s=value;
+    printf("[%s, %s]\n", k, s);
+}
+
+// Compare two keys (char *).
+int compare_strings(const void *k1, const void *k2)
+{
+    return strcmp(k1, k2);
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Prefix scans on a (string, string) table.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    // Hand over the deallocation responsibility to the table.
+    table *t = table_empty(compare_strings, free, free);
+
+    table_insert(t, string_copy("se/umu/cs/doa"), string_copy("Datastrukturer och algoritmer"));
+    table_insert(t, string_copy("se/umu"), string_copy("Umea universitet"));
+    table_insert(t, string_copy("se/umu/cs"), string_copy("Datavetenskap"));
+    table_insert(t, string_copy("se/kth/eecs"), string_copy("Elektroteknik och datavetenskap"));
+    table_insert(t, string_copy("se/umu/cs/ou3"), string_copy("Obligatorisk uppgift 3"));
+    table_insert(t, string_copy("se/umu/math"), string_copy("Matematik"));
+
+    const char *prefixes[] = { "se/umu/cs/", "se/umu/", "se/k", "no/" };
+    for (int i = 0; i < 4; i++) {
+        printf("Pairs with keys starting with %s:\n", prefixes[i]);
+        table_prefix_scan(t, prefixes[i], print_string_string_pair);
+    }
+
+    // Kill the table, including the keys and values.
+    table_kill(t);
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <table.h>
+
+/*
+ * Minimum working example of a table with a user-supplied allocator.
+ * The allocator counts the number of blocks and bytes that the table
+ * uses. The table is filled, cloned and emptied, and the counters are
+ * printed after each step. After table_kill, no memory should remain
+ * in use. The keys and values are stored on the stack.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+// Counters of the allocator.
+typedef struct counters {
+    long blocks; // Number of blocks in use
+    long bytes;  // Number of bytes in use
+    long peak;   // Largest number of bytes in use
+} counters;
+
+// Allocate zeroed memory and count it.
+void *counting_allocate(void *context, size_t size)
+{
+    counters *c = context;
+    c->blocks++;
+    c->bytes += size;
+    if (c->bytes > c->peak) {
+        c->peak = c->bytes;
+    }
+    return calloc(1, size);
+}
+
+// Deallocate memory and count it.
+void counting_deallocate(void *context, void *p, size_t size)
+{
+    counters *c = context;
+    c->blocks--;
+    c->bytes -= size;
+    free(p);
+}
+
+// Compare two keys (int *).
+int compare_ints(const void *k1, const void *k2)
+{
+    int key1 = *(const int *)k1;
+    int key2 = *(const int *)k2;
+
+    if (key1 == key2) {
+        return 0;
+    }
+    if (key1 < key2) {
+        return -1;
+    }
+    return 1;
+}
+
+// Print the counters of the allocator after a given step.
+void print_counters(const char *step, const counters *c)
+{
+    printf("%-24s %4ld blocks, %6ld bytes in use, peak %6ld bytes.\n",
+           step, c->blocks, c->bytes, c->peak);
+}
+
+#define N 100
+
+int main(void)
+{
+    printf("%s, %s %s: Table with a counting allocator.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    counters c = { 0, 0, 0 };
+    allocator a = { counting_allocate, counting_deallocate, &c };
+
+    int keys[N];
+    int values[N];
+
+    // The keys and values are on the stack, so no kill functions.
+    table *t = table_empty_with_allocator(compare_ints, NULL, TABLE_KEY_INT, NULL, NULL, &a);
+    print_counters("Empty table:", &c);
+
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+        values[i] = i * i;
+        table_insert(t, &keys[i], &values[i]);
+    }
+    print_counters("After inserts:", &c);
+
+    // The clone shares the pairs with t and uses the same allocator.
+    table *clone = table_clone(t);
+    for (int i = 0; i < N; i += 2) {
+        table_remove(t, &keys[i]);
+    }
+    print_counters("After clone and removes:", &c);
+
+    table_kill(clone);
+    print_counters("After killing the clone:", &c);
+
+    table_kill(t);
+    print_counters("After killing the table:", &c);
+
+    if (c.blocks != 0 || c.bytes != 0) {
+        fprintf(stderr, "Memory leak: %ld blocks, %ld bytes.\n", c.blocks, c.bytes);
+        return EXIT_FAILURE;
+    }
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
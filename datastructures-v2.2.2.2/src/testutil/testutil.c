@@ -0,0 +1,84 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "testutil.h"
+
+/*
+ * Implementation of the helpers shared by the test programs of the
+ * modules of the "Datastructures and algorithms" courses at the
+ * Department of Computing Science, Umea University.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: Moved from ou3 to src/testutil, next to the
+ *                     benchmark harness.
+ */
+
+unsigned long get_microseconds(void)
+{
+    return (unsigned long)(bench_nanoseconds() / 1000);
+}
+
+int *int_ptr_from_int(int i)
+{
+    // Allocate memory for a dynamic copy of an integer
+    int *ip=malloc(sizeof(int));
+    // Copy the value
+    *ip=i;
+    return ip;
+}
+
+int int_compare(const void *ip1, const void *ip2)
+{
+    const int *n1=ip1;
+    const int *n2=ip2;
+    return (*n1 > *n2) - (*n1 < *n2);
+}
+
+unsigned long int_hash(const void *ip)
+{
+    const int *n=ip;
+    return (unsigned long)(unsigned int)*n * 2654435761UL;
+}
+
+bool is_zero(const unsigned char *p, size_t n)
+{
+    for(size_t i=0;i<n;i++) {
+        if (p[i]!=0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void check_allocations(const allocator *alloc, const size_t *sizes, int count,
+                       unsigned char **blocks, int round)
+{
+    for(int i=0;i<3*count;i++) {
+        size_t size=sizes[i%count];
+        blocks[i]=alloc->allocate(alloc->context,size);
+        if (blocks[i]==NULL || (uintptr_t)blocks[i]%16!=0) {
+            printf("Allocation of %zu bytes is not aligned.\n",size);
+            exit(EXIT_FAILURE);
+        }
+        if (!is_zero(blocks[i],size)) {
+            printf("Allocation of %zu bytes is not "
+                   "zero-initialized in round %d.\n",size,round);
+            exit(EXIT_FAILURE);
+        }
+        // Fill the memory, so that an overlap or a missing
+        // clear on reuse is detected.
+        memset(blocks[i],i+1,size);
+    }
+    for(int i=0;i<3*count;i++) {
+        for(size_t j=0;j<sizes[i%count];j++) {
+            if (blocks[i][j]!=i+1) {
+                printf("Allocations %d and %d overlap.\n",i,blocks[i][j]-1);
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+}
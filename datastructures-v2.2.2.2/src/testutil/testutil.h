@@ -0,0 +1,87 @@
+#ifndef __TESTUTIL_H
+#define __TESTUTIL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "util.h"
+
+/*
+ * Declaration of the helpers shared by the test programs of the
+ * modules, e.g. cache/cache_test.c and arena/arena_test.c, of the
+ * "Datastructures and algorithms" courses at the Department of
+ * Computing Science, Umea University.
+ *
+ * The programs are linked with testutil.c and with the benchmark
+ * harness ../bench/bench.c, whose monotonic clock is used for the
+ * timing, and with -lm.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: Moved from ou3 to src/testutil, next to the
+ *                     benchmark harness.
+ */
+
+/**
+ * get_microseconds() - Return the time of the monotonic clock in microseconds.
+ *
+ * Unlike the time of day, the monotonic clock is not adjusted while a
+ * program runs, so the difference of two calls is an elapsed time.
+ *
+ * Returns: The time of the monotonic clock in microseconds.
+ */
+unsigned long get_microseconds(void);
+
+/**
+ * int_ptr_from_int() - Create a dynamic copy of an integer.
+ * @i: Integer to be copied.
+ *
+ * Returns: Pointer to the copy of i, to be deallocated with free.
+ */
+int *int_ptr_from_int(int i);
+
+/**
+ * int_compare() - Compare two integers via pointers.
+ * @ip1, @ip2: Pointers to the integers to be compared.
+ *
+ * Returns: A negative, zero or positive value as for strcmp.
+ */
+int int_compare(const void *ip1, const void *ip2);
+
+/**
+ * int_hash() - Hash an integer via a pointer.
+ * @ip: Pointer to the integer to be hashed.
+ *
+ * Returns: The integer multiplied by a large odd constant, so that
+ * consecutive integers differ in their high bits as well.
+ */
+unsigned long int_hash(const void *ip);
+
+/**
+ * is_zero() - Check if memory is zero.
+ * @p: The memory.
+ * @n: The number of bytes.
+ *
+ * Returns: True if the n bytes starting at p are all zero.
+ */
+bool is_zero(const unsigned char *p, size_t n);
+
+/**
+ * check_allocations() - Check a round of allocations from an allocator.
+ * @alloc: The allocator.
+ * @sizes: The sizes of the blocks.
+ * @count: The number of sizes.
+ * @blocks: Output array for the 3 * count blocks.
+ * @round: The number of the round, for the error messages.
+ *
+ * Three blocks of each size are allocated, and it is checked that
+ * they are aligned to 16 bytes, zero-initialized and separate. The
+ * blocks are left filled with non-zero bytes, so that a missing clear
+ * on reuse is detected in the next round. The program exits if any
+ * check fails.
+ *
+ * Returns: Nothing.
+ */
+void check_allocations(const allocator *alloc, const size_t *sizes, int count,
+                       unsigned char **blocks, int round);
+
+#endif
@@ -0,0 +1,872 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <limits.h>
+
+#include <ttltable.h>
+
+/*
+ * Implementation of a generic table with expiring pairs for the
+ * "Datastructures and algorithms" courses at the Department of
+ * Computing Science, Umea University.
+ *
+ * Each key/value pair is stored in an entry. All entries are linked
+ * into a hash index, i.e. an array of buckets where each bucket is a
+ * singly linked chain of entries. The number of buckets is a power of
+ * two that is doubled when the table holds more entries than buckets.
+ *
+ * The expiry times are kept in a hierarchical timing wheel. The wheel
+ * has WHEEL_LEVELS levels of WHEEL_SIZE slots each, and each slot is a
+ * circular doubly linked list of entries with a head cell, as in
+ * dlist.c. Level 0 has one slot per tick and holds the entries that
+ * expire within WHEEL_SIZE ticks, in slot (expiry mod WHEEL_SIZE).
+ * Each slot on level 1 covers WHEEL_SIZE ticks, each slot on level 2
+ * covers WHEEL_SIZE^2 ticks, etc. An entry that expires further away
+ * is put in the level where its expiry time fits.
+ *
+ * When the clock is advanced one tick, the entries in the level 0
+ * slot of the new time expire. Every WHEEL_SIZE ticks, when the level
+ * 0 slot index wraps around to 0, the next slot on level 1 is emptied
+ * and its entries are moved ("cascaded") to level 0, and likewise for
+ * the higher levels. An entry that expires within the 2^24 ticks of
+ * the wheel is thus moved at most WHEEL_LEVELS - 1 times before it
+ * expires, which gives O(1) amortized time per entry without ever
+ * scanning the entries that are not about to expire. Entries beyond
+ * the range of the top level are put in its last slot and cascaded
+ * again about every 2^24 ticks until their expiry time is within
+ * range, so they are moved O(TTL / 2^24) times.
+ *
+ * The clock is not advanced one tick at a time, but jumps directly to
+ * the next tick that either expires the entries of a level 0 slot or
+ * cascades a slot that holds entries. Ticks without any work are
+ * skipped, so a long advance of a table with few entries is cheap.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ *   v1.1  2026-10-18: ttltable_advance_time skips the ticks without work.
+ */
+
+// The number of bits of the time used by each level of the wheel.
+#define WHEEL_BITS 6
+// The number of slots on each level.
+#define WHEEL_SIZE (1 << WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SIZE - 1)
+// The number of levels, i.e. the wheel covers 2^24 ticks.
+#define WHEEL_LEVELS 4
+
+// ===========INTERNAL DATA TYPES ============
+
+typedef struct ttl_entry {
+    struct ttl_entry *prev;  // Previous entry in the same wheel slot
+    struct ttl_entry *next;  // Next entry in the same wheel slot
+    struct ttl_entry *chain; // Next entry in the same bucket
+    void *key;
+    void *value;
+    unsigned long hash;      // Cached hash of the key
+    unsigned long expiry;    // The time when the pair expires
+} ttl_entry;
+
+struct ttltable {
+    int size;              // Number of entries
+    int bucket_count;      // Number of buckets, a power of two
+    ttl_entry **buckets;   // Chains of entries with the same bucket
+    unsigned long now;     // The current time of the clock
+    ttl_entry wheel[WHEEL_LEVELS][WHEEL_SIZE]; // Head cells of the slots
+    compare_function *key_cmp_func;
+    hash_function *key_hash_func;
+    kill_function key_kill_func;
+    kill_function value_kill_func;
+    inspect_callback_pair expire_func; // Called for expired pairs, or NULL
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * mix() - Scramble the bits of a 64-bit value.
+ * @x: Value to scramble.
+ *
+ * Uses the finalizer of the splitmix64 generator, so that the low
+ * bits used to select a bucket depend on all bits of the hash.
+ *
+ * Returns: The scrambled value.
+ */
+static unsigned long long mix(unsigned long long x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Internal function to return the bucket chain of a hash value.
+static ttl_entry **bucket_of(const ttltable *t, unsigned long hash)
+{
+    return &t->buckets[mix(hash) & (t->bucket_count - 1)];
+}
+
+/**
+ * find_link() - Find the link to the entry with a given key.
+ * @t: Table to inspect.
+ * @key: Key to look for.
+ *
+ * Returns: A pointer to the link in the bucket chain that points to
+ * the entry with the key, or to the NULL link ending the chain if the
+ * key is not found.
+ */
+static ttl_entry **find_link(const ttltable *t, const void *key)
+{
+    unsigned long hash = t->key_hash_func(key);
+    ttl_entry **link = bucket_of(t, hash);
+    while (*link != NULL) {
+        ttl_entry *e = *link;
+        if (e->hash == hash && t->key_cmp_func(e->key, key) == 0) {
+            break;
+        }
+        link = &e->chain;
+    }
+    return link;
+}
+
+// Internal function to find the link to a given entry in its bucket chain.
+static ttl_entry **entry_link(const ttltable *t, const ttl_entry *e)
+{
+    ttl_entry **link = bucket_of(t, e->hash);
+    while (*link != e) {
+        link = &(*link)->chain;
+    }
+    return link;
+}
+
+/**
+ * grow() - Double the number of buckets of a table.
+ * @t: Table to manipulate.
+ *
+ * The entries are moved to their new buckets. The order within a
+ * chain is not preserved.
+ *
+ * Returns: Nothing.
+ */
+static void grow(ttltable *t)
+{
+    ttl_entry **old_buckets = t->buckets;
+    int old_count = t->bucket_count;
+
+    t->bucket_count *= 2;
+    t->buckets = calloc(t->bucket_count, sizeof(*t->buckets));
+    for (int i = 0; i < old_count; i++) {
+        while (old_buckets[i] != NULL) {
+            ttl_entry *e = old_buckets[i];
+            old_buckets[i] = e->chain;
+            ttl_entry **bucket = bucket_of(t, e->hash);
+            e->chain = *bucket;
+            *bucket = e;
+        }
+    }
+    free(old_buckets);
+}
+
+// Internal function to unlink an entry from its wheel slot.
+static void wheel_unlink(ttl_entry *e)
+{
+    e->prev->next = e->next;
+    e->next->prev = e->prev;
+}
+
+/**
+ * wheel_link() - Put an entry in the wheel slot of its expiry time.
+ * @t: Table to manipulate.
+ * @e: Entry to put. Its expiry time must not be before the current time.
+ *
+ * The entry is linked last in the slot.
+ *
+ * Returns: Nothing.
+ */
+static void wheel_link(ttltable *t, ttl_entry *e)
+{
+    unsigned long delta = e->expiry - t->now;
+    unsigned long expiry = e->expiry;
+    int level = 0;
+
+    // Find the lowest level whose range covers the expiry time...
+    while (level < WHEEL_LEVELS - 1
+           && delta >= 1UL << ((level + 1) * WHEEL_BITS)) {
+        level++;
+    }
+    // ...where times beyond the top level are put in its last slot.
+    if (delta >= 1UL << (WHEEL_LEVELS * WHEEL_BITS)) {
+        expiry = t->now + (1UL << (WHEEL_LEVELS * WHEEL_BITS)) - 1;
+    }
+    ttl_entry *head = &t->wheel[level][(expiry >> (level * WHEEL_BITS)) & WHEEL_MASK];
+
+    e->next = head;
+    e->prev = head->prev;
+    head->prev->next = e;
+    head->prev = e;
+}
+
+/**
+ * cascade() - Move the entries of a wheel slot to lower levels.
+ * @t: Table to manipulate.
+ * @level: The level of the slot, at least 1.
+ * @index: The index of the slot.
+ *
+ * Returns: Nothing.
+ */
+static void cascade(ttltable *t, int level, int index)
+{
+    ttl_entry *head = &t->wheel[level][index];
+    if (head->next == head) {
+        return;
+    }
+
+    // Detach the list before the entries are linked again, since an
+    // entry beyond the range of the wheel may return to the top level.
+    ttl_entry *e = head->next;
+    head->prev->next = NULL;
+    head->next = head;
+    head->prev = head;
+    while (e != NULL) {
+        ttl_entry *next = e->next;
+        wheel_link(t, e);
+        e = next;
+    }
+}
+
+/**
+ * next_event() - Return the number of ticks to the next tick with work.
+ * @t: Table to inspect. Must not be empty.
+ *
+ * A tick has work if it expires the entries of a level 0 slot, or if
+ * it cascades a slot that holds entries. The level 0 slots hold the
+ * entries that expire within WHEEL_SIZE ticks, and the slots of level
+ * L are cascaded at the next WHEEL_SIZE multiples of WHEEL_SIZE^L, so
+ * at most WHEEL_SIZE slots are checked on each level.
+ *
+ * Returns: The number of ticks from the current time to the next tick
+ * with work, at least 1.
+ */
+static unsigned long next_event(const ttltable *t)
+{
+    unsigned long best = ULONG_MAX;
+
+    // The first occupied level 0 slot after the current time...
+    for (unsigned long d = 1; d < WHEEL_SIZE; d++) {
+        const ttl_entry *head = &t->wheel[0][(t->now + d) & WHEEL_MASK];
+        if (head->next != head) {
+            best = d;
+            break;
+        }
+    }
+    // ...or the first cascade of an occupied slot on a higher level.
+    for (int level = 1; level < WHEEL_LEVELS; level++) {
+        int shift = level * WHEEL_BITS;
+        unsigned long base = t->now >> shift;
+        for (unsigned long j = 1; j <= WHEEL_SIZE; j++) {
+            unsigned long d = ((base + j) << shift) - t->now;
+            if (d >= best) {
+                break;
+            }
+            const ttl_entry *head = &t->wheel[level][(base + j) & WHEEL_MASK];
+            if (head->next != head) {
+                best = d;
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * remove_entry() - Remove an entry from a table.
+ * @t: Table to manipulate.
+ * @e: Entry to remove.
+ * @expired: If true, call the expire callback before the kill functions.
+ *
+ * Returns: Nothing.
+ */
+static void remove_entry(ttltable *t, ttl_entry *e, bool expired)
+{
+    ttl_entry **link = entry_link(t, e);
+    *link = e->chain;
+    wheel_unlink(e);
+
+    if (expired && t->expire_func != NULL) {
+        t->expire_func(e->key, e->value);
+    }
+    if (t->key_kill_func != NULL) {
+        t->key_kill_func(e->key);
+    }
+    if (t->value_kill_func != NULL) {
+        t->value_kill_func(e->value);
+    }
+    free(e);
+    t->size--;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS ============
+
+/**
+ * ttltable_empty() - Create an empty table with expiring pairs.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function to be used to hash keys.
+ * @key_kill_func: A pointer to a function (or NULL) to be called to
+ *                 de-allocate memory for keys on remove/expire/kill.
+ * @value_kill_func: A pointer to a function (or NULL) to be called to
+ *                   de-allocate memory for values on remove/expire/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+ttltable *ttltable_empty(compare_function *key_cmp_func,
+                         hash_function *key_hash_func,
+                         kill_function key_kill_func,
+                         kill_function value_kill_func)
+{
+    // Allocate the table header.
+    ttltable *t = calloc(1, sizeof(*t));
+
+    // Start with a few buckets, doubled as the table grows.
+    t->bucket_count = 8;
+    t->buckets = calloc(t->bucket_count, sizeof(*t->buckets));
+
+    // All slots are initially empty, i.e. the heads link to themselves.
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        for (int i = 0; i < WHEEL_SIZE; i++) {
+            t->wheel[level][i].prev = &t->wheel[level][i];
+            t->wheel[level][i].next = &t->wheel[level][i];
+        }
+    }
+
+    // Store the key compare/hash functions and key/value kill functions.
+    t->key_cmp_func = key_cmp_func;
+    t->key_hash_func = key_hash_func;
+    t->key_kill_func = key_kill_func;
+    t->value_kill_func = value_kill_func;
+
+    return t;
+}
+
+/**
+ * ttltable_set_expire_callback() - Register a function to call on expiry.
+ * @t: Table to manipulate.
+ * @expire_func: Function (or NULL) called with the key and value of
+ *               each expired pair.
+ *
+ * Returns: Nothing.
+ */
+void ttltable_set_expire_callback(ttltable *t, inspect_callback_pair expire_func)
+{
+    t->expire_func = expire_func;
+}
+
+/**
+ * ttltable_is_empty() - Check if a table is empty.
+ * @t: Table to check.
+ *
+ * Returns: True if the table contains no key/value pairs, false otherwise.
+ */
+bool ttltable_is_empty(const ttltable *t)
+{
+    return t->size == 0;
+}
+
+/**
+ * ttltable_size() - Return the number of key/value pairs in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The number of pairs that have not expired.
+ */
+int ttltable_size(const ttltable *t)
+{
+    return t->size;
+}
+
+/**
+ * ttltable_insert() - Add a key/value pair with a time to live to a table.
+ * @t: Table to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ * @ttl: The number of ticks until the pair expires.
+ *
+ * Returns: 0 on success, -1 if ttl is 0.
+ */
+int ttltable_insert(ttltable *t, void *key, void *value, unsigned long ttl)
+{
+    if (ttl == 0) {
+        return -1;
+    }
+    ttl_entry *e = *find_link(t, key);
+
+    if (e != NULL) {
+        // Duplicate. Kill the old pair unless the memory is reused.
+        if (t->key_kill_func != NULL && e->key != key) {
+            t->key_kill_func(e->key);
+        }
+        if (t->value_kill_func != NULL && e->value != value) {
+            t->value_kill_func(e->value);
+        }
+        wheel_unlink(e);
+    } else {
+        // Link a new entry first in its bucket chain.
+        if (t->size == t->bucket_count) {
+            grow(t);
+        }
+        e = calloc(1, sizeof(*e));
+        e->hash = t->key_hash_func(key);
+        ttl_entry **bucket = bucket_of(t, e->hash);
+        e->chain = *bucket;
+        *bucket = e;
+        t->size++;
+    }
+    e->key = key;
+    e->value = value;
+    e->expiry = t->now + ttl;
+    wheel_link(t, e);
+
+    return 0;
+}
+
+/**
+ * ttltable_lookup() - Look up a given key in a table.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to the key, or NULL if the key is
+ * not found in the table or has expired.
+ */
+void *ttltable_lookup(const ttltable *t, const void *key)
+{
+    ttl_entry *e = *find_link(t, key);
+    return e == NULL ? NULL : e->value;
+}
+
+/**
+ * ttltable_time_left() - Return the time left before a pair expires.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The number of ticks until the pair with the given key
+ * expires, or 0 if the key is not found in the table.
+ */
+unsigned long ttltable_time_left(const ttltable *t, const void *key)
+{
+    ttl_entry *e = *find_link(t, key);
+    return e == NULL ? 0 : e->expiry - t->now;
+}
+
+/**
+ * ttltable_remove() - Remove a key/value pair from a table.
+ * @t: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Returns: Nothing.
+ */
+void ttltable_remove(ttltable *t, const void *key)
+{
+    ttl_entry *e = *find_link(t, key);
+    if (e != NULL) {
+        remove_entry(t, e, false);
+    }
+}
+
+/**
+ * ttltable_now() - Return the time of the clock of a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The number of ticks the clock has been advanced since the
+ * table was created.
+ */
+unsigned long ttltable_now(const ttltable *t)
+{
+    return t->now;
+}
+
+/**
+ * ttltable_advance_time() - Advance the clock of a table.
+ * @t: Table to manipulate.
+ * @ticks: The number of ticks to advance the clock.
+ *
+ * Returns: The number of expired pairs.
+ */
+int ttltable_advance_time(ttltable *t, unsigned long ticks)
+{
+    int expired = 0;
+
+    while (ticks > 0) {
+        // Jump to the next tick with work, if it is within the advance.
+        unsigned long step = t->size == 0 ? ULONG_MAX : next_event(t);
+        if (step > ticks) {
+            // No slot is expired or cascaded before the new time.
+            t->now += ticks;
+            break;
+        }
+        t->now += step;
+        ticks -= step;
+
+        // Cascade from each level whose lower level wrapped around.
+        int index = t->now & WHEEL_MASK;
+        for (int level = 1; index == 0 && level < WHEEL_LEVELS; level++) {
+            index = (t->now >> (level * WHEEL_BITS)) & WHEEL_MASK;
+            cascade(t, level, index);
+        }
+
+        // Expire the entries in the level 0 slot of the new time.
+        ttl_entry *head = &t->wheel[0][t->now & WHEEL_MASK];
+        while (head->next != head) {
+            remove_entry(t, head->next, true);
+            expired++;
+        }
+    }
+    return expired;
+}
+
+/**
+ * ttltable_kill() - Destroy a table.
+ * @t: Table to destroy.
+ *
+ * Returns: Nothing.
+ */
+void ttltable_kill(ttltable *t)
+{
+    for (int i = 0; i < t->bucket_count; i++) {
+        while (t->buckets[i] != NULL) {
+            ttl_entry *e = t->buckets[i];
+            t->buckets[i] = e->chain;
+            if (t->key_kill_func != NULL) {
+                t->key_kill_func(e->key);
+            }
+            if (t->value_kill_func != NULL) {
+                t->value_kill_func(e->value);
+            }
+            free(e);
+        }
+    }
+    free(t->buckets);
+    free(t);
+}
+
+/**
+ * ttltable_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Returns: Nothing.
+ */
+void ttltable_print(const ttltable *t, inspect_callback_pair print_func)
+{
+    for (int i = 0; i < t->bucket_count; i++) {
+        for (const ttl_entry *e = t->buckets[i]; e != NULL; e = e->chain) {
+            print_func(e->key, e->value);
+        }
+    }
+}
+
+// ===========INTERNAL FUNCTIONS USED BY ttltable_print_internal ============
+
+// The functions below output code in the dot language, used by
+// GraphViz. For documention of the dot language, see graphviz.org.
+
+/**
+ * indent() - Output indentation string.
+ * @n: Indentation level.
+ *
+ * Print n tab characters.
+ *
+ * Returns: Nothing.
+ */
+static void indent(int n)
+{
+    for (int i=0; i<n; i++) {
+        printf("\t");
+    }
+}
+
+/**
+ * iprintf(...) - Indent and print.
+ * @n: Indentation level
+ * @...: printf arguments
+ *
+ * Print n tab characters and calls printf.
+ *
+ * Returns: Nothing.
+ */
+static void iprintf(int n, const char *fmt, ...)
+{
+    // Indent...
+    indent(n);
+    // ...and call printf
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * print_edge() - Print a edge between two addresses.
+ * @from: The address of the start of the edge. Should be non-NULL.
+ * @to: The address of the destination for the edge, including NULL.
+ * @port: The name of the port on the source node, or NULL.
+ * @label: The label for the edge, or NULL.
+ * @options: A string with other edge options, or NULL.
+ *
+ * Print an edge from port PORT on node FROM to TO with label
+ * LABEL. If to is NULL, the destination is the NULL node, otherwise a
+ * memory node. If the port is NULL, the edge starts at the node, not
+ * a specific port on it. If label is NULL, no label is used. The
+ * options string, if non-NULL, is printed before the label.
+ *
+ * Returns: Nothing.
+ */
+static void print_edge(int indent_level, const void *from, const void *to, const char *port,
+                       const char *label, const char *options)
+{
+    indent(indent_level);
+    if (port) {
+        printf("m%04lx:%s -> ", PTR2ADDR(from), port);
+    } else {
+        printf("m%04lx -> ", PTR2ADDR(from));
+    }
+    if (to == NULL) {
+        printf("NULL");
+    } else {
+        printf("m%04lx", PTR2ADDR(to));
+    }
+    printf(" [");
+    if (options != NULL) {
+        printf("%s", options);
+    }
+    if (label != NULL) {
+        printf(" label=\"%s\"",label);
+    }
+    printf("]\n");
+}
+
+// Internal function to print the head node in dot format.
+static void print_head_node(int indent_level, const ttltable *t)
+{
+    iprintf(indent_level, "m%04lx [shape=record "
+            "label=\"size\\n%d|<b>buckets\\n%04lx|now\\n%lu", PTR2ADDR(t), t->size,
+            PTR2ADDR(t->buckets), t->now);
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        printf("|<w%d>wheel[%d]\\n%04lx", level, level, PTR2ADDR(t->wheel[level]));
+    }
+    printf("\"]\n");
+}
+
+// Internal function to print the bucket array in dot format.
+static void print_buckets(int indent_level, const ttltable *t)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"", PTR2ADDR(t->buckets));
+    for (int i = 0; i < t->bucket_count; i++) {
+        printf("<%02d>%02d\\n%04lx", i, i, PTR2ADDR(t->buckets[i]));
+        if (i < t->bucket_count - 1) {
+            printf("|");
+        }
+    }
+    printf("\"]\n");
+}
+
+// Internal function to print a level of the wheel in dot format. Only
+// the non-empty slots are shown.
+static void print_wheel_level(int indent_level, const ttltable *t, int level)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"level\\n%d",
+            PTR2ADDR(t->wheel[level]), level);
+    for (int i = 0; i < WHEEL_SIZE; i++) {
+        const ttl_entry *head = &t->wheel[level][i];
+        if (head->next != head) {
+            printf("|<%02d>%02d\\n%04lx", i, i, PTR2ADDR(head->next));
+        }
+    }
+    printf("\"]\n");
+}
+
+// Internal function to print an entry node in dot format.
+static void print_entry_node(int indent_level, const ttl_entry *e)
+{
+    iprintf(indent_level, "m%04lx [shape=record label=\"<p>prev\\n%04lx|<n>next\\n%04lx"
+            "|<c>chain\\n%04lx|<k>key\\n%04lx|<v>value\\n%04lx|expiry\\n%lu\"]\n",
+            PTR2ADDR(e), PTR2ADDR(e->prev), PTR2ADDR(e->next), PTR2ADDR(e->chain),
+            PTR2ADDR(e->key), PTR2ADDR(e->value), e->expiry);
+}
+
+// Internal function to print a key or value node in dot format.
+static void print_payload_node(int indent_level, const void *p, inspect_callback print_func)
+{
+    iprintf(indent_level, "m%04lx [label=\"", PTR2ADDR(p));
+    if (print_func != NULL) {
+        print_func(p);
+    }
+    printf("\" xlabel=\"%04lx\"]\n", PTR2ADDR(p));
+}
+
+// Internal function to return the node to draw a slot link to. The
+// head cell of a slot is part of the node of its level.
+static const void *slot_link_node(const ttltable *t, const ttl_entry *p)
+{
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        if (p >= t->wheel[level] && p < t->wheel[level] + WHEEL_SIZE) {
+            return t->wheel[level];
+        }
+    }
+    return p;
+}
+
+// Create an escaped version of the input string. The most common
+// control characters - newline, horizontal tab, backslash, and double
+// quote - are replaced by their escape sequence. The returned pointer
+// must be deallocated by the caller.
+static char *escape_chars(const char *s)
+{
+    int i, j;
+    int escaped = 0; // The number of chars that must be escaped.
+
+    // Count how many chars need to be escaped, i.e. how much longer
+    // the output string will be.
+    for (i = escaped = 0; s[i] != '\0'; i++) {
+        if (s[i] == '\n' || s[i] == '\t' || s[i] == '\\' || s[i] == '\"') {
+            escaped++;
+        }
+    }
+    // Allocate space for the escaped string. The variable i holds the input
+    // length, escaped how much the string will grow.
+    char *t = malloc(i + escaped + 1);
+
+    // Copy-and-escape loop
+    for (i = j = 0; s[i] != '\0'; i++) {
+        // Convert each control character by its escape sequence.
+        // Non-control characters are copied as-is.
+        switch (s[i]) {
+        case '\n': t[i+j] = '\\'; t[i+j+1] = 'n';  j++; break;
+        case '\t': t[i+j] = '\\'; t[i+j+1] = 't';  j++; break;
+        case '\\': t[i+j] = '\\'; t[i+j+1] = '\\'; j++; break;
+        case '\"': t[i+j] = '\\'; t[i+j+1] = '\"'; j++; break;
+        default:   t[i+j] = s[i]; break;
+        }
+    }
+    // Terminal the output string
+    t[i+j] = '\0';
+    return t;
+}
+
+/**
+ * ttltable_print_internal() - Output the internal structure of the table.
+ * @t: Table to print.
+ * @key_print_func: Function called for each key in the table.
+ * @value_print_func: Function called for each value in the table.
+ * @desc: String with a description/state of the table.
+ * @indent_level: Indentation level, 0 for outermost
+ *
+ * Iterates over the table and prints code that shows its' internal structure.
+ *
+ * Returns: Nothing.
+ */
+void ttltable_print_internal(const ttltable *t, inspect_callback key_print_func,
+                             inspect_callback value_print_func, const char *desc,
+                             int indent_level)
+{
+    static int graph_number = 0;
+    graph_number++;
+    int il = indent_level;
+
+    if (indent_level == 0) {
+        // If this is the outermost datatype, start a graph and set up defaults
+        printf("digraph TTLTABLE_%d {\n", graph_number);
+
+        // Specify default shape and fontname
+        il++;
+        iprintf(il, "node [shape=rectangle fontname=\"Courier New\"]\n");
+        iprintf(il, "ranksep=0.01\n");
+        iprintf(il, "subgraph cluster_nullspace {\n");
+        iprintf(il+1, "NULL\n");
+        iprintf(il, "}\n");
+    }
+
+    if (desc != NULL) {
+        // Escape the string before printout
+        char *escaped = escape_chars(desc);
+        // Use different names on inner description nodes
+        if (indent_level == 0) {
+            iprintf(il, "description [label=\"%s\"]\n", escaped);
+        } else {
+            iprintf(il, "cluster_ttltable_%d_description [label=\"%s\"]\n",
+                    graph_number, escaped);
+        }
+        free(escaped);
+    }
+
+    if (indent_level == 0) {
+        // Use a single "pointer" edge as a starting point for the
+        // outermost datatype
+        iprintf(il, "t [label=\"%04lx\" xlabel=\"t\"]\n", PTR2ADDR(t));
+        iprintf(il, "t -> m%04lx\n", PTR2ADDR(t));
+
+        // Put the user nodes in userspace
+        iprintf(il, "subgraph cluster_userspace { label=\"User space\"\n");
+        for (int i = 0; i < t->bucket_count; i++) {
+            for (const ttl_entry *e = t->buckets[i]; e != NULL; e = e->chain) {
+                print_payload_node(il + 1, e->key, key_print_func);
+                print_payload_node(il + 1, e->value, value_print_func);
+            }
+        }
+        iprintf(il, "}\n");
+    }
+
+    // Print the subgraph to surround the table content
+    iprintf(il, "subgraph cluster_ttltable_%d { label=\"TTL table\"\n", graph_number);
+    il++;
+    print_head_node(il, t);
+    print_buckets(il, t);
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        print_wheel_level(il, t, level);
+    }
+    for (int i = 0; i < t->bucket_count; i++) {
+        for (const ttl_entry *e = t->buckets[i]; e != NULL; e = e->chain) {
+            print_entry_node(il, e);
+        }
+    }
+    il--;
+    iprintf(il, "}\n");
+
+    // Output the edges from the head, the buckets, the wheel and the
+    // entries.
+    print_edge(il, t, t->buckets, "b", "buckets", NULL);
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        char port[15];
+        sprintf(port, "w%d", level);
+        print_edge(il, t, t->wheel[level], port, NULL, NULL);
+        for (int i = 0; i < WHEEL_SIZE; i++) {
+            const ttl_entry *head = &t->wheel[level][i];
+            if (head->next != head) {
+                sprintf(port, "%02d", i);
+                print_edge(il, t->wheel[level], head->next, port, NULL, NULL);
+            }
+        }
+    }
+    for (int i = 0; i < t->bucket_count; i++) {
+        if (t->buckets[i] != NULL) {
+            char port[15];
+            sprintf(port, "%02d", i);
+            print_edge(il, t->buckets, t->buckets[i], port, NULL, NULL);
+        }
+    }
+    for (int i = 0; i < t->bucket_count; i++) {
+        for (const ttl_entry *e = t->buckets[i]; e != NULL; e = e->chain) {
+            print_edge(il, e, slot_link_node(t, e->prev), "p", "prev", NULL);
+            print_edge(il, e, slot_link_node(t, e->next), "n", "next", NULL);
+            if (e->chain != NULL) {
+                print_edge(il, e, e->chain, "c", "chain", NULL);
+            }
+            print_edge(il, e, e->key, "k", "key",
+                       t->key_kill_func ? "color=red" : "color=red style=dashed");
+            print_edge(il, e, e->value, "v", "value",
+                       t->value_kill_func ? "color=red" : "color=red style=dashed");
+        }
+    }
+
+    if (indent_level == 0) {
+        // Termination of graph
+        printf("}\n");
+    }
+}
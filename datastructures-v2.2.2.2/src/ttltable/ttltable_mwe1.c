@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ttltable.h>
+
+/*
+ * Minimum working example for ttltable.c. Keeps (session id, user)
+ * pairs that expire after a number of ticks, and shows how a session
+ * is kept alive by inserting it again. The table is responsible for
+ * deallocating the keys and values.
+ *
+ * Version information:
+ *   v1.0  2026-10-18: First public version.
+ */
+
+#define VERSION "v1.0"
+#define VERSION_DATE "2026-10-18"
+
+// Create a dynamic copy of the string str.
+char* string_copy(const char *str)
+{
+    // Use calloc to ensure a '\0' termination.
+    char *copy = calloc(strlen(str) + 1, sizeof(*copy));
+    strcpy(copy, str);
+    return copy;
+}
+
+// Create a dynamic copy of the integer i.
+int *int_create(int i)
+{
+    // Allocate memory for an integer and set the value
+    int *v = malloc(sizeof(*v));
+    *v = i;
+    return v;
+}
+
+// Interpret the supplied key and value pointers and print their content.
+void print_int_string_pair(const void *key, const void *value)
+{
+    const int *k=key;
+    const char *s=value;
+    printf("[%d, %s]\n", *k, s);
+}
+
+// Called by the table for each expired pair.
+void print_expired(const void *key, const void *value)
+{
+    printf("Expired ");
+    print_int_string_pair(key, value);
+}
+
+// Compare two keys (int *).
+int compare_ints(const void *k1, const void *k2)
+{
+    int key1 = *(int *)k1;
+    int key2 = *(int *)k2;
+
+    if ( key1 == key2 )
+        return 0;
+    if ( key1 < key2 )
+        return -1;
+    return 1;
+}
+
+// Hash a key (int *).
+unsigned long hash_int(const void *k)
+{
+    return *(const int *)k;
+}
+
+// Advance the clock and print the number of expired sessions.
+void advance(ttltable *t, unsigned long ticks)
+{
+    int expired = ttltable_advance_time(t, ticks);
+    printf("Time %lu: %d session(s) expired, %d left.\n", ttltable_now(t),
+           expired, ttltable_size(t));
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Expiring (integer, string) pairs.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s (%s).\n\n", CODE_BASE_VERSION, CODE_BASE_RELEASE_DATE);
+
+    // Hand over the deallocation responsibility to the table.
+    ttltable *t = ttltable_empty(compare_ints, hash_int, free, free);
+    ttltable_set_expire_callback(t, print_expired);
+
+    // Three sessions that live for 30, 60 and 1000 ticks.
+    ttltable_insert(t, int_create(1001), string_copy("alice"), 30);
+    ttltable_insert(t, int_create(1002), string_copy("bob"), 60);
+    ttltable_insert(t, int_create(1003), string_copy("carol"), 1000);
+
+    printf("Sessions at time %lu:\n", ttltable_now(t));
+    ttltable_print(t, print_int_string_pair);
+
+    advance(t, 20);
+
+    // Keep the session of bob alive for another 60 ticks.
+    int key = 1002;
+    printf("Session %d has %lu ticks left.\n", key, ttltable_time_left(t, &key));
+    ttltable_insert(t, int_create(1002), string_copy("bob"), 60);
+    printf("Session %d has %lu ticks left after a refresh.\n", key,
+           ttltable_time_left(t, &key));
+
+    advance(t, 20);
+    advance(t, 50);
+    advance(t, 1000);
+
+    // Kill the table, including the keys and values.
+    ttltable_kill(t);
+
+    printf("\nNormal exit.\n\n");
+    return 0;
+}
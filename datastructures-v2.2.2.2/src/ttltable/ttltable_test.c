@@ -0,0 +1,259 @@
+/*
+ * ttltable_test - test the table with expiring pairs.
+ *
+ * Should be compiled together with the TTL table implementation that
+ * follows the interface in ttltable.h of the code base for the
+ * Datastructures and Algorithms courses at the Department of
+ * Computing Science, Umea University.
+ *
+ * The program runs a number of correctness tests, and exits with an
+ * error message at the first failure.
+ *
+ * 2026-10-18 v1.0  First public version.
+ * 2026-10-18 v1.1  The helpers shared with the other tests, and the
+ *                  monotonic clock of the timing, come from testutil.c.
+ * 2026-10-18 v1.2  Moved from ou3/ttltest.c to
+ *                  src/ttltable/ttltable_test.c. The speed test and
+ *                  its command line arguments are removed.
+*/
+
+#define VERSION "v1.2"
+#define VERSION_DATE "2026-10-18"
+
+/*
+ * Correctness testing algorithm:
+ *
+ * 1. Tests that a new table is empty, and that a pair cannot be
+ *    inserted without a positive time to live.
+ * 2. Tests that pairs expire exactly at the time they should, for
+ *    times to live on each level of the timing wheel and beyond it,
+ *    also in a single long advance, and that the expire callback is
+ *    called for each of them.
+ * 3. Tests the table with a random sequence of inserts, refreshes,
+ *    removes and clock advances, both short ones and ones that pass
+ *    several slots of the higher levels, and compares the contents,
+ *    the time left of each pair and the number of expired pairs with
+ *    a simple array of expiry times.
+ * */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "ttltable.h"
+#include "testutil.h"
+
+/* Creates a table with int keys and values owned by the table.
+ */
+ttltable *int_table()
+{
+    return ttltable_empty(int_compare, int_hash, free, free);
+}
+
+/* Inserts the pair (key, value) into a table with int keys and values.
+ *    t - the table
+ *    key, value - the pair
+ *    ttl - the time to live
+ */
+void insert_int(ttltable *t, int key, int value, unsigned long ttl)
+{
+    if (ttltable_insert(t, int_ptr_from_int(key), int_ptr_from_int(value),
+                        ttl) != 0) {
+        printf("Inserting key %d with ttl %lu failed.\n", key, ttl);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Tests that a new table is empty.
+ */
+void test_isempty()
+{
+    ttltable *t = int_table();
+
+    if (!ttltable_is_empty(t) || ttltable_size(t) != 0
+        || ttltable_now(t) != 0) {
+        printf("A newly created table is not empty.\n");
+        exit(EXIT_FAILURE);
+    }
+    int key = 1;
+    if (ttltable_insert(t, &key, &key, 0) == 0 || !ttltable_is_empty(t)) {
+        printf("A pair with ttl 0 was inserted.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (ttltable_advance_time(t, 1000) != 0 || ttltable_now(t) != 1000) {
+        printf("Advancing the clock of an empty table failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    ttltable_kill(t);
+    printf("A new table is empty. - OK\n");
+}
+
+// The table whose expired pairs are recorded by record_expiry.
+ttltable *expiry_table;
+// The time when each key expired, recorded by record_expiry.
+unsigned long expired_at[16];
+
+// Expire callback used by test_expiry_times.
+void record_expiry(const void *key, const void *value)
+{
+    const int *k=key;
+    expired_at[*k]=ttltable_now(expiry_table);
+}
+
+/* Tests that pairs expire exactly when they should.
+ */
+void test_expiry_times()
+{
+    const unsigned long ttls[] = { 1, 2, 63, 64, 65, 127, 4095, 4096,
+                                   4097, 1UL << 18, (1UL << 18) + 1,
+                                   (1UL << 24) - 1, 1UL << 24,
+                                   (1UL << 24) + 65, 3UL << 24 };
+    const int count = sizeof(ttls)/sizeof(ttls[0]);
+    // Start with the clock in the middle of the wheel.
+    const unsigned long start = 12345;
+
+    expiry_table = int_table();
+    ttltable_set_expire_callback(expiry_table, record_expiry);
+    ttltable_advance_time(expiry_table, start);
+    for (int i = 0; i < count; i++) {
+        insert_int(expiry_table, i, i, ttls[i]);
+        expired_at[i] = 0;
+    }
+    int key = count - 1;
+    if (ttltable_time_left(expiry_table, &key) != ttls[count - 1]) {
+        printf("Wrong time left of key %d.\n", key);
+        exit(EXIT_FAILURE);
+    }
+    // Advance the clock in steps of different lengths.
+    int expired = 0;
+    for (unsigned long step = 1; !ttltable_is_empty(expiry_table); step = step * 7 + 1) {
+        expired += ttltable_advance_time(expiry_table, step);
+    }
+    if (expired != count) {
+        printf("%d pairs expired, expected %d.\n", expired, count);
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < count; i++) {
+        if (expired_at[i] != start + ttls[i]) {
+            printf("Key %d with ttl %lu expired at time %lu, "
+                   "expected %lu.\n", i, ttls[i], expired_at[i],
+                   start + ttls[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    // A single advance far beyond the range of the wheel.
+    unsigned long now = ttltable_now(expiry_table);
+    unsigned long far = (1UL << 36) + 5;
+    insert_int(expiry_table, 0, 0, far);
+    if (ttltable_advance_time(expiry_table, 1UL << 37) != 1
+        || expired_at[0] != now + far
+        || ttltable_now(expiry_table) != now + (1UL << 37)) {
+        printf("A pair with ttl %lu did not expire at time %lu "
+               "in a single advance.\n", far, now + far);
+        exit(EXIT_FAILURE);
+    }
+    ttltable_kill(expiry_table);
+    printf("Pairs expire exactly when their time to live has passed. - OK\n");
+}
+
+// The number of keys in test_random_operations.
+#define RANDOM_KEYS 200
+
+/* Checks that a table has the same contents as an array of expiry
+ * times, where 0 means that the key is missing.
+ *    t - the table
+ *    expiry - the expiry time of each key
+ */
+void check_against_reference(const ttltable *t, const unsigned long *expiry)
+{
+    int size = 0;
+    for (int key = 0; key < RANDOM_KEYS; key++) {
+        const int *v = ttltable_lookup(t, &key);
+        unsigned long left = ttltable_time_left(t, &key);
+        if (expiry[key] == 0) {
+            if (v != NULL || left != 0) {
+                printf("Key %d should have expired.\n", key);
+                exit(EXIT_FAILURE);
+            }
+            continue;
+        }
+        size++;
+        if (v == NULL || *v != key
+            || left != expiry[key] - ttltable_now(t)) {
+            printf("Key %d should have %lu ticks left.\n", key,
+                   expiry[key] - ttltable_now(t));
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (ttltable_size(t) != size) {
+        printf("The table has %d pairs, expected %d.\n",
+               ttltable_size(t), size);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Tests the table with a random sequence of operations.
+ */
+void test_random_operations()
+{
+    // Times to live on level 0, level 1 and level 2 of the wheel.
+    const unsigned long max_ttls[] = { 60, 4000, 200000 };
+    unsigned long expiry[RANDOM_KEYS] = { 0 };
+    ttltable *t = int_table();
+
+    for (int i = 0; i < 20000; i++) {
+        int key = rand() % RANDOM_KEYS;
+        int op = rand() % 4;
+        if (op == 0) {
+            ttltable_remove(t, &key);
+            expiry[key] = 0;
+        } else if (op == 1) {
+            // Insert or refresh the key.
+            unsigned long ttl = 1 + rand() % max_ttls[rand() % 3];
+            insert_int(t, key, key, ttl);
+            expiry[key] = ttltable_now(t) + ttl;
+        } else {
+            // Mostly short advances, and some long enough
+            // to pass several slots of the higher levels.
+            unsigned long ticks = op == 2 ? rand() % 3
+                : rand() % 8 == 0 ? rand() % 300000 : rand() % 300;
+            unsigned long now = ttltable_now(t) + ticks;
+            int expected = 0;
+            for (int k = 0; k < RANDOM_KEYS; k++) {
+                if (expiry[k] != 0 && expiry[k] <= now) {
+                    expiry[k] = 0;
+                    expected++;
+                }
+            }
+            int expired = ttltable_advance_time(t, ticks);
+            if (expired != expected) {
+                printf("%d pairs expired, expected %d.\n",
+                       expired, expected);
+                exit(EXIT_FAILURE);
+            }
+        }
+        check_against_reference(t, expiry);
+    }
+    ttltable_kill(t);
+    printf("Random inserts, refreshes, removes and clock advances. - OK\n");
+}
+
+/*  Tests the table by performing a set of tests. Program exits if any
+ *  error is found.
+ */
+void correctness_test()
+{
+    test_isempty();
+    test_expiry_times();
+    test_random_operations();
+}
+
+int main(void)
+{
+    printf("%s, %s %s: Test program for the ttltable.\n",
+           __FILE__, VERSION, VERSION_DATE);
+    printf("Code base version %s.\n\n", CODE_BASE_VERSION);
+
+    correctness_test();
+
+    printf("\nAll correctness tests succeeded! Normal exit.\n");
+    return 0;
+}
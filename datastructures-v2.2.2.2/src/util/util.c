@@ -0,0 +1,56 @@
+/*
+ * Implementation of the utility functions declared in util.h, shared
+ * by the data types of the code base for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University.
+ *
+ * Version information:
+ *   v1.0 2026-10-18: First public version, with the default allocator.
+ */
+
+#include <stdlib.h>
+
+#include <util.h>
+
+// Allocation function of the default allocator.
+static void *default_allocate(void *context, size_t size)
+{
+    return calloc(1, size);
+}
+
+// De-allocation function of the default allocator.
+static void default_deallocate(void *context, void *p, size_t size)
+{
+    free(p);
+}
+
+/**
+ * default_allocator() - Return the allocator that uses calloc and free.
+ *
+ * Returns: The allocator, which is never deallocated.
+ */
+const allocator *default_allocator(void)
+{
+    static const allocator a = {
+        default_allocate, default_deallocate, NULL
+    };
+    return &a;
+}
+
+/**
+ * allocator_deallocate() - Return memory to an allocator.
+ * @a: The allocator that allocated the memory.
+ * @p: The memory.
+ * @size: The size given to the allocation.
+ *
+ * Does nothing for an allocator that returns all its memory at once,
+ * i.e. without a deallocate function.
+ *
+ * Returns: Nothing.
+ */
+void allocator_deallocate(const allocator *a, void *p, size_t size)
+{
+    if (a->deallocate != NULL) {
+        a->deallocate(a->context, p, size);
+    }
+}